@@ -52,6 +52,8 @@ namespace dqm4hep {
         std::size_t     m_size = {0};
         /// Whether the structure owns the buffer
         bool            m_isOwner = {true};
+        /// The owner of the referenced buffer, if any
+        BufferHolder    m_holder = {nullptr};
       };
       
     public:
@@ -99,6 +101,18 @@ namespace dqm4hep {
        */
       void handleBuffer(char *b, std::size_t len);
       
+      /**
+       *  @brief  Let the event structure reference a buffer owned by a ref-counted holder,
+       *          i.e a network buffer model. The buffer is neither copied nor owned by the
+       *          event structure, but the holder is kept alive until the event is cleared.
+       *          Used to read events in place (see BufferEventStreamer)
+       *                
+       * @param b the buffer to reference
+       * @param len the buffer length
+       * @param holder the owner of the buffer
+       */
+      void handleBuffer(const char *b, std::size_t len, BufferHolder holder);
+      
       /**
        *  @brief  Access the event internal buffer 
        */
@@ -44,6 +44,12 @@ namespace dqm4hep {
      *  are called (default : not owner)
      *
      *  This interface doesn't allow moving sub-directories
+     *
+     *  Sub-directories and objects are indexed by name (T must provide a name() method).
+     *  The root directory of the tree also indexes all the objects of the tree by 
+     *  full name (directory full path + "/" + object name), see findObjectByPath().
+     *  If several objects have the same name in a directory, the indexes refer to 
+     *  one of them.
      */
     template <typename T>
     class Directory : public std::enable_shared_from_this<Directory<T>> {
@@ -99,6 +105,15 @@ namespace dqm4hep {
       template <typename F>
       ObjectPtr find(F function) const;
 
+      /** Find an object by name in the directory (indexed lookup)
+       */
+      StatusCode findObject(const std::string &objectName, ObjectPtr &object) const;
+
+      /** Find an object in the whole directory tree by full name (indexed lookup),
+       *  i.e "/path/to/dir/objectName". See pathPrefix()
+       */
+      StatusCode findObjectByPath(const std::string &fullName, ObjectPtr &object) const;
+
       /** Whether the directory contains the monitor element (search by ptr compare)
        */
       bool containsObject(const ObjectPtr &object) const;
@@ -134,6 +149,11 @@ namespace dqm4hep {
        */
       Path fullPath() const;
 
+      /** Get the full path name of the directory, terminated by "/".
+       *  This is the prefix of the full names of the directory objects
+       */
+      const std::string &pathPrefix() const;
+
       /** Whether the directory is a root directory
        */
       bool isRoot() const;
@@ -155,11 +175,33 @@ namespace dqm4hep {
        */
       Directory(const std::string &name, DirectoryPtr parent = nullptr);
 
+      /** Add the object in the name indexes
+       */
+      void indexObject(const ObjectPtr &object);
+
+      /** Remove the object from the name indexes. 
+       *  Must be called after removal from the content list
+       */
+      void unindexObject(const ObjectPtr &object);
+
+      /** Remove all the objects of the directory tree from the 
+       *  root index and detach the directories from the root
+       */
+      void unindexTree();
+
     private:
+      typedef std::unordered_map<std::string, DirectoryPtr> DirectoryIndex;
+      typedef std::unordered_map<std::string, ObjectPtr> ObjectIndex;
+
       std::string m_name;
       DirectoryPtr m_parent;
       DirectoryList m_subdirs;
       ObjectList m_contents;
+      std::string m_pathPrefix;                ///< The full path, terminated by "/"
+      Directory<T> *m_pRoot;                   ///< The root directory, owner of the full name index
+      DirectoryIndex m_subdirIndex = {};       ///< The sub directories by name
+      ObjectIndex m_contentIndex = {};         ///< The objects by name
+      ObjectIndex m_treeIndex = {};            ///< The objects of the tree by full name (root only)
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -180,7 +222,7 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
 
     template <typename T>
-    inline Directory<T>::Directory() : m_name(""), m_parent(nullptr), m_subdirs(), m_contents() {
+    inline Directory<T>::Directory() : m_name(""), m_parent(nullptr), m_subdirs(), m_contents(), m_pathPrefix("/"), m_pRoot(this) {
       /* nop */
     }
 
@@ -188,8 +230,14 @@ namespace dqm4hep {
 
     template <typename T>
     inline Directory<T>::Directory(const std::string &dname, DirectoryPtr dparent)
-        : m_name(dname), m_parent(dparent), m_subdirs(), m_contents() {
-      /* nop */
+        : m_name(dname), m_parent(dparent), m_subdirs(), m_contents(), m_pathPrefix(), m_pRoot(this) {
+      if (nullptr != m_parent) {
+        m_pathPrefix = m_parent->m_pathPrefix + m_name + "/";
+        m_pRoot = m_parent->m_pRoot;
+      } 
+      else {
+        m_pathPrefix = m_name.empty() ? "/" : "/" + m_name + "/";
+      }
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -237,6 +285,7 @@ namespace dqm4hep {
 
       auto newDirectory = Directory<T>::make_shared(dirName, this->shared_from_this());
       m_subdirs.push_back(newDirectory);
+      m_subdirIndex[dirName] = newDirectory;
 
       return newDirectory;
     }
@@ -245,36 +294,22 @@ namespace dqm4hep {
 
     template <typename T>
     inline bool Directory<T>::hasChild(const std::string &dirName) const {
-      if (dirName.find("/") != std::string::npos || dqm4hep::core::containsSpecialCharacters(dirName) ||
-          dirName.empty())
-        return false;
-
-      for (auto iter = m_subdirs.begin(), endIter = m_subdirs.end(); endIter != iter; ++iter) {
-        auto directory = *iter;
-
-        if (directory->name() == dirName)
-          return true;
-      }
-
-      return false;
+      return (m_subdirIndex.end() != m_subdirIndex.find(dirName));
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <typename T>
     inline StatusCode Directory<T>::find(const std::string &dirName, DirectoryPtr &directory) const {
-      directory = nullptr;
+      auto iter = m_subdirIndex.find(dirName);
 
-      for (auto iter = m_subdirs.begin(), endIter = m_subdirs.end(); endIter != iter; ++iter) {
-        auto dir = *iter;
-
-        if (dir->name() == dirName) {
-          directory = dir;
-          return STATUS_CODE_SUCCESS;
-        }
+      if (m_subdirIndex.end() == iter) {
+        directory = nullptr;
+        return STATUS_CODE_NOT_FOUND;
       }
 
-      return STATUS_CODE_NOT_FOUND;
+      directory = iter->second;
+      return STATUS_CODE_SUCCESS;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -288,6 +323,7 @@ namespace dqm4hep {
         return STATUS_CODE_ALREADY_PRESENT;
 
       m_contents.push_back(object);
+      this->indexObject(object);
 
       return STATUS_CODE_SUCCESS;
     }
@@ -306,13 +342,56 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    template <typename T>
+    inline StatusCode Directory<T>::findObject(const std::string &objectName, ObjectPtr &object) const {
+      auto iter = m_contentIndex.find(objectName);
+
+      if (m_contentIndex.end() == iter) {
+        object = nullptr;
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      object = iter->second;
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline StatusCode Directory<T>::findObjectByPath(const std::string &fullName, ObjectPtr &object) const {
+      object = nullptr;
+
+      // detached directory
+      if (nullptr == m_pRoot)
+        return STATUS_CODE_NOT_FOUND;
+
+      auto iter = m_pRoot->m_treeIndex.find(fullName);
+
+      if (m_pRoot->m_treeIndex.end() == iter)
+        return STATUS_CODE_NOT_FOUND;
+
+      object = iter->second;
+      return STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     template <typename T>
     inline bool Directory<T>::containsObject(const ObjectPtr &object) const {
       if (nullptr == object)
         return false;
 
-      for (auto iter = m_contents.begin(), endIter = m_contents.end(); endIter != iter; ++iter)
-        if (object == *iter)
+      auto iter = m_contentIndex.find(object->name());
+
+      if (m_contentIndex.end() == iter)
+        return false;
+
+      if (iter->second == object)
+        return true;
+
+      // another object with the same name is indexed
+      for (auto contentIter = m_contents.begin(), endIter = m_contents.end(); endIter != contentIter; ++contentIter)
+        if (object == *contentIter)
           return true;
 
       return false;
@@ -340,6 +419,7 @@ namespace dqm4hep {
       for (auto iter = m_contents.begin(), endIter = m_contents.end(); endIter != iter; ++iter) {
         if (object == *iter) {
           m_contents.erase(iter);
+          this->unindexObject(object);
           return STATUS_CODE_SUCCESS;
         }
       }
@@ -354,7 +434,9 @@ namespace dqm4hep {
     inline StatusCode Directory<T>::remove(F function) {
       for (auto iter = m_contents.begin(), endIter = m_contents.end(); endIter != iter; ++iter) {
         if (function(*iter)) {
+          ObjectPtr object = *iter;
           m_contents.erase(iter);
+          this->unindexObject(object);
           return STATUS_CODE_SUCCESS;
         }
       }
@@ -373,49 +455,66 @@ namespace dqm4hep {
 
     template <typename T>
     inline StatusCode Directory<T>::rmdir(const std::string &dirName) {
-      for (auto iter = m_subdirs.begin(), endIter = m_subdirs.end(); endIter != iter; ++iter) {
-        DirectoryPtr dir = *iter;
+      auto indexIter = m_subdirIndex.find(dirName);
+
+      if (m_subdirIndex.end() == indexIter)
+        return STATUS_CODE_NOT_FOUND;
+
+      DirectoryPtr dir = indexIter->second;
+      dir->unindexTree();
+      m_subdirIndex.erase(indexIter);
 
-        if (dir->name() == dirName) {
+      for (auto iter = m_subdirs.begin(), endIter = m_subdirs.end(); endIter != iter; ++iter) {
+        if (dir == *iter) {
           m_subdirs.erase(iter);
-          return STATUS_CODE_SUCCESS;
+          break;
         }
       }
 
-      return STATUS_CODE_NOT_FOUND;
+      return STATUS_CODE_SUCCESS;
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <typename T>
     inline void Directory<T>::clear() {
-      for (auto iter = m_subdirs.begin(), endIter = m_subdirs.end(); endIter != iter; ++iter)
+      for (auto iter = m_subdirs.begin(), endIter = m_subdirs.end(); endIter != iter; ++iter) {
         (*iter)->clear();
+        (*iter)->m_pRoot = nullptr;
+      }
+
+      if (nullptr != m_pRoot) {
+        if (m_pRoot == this) {
+          m_treeIndex.clear();
+        } 
+        else {
+          for (auto iter = m_contents.begin(), endIter = m_contents.end(); endIter != iter; ++iter)
+            m_pRoot->m_treeIndex.erase(m_pathPrefix + (*iter)->name());
+        }
+      }
 
       m_subdirs.clear();
       m_contents.clear();
+      m_subdirIndex.clear();
+      m_contentIndex.clear();
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <typename T>
     inline Path Directory<T>::fullPath() const {
-      Path fPath = this->name();
-      DirectoryPtr dir = const_cast<Directory<T> *>(this)->shared_from_this();
+      // the prefix is "/" for an unnamed root directory
+      if (m_pathPrefix.size() == 1)
+        return Path(m_pathPrefix);
 
-      while (true) {
-        DirectoryPtr parentDir = dir->parent();
+      return Path(m_pathPrefix.substr(0, m_pathPrefix.size() - 1));
+    }
 
-        if (nullptr != parentDir) {
-          fPath = parentDir->name() + fPath;
-          dir = parentDir;
-        } else {
-          fPath = Path("/") + fPath;
-          break;
-        }
-      }
+    //-------------------------------------------------------------------------------------------------
 
-      return fPath;
+    template <typename T>
+    inline const std::string &Directory<T>::pathPrefix() const {
+      return m_pathPrefix;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -441,6 +540,63 @@ namespace dqm4hep {
       }
       return parent()->nParents() + 1;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline void Directory<T>::indexObject(const ObjectPtr &object) {
+      // keep the first object added with this name
+      m_contentIndex.insert(typename ObjectIndex::value_type(object->name(), object));
+
+      if (nullptr != m_pRoot)
+        m_pRoot->m_treeIndex.insert(typename ObjectIndex::value_type(m_pathPrefix + object->name(), object));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline void Directory<T>::unindexObject(const ObjectPtr &object) {
+      auto iter = m_contentIndex.find(object->name());
+
+      if (m_contentIndex.end() == iter || iter->second != object)
+        return;
+
+      // index another object with the same name, if any
+      ObjectPtr replacement = this->find([&object](const ObjectPtr &other) { 
+        return other->name() == object->name(); 
+      });
+
+      if (nullptr != replacement)
+        iter->second = replacement;
+      else
+        m_contentIndex.erase(iter);
+
+      if (nullptr == m_pRoot)
+        return;
+
+      const std::string fullName(m_pathPrefix + object->name());
+
+      if (nullptr != replacement)
+        m_pRoot->m_treeIndex[fullName] = replacement;
+      else
+        m_pRoot->m_treeIndex.erase(fullName);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline void Directory<T>::unindexTree() {
+      if (nullptr == m_pRoot)
+        return;
+
+      for (auto iter = m_contents.begin(), endIter = m_contents.end(); endIter != iter; ++iter)
+        m_pRoot->m_treeIndex.erase(m_pathPrefix + (*iter)->name());
+
+      for (auto iter = m_subdirs.begin(), endIter = m_subdirs.end(); endIter != iter; ++iter)
+        (*iter)->unindexTree();
+
+      m_pRoot = nullptr;
+    }
   }
 }
 
@@ -134,6 +134,10 @@ namespace dqm4hep {
       /** Get the streamer name
        */
       const std::string &getStreamerName() const;
+      
+      /** Get the streamer id, computed once from the streamer name (see EventStreamer::streamerId())
+       */
+      uint16_t getStreamerId() const;
 
       /** Clear the event.
        *  Should call the real event implementation
@@ -170,6 +174,15 @@ namespace dqm4hep {
        */
       void readBase(TBuffer &buffer);
 
+      /** Write the base event information with fixed-width fields, 
+       *  except the event type (see EventStreamer binary envelope)
+       */
+      void writeHeader(TBuffer &buffer) const;
+
+      /** Read the base event information written by writeHeader()
+       */
+      void readHeader(TBuffer &buffer);
+
     protected:
       EventType              m_type = {UNKNOWN_EVENT};       ///< The event type
       std::string            m_source = {""};                ///< The event source
@@ -178,6 +191,7 @@ namespace dqm4hep {
       uint32_t               m_eventNumber = {0};            ///< The event number
       uint32_t               m_runNumber = {0};              ///< The run number
       std::string            m_streamerName = {""};
+      uint16_t               m_streamerId = {0};             ///< The streamer id, hash of the streamer name
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -32,6 +32,13 @@
 #include <dqm4hep/Event.h>
 #include <dqm4hep/StatusCodes.h>
 
+// -- std headers
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 class TBuffer;
 
 namespace dqm4hep {
@@ -39,9 +46,67 @@ namespace dqm4hep {
   namespace core {
 
     class Event;
+
+    /**
+     *  @brief  A reference on the owner of the memory of a read buffer.
+     *          Events read in place hold it as long as they reference the memory
+     */
+    typedef std::shared_ptr<const void> BufferHolder;
     
+    /**
+     *  @brief  EventStreamer class.
+     *          Write and read events in a versioned binary envelope:
+     *           - magic number (UInt_t)
+     *           - envelope version (UChar_t)
+     *           - event type (UChar_t)
+     *           - streamer id (UShort_t), see EventStreamer::streamerId()
+     *           - event number, run number (UInt_t)
+     *           - time stamp in microseconds since epoch (Long64_t)
+     *           - source name (UShort_t size + characters)
+     *           - payload length in bytes (UInt_t)
+     *           - payload, written by the streamer plugin
+     *          The streamer plugins are looked up by id in the EventStreamerRegistry.
+     *          Events written in the former format (streamer name + base 
+     *          event fields) are still read.
+     *          Several envelopes can be packed in a batch of events: 
+     *           - batch magic number (UInt_t)
+     *           - number of events (UInt_t)
+     *           - the event envelopes, one after the other
+     */
     class EventStreamer {
     public:
+      static const uint32_t magic;      ///< The envelope magic number
+      static const uint8_t version;     ///< The envelope version
+      static const uint32_t batchMagic; ///< The batch of events magic number
+      static const size_t batchHeaderSize = 8;  ///< The batch of events header size
+      static const size_t minEventSize = 30;    ///< The minimum envelope size (empty source and payload)
+      
+      /**
+       *  @brief  Get the id of a streamer plugin, a 16 bits hash of the streamer name.
+       *          The id is the same in all processes. Never 0
+       *
+       *  @param  name the streamer plugin name
+       */
+      static uint16_t streamerId(const std::string &name);
+      
+      /**
+       *  @brief  Write the header of a batch of events at the current buffer offset.
+       *          The event envelopes are then written with writeEvent()
+       *
+       *  @param  buffer the buffer to write with
+       *  @param  nEvents the number of events in the batch
+       */
+      static void writeBatchHeader(TBuffer &buffer, uint32_t nEvents);
+      
+      /**
+       *  @brief  Get the number of events in a serialized buffer:
+       *          the batch size for a batch of events, else 1
+       *
+       *  @param  buffer the serialized buffer
+       *  @param  size the buffer size
+       */
+      static uint32_t nEvents(const char *buffer, size_t size);
+      
       /**
        *  @brief  Default constructor
        */
@@ -52,6 +117,11 @@ namespace dqm4hep {
        */
       ~EventStreamer() = default;
       
+      /**
+       *  @brief  Get the streamer plugins known by the registry, by id
+       */
+      std::map<uint16_t, std::string> streamers();
+      
       /**
        *  @brief  Write an event using an xdrstream device.
        *          The streamer info is taken from Event::getStreamerName()
@@ -64,17 +134,104 @@ namespace dqm4hep {
       
       /**
        *  @brief  Read an event using an xdrstream device.
-       *          The streamer info is read from the buffer
-       *          and the streamer if allocated from the plugin manager.
+       *          The streamer id is read from the buffer and 
+       *          the streamer is looked up in the streamer registry.
+       *          If a holder of the buffer memory is given, the streamer plugin
+       *          may reference the memory in the event instead of copying it 
+       *          (see EventStreamerPlugin::readInPlace())
        *          
        *  @param  event the event to read
        *  @param  buffer the buffer to read with
+       *  @param  holder the owner of the buffer memory (optional)
+       */
+      StatusCode readEvent(EventPtr &event, TBuffer &buffer, const BufferHolder &holder = nullptr);
+      
+      /**
+       *  @brief  Read a batch of events or a single event (see readEvent()).
+       *          The events are appended to the list. On failure, the events read 
+       *          before the failing one are still appended
+       *          
+       *  @param  events the list of events to append to
+       *  @param  buffer the buffer to read with
+       *  @param  holder the owner of the buffer memory (optional)
        */
-      StatusCode readEvent(EventPtr &event, TBuffer &buffer);
+      StatusCode readEvents(EventList &events, TBuffer &buffer, const BufferHolder &holder = nullptr);
       
     private:
-      std::string                  m_streamerName = {""};     ///< The current event streamer name in use
-      EventStreamerPluginPtr       m_streamer = {nullptr};    ///< The current event streamer in use
+      /**
+       *  @brief  Read an event written in the former format (streamer name + base event fields)
+       */
+      StatusCode readLegacyEvent(EventPtr &event, TBuffer &buffer, const BufferHolder &holder);
+    };
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  EventStreamerRegistry class.
+     *          The process wide table of the streamer plugins registered in the plugin 
+     *          manager, by streamer id (see EventStreamer::streamerId()). Each thread gets 
+     *          its own instance of a streamer plugin, created on first use and cached until 
+     *          the thread exits, so that the plugins don't need to be thread safe and all 
+     *          the EventStreamer of a thread share the same instances. Thread safe
+     */
+    class EventStreamerRegistry {
+    public:
+      /**
+       *  @brief  Entry struct
+       */
+      struct Entry {
+        const std::string           *m_name = {nullptr};         ///< The streamer plugin name
+        EventStreamerPluginPtr       m_streamer = {nullptr};     ///< The streamer plugin instance of the thread
+      };
+
+      EventStreamerRegistry(const EventStreamerRegistry&) = delete;
+      EventStreamerRegistry& operator=(const EventStreamerRegistry&) = delete;
+
+      /**
+       *  @brief  Get the unique registry instance
+       */
+      static EventStreamerRegistry &instance();
+
+      /**
+       *  @brief  Get the streamer plugin of the calling thread by id.
+       *          The table is updated once if the id is unknown (plugin library loaded
+       *          since the last update). The entry is valid until the calling thread exits
+       *
+       *  @param  id the streamer id
+       *  @return the entry, nullptr if no plugin is registered with this id
+       */
+      const Entry *find(uint16_t id);
+
+      /**
+       *  @brief  Get the registered streamer plugins, by id
+       */
+      std::map<uint16_t, std::string> streamers();
+
+      /**
+       *  @brief  Get the number of streamer plugin instances created since the program start
+       */
+      size_t nCreatedStreamers() const;
+
+    private:
+      /**
+       *  @brief  Constructor
+       */
+      EventStreamerRegistry() = default;
+
+      /**
+       *  @brief  Add the streamer plugins registered in the plugin manager to the table.
+       *          Must be called with the lock held
+       */
+      void update();
+
+    private:
+      typedef std::unordered_map<uint16_t, std::string> NameTable;
+
+      NameTable                    m_names = {};              ///< The streamer plugin names by id
+      size_t                       m_nPlugins = {0};          ///< The number of streamer plugins at the last update
+      std::atomic<size_t>          m_nCreated = {0};          ///< The number of created streamer plugin instances
+      std::mutex                   m_mutex = {};              ///< The registry mutex
     };
     
     //-------------------------------------------------------------------------------------------------
@@ -100,6 +257,12 @@ namespace dqm4hep {
       /** De-serialize an event given from the data stream
        */
       virtual StatusCode read(EventPtr event, TBuffer &buffer) = 0;
+
+      /** De-serialize an event given from the data stream, possibly referencing the 
+       *  buffer memory instead of copying it. The event must then keep the holder 
+       *  as long as it references the memory. Calls read() by default
+       */
+      virtual StatusCode readInPlace(EventPtr event, TBuffer &buffer, const BufferHolder &holder);
     };
 
   }
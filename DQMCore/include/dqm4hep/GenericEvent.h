@@ -39,11 +39,62 @@ namespace dqm4hep {
 
     class GenericEventStreamer;
 
+    /** Span class
+     *
+     *  A non-owning view on contiguous values (pointer + size)
+     */
+    template <typename T>
+    class Span {
+    public:
+      /** Constructor
+       */
+      Span() = default;
+
+      /** Constructor
+       */
+      Span(T *data, size_t size);
+
+      /** Get the first value address
+       */
+      T *data() const;
+
+      /** Get the number of values
+       */
+      size_t size() const;
+
+      /** Whether the span has no value
+       */
+      bool empty() const;
+
+      /** Get the begin iterator
+       */
+      T *begin() const;
+
+      /** Get the end iterator
+       */
+      T *end() const;
+
+      /** Get the i-th value (no bound check)
+       */
+      T &operator[](size_t i) const;
+
+    private:
+      T *m_data = {nullptr};
+      size_t m_size = {0};
+    };
+
     /** GenericEvent class
      *
-     *  Basic event implementation with a list of vectors stored in maps.
+     *  Basic event implementation with a list of columns (int, float, double
+     *  or string values) identified by a key. Keys are interned process wide
+     *  to integer ids, see GenericEvent::key(). The numeric columns of an event 
+     *  are stored in a single contiguous arena and the strings in a list of 
+     *  string slots. GenericEvent::reset() clears the event but keeps the arena 
+     *  and string capacities, so that a recycled event can be filled again 
+     *  without memory allocation.
      *  See GenericEvent::setValues() and GenericEvent::getValues() to
-     *  respectively set and get values into these map.
+     *  respectively copy values in and out of the event, and GenericEvent::values()
+     *  and GenericEvent::allocateValues() to access them without copy.
      *
      *  To get this kind of event within an analysis module, proceed like this :
      *
@@ -53,9 +104,9 @@ namespace dqm4hep {
      *
      *  	GenericEvent *pGenericEvent = pEvent->getEvent<GenericEvent>();
      *
-     *      // Access contents via getValues()
-     *  	FloatVector temperatures;
-     *  	pGenericEvent->getValues("Temperature", temperatures);
+     *      // Access contents via values(), without copy
+     *      static const GenericEvent::KeyId temperatureKey = GenericEvent::key("Temperature");
+     *  	Span<const float> temperatures = pGenericEvent->values<float>(temperatureKey);
      *  	// ...
      *  }
      *
@@ -63,11 +114,28 @@ namespace dqm4hep {
      */
     class GenericEvent {
     public:
+      typedef uint32_t KeyId;
+
       /**
        *  @brief  Allocate a shared pointer of EventPtr
        */
       static EventPtr make_shared();
-      
+
+      /**
+       *  @brief  Get the id of a key. The key is interned on first call. Thread safe.
+       *          The ids are only valid in the current process
+       *
+       *  @param  name the key name
+       */
+      static KeyId key(const std::string &name);
+
+      /**
+       *  @brief  Get the name of an interned key. Thread safe
+       *
+       *  @param  id the key id
+       */
+      static const std::string &keyName(KeyId id);
+
       /** Constructor
        */
       GenericEvent();
@@ -76,7 +144,12 @@ namespace dqm4hep {
        */
       ~GenericEvent();
 
+      /** Clear the event contents. The memory is kept for the next fill
+       */
+      void reset();
+
       /** Set a vector of values identified by key.
+       *  Existing values of the same key and type are replaced.
        *
        *  Attention : Template interface restricted to the following types :
        *    - vector<int>
@@ -89,7 +162,13 @@ namespace dqm4hep {
       template <typename T>
       StatusCode setValues(const std::string &key, const T &vals);
 
+      /** Set a vector of values identified by key id. See setValues() above
+       */
+      template <typename T>
+      StatusCode setValues(KeyId key, const T &vals);
+
       /** Get a vector of values identified by key.
+       *  The values are inserted at the beginning of the vector.
        *
        *  Attention : Template interface restricted to the following types :
        *    - vector<int>
@@ -102,20 +181,201 @@ namespace dqm4hep {
       template <typename T>
       StatusCode getValues(const std::string &key, T &vals) const;
 
+      /** Get a vector of values identified by key id. See getValues() above
+       */
+      template <typename T>
+      StatusCode getValues(KeyId key, T &vals) const;
+
+      /** Get a view on the values identified by key id, without copy.
+       *  T must be int, float, double or std::string.
+       *  The view is empty if the key is not found and is invalidated 
+       *  by any further modification of the event.
+       */
+      template <typename T>
+      Span<const T> values(KeyId key) const;
+
+      /** Allocate n values identified by key id and get write access to them.
+       *  T must be int, float, double or std::string. Existing values of the
+       *  same key and type are replaced. The values are not initialized (numeric
+       *  types) or keep their previous contents (strings) and the view is 
+       *  invalidated by any further modification of the event.
+       */
+      template <typename T>
+      Span<T> allocateValues(KeyId key, size_t size);
+
+      /** Whether values of the given type exist for the key id
+       */
+      template <typename T>
+      bool hasValues(KeyId key) const;
+
     private:
-      typedef std::map<std::string, IntVector> IntVectorMap;
-      typedef std::map<std::string, FloatVector> FloatVectorMap;
-      typedef std::map<std::string, DoubleVector> DoubleVectorMap;
-      typedef std::map<std::string, StringVector> StringVectorMap;
+      /** ColumnType enumerator
+       */
+      enum ColumnType : uint8_t { INT_COLUMN = 0, FLOAT_COLUMN = 1, DOUBLE_COLUMN = 2, STRING_COLUMN = 3 };
 
-      IntVectorMap m_intValues = {};
-      FloatVectorMap m_floatValues = {};
-      DoubleVectorMap m_doubleValues = {};
-      StringVectorMap m_stringValues = {};
+      /** ColumnTraits struct
+       */
+      template <typename T>
+      struct ColumnTraits;
+
+      /** Column struct
+       */
+      struct Column {
+        KeyId         m_key;        ///< The column key id
+        ColumnType    m_type;       ///< The column value type
+        size_t        m_offset;     ///< The arena offset in bytes (or the first string slot)
+        size_t        m_size;       ///< The number of values
+      };
+      typedef std::vector<Column> ColumnList;
+
+      /** Find a column by key and type. Linear search, events have a few columns
+       */
+      const Column *findColumn(KeyId key, ColumnType type) const;
+
+      /** Allocate a column of n values of a given type
+       */
+      const Column &allocateColumn(KeyId key, ColumnType type, size_t size, size_t valueSize);
+
+      /** Release the storage of a column, moving down the columns stored after it
+       */
+      void releaseColumn(const Column &column, size_t valueSize);
+
+      /** Get the arena address of a column
+       */
+      const char *columnData(const Column &column) const;
+
+    private:
+      ColumnList                   m_columns = {};     ///< The event columns
+      std::vector<char>            m_arena = {};       ///< The numeric values of all columns
+      size_t                       m_arenaSize = {0};  ///< The used arena size in bytes
+      StringVector                 m_strings = {};     ///< The string slots of all columns
+      size_t                       m_nStrings = {0};   ///< The number of used string slots
 
       friend class GenericEventStreamer;
     };
 
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline Span<T>::Span(T *data, size_t size) : m_data(data), m_size(size) {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline T *Span<T>::data() const {
+      return m_data;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline size_t Span<T>::size() const {
+      return m_size;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline bool Span<T>::empty() const {
+      return 0 == m_size;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline T *Span<T>::begin() const {
+      return m_data;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline T *Span<T>::end() const {
+      return m_data + m_size;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline T &Span<T>::operator[](size_t i) const {
+      return m_data[i];
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    struct GenericEvent::ColumnTraits<int> {
+      static const ColumnType type = INT_COLUMN;
+    };
+
+    template <>
+    struct GenericEvent::ColumnTraits<float> {
+      static const ColumnType type = FLOAT_COLUMN;
+    };
+
+    template <>
+    struct GenericEvent::ColumnTraits<double> {
+      static const ColumnType type = DOUBLE_COLUMN;
+    };
+
+    template <>
+    struct GenericEvent::ColumnTraits<std::string> {
+      static const ColumnType type = STRING_COLUMN;
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline Span<const T> GenericEvent::values(KeyId key) const {
+      const Column *pColumn = this->findColumn(key, ColumnTraits<T>::type);
+
+      if (nullptr == pColumn) {
+        return Span<const T>();
+      }
+
+      return Span<const T>(reinterpret_cast<const T *>(this->columnData(*pColumn)), pColumn->m_size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    inline Span<const std::string> GenericEvent::values(KeyId key) const {
+      const Column *pColumn = this->findColumn(key, STRING_COLUMN);
+
+      if (nullptr == pColumn) {
+        return Span<const std::string>();
+      }
+
+      return Span<const std::string>(m_strings.data() + pColumn->m_offset, pColumn->m_size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline Span<T> GenericEvent::allocateValues(KeyId key, size_t size) {
+      const Column &column(this->allocateColumn(key, ColumnTraits<T>::type, size, sizeof(T)));
+      return Span<T>(reinterpret_cast<T *>(m_arena.data() + column.m_offset), size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    inline Span<std::string> GenericEvent::allocateValues(KeyId key, size_t size) {
+      const Column &column(this->allocateColumn(key, STRING_COLUMN, size, 0));
+      return Span<std::string>(m_strings.data() + column.m_offset, size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline bool GenericEvent::hasValues(KeyId key) const {
+      return (nullptr != this->findColumn(key, ColumnTraits<T>::type));
+    }
+
   }
   
 }
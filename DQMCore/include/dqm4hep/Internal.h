@@ -274,6 +274,7 @@ namespace dqm4hep {
     // event
     typedef type<Event>::ptr EventPtr;
     typedef type<Event>::ptr_deque EventQueue;
+    typedef type<Event>::ptr_vector EventList;
     typedef type<EventStreamerPlugin>::ptr EventStreamerPluginPtr;
 
     // plugin
@@ -521,14 +522,9 @@ namespace dqm4hep {
     /** Whether the string contains a special character
      */
     inline bool containsSpecialCharacters(const std::string &str) {
-      StringVector specialCharacterList = dqm4hep::core::getSpecialCharacterList();
-
-      for (auto iter = specialCharacterList.begin(), endIter = specialCharacterList.end(); endIter != iter; ++iter) {
-        if (str.find(*iter) != std::string::npos)
-          return true;
-      }
-
-      return false;
+      // same characters as getSpecialCharacterList(), without allocation
+      static const char specialCharacters[] = "|&;<>()$\\'\"\t\n*?,[]#~=%";
+      return (str.find_first_of(specialCharacters) != std::string::npos);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -0,0 +1,229 @@
+/// \file JsonWriter.h
+/*
+ *
+ * JsonWriter.h header template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+#ifndef DQM4HEP_JSONWRITER_H
+#define DQM4HEP_JSONWRITER_H
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+
+namespace dqm4hep {
+
+  namespace core {
+
+    /**
+     *  @brief  JsonWriter class.
+     *          Writes compact json directly in a string, without building
+     *          an intermediate json tree. Separators between values are
+     *          handled by the writer. The caller is responsible for the
+     *          object/array nesting and for writing a key before each
+     *          object member value.
+     *
+     *  @code
+     *  std::string output;
+     *  JsonWriter writer(output);
+     *  writer.beginObject();
+     *  writer.key("name").value("h1");
+     *  writer.key("bins").array(bins.data(), bins.size());
+     *  writer.endObject();
+     *  @endcode
+     */
+    class JsonWriter {
+    public:
+      JsonWriter(const JsonWriter&) = delete;
+      JsonWriter& operator=(const JsonWriter&) = delete;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  output the string to append the json to
+       */
+      JsonWriter(std::string &output);
+
+      /**
+       *  @brief  Get the output string
+       */
+      const std::string &output() const;
+
+      /**
+       *  @brief  Open a json object
+       */
+      JsonWriter &beginObject();
+
+      /**
+       *  @brief  Close the current json object
+       */
+      JsonWriter &endObject();
+
+      /**
+       *  @brief  Open a json array
+       */
+      JsonWriter &beginArray();
+
+      /**
+       *  @brief  Close the current json array
+       */
+      JsonWriter &endArray();
+
+      /**
+       *  @brief  Write an object member key. Must be followed by a value
+       *
+       *  @param  name the key name
+       */
+      JsonWriter &key(const char *name);
+      JsonWriter &key(const std::string &name);
+
+      /**
+       *  @brief  Write a value
+       */
+      JsonWriter &value(std::nullptr_t);
+      JsonWriter &value(bool val);
+      JsonWriter &value(int val);
+      JsonWriter &value(unsigned int val);
+      JsonWriter &value(long long val);
+      JsonWriter &value(unsigned long long val);
+      JsonWriter &value(float val);
+      JsonWriter &value(double val);
+      JsonWriter &value(const char *val);
+      JsonWriter &value(const std::string &val);
+
+      /**
+       *  @brief  Write an already formatted json value as it is
+       *
+       *  @param  json the json value
+       *  @param  length the json value length
+       */
+      JsonWriter &raw(const char *json, std::size_t length);
+      JsonWriter &raw(const std::string &json);
+
+      /**
+       *  @brief  Write an array of numbers.
+       *          If a type name is given (JSROOT typed array name, i.e "Float64"),
+       *          long runs of zeros are suppressed using the JSROOT compressed
+       *          array format: {"$arr":"Float64","len":n,"p":pos,"v":[...],"p1":...}
+       *
+       *  @param  values the array values
+       *  @param  size the array size
+       *  @param  typeName the JSROOT typed array name, nullptr for a plain json array
+       */
+      template <typename T>
+      JsonWriter &array(const T *values, std::size_t size, const char *typeName = nullptr);
+
+    private:
+      /**
+       *  @brief  Write the separator before a new value, if needed
+       */
+      void separator();
+
+      /**
+       *  @brief  Append a number to the output (no separator)
+       */
+      void number(int val);
+      void number(unsigned int val);
+      void number(long long val);
+      void number(unsigned long long val);
+      void number(float val);
+      void number(double val);
+
+      /**
+       *  @brief  Append a quoted and escaped string to the output (no separator)
+       */
+      void string(const char *str, std::size_t length);
+
+    private:
+      /// The minimum number of consecutive zeros suppressed in typed arrays
+      static const std::size_t         minZeroRun;
+
+      std::string                     &m_output;          ///< The output string
+      std::vector<bool>                m_firstInScope = {}; ///< Whether the next value is the first one of each opened scope
+      bool                             m_afterKey = {false}; ///< Whether a key has just been written
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    inline JsonWriter &JsonWriter::array(const T *values, std::size_t size, const char *typeName) {
+      // plain array
+      if(nullptr == typeName) {
+        beginArray();
+        for(std::size_t i=0 ; i<size ; i++) {
+          if(0 != i) {
+            m_output.push_back(',');
+          }
+          number(values[i]);
+        }
+        return endArray();
+      }
+      // find the first long run of zeros. No run, no compression
+      std::size_t run(0), i(0);
+      for( ; i<size ; i++) {
+        run = (values[i] == T(0)) ? run+1 : 0;
+        if(run == minZeroRun) {
+          break;
+        }
+      }
+      if(i == size) {
+        return array(values, size);
+      }
+      // compressed array, only non zero segments are written
+      beginObject();
+      key("$arr").value(typeName);
+      key("len").value(static_cast<unsigned long long>(size));
+      std::size_t pos(0), segment(0);
+      while(pos < size) {
+        // skip zeros
+        while(pos < size and values[pos] == T(0)) {
+          pos++;
+        }
+        if(pos == size) {
+          break;
+        }
+        // segment ends at the next long run of zeros
+        std::size_t end(pos), zeros(0);
+        for( ; end<size ; end++) {
+          zeros = (values[end] == T(0)) ? zeros+1 : 0;
+          if(zeros == minZeroRun) {
+            break;
+          }
+        }
+        end = (end < size) ? end + 1 - zeros : end - zeros;
+        const std::string suffix(0 == segment ? "" : std::to_string(segment));
+        key("p" + suffix).value(static_cast<unsigned long long>(pos));
+        key("v" + suffix);
+        array(values + pos, end - pos);
+        pos = end;
+        segment++;
+      }
+      return endObject();
+    }
+
+  }
+
+}
+
+#endif  //  DQM4HEP_JSONWRITER_H
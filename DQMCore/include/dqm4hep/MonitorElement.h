@@ -43,12 +43,15 @@
 #include <TPad.h>
 
 class TBuffer;
+class TAxis;
+class TH1;
 
 namespace dqm4hep {
 
   namespace core {
 
     class MonitorElementManager;
+    class JsonWriter;
 
     /**
      *  @brief  MonitorElement class.
@@ -222,12 +225,38 @@ namespace dqm4hep {
       virtual void reset(bool resetQtests = true);
       
       /**
-       *  @brief  Convert the monitor element to json
+       *  @brief  Convert the monitor element to json.
+       *          Parses the output of the streaming writer. Prefer the 
+       *          string or writer versions when the json is only dumped
        *  
        *  @param  object the json object to receive
        */
       virtual void toJson(json &object) const;
       
+      /**
+       *  @brief  Write the monitor element as json in a string
+       *  
+       *  @param  output the string to append the json to
+       */
+      void toJson(std::string &output) const;
+      
+      /**
+       *  @brief  Write the monitor element as json with a streaming writer
+       *  
+       *  @param  writer the json writer
+       */
+      void toJson(JsonWriter &writer) const;
+      
+      /**
+       *  @brief  Write a ROOT object as json (JSROOT format).
+       *          Histograms are streamed directly, other objects 
+       *          are converted with TBufferJSON
+       *  
+       *  @param  writer the json writer
+       *  @param  pObject the object to write (null allowed)
+       */
+      static void writeObjectJson(JsonWriter &writer, const TObject *pObject);
+      
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6, 14, 0)
       /**
        *  @brief  Parse the json object and set monitor element properties
@@ -256,6 +285,14 @@ namespace dqm4hep {
        *  @brief  Constructor
        */
       MonitorElement();
+      
+      /**
+       *  @brief  Write the monitor element json object members.
+       *          Override to add members, calling the base implementation
+       *  
+       *  @param  writer the json writer
+       */
+      virtual void writeJsonMembers(JsonWriter &writer) const;
 
       /** 
        *  @brief  Constructor with ROOT object
@@ -330,6 +367,18 @@ namespace dqm4hep {
        */
       virtual StatusCode runQualityTest(const std::string &name, QReport &report);
 
+    private:
+      /**
+       *  @brief  Stream a histogram as json, as TBufferJSON would do.
+       *          Returns false if the histogram can't be streamed (see implementation)
+       */
+      static bool writeHistogramJson(JsonWriter &writer, const TH1 *pHistogram);
+      
+      /**
+       *  @brief  Stream a histogram axis as json, as TBufferJSON would do
+       */
+      static void writeAxisJson(JsonWriter &writer, const TAxis *pAxis);
+
     private:
       /// The monitor element path
       std::string m_path = {""};
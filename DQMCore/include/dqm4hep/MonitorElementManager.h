@@ -307,6 +307,14 @@ namespace dqm4hep {
        */
       void monitorElementsToJson(json &object) const;
       
+      /**
+       *  @brief  Write all monitor elements in the storage as a json array in a string.
+       *          Faster than the json object version (no intermediate json tree)
+       *  
+       *  @param  output the string to append the json array to
+       */
+      void monitorElementsToJson(std::string &output) const;
+      
       /**
        *  @brief  Add a reference file under the specified id
        *  
@@ -618,12 +626,7 @@ namespace dqm4hep {
     template <typename T>
     inline StatusCode MonitorElementManager::getMonitorElement(const std::string &name,
                                                         std::shared_ptr<T> &monitorElement) const {
-      monitorElement = std::dynamic_pointer_cast<T>(m_storage.findObject([&name](const MonitorElementPtr &elt) { return (elt->name() == name); }));
-
-      if (nullptr == monitorElement)
-        return STATUS_CODE_NOT_FOUND;
-
-      return STATUS_CODE_SUCCESS;
+      return this->getMonitorElement("", name, monitorElement);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -631,8 +634,9 @@ namespace dqm4hep {
     template <typename T>
     inline StatusCode MonitorElementManager::getMonitorElement(const std::string &dirName, const std::string &name,
                                                         std::shared_ptr<T> &monitorElement) const {
-      monitorElement = std::dynamic_pointer_cast<T>(
-          m_storage.findObject(dirName, [&name](const MonitorElementPtr &elt) { return (elt->name() == name); }));
+      MonitorElementPtr element = nullptr;
+      m_storage.findObject(dirName, name, element);
+      monitorElement = std::dynamic_pointer_cast<T>(element);
 
       if (nullptr == monitorElement)
         return STATUS_CODE_NOT_FOUND;
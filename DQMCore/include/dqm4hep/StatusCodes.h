@@ -120,7 +120,8 @@
   d(STATUS_CODE_NOT_ALLOWED, "STATUS_CODE_NOT_ALLOWED") \
   d(STATUS_CODE_INVALID_PARAMETER, "STATUS_CODE_INVALID_PARAMETER") \
   d(STATUS_CODE_UNCHANGED, "STATUS_CODE_UNCHANGED") \
-  d(STATUS_CODE_INVALID_PTR, "STATUS_CODE_INVALID_PTR")
+  d(STATUS_CODE_INVALID_PTR, "STATUS_CODE_INVALID_PTR") \
+  d(STATUS_CODE_TIMEOUT, "STATUS_CODE_TIMEOUT")
 
 // macros for enumerators
 #define GET_ENUM_ENTRY(a, b) a,
@@ -69,6 +69,7 @@ namespace dqm4hep {
       ObjectPtr findObject(F function) const;
       template <typename F>
       ObjectPtr findObject(const std::string &dirName, F function) const;
+      StatusCode findObject(const std::string &dirName, const std::string &objectName, ObjectPtr &object) const;
       bool containsObject(const ObjectPtr &object) const;
       bool containsObject(const std::string &dirName, const ObjectPtr &object) const;
       template <typename F>
@@ -160,31 +161,11 @@ namespace dqm4hep {
         return STATUS_CODE_SUCCESS;
       }
 
-      Path path(dirName);
-
-      if (!path.isValid())
-        return STATUS_CODE_INVALID_PARAMETER;
-
-      DirectoryPtr directory = !path.isRelative() ? m_rootDirectory : m_currentDirectory;
-      StringVector directoryList = path.getSplitPath();
-
-      for (auto iter = directoryList.begin(), endIter = directoryList.end(); endIter != iter; ++iter) {
-        std::string dname = *iter;
-
-        if (dname == ".")
-          continue;
-
-        if (dname == "..") {
-          if (directory == m_rootDirectory)
-            return STATUS_CODE_FAILURE;
-
-          directory = directory->parent();
-          continue;
-        }
+      DirectoryPtr directory = nullptr;
+      StatusCode statusCode = this->find(dirName, directory);
 
-        // navigate forward
-        RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, directory->find(dname, directory));
-      }
+      if (statusCode != STATUS_CODE_SUCCESS)
+        return statusCode;
 
       if (nullptr == directory)
         return STATUS_CODE_FAILURE;
@@ -260,16 +241,30 @@ namespace dqm4hep {
         return STATUS_CODE_SUCCESS;
       }
 
-      Path path(dirName);
-
-      if (!path.isValid())
+      if (dqm4hep::core::containsSpecialCharacters(dirName))
         return STATUS_CODE_INVALID_PARAMETER;
 
-      directory = !path.isRelative() ? m_rootDirectory : m_currentDirectory;
-      StringVector directoryList = path.getSplitPath();
+      directory = (dirName.at(0) == '/') ? m_rootDirectory : m_currentDirectory;
 
-      for (auto iter = directoryList.begin(), endIter = directoryList.end(); endIter != iter; ++iter) {
-        std::string dname = *iter;
+      // walk the path without splitting it. 
+      // The directory name buffer is reused between calls
+      static thread_local std::string dname;
+      std::size_t begin = 0;
+
+      while (begin < dirName.size()) {
+        std::size_t end = dirName.find('/', begin);
+
+        if (std::string::npos == end)
+          end = dirName.size();
+
+        // empty name, i.e "//"
+        if (end == begin) {
+          begin = end + 1;
+          continue;
+        }
+
+        dname.assign(dirName, begin, end - begin);
+        begin = end + 1;
 
         if (dname == ".")
           continue;
@@ -385,6 +380,44 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    template <typename T>
+    inline StatusCode Storage<T>::findObject(const std::string &dirName, const std::string &objectName, ObjectPtr &object) const {
+      object = nullptr;
+
+      // fast path: normalized directory name, look up the 
+      // object by full name in the root directory index
+      if (std::string::npos == dirName.find('.') && std::string::npos == dirName.find("//") &&
+          std::string::npos == objectName.find('/') && !dqm4hep::core::containsSpecialCharacters(dirName)) {
+        // the full name buffer is reused between calls
+        static thread_local std::string fullName;
+
+        if (!dirName.empty() && dirName.at(0) == '/') {
+          fullName = m_rootDirectory->pathPrefix();
+          fullName.append(dirName, 1, std::string::npos);
+        } 
+        else {
+          fullName = m_currentDirectory->pathPrefix();
+          fullName.append(dirName);
+        }
+
+        if (fullName.back() != '/')
+          fullName.push_back('/');
+
+        fullName.append(objectName);
+        return m_rootDirectory->findObjectByPath(fullName, object);
+      }
+
+      DirectoryPtr directory = nullptr;
+      StatusCode statusCode = this->find(dirName, directory);
+
+      if (statusCode != STATUS_CODE_SUCCESS)
+        return statusCode;
+
+      return directory->findObject(objectName, object);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     template <typename T>
     inline bool Storage<T>::containsObject(const ObjectPtr &object) const {
       return m_currentDirectory->containsObject(object);
@@ -84,6 +84,20 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
 
+    void BufferEvent::handleBuffer(const char *b, std::size_t len, BufferHolder holder) {
+      if(nullptr == b) {
+        return;
+      }
+      clear();
+      m_buffer.m_size = len;
+      // never written nor deleted, see m_isOwner
+      m_buffer.m_buffer = const_cast<char*>(b);
+      m_buffer.m_isOwner = false;
+      m_buffer.m_holder = std::move(holder);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
     const char* BufferEvent::buffer() const {
       return m_buffer.m_buffer;
     }
@@ -102,6 +116,7 @@ namespace dqm4hep {
       }
       m_buffer.m_buffer = nullptr;
       m_buffer.m_size = 0;
+      m_buffer.m_holder = nullptr;
     }
 
   }
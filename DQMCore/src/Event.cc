@@ -27,10 +27,14 @@
 
 // -- dqm4hep headers
 #include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
 
 // -- root headers
 #include <TBuffer.h>
 
+// -- std headers
+#include <algorithm>
+
 namespace dqm4hep {
 
   namespace core {
@@ -48,6 +52,7 @@ namespace dqm4hep {
     
     void Event::setStreamerName(const std::string &name) {
       m_streamerName = name;
+      m_streamerId = EventStreamer::streamerId(name);
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -58,6 +63,12 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    uint16_t Event::getStreamerId() const {
+      return m_streamerId;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void Event::writeBase(TBuffer &buffer) const {
       Int_t type(static_cast<Int_t>(m_type));
       Long64_t timeStamp = std::chrono::system_clock::to_time_t(m_timeStamp);
@@ -89,5 +100,38 @@ namespace dqm4hep {
       m_eventNumber = eventNumber;
       m_runNumber = runNumber;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Event::writeHeader(TBuffer &buffer) const {
+      const Long64_t timeStamp = std::chrono::duration_cast<std::chrono::microseconds>(m_timeStamp.time_since_epoch()).count();
+      const UShort_t sourceSize = static_cast<UShort_t>(std::min(m_source.size(), static_cast<size_t>(std::numeric_limits<UShort_t>::max())));
+      buffer.WriteUInt(m_eventNumber);
+      buffer.WriteUInt(m_runNumber);
+      buffer.WriteLong64(timeStamp);
+      buffer.WriteUShort(sourceSize);
+      buffer.WriteFastArray(m_source.data(), sourceSize);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Event::readHeader(TBuffer &buffer) {
+      UInt_t eventNumber(0);
+      UInt_t runNumber(0);
+      Long64_t timeStamp(0);
+      UShort_t sourceSize(0);
+      buffer.ReadUInt(eventNumber);
+      buffer.ReadUInt(runNumber);
+      buffer.ReadLong64(timeStamp);
+      buffer.ReadUShort(sourceSize);
+      sourceSize = std::min(static_cast<Int_t>(sourceSize), buffer.BufferSize() - buffer.Length());
+      m_source.resize(sourceSize);
+      if (sourceSize > 0) {
+        buffer.ReadFastArray(&m_source[0], sourceSize);
+      }
+      setTimeStamp(TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::microseconds(timeStamp))));
+      m_eventNumber = eventNumber;
+      m_runNumber = runNumber;
+    }
   }
 }
@@ -32,11 +32,63 @@
 
 // -- root headers
 #include <TBuffer.h>
+#include <TBufferFile.h>
 
 namespace dqm4hep {
 
   namespace core {
     
+    const uint32_t EventStreamer::magic = 0xD04A5C06;
+    const uint8_t EventStreamer::version = 1;
+    const uint32_t EventStreamer::batchMagic = 0xD04A5C07;
+    const size_t EventStreamer::batchHeaderSize;
+    const size_t EventStreamer::minEventSize;
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    uint16_t EventStreamer::streamerId(const std::string &name) {
+      // FNV-1a, folded to 16 bits
+      uint32_t hash(2166136261u);
+      for (auto c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+      }
+      const uint16_t id = static_cast<uint16_t>((hash >> 16) ^ (hash & 0xFFFF));
+      return (0 == id) ? 1 : id;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventStreamer::writeBatchHeader(TBuffer &buffer, uint32_t nEvents) {
+      buffer.WriteUInt(batchMagic);
+      buffer.WriteUInt(nEvents);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    uint32_t EventStreamer::nEvents(const char *buffer, size_t size) {
+      if (nullptr == buffer || size < batchHeaderSize) {
+        return 1;
+      }
+      // read with a TBuffer for the byte order
+      TBufferFile batchBuffer(TBuffer::kRead, batchHeaderSize, const_cast<char*>(buffer), false);
+      UInt_t headerMagic(0), nBatchedEvents(0);
+      batchBuffer.ReadUInt(headerMagic);
+      if (batchMagic != headerMagic) {
+        return 1;
+      }
+      batchBuffer.ReadUInt(nBatchedEvents);
+      return nBatchedEvents;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::map<uint16_t, std::string> EventStreamer::streamers() {
+      return EventStreamerRegistry::instance().streamers();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     StatusCode EventStreamer::writeEvent(EventPtr event, TBuffer &buffer) {
       // consistency check
       if (nullptr == event) {
@@ -46,57 +98,230 @@ namespace dqm4hep {
         return STATUS_CODE_NOT_ALLOWED;
       }
       // setup event streamer
-      std::string streamerName = event->getStreamerName();
-      if(not m_streamer or m_streamerName != streamerName) {
-        m_streamer = nullptr;
-        m_streamer = PluginManager::instance()->create<EventStreamerPlugin>(streamerName);
-        if(not m_streamer) {
-          dqm_error( "EventStreamer::writeEvent: streamer '{0}' not registered in plugin manager !", streamerName );
-          return STATUS_CODE_FAILURE;
-        }
-        m_streamerName = streamerName;
+      const auto pEntry = EventStreamerRegistry::instance().find(event->getStreamerId());
+      // unknown name or id collision
+      if(nullptr == pEntry or *pEntry->m_name != event->getStreamerName()) {
+        dqm_error( "EventStreamer::writeEvent: streamer '{0}' not registered in plugin manager !", event->getStreamerName() );
+        return STATUS_CODE_FAILURE;
       }
-      // write streamer name
-      buffer.WriteStdString(&m_streamerName);
-      // write base event data
-      event->writeBase(buffer);
+      // write envelope
+      buffer.WriteUInt(magic);
+      buffer.WriteUChar(version);
+      buffer.WriteUChar(static_cast<UChar_t>(event->getType()));
+      buffer.WriteUShort(event->getStreamerId());
+      event->writeHeader(buffer);
+      const Int_t lengthOffset = buffer.Length();
+      buffer.WriteUInt(0);
       // write user event data
-      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_streamer->write(event, buffer));
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pEntry->m_streamer->write(event, buffer));
+      // write the payload length
+      const Int_t endOffset = buffer.Length();
+      buffer.SetBufferOffset(lengthOffset);
+      buffer.WriteUInt(endOffset - lengthOffset - sizeof(UInt_t));
+      buffer.SetBufferOffset(endOffset);
+      return STATUS_CODE_SUCCESS;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    StatusCode EventStreamer::readEvent(EventPtr &event, TBuffer &buffer, const BufferHolder &holder) {
+      // consistency check
+      if (not buffer.IsReading()) {
+        return STATUS_CODE_NOT_ALLOWED;
+      }
+      const Int_t startOffset = buffer.Length();
+      // former format starts with the streamer name
+      UInt_t envelopeMagic(0);
+      if (buffer.BufferSize() - startOffset >= static_cast<Int_t>(sizeof(UInt_t))) {
+        buffer.ReadUInt(envelopeMagic);
+      }
+      if (magic != envelopeMagic) {
+        buffer.SetBufferOffset(startOffset);
+        return this->readLegacyEvent(event, buffer, holder);
+      }
+      // the envelope header is read without bound check
+      if (buffer.BufferSize() - startOffset < static_cast<Int_t>(minEventSize)) {
+        dqm_error( "EventStreamer::readEvent: truncated envelope ({0} bytes, min {1} bytes)", buffer.BufferSize() - startOffset, minEventSize );
+        return STATUS_CODE_FAILURE;
+      }
+      UChar_t envelopeVersion(0), type(0);
+      UShort_t id(0);
+      buffer.ReadUChar(envelopeVersion);
+      if (envelopeVersion > version) {
+        dqm_error( "EventStreamer::readEvent: unsupported envelope version {0} (max {1})", static_cast<int>(envelopeVersion), static_cast<int>(version) );
+        return STATUS_CODE_FAILURE;
+      }
+      buffer.ReadUChar(type);
+      buffer.ReadUShort(id);
+      const auto pEntry = EventStreamerRegistry::instance().find(id);
+      if (nullptr == pEntry) {
+        dqm_error( "EventStreamer::readEvent: no streamer with id {0} registered in plugin manager !", id );
+        return STATUS_CODE_FAILURE;
+      }
+      // read user event data
+      event = pEntry->m_streamer->createEvent();
+      event->setStreamerName(*pEntry->m_name);
+      event->setType(static_cast<EventType>(type));
+      event->readHeader(buffer);
+      // the source name may have taken the bytes of the payload length
+      if (buffer.BufferSize() - buffer.Length() < static_cast<Int_t>(sizeof(UInt_t))) {
+        dqm_error( "EventStreamer::readEvent: truncated envelope, no payload length" );
+        return STATUS_CODE_FAILURE;
+      }
+      UInt_t payloadLength(0);
+      buffer.ReadUInt(payloadLength);
+      const Int_t payloadOffset = buffer.Length();
+      if (payloadLength > static_cast<UInt_t>(buffer.BufferSize() - payloadOffset)) {
+        dqm_error( "EventStreamer::readEvent: truncated event (payload {0} bytes, buffer {1} bytes)", payloadLength, buffer.BufferSize() - payloadOffset );
+        return STATUS_CODE_FAILURE;
+      }
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pEntry->m_streamer->readInPlace(event, buffer, holder));
+      // skip what the plugin didn't read
+      buffer.SetBufferOffset(payloadOffset + payloadLength);
+      event->setEventSize(payloadLength);
       return STATUS_CODE_SUCCESS;
     }
     
     //-------------------------------------------------------------------------------------------------
     
-    StatusCode EventStreamer::readEvent(EventPtr &event, TBuffer &buffer) {
+    StatusCode EventStreamer::readEvents(EventList &events, TBuffer &buffer, const BufferHolder &holder) {
       // consistency check
       if (not buffer.IsReading()) {
         return STATUS_CODE_NOT_ALLOWED;
       }
+      const Int_t startOffset = buffer.Length();
+      UInt_t headerMagic(0), nBatchedEvents(0);
+      if (buffer.BufferSize() - startOffset >= static_cast<Int_t>(batchHeaderSize)) {
+        buffer.ReadUInt(headerMagic);
+      }
+      // single event
+      if (batchMagic != headerMagic) {
+        buffer.SetBufferOffset(startOffset);
+        EventPtr event;
+        RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->readEvent(event, buffer, holder));
+        events.push_back(event);
+        return STATUS_CODE_SUCCESS;
+      }
+      buffer.ReadUInt(nBatchedEvents);
+      // don't trust the header count for the allocation
+      const size_t maxBatchedEvents = (buffer.BufferSize() - buffer.Length()) / minEventSize;
+      events.reserve(events.size() + std::min(static_cast<size_t>(nBatchedEvents), maxBatchedEvents));
+      for (UInt_t e = 0; e < nBatchedEvents; e++) {
+        if (buffer.Length() >= buffer.BufferSize()) {
+          dqm_error( "EventStreamer::readEvents: truncated batch ({0}/{1} events)", e, nBatchedEvents );
+          return STATUS_CODE_FAILURE;
+        }
+        EventPtr event;
+        RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, this->readEvent(event, buffer, holder));
+        events.push_back(event);
+      }
+      return STATUS_CODE_SUCCESS;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    StatusCode EventStreamer::readLegacyEvent(EventPtr &event, TBuffer &buffer, const BufferHolder &holder) {
       // read streamer name
       std::string streamerName;
       buffer.ReadStdString(&streamerName);
       // setup event streamer
-      if(not m_streamer or m_streamerName != streamerName) {
-        m_streamer = nullptr;
-        m_streamer = PluginManager::instance()->create<EventStreamerPlugin>(streamerName);
-        if(not m_streamer) {
-          dqm_error( "EventStreamer::readEvent: streamer '{0}' not registered in plugin manager !", streamerName );
-          return STATUS_CODE_FAILURE;
-        }
-        m_streamerName = streamerName;
+      const auto pEntry = EventStreamerRegistry::instance().find(streamerId(streamerName));
+      if(nullptr == pEntry or *pEntry->m_name != streamerName) {
+        dqm_error( "EventStreamer::readEvent: streamer '{0}' not registered in plugin manager !", streamerName );
+        return STATUS_CODE_FAILURE;
       }
       // read user event data
-      event = m_streamer->createEvent();
-      event->setStreamerName(m_streamerName);
+      event = pEntry->m_streamer->createEvent();
+      event->setStreamerName(*pEntry->m_name);
       Int_t eventSize = buffer.Length();
       // write base event data
       event->readBase(buffer);
-      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, m_streamer->read(event, buffer));
+      RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, pEntry->m_streamer->readInPlace(event, buffer, holder));
       eventSize = buffer.Length() - eventSize;
       event->setEventSize(eventSize);
       return STATUS_CODE_SUCCESS;
     }
     
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    EventStreamerRegistry &EventStreamerRegistry::instance() {
+      // never deleted: the thread caches may be released after the static objects
+      static EventStreamerRegistry *pRegistry = new EventStreamerRegistry();
+      return *pRegistry;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    const EventStreamerRegistry::Entry *EventStreamerRegistry::find(uint16_t id) {
+      // the streamer instances of the calling thread
+      static thread_local std::unordered_map<uint16_t, Entry> threadEntries;
+      auto findIter = threadEntries.find(id);
+      if (threadEntries.end() != findIter) {
+        return &findIter->second;
+      }
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto nameIter = m_names.find(id);
+      if (m_names.end() == nameIter) {
+        // plugins loaded since the last update ?
+        this->update();
+        nameIter = m_names.find(id);
+        if (m_names.end() == nameIter) {
+          return nullptr;
+        }
+      }
+      Entry entry;
+      // the names are never removed, the address is stable
+      entry.m_name = &nameIter->second;
+      entry.m_streamer = PluginManager::instance()->create<EventStreamerPlugin>(nameIter->second);
+      if (nullptr == entry.m_streamer) {
+        return nullptr;
+      }
+      m_nCreated++;
+      return &threadEntries.insert(std::make_pair(id, entry)).first->second;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::map<uint16_t, std::string> EventStreamerRegistry::streamers() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      this->update();
+      return std::map<uint16_t, std::string>(m_names.begin(), m_names.end());
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    size_t EventStreamerRegistry::nCreatedStreamers() const {
+      return m_nCreated.load();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventStreamerRegistry::update() {
+      auto names = PluginManager::instance()->pluginNamesMatchingType<EventStreamerPlugin>();
+      if (names.size() == m_nPlugins) {
+        return;
+      }
+      m_nPlugins = names.size();
+      for (auto &name : names) {
+        const uint16_t id = EventStreamer::streamerId(name);
+        auto findIter = m_names.find(id);
+        if (m_names.end() == findIter) {
+          m_names[id] = name;
+        }
+        else if (findIter->second != name) {
+          dqm_error( "EventStreamerRegistry: streamers '{0}' and '{1}' have the same id {2}, '{1}' can't be used !", findIter->second, name, id );
+        }
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    StatusCode EventStreamerPlugin::readInPlace(EventPtr event, TBuffer &buffer, const BufferHolder &/*holder*/) {
+      return this->read(event, buffer);
+    }
+    
   }
   
 }
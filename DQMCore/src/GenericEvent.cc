@@ -27,17 +27,99 @@
 
 // -- dqm4hep headers
 #include "dqm4hep/GenericEvent.h"
+#include "dqm4hep/Logging.h"
 #include "dqm4hep/PluginManager.h"
 
+// -- std headers
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
 namespace dqm4hep {
 
   namespace core {
 
+    /**
+     *  @brief  The arena alignment of the numeric columns (bytes)
+     */
+    static const size_t columnAlignment = 8;
+
+    /**
+     *  @brief  KeyRegistry class.
+     *          The process wide key name <-> key id mapping
+     */
+    class KeyRegistry {
+    public:
+      static KeyRegistry &instance() {
+        static KeyRegistry registry;
+        return registry;
+      }
+
+      GenericEvent::KeyId key(const std::string &name) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto findIter = m_keys.find(name);
+
+        if (m_keys.end() != findIter) {
+          return findIter->second;
+        }
+
+        const GenericEvent::KeyId id(m_names.size());
+        m_names.push_back(name);
+        m_keys.insert(std::make_pair(name, id));
+        return id;
+      }
+
+      bool find(const std::string &name, GenericEvent::KeyId &id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto findIter = m_keys.find(name);
+
+        if (m_keys.end() == findIter) {
+          return false;
+        }
+
+        id = findIter->second;
+        return true;
+      }
+
+      const std::string &name(GenericEvent::KeyId id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (id >= m_names.size()) {
+          dqm_error("GenericEvent::keyName: key id {0} not registered", id);
+          throw StatusCodeException(STATUS_CODE_NOT_FOUND);
+        }
+
+        // deque: references stay valid when keys are added
+        return m_names[id];
+      }
+
+    private:
+      std::mutex                                              m_mutex = {};
+      std::unordered_map<std::string, GenericEvent::KeyId>    m_keys = {};
+      std::deque<std::string>                                 m_names = {};
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
     EventPtr GenericEvent::make_shared() {
       auto ptr = std::shared_ptr<Event>(new EventBase<GenericEvent>(new GenericEvent()));
       ptr->setStreamerName("GenericEventStreamer");
       return ptr;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    GenericEvent::KeyId GenericEvent::key(const std::string &name) {
+      return KeyRegistry::instance().key(name);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const std::string &GenericEvent::keyName(KeyId id) {
+      return KeyRegistry::instance().name(id);
+    }
     
     //-------------------------------------------------------------------------------------------------
 
@@ -53,104 +135,239 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    void GenericEvent::reset() {
+      m_columns.clear();
+      m_arenaSize = 0;
+      m_nStrings = 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    StatusCode GenericEvent::setValues(const std::string &key, const T &vals) {
+      return this->setValues(GenericEvent::key(key), vals);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     template <typename T>
-    StatusCode GenericEvent::setValues(const std::string &/*key*/, const T &/*vals*/) {
+    StatusCode GenericEvent::setValues(KeyId /*key*/, const T &/*vals*/) {
       return STATUS_CODE_FAILURE;
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <typename T>
-    StatusCode GenericEvent::getValues(const std::string &/*key*/, T &/*vals*/) const {
+    StatusCode GenericEvent::getValues(const std::string &key, T &vals) const {
+      KeyId id(0);
+
+      // unknown key: don't intern it
+      if (not KeyRegistry::instance().find(key, id)) {
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      return this->getValues(id, vals);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    StatusCode GenericEvent::getValues(KeyId /*key*/, T &/*vals*/) const {
       return STATUS_CODE_FAILURE;
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    template <>
-    StatusCode GenericEvent::setValues(const std::string &key, const IntVector &vals) {
-      m_intValues[key] = vals;
+    template <typename T>
+    static StatusCode setColumn(GenericEvent &event, GenericEvent::KeyId key, const std::vector<T> &vals) {
+      Span<T> values = event.allocateValues<T>(key, vals.size());
+
+      if (not vals.empty()) {
+        memcpy(values.data(), vals.data(), vals.size() * sizeof(T));
+      }
+
       return STATUS_CODE_SUCCESS;
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    template <>
-    StatusCode GenericEvent::setValues(const std::string &key, const FloatVector &vals) {
-      m_floatValues[key] = vals;
+    template <typename T>
+    static StatusCode getColumn(const GenericEvent &event, GenericEvent::KeyId key, std::vector<T> &vals) {
+      if (not event.hasValues<T>(key)) {
+        return STATUS_CODE_NOT_FOUND;
+      }
+
+      Span<const T> values = event.values<T>(key);
+      vals.insert(vals.begin(), values.begin(), values.end());
       return STATUS_CODE_SUCCESS;
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <>
-    StatusCode GenericEvent::setValues(const std::string &key, const DoubleVector &vals) {
-      m_doubleValues[key] = vals;
-      return STATUS_CODE_SUCCESS;
+    StatusCode GenericEvent::setValues(KeyId key, const IntVector &vals) {
+      return setColumn(*this, key, vals);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::setValues(KeyId key, const FloatVector &vals) {
+      return setColumn(*this, key, vals);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::setValues(KeyId key, const DoubleVector &vals) {
+      return setColumn(*this, key, vals);
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <>
-    StatusCode GenericEvent::setValues(const std::string &key, const StringVector &vals) {
-      m_stringValues[key] = vals;
+    StatusCode GenericEvent::setValues(KeyId key, const StringVector &vals) {
+      Span<std::string> values = this->allocateValues<std::string>(key, vals.size());
+      std::copy(vals.begin(), vals.end(), values.begin());
       return STATUS_CODE_SUCCESS;
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <>
-    StatusCode GenericEvent::getValues(const std::string &key, IntVector &vals) const {
-      auto findIter = m_intValues.find(key);
+    StatusCode GenericEvent::getValues(KeyId key, IntVector &vals) const {
+      return getColumn(*this, key, vals);
+    }
 
-      if (m_intValues.cend() != findIter) {
-        vals.insert(vals.begin(), findIter->second.cbegin(), findIter->second.cend());
-        return STATUS_CODE_SUCCESS;
-      }
+    //-------------------------------------------------------------------------------------------------
 
-      return STATUS_CODE_NOT_FOUND;
+    template <>
+    StatusCode GenericEvent::getValues(KeyId key, FloatVector &vals) const {
+      return getColumn(*this, key, vals);
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <>
-    StatusCode GenericEvent::getValues(const std::string &key, FloatVector &vals) const {
-      auto findIter = m_floatValues.find(key);
+    StatusCode GenericEvent::getValues(KeyId key, DoubleVector &vals) const {
+      return getColumn(*this, key, vals);
+    }
 
-      if (m_floatValues.cend() != findIter) {
-        vals.insert(vals.begin(), findIter->second.cbegin(), findIter->second.cend());
-        return STATUS_CODE_SUCCESS;
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    StatusCode GenericEvent::getValues(KeyId key, StringVector &vals) const {
+      return getColumn(*this, key, vals);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template StatusCode GenericEvent::setValues(const std::string &, const IntVector &);
+    template StatusCode GenericEvent::setValues(const std::string &, const FloatVector &);
+    template StatusCode GenericEvent::setValues(const std::string &, const DoubleVector &);
+    template StatusCode GenericEvent::setValues(const std::string &, const StringVector &);
+    template StatusCode GenericEvent::getValues(const std::string &, IntVector &) const;
+    template StatusCode GenericEvent::getValues(const std::string &, FloatVector &) const;
+    template StatusCode GenericEvent::getValues(const std::string &, DoubleVector &) const;
+    template StatusCode GenericEvent::getValues(const std::string &, StringVector &) const;
+
+    //-------------------------------------------------------------------------------------------------
+
+    const GenericEvent::Column *GenericEvent::findColumn(KeyId key, ColumnType type) const {
+      for (auto &column : m_columns) {
+        if (column.m_key == key && column.m_type == type) {
+          return &column;
+        }
       }
 
-      return STATUS_CODE_NOT_FOUND;
+      return nullptr;
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    template <>
-    StatusCode GenericEvent::getValues(const std::string &key, DoubleVector &vals) const {
-      auto findIter = m_doubleValues.find(key);
+    const GenericEvent::Column &GenericEvent::allocateColumn(KeyId key, ColumnType type, size_t size, size_t valueSize) {
+      auto findIter = std::find_if(m_columns.begin(), m_columns.end(), [key, type](const Column &column) {
+        return (column.m_key == key && column.m_type == type);
+      });
+
+      // same key, same size: overwrite in place
+      if (m_columns.end() != findIter && findIter->m_size == size) {
+        return *findIter;
+      }
 
-      if (m_doubleValues.cend() != findIter) {
-        vals.insert(vals.begin(), findIter->second.cbegin(), findIter->second.cend());
-        return STATUS_CODE_SUCCESS;
+      // different size: give the storage back before re-allocating at the end
+      if (m_columns.end() != findIter) {
+        this->releaseColumn(*findIter, valueSize);
       }
 
-      return STATUS_CODE_NOT_FOUND;
+      size_t offset(0);
+
+      if (STRING_COLUMN == type) {
+        offset = m_nStrings;
+        m_nStrings += size;
+
+        if (m_nStrings > m_strings.size()) {
+          m_strings.resize(m_nStrings);
+        }
+      } else {
+        offset = (m_arenaSize + columnAlignment - 1) & ~(columnAlignment - 1);
+        const size_t arenaSize(offset + size * valueSize);
+
+        if (arenaSize > m_arena.size()) {
+          m_arena.resize(std::max(arenaSize, 2 * m_arena.size()));
+        }
+
+        m_arenaSize = arenaSize;
+      }
+
+      if (m_columns.end() != findIter) {
+        findIter->m_offset = offset;
+        findIter->m_size = size;
+        return *findIter;
+      }
+
+      m_columns.push_back(Column{key, type, offset, size});
+      return m_columns.back();
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    template <>
-    StatusCode GenericEvent::getValues(const std::string &key, StringVector &vals) const {
-      auto findIter = m_stringValues.find(key);
+    void GenericEvent::releaseColumn(const Column &column, size_t valueSize) {
+      const bool isString(STRING_COLUMN == column.m_type);
+      size_t begin(column.m_offset), end(0), used(0);
+
+      if (isString) {
+        end = begin + column.m_size;
+        used = m_nStrings;
+        // move the released slots at the end, they keep their capacity
+        std::rotate(m_strings.begin() + begin, m_strings.begin() + end, m_strings.begin() + used);
+        m_nStrings -= column.m_size;
+      } else {
+        // offsets are aligned: removing up to the next aligned offset keeps the alignment
+        end = (begin + column.m_size * valueSize + columnAlignment - 1) & ~(columnAlignment - 1);
+        used = m_arenaSize;
+
+        if (end >= used) {
+          m_arenaSize = begin;
+          return;
+        }
+
+        memmove(m_arena.data() + begin, m_arena.data() + end, used - end);
+        m_arenaSize -= (end - begin);
+      }
 
-      if (m_stringValues.cend() != findIter) {
-        vals.insert(vals.begin(), findIter->second.cbegin(), findIter->second.cend());
-        return STATUS_CODE_SUCCESS;
+      // shift the columns stored after the released one
+      for (auto &other : m_columns) {
+        if ((STRING_COLUMN == other.m_type) == isString && other.m_offset > column.m_offset) {
+          other.m_offset -= (end - begin);
+        }
       }
+    }
+
+    //-------------------------------------------------------------------------------------------------
 
-      return STATUS_CODE_NOT_FOUND;
+    const char *GenericEvent::columnData(const Column &column) const {
+      return m_arena.data() + column.m_offset;
     }
 
   }
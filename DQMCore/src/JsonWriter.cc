@@ -0,0 +1,341 @@
+/// \file JsonWriter.cc
+/*
+ *
+ * JsonWriter.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/JsonWriter.h>
+
+// -- std headers
+#include <cmath>
+#include <cstring>
+
+namespace dqm4hep {
+
+  namespace core {
+    
+    const std::size_t JsonWriter::minZeroRun = 8;
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter::JsonWriter(std::string &output) :
+      m_output(output) {
+      /* nop */
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    const std::string &JsonWriter::output() const {
+      return m_output;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::beginObject() {
+      separator();
+      m_output.push_back('{');
+      m_firstInScope.push_back(true);
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::endObject() {
+      m_output.push_back('}');
+      m_firstInScope.pop_back();
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::beginArray() {
+      separator();
+      m_output.push_back('[');
+      m_firstInScope.push_back(true);
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::endArray() {
+      m_output.push_back(']');
+      m_firstInScope.pop_back();
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::key(const char *name) {
+      separator();
+      string(name, strlen(name));
+      m_output.push_back(':');
+      m_afterKey = true;
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::key(const std::string &name) {
+      separator();
+      string(name.c_str(), name.size());
+      m_output.push_back(':');
+      m_afterKey = true;
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::value(std::nullptr_t) {
+      separator();
+      m_output.append("null", 4);
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::value(bool val) {
+      separator();
+      if(val) {
+        m_output.append("true", 4);
+      }
+      else {
+        m_output.append("false", 5);
+      }
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::value(int val) {
+      separator();
+      number(val);
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::value(unsigned int val) {
+      separator();
+      number(val);
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::value(long long val) {
+      separator();
+      number(val);
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::value(unsigned long long val) {
+      separator();
+      number(val);
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::value(float val) {
+      separator();
+      number(val);
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::value(double val) {
+      separator();
+      number(val);
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::value(const char *val) {
+      separator();
+      if(nullptr == val) {
+        m_output.append("null", 4);
+      }
+      else {
+        string(val, strlen(val));
+      }
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::value(const std::string &val) {
+      separator();
+      string(val.c_str(), val.size());
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::raw(const char *json, std::size_t length) {
+      separator();
+      m_output.append(json, length);
+      return *this;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    JsonWriter &JsonWriter::raw(const std::string &json) {
+      return raw(json.c_str(), json.size());
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    void JsonWriter::separator() {
+      if(m_afterKey) {
+        m_afterKey = false;
+        return;
+      }
+      if(m_firstInScope.empty()) {
+        return;
+      }
+      if(m_firstInScope.back()) {
+        m_firstInScope.back() = false;
+        return;
+      }
+      m_output.push_back(',');
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    void JsonWriter::number(int val) {
+      number(static_cast<long long>(val));
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    void JsonWriter::number(unsigned int val) {
+      number(static_cast<unsigned long long>(val));
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    void JsonWriter::number(long long val) {
+      if(val < 0) {
+        m_output.push_back('-');
+        // avoid overflow on the most negative value
+        number(static_cast<unsigned long long>(-(val + 1)) + 1);
+        return;
+      }
+      number(static_cast<unsigned long long>(val));
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    void JsonWriter::number(unsigned long long val) {
+      char digits[24];
+      char *pEnd = digits + sizeof(digits);
+      char *pBegin = pEnd;
+      do {
+        *--pBegin = static_cast<char>('0' + (val % 10));
+        val /= 10;
+      } while(0 != val);
+      m_output.append(pBegin, pEnd - pBegin);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    void JsonWriter::number(float val) {
+      if(not std::isfinite(val)) {
+        m_output.append("null", 4);
+        return;
+      }
+      // fast path for integral values (counts)
+      if(val == std::floor(val) and std::fabs(val) < 1e7f) {
+        number(static_cast<long long>(val));
+        return;
+      }
+      char str[32];
+      int length = snprintf(str, sizeof(str), "%.7g", val);
+      if(strtof(str, nullptr) != val) {
+        length = snprintf(str, sizeof(str), "%.9g", val);
+      }
+      m_output.append(str, length);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    void JsonWriter::number(double val) {
+      if(not std::isfinite(val)) {
+        m_output.append("null", 4);
+        return;
+      }
+      // fast path for integral values (counts)
+      if(val == std::floor(val) and std::fabs(val) < 1e15) {
+        number(static_cast<long long>(val));
+        return;
+      }
+      char str[32];
+      int length = snprintf(str, sizeof(str), "%.15g", val);
+      if(strtod(str, nullptr) != val) {
+        length = snprintf(str, sizeof(str), "%.17g", val);
+      }
+      m_output.append(str, length);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+
+    void JsonWriter::string(const char *str, std::size_t length) {
+      static const char *hexDigits = "0123456789abcdef";
+      m_output.push_back('"');
+      const char *pBegin = str;
+      const char *pEnd = str + length;
+      for(const char *pChar = str ; pChar != pEnd ; ++pChar) {
+        const unsigned char c = static_cast<unsigned char>(*pChar);
+        if(c >= 0x20 and c != '"' and c != '\\') {
+          continue;
+        }
+        // flush the non escaped characters
+        m_output.append(pBegin, pChar - pBegin);
+        pBegin = pChar + 1;
+        switch(c) {
+          case '"':  m_output.append("\\\"", 2); break;
+          case '\\': m_output.append("\\\\", 2); break;
+          case '\b': m_output.append("\\b", 2); break;
+          case '\f': m_output.append("\\f", 2); break;
+          case '\n': m_output.append("\\n", 2); break;
+          case '\r': m_output.append("\\r", 2); break;
+          case '\t': m_output.append("\\t", 2); break;
+          default: {
+            const char escaped[6] = {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xF]};
+            m_output.append(escaped, 6);
+          }
+        }
+      }
+      m_output.append(pBegin, pEnd - pBegin);
+      m_output.push_back('"');
+    }
+
+  }
+
+}
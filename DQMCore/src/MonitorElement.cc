@@ -26,6 +26,7 @@
  */
 
 // -- dqm4hep headers
+#include <dqm4hep/JsonWriter.h>
 #include <dqm4hep/Logging.h>
 #include <dqm4hep/MonitorElement.h>
 #include <dqm4hep/QualityTest.h>
@@ -39,6 +40,9 @@
 #include <TBufferJSON.h>
 #include <TBufferFile.h>
 
+// -- std headers
+#include <cmath>
+
 templateClassImp(dqm4hep::core::TScalarObject) 
 ClassImp(dqm4hep::core::TDynamicGraph)
 
@@ -259,22 +263,228 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void MonitorElement::toJson(json &jobject) const {
-      
-      json jsonObject = nullptr, jsonReference = nullptr;
-      
-      if(nullptr != m_monitorObject) {
-        jsonObject = json::parse(TBufferJSON::ConvertToJSON(m_monitorObject.ptr(), 23).Data());
+      std::string output;
+      toJson(output);
+      jobject = json::parse(output);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElement::toJson(std::string &output) const {
+      JsonWriter writer(output);
+      toJson(writer);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElement::toJson(JsonWriter &writer) const {
+      writer.beginObject();
+      writeJsonMembers(writer);
+      writer.endObject();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElement::writeJsonMembers(JsonWriter &writer) const {
+      writer.key("object");
+      writeObjectJson(writer, m_monitorObject.ptr());
+      writer.key("reference");
+      writeObjectJson(writer, m_referenceObject.ptr());
+      writer.key("path").value(m_path);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElement::writeObjectJson(JsonWriter &writer, const TObject *pObject) {
+      if(nullptr == pObject) {
+        writer.value(nullptr);
+        return;
       }
-      
-      if(nullptr != m_referenceObject) {
-        jsonReference = json::parse(TBufferJSON::ConvertToJSON(m_referenceObject.ptr(), 23).Data());
+      const TH1 *pHistogram = dynamic_cast<const TH1*>(pObject);
+      if(nullptr != pHistogram and writeHistogramJson(writer, pHistogram)) {
+        return;
       }
-
-      jobject = {
-        {"object", jsonObject},
-        {"reference", jsonReference},
-        {"path", m_path}
+      const TString json = TBufferJSON::ConvertToJSON(pObject, 23);
+      writer.raw(json.Data(), json.Length());
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool MonitorElement::writeHistogramJson(JsonWriter &writer, const TH1 *pHistogram) {
+      // Only the standard histogram classes are streamed. Derived classes 
+      // (profiles, TH2Poly, user classes) have additional members.
+      // Rare cases handled by TBufferJSON: functions, bin labels, non empty buffer
+      static const std::set<std::string> supportedClasses = {
+        "TH1C", "TH1S", "TH1I", "TH1F", "TH1D",
+        "TH2C", "TH2S", "TH2I", "TH2F", "TH2D",
+        "TH3C", "TH3S", "TH3I", "TH3F", "TH3D"
       };
+      const std::string className(pHistogram->IsA()->GetName());
+      if(0 == supportedClasses.count(className)) {
+        return false;
+      }
+      if(nullptr != pHistogram->GetBuffer()) {
+        return false;
+      }
+      TList *pFunctions = pHistogram->GetListOfFunctions();
+      if(nullptr != pFunctions and 0 != pFunctions->GetSize()) {
+        return false;
+      }
+      for(const TAxis *pAxis : {pHistogram->GetXaxis(), pHistogram->GetYaxis(), pHistogram->GetZaxis()}) {
+        if(nullptr != pAxis->GetLabels()) {
+          return false;
+        }
+      }
+      const int dimension(pHistogram->GetDimension());
+      double stats[13] = {0};
+      pHistogram->GetStats(stats);
+      
+      writer.beginObject();
+      writer.key("_typename").value(className);
+      // TNamed
+      writer.key("fUniqueID").value(pHistogram->GetUniqueID());
+      // TObject internal bits are not streamed
+      writer.key("fBits").value(static_cast<unsigned int>(pHistogram->TestBits(0x00ffffff)));
+      writer.key("fName").value(pHistogram->GetName());
+      writer.key("fTitle").value(pHistogram->GetTitle());
+      // TAttLine, TAttFill, TAttMarker
+      writer.key("fLineColor").value(pHistogram->GetLineColor());
+      writer.key("fLineStyle").value(pHistogram->GetLineStyle());
+      writer.key("fLineWidth").value(pHistogram->GetLineWidth());
+      writer.key("fFillColor").value(pHistogram->GetFillColor());
+      writer.key("fFillStyle").value(pHistogram->GetFillStyle());
+      writer.key("fMarkerColor").value(pHistogram->GetMarkerColor());
+      writer.key("fMarkerStyle").value(pHistogram->GetMarkerStyle());
+      writer.key("fMarkerSize").value(pHistogram->GetMarkerSize());
+      // TH1
+      writer.key("fNcells").value(pHistogram->GetNcells());
+      writer.key("fXaxis");
+      writeAxisJson(writer, pHistogram->GetXaxis());
+      writer.key("fYaxis");
+      writeAxisJson(writer, pHistogram->GetYaxis());
+      writer.key("fZaxis");
+      writeAxisJson(writer, pHistogram->GetZaxis());
+      writer.key("fBarOffset").value(static_cast<int>(std::round(1000*pHistogram->GetBarOffset())));
+      writer.key("fBarWidth").value(static_cast<int>(std::round(1000*pHistogram->GetBarWidth())));
+      writer.key("fEntries").value(pHistogram->GetEntries());
+      writer.key("fTsumw").value(stats[0]);
+      writer.key("fTsumw2").value(stats[1]);
+      writer.key("fTsumwx").value(stats[2]);
+      writer.key("fTsumwx2").value(stats[3]);
+      writer.key("fMaximum").value(pHistogram->GetMaximumStored());
+      writer.key("fMinimum").value(pHistogram->GetMinimumStored());
+      writer.key("fNormFactor").value(pHistogram->GetNormFactor());
+      std::vector<double> contour(const_cast<TH1*>(pHistogram)->GetContour(nullptr));
+      for(unsigned int i=0 ; i<contour.size() ; i++) {
+        contour[i] = pHistogram->GetContourLevel(i);
+      }
+      writer.key("fContour").array(contour.data(), contour.size());
+      const TArrayD *pSumw2 = pHistogram->GetSumw2();
+      writer.key("fSumw2").array(pSumw2->GetArray(), pSumw2->GetSize(), "Float64");
+      writer.key("fOption").value(pHistogram->GetOption());
+      writer.key("fFunctions").beginObject();
+      writer.key("_typename").value("TList");
+      writer.key("name").value("TList");
+      writer.key("arr").beginArray().endArray();
+      writer.key("opt").beginArray().endArray();
+      writer.endObject();
+      writer.key("fBufferSize").value(pHistogram->GetBufferSize());
+      writer.key("fBuffer").beginArray().endArray();
+      writer.key("fBinStatErrOpt").value(static_cast<int>(pHistogram->GetBinErrorOption()));
+      writer.key("fStatOverflows").value(static_cast<int>(pHistogram->GetStatOverflows()));
+      // TH2, TH3
+      if(2 == dimension) {
+        // not accessible, always the default value
+        writer.key("fScalefactor").value(1.);
+        writer.key("fTsumwy").value(stats[4]);
+        writer.key("fTsumwy2").value(stats[5]);
+        writer.key("fTsumwxy").value(stats[6]);
+      }
+      else if(3 == dimension) {
+        writer.key("fTsumwy").value(stats[4]);
+        writer.key("fTsumwy2").value(stats[5]);
+        writer.key("fTsumwxy").value(stats[6]);
+        writer.key("fTsumwz").value(stats[7]);
+        writer.key("fTsumwz2").value(stats[8]);
+        writer.key("fTsumwxz").value(stats[9]);
+        writer.key("fTsumwyz").value(stats[10]);
+      }
+      // bin contents, written with the storage type
+      writer.key("fArray");
+      switch(className.back()) {
+        case 'C': {
+          const TArrayC *pArray = dynamic_cast<const TArrayC*>(pHistogram);
+          writer.array(pArray->GetArray(), pArray->GetSize(), "Int8");
+          break;
+        }
+        case 'S': {
+          const TArrayS *pArray = dynamic_cast<const TArrayS*>(pHistogram);
+          writer.array(pArray->GetArray(), pArray->GetSize(), "Int16");
+          break;
+        }
+        case 'I': {
+          const TArrayI *pArray = dynamic_cast<const TArrayI*>(pHistogram);
+          writer.array(pArray->GetArray(), pArray->GetSize(), "Int32");
+          break;
+        }
+        case 'F': {
+          const TArrayF *pArray = dynamic_cast<const TArrayF*>(pHistogram);
+          writer.array(pArray->GetArray(), pArray->GetSize(), "Float32");
+          break;
+        }
+        default: {
+          const TArrayD *pArray = dynamic_cast<const TArrayD*>(pHistogram);
+          writer.array(pArray->GetArray(), pArray->GetSize(), "Float64");
+          break;
+        }
+      }
+      writer.endObject();
+      return true;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElement::writeAxisJson(JsonWriter &writer, const TAxis *pAxis) {
+      writer.beginObject();
+      writer.key("_typename").value("TAxis");
+      // TNamed
+      writer.key("fUniqueID").value(pAxis->GetUniqueID());
+      writer.key("fBits").value(static_cast<unsigned int>(pAxis->TestBits(0x00ffffff)));
+      writer.key("fName").value(pAxis->GetName());
+      writer.key("fTitle").value(pAxis->GetTitle());
+      // TAttAxis
+      writer.key("fNdivisions").value(pAxis->GetNdivisions());
+      writer.key("fAxisColor").value(pAxis->GetAxisColor());
+      writer.key("fLabelColor").value(pAxis->GetLabelColor());
+      writer.key("fLabelFont").value(pAxis->GetLabelFont());
+      writer.key("fLabelOffset").value(pAxis->GetLabelOffset());
+      writer.key("fLabelSize").value(pAxis->GetLabelSize());
+      writer.key("fTickLength").value(pAxis->GetTickLength());
+      writer.key("fTitleOffset").value(pAxis->GetTitleOffset());
+      writer.key("fTitleSize").value(pAxis->GetTitleSize());
+      writer.key("fTitleColor").value(pAxis->GetTitleColor());
+      writer.key("fTitleFont").value(pAxis->GetTitleFont());
+      // TAxis
+      writer.key("fNbins").value(pAxis->GetNbins());
+      writer.key("fXmin").value(pAxis->GetXmin());
+      writer.key("fXmax").value(pAxis->GetXmax());
+      const TArrayD *pXbins = pAxis->GetXbins();
+      writer.key("fXbins").array(pXbins->GetArray(), pXbins->GetSize());
+      // the stored range is only meaningful if the range bit is set
+      const bool hasRange(pAxis->TestBit(TAxis::kAxisRange));
+      writer.key("fFirst").value(hasRange ? pAxis->GetFirst() : 0);
+      writer.key("fLast").value(hasRange ? pAxis->GetLast() : 0);
+      // axis with labels are not streamed, so never alphanumeric.
+      // Bits: alphanumeric (0), can extend (1), not alpha (2)
+      const unsigned int bits2 = 
+        (pAxis->CanExtend() ? BIT(1) : 0) |
+        (const_cast<TAxis*>(pAxis)->CanBeAlphanumeric() ? 0 : BIT(2));
+      writer.key("fBits2").value(bits2);
+      writer.key("fTimeDisplay").value(pAxis->GetTimeDisplay());
+      writer.key("fTimeFormat").value(pAxis->GetTimeFormat());
+      writer.key("fLabels").value(nullptr);
+      writer.key("fModLabs").value(nullptr);
+      writer.endObject();
     }
   
     //-------------------------------------------------------------------------------------------------
@@ -27,6 +27,7 @@
 
 // -- dqm4hep headers
 #include <dqm4hep/Directory.h>
+#include <dqm4hep/JsonWriter.h>
 #include <dqm4hep/MonitorElement.h>
 #include <dqm4hep/MonitorElementManager.h>
 #include <dqm4hep/PluginManager.h>
@@ -172,6 +173,18 @@ namespace dqm4hep {
         return true;
       });
     }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementManager::monitorElementsToJson(std::string &output) const {
+      JsonWriter writer(output);
+      writer.beginArray();
+      m_storage.iterate([&writer](const MonitorElementDir &, MonitorElementPtr monitorElement) {
+        monitorElement->toJson(writer);
+        return true;
+      });
+      writer.endArray();
+    }
 
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
@@ -363,9 +376,8 @@ namespace dqm4hep {
     
     StatusCode MonitorElementManager::addToStorage(const std::string &path, MonitorElementPtr monitorElement) {
       // check for existence
-      if (nullptr != m_storage.findObject(path, [&](MonitorElementPtr obj) { 
-        return obj->name() == monitorElement->name(); 
-      })) {
+      MonitorElementPtr existingElement = nullptr;
+      if (STATUS_CODE_SUCCESS == m_storage.findObject(path, monitorElement->name(), existingElement)) {
         dqm_error("Monitor element '{0}' in directory '{1}' already booked !", monitorElement->name(), path);
         return STATUS_CODE_ALREADY_PRESENT;
       }
@@ -59,6 +59,11 @@ namespace dqm4hep {
       /** De-serialize the event.
        */
       StatusCode read(EventPtr event, TBuffer &buffer) override;
+
+      /** De-serialize the event. The event references the buffer memory
+       *  if it is held, else the buffer is copied
+       */
+      StatusCode readInPlace(EventPtr event, TBuffer &buffer, const BufferHolder &holder) override;
     };
     
     //-------------------------------------------------------------------------------------------------
@@ -88,6 +93,25 @@ namespace dqm4hep {
       bufferEvent->moveBuffer(rawBuffer, size);
       return STATUS_CODE_SUCCESS;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StatusCode BufferEventStreamer::readInPlace(EventPtr event, TBuffer &buffer, const BufferHolder &holder) {
+      if (nullptr == holder) {
+        return this->read(event, buffer);
+      }
+      BufferEvent *bufferEvent = event->getEvent<BufferEvent>();
+      // same layout as WriteArray(): size + contents
+      Int_t size(0);
+      buffer.ReadInt(size);
+      const Int_t offset = buffer.Length();
+      if (size < 0 || size > buffer.BufferSize() - offset) {
+        return STATUS_CODE_OUT_OF_RANGE;
+      }
+      bufferEvent->handleBuffer(buffer.Buffer() + offset, size, holder);
+      buffer.SetBufferOffset(offset + size);
+      return STATUS_CODE_SUCCESS;
+    }
     
     //-------------------------------------------------------------------------------------------------
     
@@ -35,12 +35,29 @@
 // -- root headers
 #include <TBuffer.h>
 
+// -- std headers
+#include <unordered_map>
+
 namespace dqm4hep {
 
   namespace core {
 
+    /**
+     *  @brief  The version of the generic event payload.
+     *          The former map based payload starts with a zero byte and is not supported
+     */
+    static const UChar_t payloadVersion = 1;
+    
+    //-------------------------------------------------------------------------------------------------
+
     /**
      * @brief GenericEventStreamer class
+     *
+     * Write the payload version (UChar_t), then the event columns one after the other:
+     *  - number of columns (UInt_t)
+     *  - for each column: key name (std::string), value type (UChar_t), number of values (UInt_t),
+     *    then the values. Numeric values are written as a single raw block in the host byte order 
+     *    (little endian on all supported platforms). Strings are written one by one.
      */
     class GenericEventStreamer : public EventStreamerPlugin {
     public:
@@ -66,68 +83,45 @@ namespace dqm4hep {
       StatusCode read(EventPtr event, TBuffer &buffer) override;
       
     private:
-      template <typename T>
-      void writeMap(TBuffer &buffer, const std::map<std::string, std::vector<T>> &values);
+      /** Get the id of a key read from a buffer, cached to avoid the key registry lock
+       */
+      GenericEvent::KeyId key(const std::string &name);
       
       template <typename T>
-      void readMap(TBuffer &buffer, std::map<std::string, std::vector<T>> &values);
+      StatusCode readColumn(GenericEvent *pGenericEvent, GenericEvent::KeyId key, UInt_t size, TBuffer &buffer);
+      
+    private:
+      /// The ids of the keys already read. The streamer instances are used by a single thread
+      std::unordered_map<std::string, GenericEvent::KeyId>    m_keys = {};
     };
     
-    
-    template <typename T>
-    inline void GenericEventStreamer::writeMap(TBuffer &buffer, const std::map<std::string, std::vector<T>> &values) {
-      buffer.WriteInt(values.size());
-      for(auto elt : values) {
-        buffer.WriteStdString(&elt.first);
-        buffer.WriteArray(&elt.second[0], elt.second.size());
-      }
-    }
-    
+    //-------------------------------------------------------------------------------------------------
+
     template <typename T>
-    inline void GenericEventStreamer::readMap(TBuffer &buffer, std::map<std::string, std::vector<T>> &values) {
-      Int_t size = 0;
-      buffer.ReadInt(size);
-      for(Int_t s=0 ; s<size ; s++) {
-        std::string key;
-        buffer.ReadStdString(&key);
-        T *array = nullptr;
-        Int_t size = buffer.ReadArray(array);
-        std::vector<T> vecValues(array, array + sizeof(array) / sizeof(T));
-        delete [] array;
-        values[key] = vecValues;
+    inline StatusCode GenericEventStreamer::readColumn(GenericEvent *pGenericEvent, GenericEvent::KeyId key, UInt_t size, TBuffer &buffer) {
+      const size_t nBytes(size * sizeof(T));
+      // corrupted buffer, don't allocate
+      if (nBytes > static_cast<size_t>(buffer.BufferSize() - buffer.Length())) {
+        return STATUS_CODE_FAILURE;
       }
+      Span<T> values = pGenericEvent->allocateValues<T>(key, size);
+      buffer.ReadFastArray(reinterpret_cast<Char_t *>(values.data()), static_cast<Int_t>(nBytes));
+      return STATUS_CODE_SUCCESS;
     }
     
+    //-------------------------------------------------------------------------------------------------
+
     template <>
-    inline void GenericEventStreamer::writeMap(TBuffer &buffer, const std::map<std::string, std::vector<std::string>> &values) {
-      buffer.WriteInt(values.size());
-      for(auto elt : values) {
-        buffer.WriteStdString(&elt.first);
-        buffer.WriteInt(elt.second.size());
-        for(auto elt2 : elt.second) {
-          buffer.WriteStdString(&elt2);
-        }
+    inline StatusCode GenericEventStreamer::readColumn<std::string>(GenericEvent *pGenericEvent, GenericEvent::KeyId key, UInt_t size, TBuffer &buffer) {
+      // at least one byte per string
+      if (size > static_cast<size_t>(buffer.BufferSize() - buffer.Length())) {
+        return STATUS_CODE_FAILURE;
       }
-    }
-    
-    template <>
-    inline void GenericEventStreamer::readMap(TBuffer &buffer, std::map<std::string, std::vector<std::string>> &values) {
-      Int_t size = 0;
-      buffer.ReadInt(size);
-      for(Int_t s=0 ; s<size ; s++) {
-        std::string key;
-        buffer.ReadStdString(&key);
-        Int_t vecSize = 0;
-        buffer.ReadInt(vecSize);
-        std::vector<std::string> vecValues;
-        vecValues.reserve(vecSize);
-        for(Int_t s2=0 ; s2<vecSize ; s2++) {
-          std::string value;
-          buffer.ReadStdString(&value);
-          vecValues.push_back(value);
-        }
-        values[key] = vecValues;
+      // the string slots keep their capacity across events
+      for (auto &value : pGenericEvent->allocateValues<std::string>(key, size)) {
+        buffer.ReadStdString(&value);
       }
+      return STATUS_CODE_SUCCESS;
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -151,16 +145,47 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    GenericEvent::KeyId GenericEventStreamer::key(const std::string &name) {
+      auto findIter = m_keys.find(name);
+      if (m_keys.end() != findIter) {
+        return findIter->second;
+      }
+      const GenericEvent::KeyId id(GenericEvent::key(name));
+      m_keys.insert(std::make_pair(name, id));
+      return id;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     StatusCode GenericEventStreamer::write(EventPtr event, TBuffer &buffer) {
       const GenericEvent *pGenericEvent = event->getEvent<GenericEvent>();
       if (nullptr == pGenericEvent) {
         return STATUS_CODE_INVALID_PARAMETER;
       }
       // write event contents
-      writeMap(buffer, pGenericEvent->m_intValues);
-      writeMap(buffer, pGenericEvent->m_floatValues);
-      writeMap(buffer, pGenericEvent->m_doubleValues);
-      writeMap(buffer, pGenericEvent->m_stringValues);
+      buffer.WriteUChar(payloadVersion);
+      buffer.WriteUInt(pGenericEvent->m_columns.size());
+      for (auto &column : pGenericEvent->m_columns) {
+        buffer.WriteStdString(&GenericEvent::keyName(column.m_key));
+        buffer.WriteUChar(column.m_type);
+        buffer.WriteUInt(column.m_size);
+        switch (column.m_type) {
+          case GenericEvent::INT_COLUMN:
+            buffer.WriteFastArray(pGenericEvent->columnData(column), static_cast<Int_t>(column.m_size * sizeof(int)));
+            break;
+          case GenericEvent::FLOAT_COLUMN:
+            buffer.WriteFastArray(pGenericEvent->columnData(column), static_cast<Int_t>(column.m_size * sizeof(float)));
+            break;
+          case GenericEvent::DOUBLE_COLUMN:
+            buffer.WriteFastArray(pGenericEvent->columnData(column), static_cast<Int_t>(column.m_size * sizeof(double)));
+            break;
+          case GenericEvent::STRING_COLUMN:
+            for (auto &value : pGenericEvent->values<std::string>(column.m_key)) {
+              buffer.WriteStdString(&value);
+            }
+            break;
+        }
+      }
       return STATUS_CODE_SUCCESS;
     }
 
@@ -171,11 +196,42 @@ namespace dqm4hep {
       if (nullptr == pGenericEvent) {
         return STATUS_CODE_INVALID_PARAMETER;
       }
-      // write event contents
-      readMap(buffer, pGenericEvent->m_intValues);
-      readMap(buffer, pGenericEvent->m_floatValues);
-      readMap(buffer, pGenericEvent->m_doubleValues);
-      readMap(buffer, pGenericEvent->m_stringValues);
+      pGenericEvent->reset();
+      UChar_t version(0);
+      buffer.ReadUChar(version);
+      if (payloadVersion != version) {
+        dqm_error("GenericEventStreamer::read: unsupported payload version {0} (expected {1})", static_cast<int>(version), static_cast<int>(payloadVersion));
+        return STATUS_CODE_FAILURE;
+      }
+      // read event contents
+      UInt_t nColumns(0);
+      buffer.ReadUInt(nColumns);
+      std::string keyName;
+      for (UInt_t c = 0; c < nColumns; c++) {
+        UChar_t type(0);
+        UInt_t size(0);
+        buffer.ReadStdString(&keyName);
+        buffer.ReadUChar(type);
+        buffer.ReadUInt(size);
+        const GenericEvent::KeyId key(this->key(keyName));
+        switch (type) {
+          case GenericEvent::INT_COLUMN:
+            RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, readColumn<int>(pGenericEvent, key, size, buffer));
+            break;
+          case GenericEvent::FLOAT_COLUMN:
+            RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, readColumn<float>(pGenericEvent, key, size, buffer));
+            break;
+          case GenericEvent::DOUBLE_COLUMN:
+            RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, readColumn<double>(pGenericEvent, key, size, buffer));
+            break;
+          case GenericEvent::STRING_COLUMN:
+            RETURN_RESULT_IF(STATUS_CODE_SUCCESS, !=, readColumn<std::string>(pGenericEvent, key, size, buffer));
+            break;
+          default:
+            dqm_error("GenericEventStreamer::read: invalid column type {0}", static_cast<int>(type));
+            return STATUS_CODE_FAILURE;
+        }
+      }
       return STATUS_CODE_SUCCESS;
     }
     
@@ -29,7 +29,10 @@
 #define CLIENT_H
 
 // -- dqm4hep headers
+#include "dqm4hep/Codec.h"
+#include "dqm4hep/CommandBatcher.h"
 #include "dqm4hep/NetBuffer.h"
+#include "dqm4hep/RequestChannel.h"
 #include "dqm4hep/RequestHandler.h"
 #include "dqm4hep/Service.h"
 #include "dqm4hep/ServiceHandler.h"
@@ -40,6 +43,11 @@
 
 // -- std headers
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
 
 namespace dqm4hep {
 
@@ -52,9 +60,16 @@ namespace dqm4hep {
      *          the sendRequest() function. User can also subscribe to
      *          a particular service run on a server by using the
      *          subscribe() method and by providing a callback function.
+     *          Requests can also be sent asynchronously using sendRequestAsync().
+     *          Asynchronous requests are sent on a persistent connection per
+     *          request name and several requests can be in flight at the same time.
+     *          Non-blocking commands can be batched per target (see setCommandBatching()).
      */
     class Client {
     public:
+      typedef RequestChannel::ResponseFunction ResponseFunction;
+      typedef std::function<void(core::StatusCode, const core::json &)> ServerInfoFunction;
+
       /**
        *  @brief  Constructor
        */
@@ -73,6 +88,16 @@ namespace dqm4hep {
        */
       void queryServerInfo(const std::string &serverName, core::json &serverInfo) const;
 
+      /**
+       *  @brief  Query server information asynchronously.
+       *          The function is called from the network thread
+       *
+       *  @param  serverName the server name
+       *  @param  function the function receiving the status and the server information
+       *  @param  timeout the timeout in milliseconds (0 means no timeout)
+       */
+      uint32_t queryServerInfoAsync(const std::string &serverName, ServerInfoFunction function, unsigned int timeout = 0);
+
       /**
        *  @brief  Send a command. Do not wait for any response
        *
@@ -92,6 +117,43 @@ namespace dqm4hep {
       template <typename Operation>
       void sendRequest(const std::string &name, const Buffer &request, Operation operation) const;
 
+      /**
+       *  @brief  Send a request. Do not wait for the server response.
+       *          The function is called from the network thread with the status 
+       *          (see RequestChannel::ResponseFunction) and the response, valid 
+       *          only during the call. Returns the request id, to use for cancellation
+       *
+       *  @param  name the request name
+       *  @param  request the request to send
+       *  @param  function the function receiving the response
+       *  @param  timeout the timeout in milliseconds (0 means no timeout)
+       */
+      uint32_t sendRequestAsync(const std::string &name, const Buffer &request, ResponseFunction function, unsigned int timeout = 0);
+
+      /**
+       *  @brief  Send a request. Do not wait for the server response.
+       *          The future holds a copy of the response, or a core::StatusCodeException
+       *          on timeout (STATUS_CODE_TIMEOUT) or connection loss (STATUS_CODE_FAILURE)
+       *
+       *  @param  name the request name
+       *  @param  request the request to send
+       *  @param  timeout the timeout in milliseconds (0 means no timeout)
+       */
+      std::future<Buffer> sendRequestAsync(const std::string &name, const Buffer &request, unsigned int timeout = 0);
+
+      /**
+       *  @brief  Cancel an asynchronous request. The response function is not called.
+       *          Returns false if the request is not pending
+       *
+       *  @param  requestId the request id returned by sendRequestAsync()
+       */
+      bool cancelRequest(uint32_t requestId);
+
+      /**
+       *  @brief  Get the number of asynchronous requests waiting for a response
+       */
+      unsigned int numberOfPendingRequests() const;
+
       /**
        *  @brief  Send a command.
        *
@@ -102,6 +164,47 @@ namespace dqm4hep {
       template <typename Command>
       void sendCommand(const std::string &name, const Command &command, bool blocking = false) const;
 
+      /**
+       *  @brief  Enable the batching of non-blocking commands (see CommandBatcher).
+       *          Commands sent to the same target are packed in a single dim command,
+       *          sent when the batch reaches the maximum size or the maximum delay.
+       *          The command handlers receive the commands one by one, as without batching.
+       *          Blocking commands are not batched and send the pending batch of their target first.
+       *          Must be called before sending commands
+       *
+       *  @param  maxSize the maximum batch size in bytes
+       *  @param  maxDelay the maximum delay before sending a batch, in milliseconds
+       */
+      void setCommandBatching(size_t maxSize = 64*1024, unsigned int maxDelay = 2);
+
+      /**
+       *  @brief  Whether the batching of commands is enabled
+       */
+      bool commandBatching() const;
+
+      /**
+       *  @brief  Send the pending batches of commands, if batching is enabled
+       */
+      void flushCommands() const;
+
+      /**
+       *  @brief  Set the codec used to compress the commands (see Codec).
+       *          With batching enabled, the whole batch is compressed.
+       *          Only commands (or batches) larger than minSize are compressed.
+       *          If the codec is not available in this build, zlib is used instead.
+       *          Must be called before sending commands
+       *
+       *  @param  type the codec type
+       *  @param  level the compression level, 0 for the codec default
+       *  @param  minSize the minimum command size to compress
+       */
+      void setCommandCodec(Codec::Type type, int level = 0, size_t minSize = 512);
+
+      /**
+       *  @brief  Get the codec used to compress the commands
+       */
+      Codec::Type commandCodec() const;
+
       /**
        *  @brief  Subscribe to service
        *
@@ -151,10 +254,54 @@ namespace dqm4hep {
        */
       void notifyServerOnExit(const std::string &serverName);
 
+    private:
+      /**
+       *  @brief  Send a command buffer, batched if enabled and non-blocking
+       *
+       *  @param  name the command name
+       *  @param  data the command contents
+       *  @param  size the command size
+       *  @param  blocking whether to wait for command reception on server side
+       */
+      void sendCommandBuffer(const std::string &name, const char *data, size_t size, bool blocking) const;
+
+      /**
+       *  @brief  Get the request channel of a request name. Created on first use
+       *
+       *  @param  name the request name
+       */
+      RequestChannel *requestChannel(const std::string &name);
+
+      /**
+       *  @brief  Register a request deadline in the timeout thread (started on first use)
+       *
+       *  @param  timeout the request timeout in milliseconds
+       */
+      void scheduleTimeout(unsigned int timeout);
+
+      /**
+       *  @brief  The timeout thread function. Notify the requests that timed out
+       */
+      void timeoutThread();
+
     private:
       typedef std::map<std::string, ServiceHandler *> ServiceHandlerMap;
       typedef std::vector<ServiceHandler *> ServiceHandlerList;
-      ServiceHandlerMap m_serviceHandlerMap = {}; ///< The service map
+      typedef std::map<std::string, RequestChannel *> RequestChannelMap;
+
+      ServiceHandlerMap                m_serviceHandlerMap = {};   ///< The service map
+      RequestChannelMap                m_requestChannels = {};     ///< The asynchronous request channels
+      std::unique_ptr<CommandBatcher>  m_commandBatcher = {nullptr}; ///< The command batcher (batching enabled only)
+      Codec::Type                      m_commandCodec = {Codec::NONE}; ///< The codec used to compress the commands
+      int                              m_commandCodecLevel = {0};  ///< The command compression level
+      size_t                           m_commandCodecMinSize = {512}; ///< The minimum command size to compress
+      mutable std::mutex               m_channelMutex = {};        ///< The request channels mutex
+      std::atomic<uint32_t>            m_lastRequestId = {0};      ///< The last asynchronous request id
+      std::thread                      m_timeoutThread = {};       ///< The request timeout thread
+      std::mutex                       m_timeoutMutex = {};        ///< The timeout thread mutex
+      std::condition_variable          m_timeoutCondition = {};    ///< The timeout thread condition
+      RequestChannel::TimePoint        m_nextDeadline = {RequestChannel::TimePoint::max()}; ///< The next request deadline
+      bool                             m_stopTimeoutThread = {false}; ///< Whether to stop the timeout thread
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -210,23 +357,14 @@ namespace dqm4hep {
       auto model = contents.createModel<Command>();
       model->copy(command);
       contents.setModel(model);
-
-      if (blocking) {
-        DimClient::sendCommand(const_cast<char *>(name.c_str()), (void *)contents.begin(), contents.size());
-      } else {
-        DimClient::sendCommandNB(const_cast<char *>(name.c_str()), (void *)contents.begin(), contents.size());
-      }
+      this->sendCommandBuffer(name, contents.begin(), contents.size(), blocking);
     }
 
     //-------------------------------------------------------------------------------------------------
 
     template <>
     inline void Client::sendCommand(const std::string &name, const Buffer &buffer, bool blocking) const {
-      if (blocking) {
-        DimClient::sendCommand(const_cast<char *>(name.c_str()), (void *)buffer.begin(), buffer.size());
-      } else {
-        DimClient::sendCommandNB(const_cast<char *>(name.c_str()), (void *)buffer.begin(), buffer.size());
-      }
+      this->sendCommandBuffer(name, buffer.begin(), buffer.size(), blocking);
     }
 
     //-------------------------------------------------------------------------------------------------
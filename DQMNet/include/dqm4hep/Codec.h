@@ -0,0 +1,134 @@
+/// \file Codec.h
+/*
+ *
+ * Codec.h header template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+
+#ifndef CODEC_H
+#define CODEC_H
+
+// -- dqm4hep headers
+#include "dqm4hep/NetBuffer.h"
+
+// -- std headers
+#include <cstdint>
+#include <string>
+
+namespace dqm4hep {
+
+  namespace net {
+
+    /**
+     *  @brief  Codec class.
+     *          Compression of the network payloads (service updates and commands).
+     *          An encoded payload starts with a header: magic number (4 bytes),
+     *          codec id (1 byte), 3 reserved bytes and the uncompressed size (4 bytes).
+     *          Little endian. Receivers detect the encoded payloads using the magic
+     *          number and decode them transparently, so the codec is chosen by the
+     *          sender only (see Service::setCodec() and Client::setCommandCodec()).
+     *          The zlib codec is always available, lz4 and zstd only if found at build time
+     */
+    class Codec {
+    public:
+      /**
+       *  @brief  Type enum. The value is the codec id written in the header
+       */
+      enum Type {
+        NONE = 0,
+        ZLIB = 1,
+        LZ4 = 2,
+        ZSTD = 3
+      };
+
+      static const uint32_t magic;             ///< The encoded payload magic number
+      static const size_t   headerSize = 12;   ///< The encoded payload header size
+      static const size_t   maxDecodedSize;    ///< The maximum uncompressed payload size
+
+      /**
+       *  @brief  Whether the codec is available in this build
+       *
+       *  @param  type the codec type
+       */
+      static bool isAvailable(Type type);
+
+      /**
+       *  @brief  Convert a codec name (none, zlib, lz4, zstd) to codec type.
+       *          Throws STATUS_CODE_INVALID_PARAMETER if the name is unknown
+       *
+       *  @param  name the codec name
+       */
+      static Type fromString(const std::string &name);
+
+      /**
+       *  @brief  Convert a codec type to string
+       *
+       *  @param  type the codec type
+       */
+      static std::string toString(Type type);
+
+      /**
+       *  @brief  Whether the buffer is an encoded payload
+       *
+       *  @param  buffer the buffer to check
+       *  @param  size the buffer size
+       */
+      static bool isEncoded(const char *buffer, size_t size);
+
+      /**
+       *  @brief  Encode a buffer (header + compressed data) into the output string.
+       *          The output capacity is reused. Returns false if the buffer has not
+       *          been encoded and must be sent as is: codec NONE or not available,
+       *          buffer smaller than minSize or larger than maxDecodedSize or 
+       *          compression not reducing the size
+       *
+       *  @param  type the codec type
+       *  @param  level the compression level, 0 for the codec default
+       *  @param  minSize the minimum buffer size to compress
+       *  @param  buffer the buffer to encode
+       *  @param  size the buffer size
+       *  @param  output the encoded buffer
+       */
+      static bool encode(Type type, int level, size_t minSize, const char *buffer, size_t size, std::string &output);
+
+      /**
+       *  @brief  Decode an encoded payload. The decompressed data is written in a
+       *          model acquired from a buffer pool shared by all decoders and released
+       *          to the pool once the output buffer is destroyed. The uncompressed size
+       *          read from the header is checked before allocating: it must not exceed
+       *          maxDecodedSize nor the maximum compression ratio of the codec.
+       *          Returns false if the payload is malformed or the codec is not available
+       *
+       *  @param  buffer the encoded payload
+       *  @param  size the encoded payload size
+       *  @param  output the decoded buffer
+       */
+      static bool decode(const char *buffer, size_t size, Buffer &output);
+    };
+
+  }
+
+}
+
+#endif //  CODEC_H
@@ -0,0 +1,208 @@
+/// \file CommandBatcher.h
+/*
+ *
+ * CommandBatcher.h header template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+#ifndef COMMANDBATCHER_H
+#define COMMANDBATCHER_H
+
+// -- dqm4hep headers
+#include "dqm4hep/Codec.h"
+#include "dqm4hep/Internal.h"
+
+// -- std headers
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace dqm4hep {
+
+  namespace net {
+
+    /**
+     *  @brief  CommandBatch struct.
+     *          Defines the format of a batch of commands sent in a single dim command:
+     *          magic number (4 bytes) + number of commands (4 bytes), then for each
+     *          command its size (4 bytes) followed by the command contents. Little endian.
+     *          Batches are unpacked by the command handler, so that handlers receive
+     *          one buffer per command
+     */
+    struct CommandBatch {
+      typedef std::function<void(const char *, size_t)> CommandFunction;
+
+      static const uint32_t magic;           ///< The batch magic number
+      static const size_t   headerSize = 8;  ///< The batch header size
+
+      /**
+       *  @brief  Whether the buffer is a batch of commands
+       *
+       *  @param  buffer the buffer to check
+       *  @param  size the buffer size
+       */
+      static bool isBatch(const char *buffer, size_t size);
+
+      /**
+       *  @brief  Unpack a batch of commands. Returns false if the batch is malformed.
+       *          The commands preceding the malformed one are processed
+       *
+       *  @param  buffer the batch buffer
+       *  @param  size the batch size
+       *  @param  function the function called for each command
+       */
+      static bool unpack(const char *buffer, size_t size, CommandFunction function);
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  CommandBatcher class.
+     *          Packs the non-blocking commands sent to the same target in a single
+     *          buffer (see CommandBatch). A batch is sent when it reaches the maximum
+     *          size or when its oldest command waited for the maximum delay.
+     *          Commands to the same target are sent in order. Thread safe.
+     *          Enabled in the client using Client::setCommandBatching()
+     */
+    class CommandBatcher {
+    public:
+      /**
+       *  @brief  The function sending a buffer to a command name
+       */
+      typedef std::function<void(const std::string &, const char *, size_t)> SendFunction;
+
+      CommandBatcher(const CommandBatcher&) = delete;
+      CommandBatcher& operator=(const CommandBatcher&) = delete;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  maxSize the maximum batch size in bytes
+       *  @param  maxDelay the maximum delay before sending a batch, in milliseconds
+       *  @param  function the function sending the buffers (default: non-blocking dim command)
+       */
+      CommandBatcher(size_t maxSize, unsigned int maxDelay, SendFunction function = nullptr);
+
+      /**
+       *  @brief  Destructor. Send all the pending batches
+       */
+      ~CommandBatcher();
+
+      /**
+       *  @brief  Add a command to the batch of the target command name.
+       *          Commands larger than the maximum batch size are sent directly
+       *
+       *  @param  name the command name
+       *  @param  data the command contents
+       *  @param  size the command size
+       */
+      void send(const std::string &name, const char *data, size_t size);
+
+      /**
+       *  @brief  Send the pending batch of a command name, if any
+       *
+       *  @param  name the command name
+       */
+      void flush(const std::string &name);
+
+      /**
+       *  @brief  Send all the pending batches
+       */
+      void flush();
+
+      /**
+       *  @brief  Get the maximum batch size in bytes
+       */
+      size_t maxSize() const;
+
+      /**
+       *  @brief  Get the maximum delay before sending a batch, in milliseconds
+       */
+      unsigned int maxDelay() const;
+
+      /**
+       *  @brief  Set the codec used to compress the batches and the commands sent directly
+       *
+       *  @param  type the codec type
+       *  @param  level the compression level, 0 for the codec default
+       *  @param  minSize the minimum size to compress
+       */
+      void setCodec(Codec::Type type, int level, size_t minSize);
+
+    private:
+      typedef std::chrono::steady_clock::time_point TimePoint;
+
+      /**
+       *  @brief  Batch struct
+       */
+      struct Batch {
+        std::string           m_buffer = {""};         ///< The batch buffer
+        uint32_t              m_nCommands = {0};       ///< The number of commands in the batch
+        TimePoint             m_deadline = {};         ///< The batch sending deadline
+      };
+      typedef std::map<std::string, Batch> BatchMap;
+
+      /**
+       *  @brief  Send a batch and reset it. Must be called with the lock held
+       *
+       *  @param  name the command name
+       *  @param  batch the batch to send
+       */
+      void sendBatch(const std::string &name, Batch &batch);
+
+      /**
+       *  @brief  Send a buffer, compressed if a codec is set. Must be called with the lock held
+       *
+       *  @param  name the command name
+       *  @param  data the buffer to send
+       *  @param  size the buffer size
+       */
+      void sendBuffer(const std::string &name, const char *data, size_t size);
+
+      /**
+       *  @brief  The flush thread function. Send the batches that reached their deadline
+       */
+      void flushThread();
+
+    private:
+      const size_t               m_maxSize;                      ///< The maximum batch size
+      const unsigned int         m_maxDelay;                     ///< The maximum delay before sending a batch (ms)
+      SendFunction               m_sendFunction = {};            ///< The function sending the buffers
+      BatchMap                   m_batches = {};                 ///< The batches per command name
+      std::mutex                 m_mutex = {};                   ///< The batches mutex
+      std::condition_variable    m_condition = {};               ///< The flush thread condition
+      bool                       m_stopFlag = {false};           ///< Whether to stop the flush thread
+      std::thread                m_flushThread = {};             ///< The flush thread
+      Codec::Type                m_codec = {Codec::NONE};        ///< The codec used to compress the batches
+      int                        m_codecLevel = {0};             ///< The compression level
+      size_t                     m_codecMinSize = {512};         ///< The minimum size to compress
+      std::string                m_encodeBuffer = {""};          ///< The compressed buffer, reused between batches
+    };
+
+  }
+
+}
+
+#endif //  COMMANDBATCHER_H
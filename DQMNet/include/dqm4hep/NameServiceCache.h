@@ -0,0 +1,221 @@
+/// \file NameServiceCache.h
+/*
+ *
+ * NameServiceCache.h header template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+#ifndef NAMESERVICECACHE_H
+#define NAMESERVICECACHE_H
+
+// -- dim headers
+#include "dic.hxx"
+
+// -- std headers
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace dqm4hep {
+
+  namespace net {
+
+    /**
+     *  @brief  NameServiceCache class.
+     *          A process-wide, in-memory copy of the dim name service.
+     *          Subscribes once to the dns server list and to the service list of
+     *          each running server, and updates the running servers and services
+     *          from the incremental updates sent by dim. Queries are answered
+     *          without network traffic. Service names are matched exactly (no wildcard).
+     *          Created on first use. The first calls to instance() wait for the initial 
+     *          server and service lists, unless called from a dim callback. The wait
+     *          happens outside of the instance creation, so that dim callbacks calling 
+     *          instance() in the meantime are not blocked.
+     *          Used by the Server static queries (Server::isServerRunning(), etc...)
+     */
+    class NameServiceCache {
+    public:
+      NameServiceCache(const NameServiceCache&) = delete;
+      NameServiceCache& operator=(const NameServiceCache&) = delete;
+
+      /**
+       *  @brief  Constructor. Without subscription, the cache is only updated by calling
+       *          handleServerList() and handleServiceList() (no dim traffic, for testing).
+       *          Use instance() to get the process-wide cache
+       *
+       *  @param  subscribe whether to subscribe to the dns server list and the service lists
+       */
+      explicit NameServiceCache(bool subscribe);
+
+      /**
+       *  @brief  Get the unique cache instance. Thread safe
+       */
+      static NameServiceCache &instance();
+
+      /**
+       *  @brief  Get the list of running servers
+       */
+      std::vector<std::string> servers() const;
+
+      /**
+       *  @brief  Whether the server is running
+       *
+       *  @param  name the 'short' server name
+       */
+      bool hasServer(const std::string &name) const;
+
+      /**
+       *  @brief  Whether the service is running
+       *
+       *  @param  name the service name
+       */
+      bool hasService(const std::string &name) const;
+
+      /**
+       *  @brief  Whether the request handler is running
+       *
+       *  @param  name the request handler name
+       */
+      bool hasRequestHandler(const std::string &name) const;
+
+      /**
+       *  @brief  Whether the command handler is running
+       *
+       *  @param  name the command handler name
+       */
+      bool hasCommandHandler(const std::string &name) const;
+
+      /**
+       *  @brief  Handle a server list update. Either the full list "server@node|..."
+       *          or a single server prefixed with '+' (new), '-' (exited) or '!' (in error)
+       *
+       *  @param  data the server list (null if the dns is not reachable)
+       */
+      void handleServerList(const char *data);
+
+      /**
+       *  @brief  Handle a service list update of a server. Either the full list
+       *          or services prefixed with '-' (removed) or '+' (added, prefixes the first one only).
+       *          A service reads "name|format|type" where type is empty, "CMD" or "RPC"
+       *
+       *  @param  server the server name
+       *  @param  data the service list (null if the server is not reachable)
+       */
+      void handleServiceList(const std::string &server, const char *data);
+
+    private:
+      /**
+       *  @brief  ServiceType enumerator
+       */
+      enum ServiceType { SERVICE, REQUEST_HANDLER, COMMAND_HANDLER };
+
+      /** ServerListInfo class.
+       *
+       *  The dns server list subscription
+       */
+      class ServerListInfo : public DimInfo {
+      public:
+        ServerListInfo(NameServiceCache *pCache);
+        void infoHandler() override;
+
+      private:
+        NameServiceCache *m_pCache = {nullptr};
+      };
+
+      /** ServiceListInfo class.
+       *
+       *  The service list subscription of a server
+       */
+      class ServiceListInfo : public DimInfo {
+      public:
+        ServiceListInfo(NameServiceCache *pCache, const std::string &server);
+        void infoHandler() override;
+
+      private:
+        NameServiceCache *m_pCache = {nullptr};
+        std::string       m_server = {""};
+      };
+
+      /**
+       *  @brief  ServerEntry struct
+       */
+      struct ServerEntry {
+        std::string                        m_node = {""};              ///< The server node
+        std::unordered_set<std::string>    m_services = {};            ///< The services of the server
+        bool                               m_received = {false};       ///< Whether the service list was received
+        std::unique_ptr<ServiceListInfo>   m_info = {nullptr};         ///< The service list subscription
+      };
+      typedef std::unordered_map<std::string, ServerEntry> ServerMap;
+      typedef std::unordered_map<std::string, ServiceType> ServiceTypeMap;
+
+      /**
+       *  @brief  Whether the name is running with the given service type
+       */
+      bool hasServiceType(const std::string &name, ServiceType type) const;
+
+      /**
+       *  @brief  Wait for the initial server and service lists. Returns immediately once
+       *          the lists were received or the wait timed out once
+       */
+      void waitInitialized();
+
+      /**
+       *  @brief  Add a server and subscribe to its service list. Must be called with the lock held
+       */
+      void addServer(const std::string &server, const std::string &node);
+
+      /**
+       *  @brief  Remove a server and its services. Must be called with the lock held
+       */
+      void removeServer(const std::string &server);
+
+      /**
+       *  @brief  Remove the services of a server. Must be called with the lock held
+       */
+      void clearServices(ServerEntry &entry);
+
+      /**
+       *  @brief  Whether the initial server and service lists were received. Must be called with the lock held
+       */
+      bool initialized() const;
+
+    private:
+      ServerMap                         m_servers = {};               ///< The running servers
+      ServiceTypeMap                    m_services = {};              ///< The running services and their types
+      bool                              m_subscribe = {true};         ///< Whether to subscribe to the dim name service
+      bool                              m_serverListReceived = {false}; ///< Whether the server list was received
+      bool                              m_waited = {false};           ///< Whether the initial wait is over
+      mutable std::mutex                m_mutex = {};                 ///< The cache mutex
+      std::condition_variable           m_condition = {};             ///< Notified when the cache is initialized
+      std::unique_ptr<ServerListInfo>   m_serverListInfo = {nullptr}; ///< The dns server list subscription
+    };
+
+  }
+
+}
+
+#endif //  NAMESERVICECACHE_H
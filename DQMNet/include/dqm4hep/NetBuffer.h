@@ -29,13 +29,16 @@
 #define DQM4HEP_NETBUFFER_H
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 namespace dqm4hep {
 
@@ -49,6 +52,11 @@ namespace dqm4hep {
       static const size_t size;    ///< The buffer size
     };
 
+    /**
+     *  @brief  Count a buffer memory allocation (see BufferModelPool::allocations())
+     */
+    void countBufferAllocation();
+
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
 
@@ -121,8 +129,16 @@ namespace dqm4hep {
        */
       void handle(const char *buffer, size_t size);
 
+      /**
+       *  @brief  Whether the model owns the raw buffer memory. If so, the memory 
+       *          stays valid as long as the model is referenced, e.g to read it in place
+       *          after the callback delivering the buffer has returned
+       */
+      bool isOwner() const;
+
     protected:
       RawBuffer m_rawBuffer = {}; ///< The raw buffer
+      bool      m_isOwner = {false}; ///< Whether the model owns the raw buffer memory
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -169,16 +185,48 @@ namespace dqm4hep {
       inline BufferModelT() {
         m_value.assign(NullBuffer::buffer, NullBuffer::size);
         m_rawBuffer.adopt(m_value.c_str(), m_value.size());
+        m_isOwner = true;
       }
 
       inline void copy(const std::string &value) {
         m_value = value;
         m_rawBuffer.adopt(m_value.c_str(), m_value.size());
+        m_isOwner = true;
       }
 
       inline void move(std::string &&value) {
         m_value = std::move(value);
         m_rawBuffer.adopt(m_value.c_str(), m_value.size());
+        m_isOwner = true;
+      }
+
+      /**
+       *  @brief  Copy a raw buffer. The internal string capacity is reused
+       *
+       *  @param  buffer the buffer start address
+       *  @param  size the buffer size
+       */
+      inline void copy(const char *buffer, size_t size) {
+        if (size > m_value.capacity())
+          countBufferAllocation();
+        m_value.assign(buffer, size);
+        m_rawBuffer.adopt(m_value.c_str(), m_value.size());
+        m_isOwner = true;
+      }
+
+      /**
+       *  @brief  Resize the internal string and get write access to it.
+       *          The internal string capacity is reused
+       *
+       *  @param  size the new buffer size
+       */
+      inline char *resize(size_t size) {
+        if (size > m_value.capacity())
+          countBufferAllocation();
+        m_value.resize(size);
+        m_rawBuffer.adopt(m_value.c_str(), m_value.size());
+        m_isOwner = true;
+        return &m_value[0];
       }
 
     private:
@@ -190,6 +238,98 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
 
+    /**
+     *  @brief  BufferPool class.
+     *          A pool of std::string buffer models. A model is recycled as soon as
+     *          the pool holds the last reference on it. The string capacity of a 
+     *          recycled model is reused, so that copying buffers of similar sizes 
+     *          does not allocate memory in steady state.
+     *          A model acquired from the pool can be shared (e.g between a cache 
+     *          and a network update) and must be considered as immutable once filled
+     */
+    class BufferPool {
+    public:
+      typedef BufferModelT<std::string> Model;
+      typedef std::shared_ptr<Model> ModelPtr;
+      
+      BufferPool(const BufferPool &) = delete;
+      BufferPool &operator=(const BufferPool &) = delete;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  maxSize the maximum number of models owned by the pool
+       */
+      BufferPool(size_t maxSize = 16);
+
+      /**
+       *  @brief  Get a free model from the pool.
+       *          If no model is free and the pool is full, a new model 
+       *          not owned by the pool is created
+       */
+      ModelPtr acquire();
+
+      /**
+       *  @brief  Get a free model from the pool and copy the buffer into it
+       *
+       *  @param  buffer the buffer start address
+       *  @param  size the buffer size
+       */
+      ModelPtr copy(const char *buffer, size_t size);
+
+      /**
+       *  @brief  Get the number of models owned by the pool
+       */
+      size_t size() const;
+
+      /**
+       *  @brief  Get the maximum number of models owned by the pool
+       */
+      size_t maxSize() const;
+
+    private:
+      std::vector<ModelPtr>     m_models = {};       ///< The models owned by the pool
+      size_t                    m_maxSize = {16};    ///< The maximum number of models owned by the pool
+      mutable std::mutex        m_mutex = {};        ///< The pool mutex
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  BufferModelPool class.
+     *          Per-thread pools of raw and std::string buffer models, used by the
+     *          Buffer model factories. As for BufferPool, a model is recycled as soon
+     *          as the pool holds the last reference on it, whatever the thread releasing
+     *          it. A recycled model is reset to the null buffer, a recycled std::string
+     *          model keeps its capacity. Once the pools are warm, exchanging messages
+     *          does not allocate memory for buffer models
+     */
+    class BufferModelPool {
+    public:
+      static const size_t maxSize = 64;   ///< The maximum number of models per pool
+
+      /**
+       *  @brief  Get a free raw buffer model from the pool of the calling thread
+       */
+      static std::shared_ptr<BufferModel> acquireRaw();
+
+      /**
+       *  @brief  Get a free std::string buffer model from the pool of the calling thread
+       */
+      static std::shared_ptr<BufferModelT<std::string>> acquireString();
+
+      /**
+       *  @brief  Get the total number of memory allocations for buffer models since
+       *          the program start: model allocations when no pooled model is free
+       *          and string capacity growths. Constant in steady state
+       */
+      static uint64_t allocations();
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
     /**
      *  @brief  Buffer class
      */
@@ -217,7 +357,7 @@ namespace dqm4hep {
       std::shared_ptr<BufferModelT<T>> createModel() const;
 
       /**
-       *  @brief  Factory method to create a new model (std::string specialization)
+       *  @brief  Factory method to create a new raw model, from the pool of the calling thread
        */
       std::shared_ptr<BufferModel> createModel() const;
 
@@ -266,6 +406,7 @@ namespace dqm4hep {
     template <typename T>
     inline BufferModelT<T>::BufferModelT() {
       m_rawBuffer.adopt((const char *)&m_value, sizeof(m_value));
+      m_isOwner = true;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -274,6 +415,7 @@ namespace dqm4hep {
     inline void BufferModelT<T>::copy(const T &value) {
       m_value = T(value);
       m_rawBuffer.adopt((const char *)&m_value, sizeof(m_value));
+      m_isOwner = true;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -282,6 +424,7 @@ namespace dqm4hep {
     inline void BufferModelT<T>::move(T &&value) {
       m_value = std::move(value);
       m_rawBuffer.adopt((const char *)&m_value, sizeof(m_value));
+      m_isOwner = true;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -289,8 +432,16 @@ namespace dqm4hep {
 
     template <typename T>
     inline std::shared_ptr<BufferModelT<T>> Buffer::createModel() const {
+      countBufferAllocation();
       return std::make_shared<BufferModelT<T>>();
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <>
+    inline std::shared_ptr<BufferModelT<std::string>> Buffer::createModel<std::string>() const {
+      return BufferModelPool::acquireString();
+    }
   }
 }
 
@@ -0,0 +1,269 @@
+/// \file RequestChannel.h
+/*
+ *
+ * RequestChannel.h header template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+#ifndef REQUESTCHANNEL_H
+#define REQUESTCHANNEL_H
+
+// -- dim headers
+#include "dic.hxx"
+
+// -- dqm4hep headers
+#include "dqm4hep/Internal.h"
+#include "dqm4hep/StatusCodes.h"
+#include "dqm4hep/NetBuffer.h"
+
+// -- std headers
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace dqm4hep {
+
+  namespace net {
+
+    class Client;
+
+    /**
+     *  @brief  PendingRequests class.
+     *          The requests of a request channel waiting for a response, by request id.
+     *          Matches the responses to their request using the request header echoed 
+     *          by the server and handles the timeouts. Responses without request header
+     *          can't be matched and are dropped: asynchronous requests need a server
+     *          echoing the request header (see RequestHandler)
+     */
+    class PendingRequests {
+    public:
+      /**
+       *  @brief  The response callback function. Called with STATUS_CODE_SUCCESS and the
+       *          response on success, STATUS_CODE_TIMEOUT if no response was received in time
+       *          and STATUS_CODE_FAILURE if the connection to the server was lost
+       */
+      typedef std::function<void(core::StatusCode, const Buffer &)> ResponseFunction;
+      typedef std::chrono::steady_clock::time_point TimePoint;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  name the request name, for logging
+       */
+      PendingRequests(const std::string &name);
+      PendingRequests(const PendingRequests&) = delete;
+      PendingRequests& operator=(const PendingRequests&) = delete;
+
+      /**
+       *  @brief  Add a pending request
+       *
+       *  @param  requestId the request id (must not be 0)
+       *  @param  function the response callback function
+       *  @param  timeout the timeout in milliseconds (0 means no timeout)
+       */
+      void add(uint32_t requestId, ResponseFunction function, unsigned int timeout);
+
+      /**
+       *  @brief  Remove a pending request. The response callback is not called.
+       *          Returns false if the request is not pending
+       *
+       *  @param  requestId the request id
+       */
+      bool cancel(uint32_t requestId);
+
+      /**
+       *  @brief  Get the number of requests waiting for a response
+       */
+      unsigned int size() const;
+
+      /**
+       *  @brief  Remove the requests that timed out and notify them (STATUS_CODE_TIMEOUT).
+       *          Returns the earliest deadline of the remaining requests (TimePoint::max() if none)
+       *
+       *  @param  now the current time
+       */
+      TimePoint processTimeouts(const TimePoint &now);
+
+      /**
+       *  @brief  Handle a response received from the server and notify the matching request.
+       *          A response with the request id 0 (no link) fails all the pending requests
+       *
+       *  @param  data the response data (request header + response)
+       *  @param  size the response size
+       */
+      void handleResponse(const char *data, size_t size);
+
+    private:
+      /**
+       *  @brief  PendingRequest struct
+       */
+      struct PendingRequest {
+        ResponseFunction      m_function = {};        ///< The response callback function
+        TimePoint             m_deadline = {};        ///< The response deadline (TimePoint::max() if no timeout)
+      };
+      typedef std::map<uint32_t, PendingRequest> PendingRequestMap;
+
+    private:
+      std::string               m_name = {""};              ///< The request name
+      PendingRequestMap         m_requests = {};            ///< The requests waiting for a response, by request id
+      mutable std::mutex        m_mutex = {};               ///< The pending requests mutex
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  RequestChannel class.
+     *          A persistent rpc connection to a request handler, used to
+     *          send asynchronous requests. Several requests can be in flight
+     *          at the same time. Responses are matched to their request using
+     *          the request id echoed by the server (see RequestHeader).
+     *          Created and owned by the client (see Client::sendRequestAsync())
+     */
+    class RequestChannel {
+      friend class Client;
+
+    public:
+      typedef PendingRequests::ResponseFunction ResponseFunction;
+      typedef PendingRequests::TimePoint TimePoint;
+
+      /**
+       *  @brief  Get the request name
+       */
+      const std::string &name() const;
+
+      /**
+       *  @brief  Get the client interface
+       */
+      Client *client() const;
+
+      /**
+       *  @brief  Get the number of requests waiting for a response
+       */
+      unsigned int numberOfPendingRequests() const;
+
+    private:
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  pClient the client that owns the channel
+       *  @param  name the request name
+       */
+      RequestChannel(Client *pClient, const std::string &name);
+
+      RequestChannel() = delete;
+      RequestChannel(const RequestChannel&) = delete;
+      RequestChannel& operator=(const RequestChannel&) = delete;
+
+      /**
+       *  @brief  Destructor. Pending requests are dropped without notification
+       */
+      ~RequestChannel();
+
+      /**
+       *  @brief  Send a request
+       *
+       *  @param  requestId the request id (must not be 0)
+       *  @param  request the request contents
+       *  @param  function the response callback function
+       *  @param  timeout the timeout in milliseconds (0 means no timeout)
+       */
+      void send(uint32_t requestId, const Buffer &request, ResponseFunction function, unsigned int timeout);
+
+      /**
+       *  @brief  Cancel a pending request. The response callback is not called.
+       *          Returns false if the request is not pending on this channel
+       *
+       *  @param  requestId the request id
+       */
+      bool cancel(uint32_t requestId);
+
+      /**
+       *  @brief  Remove the requests that timed out and notify them (STATUS_CODE_TIMEOUT).
+       *          Returns the earliest deadline of the remaining requests (TimePoint::max() if none)
+       *
+       *  @param  now the current time
+       */
+      TimePoint processTimeouts(const TimePoint &now);
+
+      /**
+       *  @brief  Handle a response received from the server
+       *
+       *  @param  data the response data
+       *  @param  size the response size
+       */
+      void handleResponse(const char *data, size_t size);
+
+    private:
+      /** Rpc class.
+       *
+       *  The concrete dim rpc info implementation
+       */
+      class Rpc : public DimRpcInfo {
+      public:
+        /** Contructor
+         */
+        Rpc(RequestChannel *pChannel);
+        Rpc() = delete;
+        Rpc(const Rpc&) = delete;
+        Rpc& operator=(const Rpc&) = delete;
+
+        /** Destructor
+         */
+        ~Rpc();
+
+        /** The dim rpc info handler
+         */
+        void rpcInfoHandler() override;
+
+        /** Send a request without waiting for the response. Must be called with the send lock held
+         */
+        void send(char *data, size_t size);
+
+      private:
+        /** The dim command completion callback. Fails the pending requests if the command couldn't be sent
+         */
+        static void commandCallback(void *tag, int *status);
+
+      private:
+        RequestChannel *m_pChannel = {nullptr};
+        std::string     m_commandName = {""};     ///< The dim rpc input command name
+        bool            m_listening = {false};    ///< Whether the rpc listens for responses
+        dim_long        m_id = {0};               ///< The rpc id, passed to the command callback
+      };
+
+    private:
+      std::string               m_name = {""};              ///< The request name
+      Client                   *m_pClient = {nullptr};      ///< The client manager
+      PendingRequests           m_pendingRequests;          ///< The requests waiting for a response
+      std::recursive_mutex      m_sendMutex = {};           ///< Serialize the requests sending
+      std::string               m_sendBuffer = {""};        ///< The buffer of the request being sent (header + contents)
+      Rpc                       m_rpc;                      ///< The dim rpc info
+    };
+
+  }
+
+}
+
+#endif //  REQUESTCHANNEL_H
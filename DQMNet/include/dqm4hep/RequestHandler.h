@@ -31,11 +31,19 @@
 // -- dqm4hep headers
 #include "dqm4hep/Internal.h"
 #include "dqm4hep/NetBuffer.h"
+#include "dqm4hep/SharedMemory.h"
 #include "dqm4hep/Signal.h"
 #include "dqm4hep/json.h"
 
 // -- std headers
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 // -- dim headers
 #include "dis.hxx"
@@ -46,11 +54,185 @@ namespace dqm4hep {
 
     class Server;
 
+    /**
+     *  @brief  RequestHeader struct.
+     *          Header prepended to asynchronous requests (see Client::sendRequestAsync())
+     *          and echoed back in the response by the request handler, so that the 
+     *          client can match responses to requests when several requests are in flight.
+     *          Layout: magic number (4 bytes) + request id (4 bytes), little endian.
+     *          The request id 0 is reserved (no link)
+     */
+    struct RequestHeader {
+      static const uint32_t magic;     ///< The header magic number
+      static const size_t   size = 8;  ///< The header size
+
+      /**
+       *  @brief  Write the header
+       *
+       *  @param  buffer the buffer to write to (at least size bytes)
+       *  @param  requestId the request id
+       */
+      static void write(char *buffer, uint32_t requestId);
+
+      /**
+       *  @brief  Read the header. Returns false if the buffer doesn't start with a header
+       *
+       *  @param  buffer the buffer to read
+       *  @param  bufferSize the buffer size
+       *  @param  requestId the request id to receive
+       */
+      static bool read(const char *buffer, size_t bufferSize, uint32_t &requestId);
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  RequestExecutor class.
+     *          A pool of threads running the requests of non-inline request handlers
+     *          (see RequestHandler::Execution), so that a slow handler doesn't block
+     *          the dim server thread. Tasks are run in the order they are posted.
+     *          The pending tasks are run before the threads exit
+     */
+    class RequestExecutor {
+    public:
+      typedef std::function<void()> Task;
+
+      RequestExecutor(const RequestExecutor&) = delete;
+      RequestExecutor& operator=(const RequestExecutor&) = delete;
+
+      /**
+       *  @brief  Constructor. Start the threads
+       *
+       *  @param  nThreads the number of threads (at least 1)
+       */
+      RequestExecutor(unsigned int nThreads);
+
+      /**
+       *  @brief  Destructor. Run the pending tasks and join the threads
+       */
+      ~RequestExecutor();
+
+      /**
+       *  @brief  Post a task to run in one of the threads
+       *
+       *  @param  task the task to run
+       */
+      void post(Task task);
+
+      /**
+       *  @brief  Get the number of threads
+       */
+      unsigned int nThreads() const;
+
+      /**
+       *  @brief  Get the number of posted tasks not yet started
+       */
+      size_t nPendingTasks() const;
+
+      /**
+       *  @brief  Get the process-wide executor shared by the request handlers
+       *          created with RequestHandler::SHARED_POOL. One thread per core.
+       */
+      static std::shared_ptr<RequestExecutor> shared();
+
+    private:
+      /**
+       *  @brief  The thread function. Run the tasks until stopped
+       */
+      void run();
+
+    private:
+      std::vector<std::thread>         m_threads = {};              ///< The executor threads
+      std::deque<Task>                 m_tasks = {};                ///< The pending tasks
+      mutable std::mutex               m_mutex = {};                ///< The task queue mutex
+      std::condition_variable          m_condition = {};            ///< Notified on new tasks and on stop
+      bool                             m_stopFlag = {false};        ///< Whether to stop the threads
+    };
+
+    typedef std::shared_ptr<RequestExecutor> RequestExecutorPtr;
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  DeferredResponse class.
+     *          A handle on the response of a request handled asynchronously.
+     *          Copyable: it can be stored and completed later from any thread,
+     *          using send(). Only the first send() is sent. If the last copy is
+     *          destroyed without sending, an empty response is sent so that the
+     *          client doesn't wait until its timeout. Sending after the request
+     *          handler has been stopped is a no-op
+     */
+    class DeferredResponse {
+    public:
+      /**
+       *  @brief  The function sending the response buffer to the client
+       */
+      typedef std::function<void(const char *, size_t)> SendFunction;
+
+      /**
+       *  @brief  Constructor. Not linked to any request
+       */
+      DeferredResponse() = default;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  function the function sending the response, called at most once
+       */
+      DeferredResponse(SendFunction function);
+
+      /**
+       *  @brief  Send the response buffer. The buffer is copied
+       *
+       *  @param  response the response to send
+       */
+      void send(const Buffer &response);
+
+      /**
+       *  @brief  Send the response. The buffer is copied
+       *
+       *  @param  buffer the buffer start address
+       *  @param  size the buffer size
+       */
+      void send(const char *buffer, size_t size);
+
+      /**
+       *  @brief  Whether the response is linked to a request and not yet sent
+       */
+      bool pending() const;
+
+    private:
+      class State;
+
+    private:
+      std::shared_ptr<State>      m_state = {nullptr};     ///< The response state shared by the copies
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
     class RequestHandler {
       friend class Server;
 
     public:
       typedef core::Signal<const Buffer &, Buffer &> RequestSignal;
+      typedef std::function<void(const Buffer &, DeferredResponse)> DeferredFunction;
+
+      /**
+       *  @brief  Execution enumerator.
+       *          Where the user callback of a request handler runs:
+       *          - INLINE: in the dim server thread. A slow callback blocks all the
+       *            requests and commands of the server (default)
+       *          - DEDICATED_THREAD: in a thread owned by the request handler.
+       *            Requests are still processed one at a time, in order
+       *          - SHARED_POOL: in the process-wide pool (see RequestExecutor::shared()).
+       *            Requests may be processed concurrently: the callback must be thread safe
+       *          For non-inline executions, the request buffer is copied before
+       *          the dim server thread is released
+       */
+      enum Execution { INLINE, DEDICATED_THREAD, SHARED_POOL };
 
       /**
        * Get the request name
@@ -62,25 +244,48 @@ namespace dqm4hep {
        */
       Server *server() const;
 
+      /**
+       * Get the execution of the user callback
+       */
+      Execution execution() const;
+
     private:
       /**
        * Constructor
        *
        * @param pServer the server managing the request handler
        * @param name the request handler name
+       * @param execution where the user callback runs
+       */
+      template <typename Controller>
+      RequestHandler(Server *pServer, const std::string &name, Controller *pController,
+                     void (Controller::*function)(const Buffer &request, Buffer &response), Execution execution = INLINE);
+
+      /**
+       * Constructor. The callback completes the response with DeferredResponse::send(),
+       * possibly after returning
+       *
+       * @param pServer the server managing the request handler
+       * @param name the request handler name
+       * @param execution where the user callback runs
        */
       template <typename Controller>
       RequestHandler(Server *pServer, const std::string &name, Controller *pController,
-                     void (Controller::*function)(const Buffer &request, Buffer &response));
+                     void (Controller::*function)(const Buffer &request, DeferredResponse response), Execution execution = INLINE);
       
       RequestHandler(const RequestHandler&) = delete;
       RequestHandler& operator=(const RequestHandler&) = delete;
 
       /**
-       * Destructor
+       * Destructor. Wait for the requests running in the executor
        */
       ~RequestHandler();
 
+      /**
+       * Create the executor matching the execution
+       */
+      void createExecutor();
+
       /**
        * Create the actual request handler connection
        */
@@ -116,13 +321,41 @@ namespace dqm4hep {
         Rpc(const Rpc&) = delete;
         Rpc& operator=(const Rpc&) = delete;
 
+        /**
+         * Destructor. Pending deferred responses are dropped
+         */
+        ~Rpc();
+
         /**
          * The dim rpc handler
          */
         void rpcHandler() override;
 
+        /**
+         * Send a deferred response to a client. Must be called with the dim lock held
+         *
+         * @param clientId the dim connection id of the client
+         * @param asyncRequest whether to prepend the request header
+         * @param requestId the request id of an asynchronous request
+         * @param buffer the response buffer
+         * @param size the response size
+         */
+        void reply(int clientId, bool asyncRequest, uint32_t requestId, const char *buffer, size_t size);
+
+        /**
+         * Set the response sent by dim when returning from rpcHandler()
+         *
+         * @param asyncRequest whether to prepend the request header
+         * @param requestId the request id of an asynchronous request
+         * @param buffer the response buffer
+         * @param size the response size
+         */
+        void setResponse(bool asyncRequest, uint32_t requestId, const char *buffer, size_t size);
+
       private:
-        RequestHandler *m_pHandler = {nullptr}; ///< The request handler owner instance
+        RequestHandler         *m_pHandler = {nullptr}; ///< The request handler owner instance
+        std::string             m_response = {""};      ///< The response buffer of asynchronous requests
+        std::shared_ptr<Rpc *>  m_link = {nullptr};     ///< Reset on destruction, read with the dim lock held
       };
 
       friend class Rpc;
@@ -135,11 +368,44 @@ namespace dqm4hep {
        */
       void handleRequest(const Buffer &request, Buffer &response);
 
+      /**
+       * Handle a request in the executor or with a deferred callback
+       *
+       * @param request the request buffer
+       * @param response the response to complete
+       */
+      void handleDeferredRequest(const Buffer &request, DeferredResponse response);
+
+      /**
+       * Whether the request is handled by the dim server thread and replied on return
+       */
+      bool isSynchronous() const;
+
+      /**
+       * Post a request copy to the executor
+       *
+       * @param buffer the request buffer
+       * @param size the request size
+       * @param response the response to complete
+       */
+      void postRequest(const char *buffer, size_t size, DeferredResponse response);
+
+      /**
+       * Count a posted request as done and notify the destructor
+       */
+      void requestDone();
+
     private:
-      std::string           m_name = {""};            ///< The request handler name
-      Server               *m_pServer = {nullptr};         ///< The server in which the request handler is declared
-      RequestSignal         m_requestSignal = {};
-      Rpc                  *m_pRpc = {nullptr};
+      std::string               m_name = {""};            ///< The request handler name
+      Server                   *m_pServer = {nullptr};         ///< The server in which the request handler is declared
+      RequestSignal             m_requestSignal = {};
+      DeferredFunction          m_deferredFunction = {};  ///< The user callback with deferred response, if any
+      Execution                 m_execution = {INLINE};   ///< Where the user callback runs
+      RequestExecutorPtr        m_executor = {nullptr};   ///< The executor of non-inline executions
+      unsigned int              m_nRunningRequests = {0}; ///< The number of requests posted to the executor
+      std::mutex                m_runningMutex = {};      ///< The running requests mutex
+      std::condition_variable   m_runningCondition = {};  ///< Notified when a posted request is done
+      Rpc                      *m_pRpc = {nullptr};
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -148,9 +414,24 @@ namespace dqm4hep {
 
     template <typename Controller>
     inline RequestHandler::RequestHandler(Server *pServer, const std::string &rname, Controller *pController,
-                                          void (Controller::*function)(const Buffer &request, Buffer &response))
-        : m_name(rname), m_pServer(pServer), m_pRpc(nullptr) {
+                                          void (Controller::*function)(const Buffer &request, Buffer &response),
+                                          Execution rexecution)
+        : m_name(rname), m_pServer(pServer), m_execution(rexecution), m_pRpc(nullptr) {
       m_requestSignal.connect(pController, function);
+      this->createExecutor();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename Controller>
+    inline RequestHandler::RequestHandler(Server *pServer, const std::string &rname, Controller *pController,
+                                          void (Controller::*function)(const Buffer &request, DeferredResponse response),
+                                          Execution rexecution)
+        : m_name(rname), m_pServer(pServer), m_execution(rexecution), m_pRpc(nullptr) {
+      m_deferredFunction = [pController, function](const Buffer &request, DeferredResponse response) {
+        (pController->*function)(request, response);
+      };
+      this->createExecutor();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -240,8 +521,14 @@ namespace dqm4hep {
          */
         void commandHandler() override;
 
+        /**
+         * Handle a single command, read from shared memory if needed
+         */
+        void handleCommand(const char *data, size_t size);
+
       private:
-        CommandHandler *m_pHandler = {nullptr}; ///< The request handler owner instance
+        CommandHandler     *m_pHandler = {nullptr}; ///< The request handler owner instance
+        SharedMemoryReader  m_sharedMemoryReader = {}; ///< Resolves the commands sent in shared memory
       };
 
       friend class Command;
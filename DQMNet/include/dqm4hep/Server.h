@@ -109,10 +109,27 @@ namespace dqm4hep {
        *  @param  name the request handler name
        *  @param  pController the class instance that will handle the request
        *  @param  function the class method that will treat the request and provide a response
+       *  @param  execution where the class method runs (see RequestHandler::Execution)
        */
       template <typename Controller>
       void createRequestHandler(const std::string &name, Controller *pController,
-                                void (Controller::*function)(const Buffer &request, Buffer &response));
+                                void (Controller::*function)(const Buffer &request, Buffer &response),
+                                RequestHandler::Execution execution = RequestHandler::INLINE);
+
+      /**
+       *  @brief  Create a new request handler with deferred response.
+       *          The class method completes the response using DeferredResponse::send(),
+       *          possibly later and from another thread
+       *
+       *  @param  name the request handler name
+       *  @param  pController the class instance that will handle the request
+       *  @param  function the class method that will treat the request
+       *  @param  execution where the class method runs (see RequestHandler::Execution)
+       */
+      template <typename Controller>
+      void createRequestHandler(const std::string &name, Controller *pController,
+                                void (Controller::*function)(const Buffer &request, DeferredResponse response),
+                                RequestHandler::Execution execution = RequestHandler::INLINE);
 
       /**
        *  @brief  Create a new command handler
@@ -238,7 +255,9 @@ namespace dqm4hep {
       static int dnsPort();
 
       /**
-       *  @brief  Get the list of running servers
+       *  @brief  Get the list of running servers.
+       *          This function and the following ones are answered by the name 
+       *          service cache, without network traffic (see NameServiceCache)
        */
       static std::vector<std::string> runningServers();
 
@@ -271,6 +290,15 @@ namespace dqm4hep {
       static bool commandHandlerAlreadyRunning(const std::string &name);
 
     private:
+      /**
+       *  @brief  Register a request handler created by the factory
+       *
+       *  @param  name the request handler name
+       *  @param  factory the request handler factory function
+       */
+      template <typename Factory>
+      void addRequestHandler(const std::string &name, Factory factory);
+
       void handleServerInfoRequest(const Buffer &, Buffer &response);
       RequestHandler *requestHandler(const std::string &name) const;
       CommandHandler *commandHandler(const std::string &name) const;
@@ -297,7 +325,24 @@ namespace dqm4hep {
 
     template <typename Controller>
     inline void Server::createRequestHandler(const std::string &rname, Controller *pController,
-                                             void (Controller::*function)(const Buffer &request, Buffer &response)) {
+                                             void (Controller::*function)(const Buffer &request, Buffer &response),
+                                             RequestHandler::Execution execution) {
+      this->addRequestHandler(rname, [&]() { return new RequestHandler(this, rname, pController, function, execution); });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename Controller>
+    inline void Server::createRequestHandler(const std::string &rname, Controller *pController,
+                                             void (Controller::*function)(const Buffer &request, DeferredResponse response),
+                                             RequestHandler::Execution execution) {
+      this->addRequestHandler(rname, [&]() { return new RequestHandler(this, rname, pController, function, execution); });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename Factory>
+    inline void Server::addRequestHandler(const std::string &rname, Factory factory) {
       auto findIter = m_requestHandlerMap.find(rname);
 
       if (findIter != m_requestHandlerMap.end())
@@ -312,7 +357,7 @@ namespace dqm4hep {
       auto inserted = m_requestHandlerMap.insert(RequestHandlerMap::value_type(rname, nullptr));
 
       if (inserted.second) {
-        RequestHandler *pRequestHandler = new RequestHandler(this, rname, pController, function);
+        RequestHandler *pRequestHandler = factory();
         inserted.first->second = pRequestHandler;
 
         if (this->isRunning())
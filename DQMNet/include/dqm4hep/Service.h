@@ -29,6 +29,8 @@
 #define SERVICE_H
 
 // -- std headers
+#include <mutex>
+#include <set>
 #include <string>
 #include <typeinfo>
 
@@ -36,8 +38,10 @@
 #include "dis.hxx"
 
 // -- dqm4hep headers
+#include "dqm4hep/Codec.h"
 #include "dqm4hep/Internal.h"
 #include "dqm4hep/NetBuffer.h"
+#include "dqm4hep/SharedMemory.h"
 
 namespace dqm4hep {
 
@@ -59,6 +63,50 @@ namespace dqm4hep {
        */
       Server *server() const;
 
+      /**
+       * Set the codec used to compress the service contents. Only buffers larger
+       * than minSize are compressed. Clients decode the contents transparently.
+       * If the codec is not available in this build, zlib is used instead
+       *
+       * @param type the codec type
+       * @param level the compression level, 0 for the codec default
+       * @param minSize the minimum buffer size to compress
+       */
+      void setCodec(Codec::Type type, int level = 0, size_t minSize = 512);
+
+      /**
+       * Get the codec used to compress the service contents
+       */
+      Codec::Type codec() const;
+
+      /**
+       * Enable the shared memory transport. The clients running on the same host
+       * receive a reference on the contents written in a shared memory ring and
+       * read them in place. The other clients still receive the contents over the
+       * network. Contents larger than the slot size, or sent while all the slots
+       * are being read, go over the network. A client on the same host that can't
+       * attach to the ring (other user, other IPC namespace) reports it (see
+       * sharedMemoryFailureName()): it receives the last update again and all the
+       * next ones over the network
+       *
+       * @param nSlots the number of slots in the ring
+       * @param slotSize the maximum contents size of a slot
+       */
+      void setSharedMemory(unsigned int nSlots = 8, size_t slotSize = 4*1024*1024);
+
+      /**
+       * Whether the shared memory transport is enabled
+       */
+      bool sharedMemory() const;
+
+      /**
+       * Get the name of the command sent by the clients that can't attach to the
+       * shared memory ring of a service
+       *
+       * @param name the service name
+       */
+      static std::string sharedMemoryFailureName(const std::string &name);
+
       /**
        * Send a simple value
        */
@@ -111,6 +159,28 @@ namespace dqm4hep {
       void sendBuffer(const void *ptr, size_t size, const std::vector<int> &clientIds);
 
     private:
+      /** DimServiceImpl class
+       *
+       *  The concrete dim service implementation.
+       *  Selects the contents to send to each client
+       */
+      class DimServiceImpl : public DimService {
+      public:
+        /** Contructor
+         */
+        DimServiceImpl(Service *pService);
+        DimServiceImpl() = delete;
+        DimServiceImpl(const DimServiceImpl&) = delete;
+        DimServiceImpl& operator=(const DimServiceImpl&) = delete;
+
+        /** The dim service handler, called for each client on update
+         */
+        void serviceHandler() override;
+
+      private:
+        Service *m_pService = {nullptr};
+      };
+
       /**
        * Constructor with service name
        *
@@ -142,14 +212,59 @@ namespace dqm4hep {
       bool isServiceConnected() const;
 
       /**
-       *
+       * Send the contents to all clients or to the list of clients
        */
       void sendData(const Buffer &buffer, const std::vector<int> &clientIds);
 
+      /**
+       * Get the contents to send over the network, compressed if a codec is set.
+       * Must be called with the dim and send locks held
+       */
+      void networkContents(void *&data, int &size);
+
+      /**
+       * Select the contents to send to the current client (dim service handler):
+       * shared memory reference for clients on the same host, network contents otherwise.
+       * Outside of sendData(), the null buffer is selected
+       */
+      void selectClientContents();
+
+      /**
+       * Whether the current client (dim service handler) runs on the same host
+       */
+      static bool isLocalClient();
+
+      /**
+       * Whether the current client (dim service handler) reported that it can't
+       * attach to the shared memory ring
+       */
+      bool isNetworkClient() const;
+
+      /**
+       * Handle the command of a client that can't attach to the shared memory ring.
+       * The last update is sent again to the client over the network
+       */
+      void handleSharedMemoryFailure(const Buffer &command);
+
     private:
       DimService         *m_pService = {nullptr};      ///< The service implementation
       std::string         m_name = {""};               ///< The service name
       Server             *m_pServer = {nullptr};       ///< The server in which the service is declared
+      Codec::Type         m_codec = {Codec::NONE};     ///< The codec used to compress the service contents
+      int                 m_codecLevel = {0};          ///< The compression level
+      size_t              m_codecMinSize = {512};      ///< The minimum buffer size to compress
+      std::string         m_encodeBuffer = {""};       ///< The buffer of compressed contents, reused between updates
+      std::mutex          m_sendMutex = {};            ///< The send mutex
+      std::unique_ptr<SharedMemoryRing> m_sharedMemory = {nullptr}; ///< The shared memory ring (shared memory transport only)
+      std::string         m_reference = {""};          ///< The shared memory reference of the contents being sent
+      const Buffer       *m_pContents = {nullptr};     ///< The contents being sent
+      bool                m_sharedUpdate = {false};    ///< Whether the contents being sent are in shared memory
+      bool                m_lastUpdateShared = {false}; ///< Whether the last contents sent are in shared memory
+      std::set<int>       m_networkClients = {};       ///< The clients that can't attach to the shared memory ring
+      mutable std::mutex  m_networkClientsMutex = {};  ///< The network clients mutex
+      bool                m_contentsPrepared = {false}; ///< Whether the network contents are prepared
+      void               *m_networkData = {nullptr};   ///< The network contents being sent
+      int                 m_networkSize = {0};         ///< The network contents size
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -166,6 +281,13 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    template <>
+    inline void Service::send(const Buffer &buffer) {
+      this->sendData(buffer, std::vector<int>());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     template <typename T>
     inline void Service::sendArray(const T *value, size_t nElements) {
       Buffer buffer(value, nElements);
@@ -34,6 +34,7 @@
 // -- dqm4hep headers
 #include "dqm4hep/Internal.h"
 #include "dqm4hep/NetBuffer.h"
+#include "dqm4hep/SharedMemory.h"
 #include "dqm4hep/Signal.h"
 #include "dqm4hep/json.h"
 
@@ -107,7 +108,9 @@ namespace dqm4hep {
         void infoHandler() override;
 
       private:
-        ServiceHandler *m_pHandler = {nullptr};
+        ServiceHandler     *m_pHandler = {nullptr};
+        SharedMemoryReader  m_sharedMemoryReader = {};   ///< Resolves the contents sent in shared memory
+        bool                m_networkFallback = {false}; ///< Whether the server was asked to send the contents over the network
       };
 
       /**
@@ -0,0 +1,258 @@
+/// \file SharedMemory.h
+/*
+ *
+ * SharedMemory.h header template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+
+#ifndef SHAREDMEMORY_H
+#define SHAREDMEMORY_H
+
+// -- std headers
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace dqm4hep {
+
+  namespace net {
+
+    /**
+     *  @brief  SharedMemoryReference struct.
+     *          Defines the message sent over the network in place of contents
+     *          written in a shared memory ring (see SharedMemoryRing):
+     *          magic number (4 bytes), slot index (4 bytes), slot sequence (8 bytes),
+     *          contents size (8 bytes), ring name size (4 bytes) and ring name. Little endian
+     */
+    struct SharedMemoryReference {
+      static const uint32_t magic;             ///< The reference magic number
+      static const size_t   headerSize = 28;   ///< The reference size without ring name
+
+      /**
+       *  @brief  Whether the buffer is a shared memory reference
+       *
+       *  @param  buffer the buffer to check
+       *  @param  size the buffer size
+       */
+      static bool isReference(const char *buffer, size_t size);
+
+      /**
+       *  @brief  Write a reference. The output capacity is reused
+       *
+       *  @param  output the output reference
+       *  @param  ring the ring name
+       *  @param  slot the slot index
+       *  @param  sequence the slot sequence
+       *  @param  size the contents size
+       */
+      static void write(std::string &output, const std::string &ring, uint32_t slot, uint64_t sequence, uint64_t size);
+
+      /**
+       *  @brief  Read a reference. Returns false if the reference is malformed
+       *
+       *  @param  buffer the reference buffer
+       *  @param  bufferSize the reference buffer size
+       *  @param  ring the ring name
+       *  @param  slot the slot index
+       *  @param  sequence the slot sequence
+       *  @param  size the contents size
+       */
+      static bool read(const char *buffer, size_t bufferSize, std::string &ring, uint32_t &slot, uint64_t &sequence, uint64_t &size);
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  SharedMemoryRing class.
+     *          A ring of fixed size slots in a POSIX shared memory segment, used
+     *          to pass contents to processes running on the same host without copy
+     *          on the reader side. The writer process creates the ring and writes
+     *          the contents in the next slot not read at the moment. Readers open
+     *          the ring by name and pin a slot while reading it in place.
+     *          A slot rewritten before being read is reported as lost to the reader.
+     *          The segment is only accessible to the processes of the same user (mode 0600):
+     *          writers must check that their readers can attach before sending them
+     *          references (see SharedMemoryReader::attach()). Single writer, multiple readers
+     */
+    class SharedMemoryRing {
+    public:
+      SharedMemoryRing(const SharedMemoryRing&) = delete;
+      SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+      /**
+       *  @brief  Create a new ring with a unique name (writer side).
+       *          Returns nullptr if the shared memory segment can't be created
+       *
+       *  @param  nSlots the number of slots
+       *  @param  slotSize the maximum contents size of a slot
+       */
+      static std::unique_ptr<SharedMemoryRing> create(unsigned int nSlots, size_t slotSize);
+
+      /**
+       *  @brief  Open an existing ring (reader side).
+       *          Returns nullptr if the ring doesn't exist or is not valid
+       *
+       *  @param  name the ring name
+       */
+      static std::unique_ptr<SharedMemoryRing> open(const std::string &name);
+
+      /**
+       *  @brief  Destructor. The writer removes the shared memory segment,
+       *          the readers still mapping it keep a valid view
+       */
+      ~SharedMemoryRing();
+
+      /**
+       *  @brief  Get the ring name
+       */
+      const std::string &name() const;
+
+      /**
+       *  @brief  Get the number of slots
+       */
+      unsigned int nSlots() const;
+
+      /**
+       *  @brief  Get the maximum contents size of a slot
+       */
+      size_t slotSize() const;
+
+      /**
+       *  @brief  Write contents in the next free slot and the corresponding reference
+       *          to send (writer side). Returns false if the contents are too large or
+       *          all the slots are being read
+       *
+       *  @param  data the contents to write
+       *  @param  size the contents size
+       *  @param  reference the reference to send to the readers
+       */
+      bool write(const char *data, size_t size, std::string &reference);
+
+      /**
+       *  @brief  Pin a slot for reading (reader side). Returns false if the slot
+       *          was rewritten since the reference was sent (contents lost).
+       *          A pinned slot must be unpinned once read
+       *
+       *  @param  slot the slot index
+       *  @param  sequence the slot sequence from the reference
+       *  @param  size the contents size from the reference
+       *  @param  data the contents address
+       */
+      bool pin(uint32_t slot, uint64_t sequence, uint64_t size, const char *&data);
+
+      /**
+       *  @brief  Unpin a slot after reading (reader side)
+       *
+       *  @param  slot the slot index
+       */
+      void unpin(uint32_t slot);
+
+    private:
+      struct Slot;
+
+      /**
+       *  @brief  Constructor
+       */
+      SharedMemoryRing(const std::string &name, bool owner, char *address, size_t mappedSize);
+
+      /**
+       *  @brief  Get a slot header
+       *
+       *  @param  slot the slot index
+       */
+      Slot *slotAt(uint32_t slot) const;
+
+      /**
+       *  @brief  Get the size of a slot in the segment (header + contents)
+       *
+       *  @param  slotSize the maximum contents size of a slot
+       */
+      static size_t slotStride(size_t slotSize);
+
+    private:
+      std::string         m_name = {""};           ///< The ring name
+      bool                m_owner = {false};       ///< Whether this process created the ring
+      char               *m_address = {nullptr};   ///< The mapped segment address
+      size_t              m_mappedSize = {0};      ///< The mapped segment size
+      unsigned int        m_nSlots = {0};          ///< The number of slots
+      size_t              m_slotSize = {0};        ///< The maximum contents size of a slot
+      uint32_t            m_nextSlot = {0};        ///< The next slot to write (writer side)
+      uint64_t            m_sequence = {0};        ///< The last written sequence (writer side)
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  SharedMemoryReader class.
+     *          Resolves the shared memory references received from the network.
+     *          The rings are opened on first use and kept open
+     */
+    class SharedMemoryReader {
+    public:
+      typedef std::function<void(const char *, size_t)> ReadFunction;
+
+      /**
+       *  @brief  Open the ring of a reference if not yet opened. Returns false if the 
+       *          reference is malformed or the ring can't be opened by this process 
+       *          (other user, other IPC namespace), i.e the contents must be sent over the network
+       *
+       *  @param  reference the reference buffer
+       *  @param  size the reference buffer size
+       */
+      bool attach(const char *reference, size_t size);
+
+      /**
+       *  @brief  Resolve a reference and call the function with a view on the
+       *          contents, valid only during the call. Returns false if the ring
+       *          can't be opened or the contents were lost
+       *
+       *  @param  reference the reference buffer
+       *  @param  size the reference buffer size
+       *  @param  function the function to call with the contents
+       */
+      bool read(const char *reference, size_t size, ReadFunction function);
+
+    private:
+      /**
+       *  @brief  Get an opened ring, open it on first use. Returns nullptr if the ring can't be opened
+       *
+       *  @param  name the ring name
+       */
+      SharedMemoryRing *openRing(const std::string &name);
+
+    private:
+      typedef std::map<std::string, std::unique_ptr<SharedMemoryRing>> RingMap;
+      RingMap             m_rings = {};            ///< The opened rings
+    };
+
+  }
+
+}
+
+#endif //  SHAREDMEMORY_H
@@ -31,9 +31,14 @@
 // -- dqm4hep headers
 #include <dqm4hep/Internal.h>
 #include <dqm4hep/Signal.h>
+#include <dqm4hep/WsSendQueue.h>
 
 // -- std headers
+#include <deque>
 #include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // -- websocketpp headers
 #include <websocketpp/config/asio_no_tls.hpp>
@@ -57,6 +62,91 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
     
+    /**
+     *  @brief  WsConnectionStats struct
+     *          Sending statistics of a service connection (see WsServer::connectionStats())
+     */
+    struct WsConnectionStats {
+      std::string       m_service = {""};           ///< The service name
+      std::string       m_remote = {""};            ///< The remote endpoint of the connection
+      size_t            m_queueDepth = {0};         ///< The number of messages waiting in the connection queue
+      size_t            m_bufferedAmount = {0};     ///< The number of bytes buffered in the connection for writing
+      uint64_t          m_nSent = {0};              ///< The number of messages sent to the connection
+      uint64_t          m_nDropped = {0};           ///< The number of messages dropped because the queue was full
+    };
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    /**
+     *  @brief  WsBinaryFrame struct
+     *          The compact framing of the clients subscribing with binary frames.
+     *          A frame reads: service id (varint), flags (1 byte), payload.
+     *          Varints are unsigned LEB128: 7 bits per byte, low bits first.
+     *          The service id is assigned by the server (see WsService::id()).
+     *          The id 0 is reserved for control frames, for which the flags give the type:
+     *          - SUBSCRIBE (client -> server), payload: the service name
+     *          - UNSUBSCRIBE (client -> server), payload: the service id as varint
+     *          - SUBSCRIBED (server -> client), payload: the service id as varint and the service name
+     *          The service updates are sent with the service id and the UPDATE flags.
+     */
+    struct WsBinaryFrame {
+      /**
+       *  @brief  Flags enumerator
+       */
+      enum Flags : unsigned char {
+        UPDATE = 0,         ///< Service update
+        SUBSCRIBE = 1,      ///< Subscribe to a service by name
+        UNSUBSCRIBE = 2,    ///< Unsubscribe from a service by id
+        SUBSCRIBED = 3      ///< Subscription acknowledgment, gives the service id
+      };
+      
+      /**
+       *  @brief  Append a varint to the output
+       *
+       *  @param  output the output to append to
+       *  @param  value the value to write
+       */
+      static void writeVarint(std::string &output, uint32_t value);
+      
+      /**
+       *  @brief  Read a varint. On success, the buffer is moved after the varint
+       *
+       *  @param  buffer the buffer to read from
+       *  @param  end the end of the buffer
+       *  @param  value the value to receive
+       *  @return false if the varint is truncated or overflows 32 bits
+       */
+      static bool readVarint(const char *&buffer, const char *end, uint32_t &value);
+      
+      /**
+       *  @brief  Append a frame to the output
+       *
+       *  @param  output the output to append to
+       *  @param  serviceId the service id (0 for control frames)
+       *  @param  flags the frame flags
+       *  @param  payload the frame payload
+       *  @param  size the payload size
+       */
+      static void write(std::string &output, uint32_t serviceId, Flags flags, const char *payload, size_t size);
+      
+      /**
+       *  @brief  Read a frame. The payload points inside the buffer
+       *
+       *  @param  buffer the frame buffer
+       *  @param  size the frame size
+       *  @param  serviceId the service id to receive
+       *  @param  flags the frame flags to receive
+       *  @param  payload the frame payload to receive
+       *  @param  payloadSize the payload size to receive
+       *  @return false if the frame is malformed
+       */
+      static bool read(const char *buffer, size_t size, uint32_t &serviceId, Flags &flags, const char *&payload, size_t &payloadSize);
+    };
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
     /**
      *  @brief  ServiceType enumerator
      */
@@ -134,8 +224,14 @@ namespace dqm4hep {
        *
        *  @param  s the server owning the service
        *  @param  n the service name
+       *  @param  i the service id in the binary framing
+       */
+      WsService(WsServer *s, const std::string &n, uint32_t i);
+      
+      /**
+       *  @brief  Get the service id used in the binary framing (see WsBinaryFrame)
        */
-      WsService(WsServer *s, const std::string &n);
+      uint32_t id() const;
       
       /**
        *  @brief  Send data to all listening clients.
@@ -160,6 +256,10 @@ namespace dqm4hep {
        *  @param  containsBinary whether the buffer contains binary data
        */
       void send(const char *buffer, size_t size, bool containsBinary = false);
+      
+    private:
+      /// The service id in the binary framing
+      uint32_t               m_id = {0};
     };
     
     //-------------------------------------------------------------------------------------------------
@@ -241,6 +341,17 @@ namespace dqm4hep {
      *  - create services to broadcast data to all clients
      *  - receive commands from clients
      *  - receive requests from clients
+     *
+     *  The server runs on a pool of threads (see setNThreads()).
+     *  Command and request handlers are called one at a time, synchronized 
+     *  with the synchronize() method. Service updates are framed once and the
+     *  same frame is shared by all the subscribed connections. Each connection
+     *  writes at its own pace: when a connection already buffers more than
+     *  setMaxBufferedAmount() bytes, the updates wait in a queue of the connection.
+     *  When this queue is full the oldest update is dropped, so that a slow
+     *  client never stalls the others.
+     *  Clients subscribing with a binary frame use the WsBinaryFrame framing
+     *  and can subscribe to several services on the same connection.
      */
     class WsServer {
       WsServer(const WsServer&) = delete;
@@ -266,6 +377,36 @@ namespace dqm4hep {
        */
       void setPort(int port);
       
+      /**
+       *  @brief  Set the number of threads running the server.
+       *          Can be done only before calling start().
+       *          The default is the number of hardware threads
+       *
+       *  @param  nThreads the number of threads
+       */
+      void setNThreads(unsigned int nThreads);
+      
+      /**
+       *  @brief  Set the maximum number of service updates waiting in the queue 
+       *          of a connection. The oldest updates are dropped first. Default is 16
+       *
+       *  @param  maxSize the maximum queue size
+       */
+      void setMaxQueueSize(size_t maxSize);
+      
+      /**
+       *  @brief  Set the number of bytes a connection can buffer for writing before
+       *          service updates are queued. Default is 1 Mo
+       *
+       *  @param  amount the maximum buffered amount in bytes
+       */
+      void setMaxBufferedAmount(size_t amount);
+      
+      /**
+       *  @brief  Get the sending statistics of the service connections
+       */
+      std::vector<WsConnectionStats> connectionStats() const;
+      
       /**
        *  @brief  Create a new service.
        *          If the service already exists, a nullptr is returned.
@@ -320,7 +461,7 @@ namespace dqm4hep {
       /**
        *  @brief  Start the server. 
        *          Start listening to client connections.
-       *          Note that the server is started in a separate thread.
+       *          Note that the server is started in separate threads.
        *          To synchronize an operation with the server to avoid
        *          data race condition, use the synchronize() method.
        */
@@ -328,7 +469,7 @@ namespace dqm4hep {
       
       /**
        *  @brief  Stop the server.
-       *          The server thread is stopped and client connections
+       *          The server threads are stopped and client connections
        *          closed. The list of services, command and request handlers
        *          are NOT cleared and can be re-used. The server can be re-started
        *          using the start() method again.
@@ -336,7 +477,7 @@ namespace dqm4hep {
       void stop();
       
       /**
-       *  @brief  Synchronize a user operation with the server thread.
+       *  @brief  Synchronize a user operation with the command and request handlers.
        *  
        *  This can be used for updating shared data between the user
        *  code and the request and command handlers. Typical use is by
@@ -356,29 +497,61 @@ namespace dqm4hep {
       void synchronize(Operation operation);
       
     private:
+      /**
+       *  @brief  ConnectionQueue struct
+       *          The outbound queue of service updates of a connection
+       */
+      struct ConnectionQueue {
+        std::mutex                  m_mutex = {};           ///< The queue mutex
+        WsSendQueue<message_ptr>    m_messages = {};        ///< The updates waiting to be sent
+        bool                        m_sharedFrames = {false}; ///< Whether the connection accepts the shared frames
+        bool                        m_binary = {false};     ///< Whether the connection uses the binary framing
+      };
+      typedef std::shared_ptr<ConnectionQueue> ConnectionQueuePtr;
+      typedef std::map<server::connection_ptr, ConnectionQueuePtr> ConnectionQueueMap;
+
       void onOpen(connection_hdl hdl);
       void onClose(connection_hdl hdl);
       void onMessage(connection_hdl hdl, message_ptr msg);
       void send(WsService *service, const char *buffer, size_t size, bool containsBinary);
       void onServiceMessage(const std::string &serviceName, connection_hdl hdl, message_ptr msg);
+      void onBinaryServiceMessage(connection_hdl hdl, message_ptr msg);
+      WsService *findService(uint32_t id);
       void onCommandMessage(const std::string &serviceName, connection_hdl hdl, message_ptr msg);
       void onRpcMessage(const std::string &serviceName, connection_hdl hdl, message_ptr msg);
+      void flushQueue(const server::connection_ptr &con, ConnectionQueue &queue);
+      void flushQueues();
+      void scheduleFlush();
 
     private:
       /// The list of service connections
       connection_map             m_serviceConnections = {};
+      /// The outbound queues of the service connections
+      ConnectionQueueMap         m_connectionQueues = {};
       /// The real server implementation
       server                     m_server;
       /// The server port on which to listen
       int                        m_port = {5555};
-      /// The server thread in which it runs
-      std::thread                m_thread = {};
+      /// The number of threads running the server
+      unsigned int               m_nThreads = {1};
+      /// The maximum number of updates in a connection queue
+      std::atomic<size_t>        m_maxQueueSize = {16};
+      /// The maximum number of bytes buffered by a connection before queuing
+      std::atomic<size_t>        m_maxBufferedAmount = {1024*1024};
+      /// The server threads in which it runs
+      std::vector<std::thread>   m_threads = {};
       /// The map of all services (services, command and request handlers)
       ServiceMap                 m_serviceMap = {};
+      /// The id of the next created service
+      uint32_t                   m_nextServiceId = {1};
       /// Whether the server is running
       std::atomic_bool           m_running = {false};
+      /// Whether a flush of the connection queues is scheduled
+      std::atomic_bool           m_flushScheduled = {false};
       /// The mutex to synchronize operations
       std::recursive_mutex       m_mutex = {};
+      /// The mutex protecting the service connections and their queues
+      mutable std::mutex         m_connectionMutex = {};
     };
     
     //-------------------------------------------------------------------------------------------------
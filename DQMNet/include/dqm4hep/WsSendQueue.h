@@ -0,0 +1,173 @@
+/// \file WsSendQueue.h
+/*
+ *
+ * WsSendQueue.h header template automatically generated by a class generator
+ * Creation date : sam. oct. 17 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ * 
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ * 
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+#ifndef DQM4HEP_WSSENDQUEUE_H
+#define DQM4HEP_WSSENDQUEUE_H
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+
+// -- std headers
+#include <algorithm>
+#include <deque>
+#include <functional>
+
+namespace dqm4hep {
+
+  namespace net {
+
+    /**
+     *  @brief  WsSendQueue class
+     *          The outbound queue of the service updates of a websocket connection.
+     *          Updates are written while the connection buffers less than a maximum
+     *          amount of bytes, the others wait in the queue. When the queue is full,
+     *          the oldest update is dropped, so that a slow client never stalls the others.
+     *          Not thread safe: the caller protects the queue.
+     *          The message type is a template parameter so that the policy can be
+     *          used without a websocket connection
+     */
+    template <typename Message>
+    class WsSendQueue {
+    public:
+      /**
+       *  @brief  The function writing a message to the connection. Returns false on error
+       */
+      typedef std::function<bool(const Message &)> SendFunction;
+
+      /**
+       *  @brief  The function getting the number of bytes buffered by the connection
+       */
+      typedef std::function<size_t()> BufferedAmountFunction;
+
+      /**
+       *  @brief  Push a message at the end of the queue.
+       *          The oldest messages are dropped to keep at most maxSize messages
+       *
+       *  @param  message the message to push
+       *  @param  maxSize the maximum queue size (at least 1)
+       */
+      void push(const Message &message, size_t maxSize);
+
+      /**
+       *  @brief  Write the queued messages in order while the connection buffers
+       *          less than maxBufferedAmount bytes. A message failing to be written
+       *          is counted as dropped
+       *
+       *  @param  maxBufferedAmount the maximum number of bytes buffered by the connection
+       *  @param  bufferedAmount the function getting the connection buffered amount
+       *  @param  send the function writing a message to the connection
+       */
+      void flush(size_t maxBufferedAmount, BufferedAmountFunction bufferedAmount, SendFunction send);
+
+      /**
+       *  @brief  Get the number of queued messages
+       */
+      size_t size() const;
+
+      /**
+       *  @brief  Whether the queue is empty
+       */
+      bool empty() const;
+
+      /**
+       *  @brief  Get the number of messages written to the connection
+       */
+      uint64_t nSent() const;
+
+      /**
+       *  @brief  Get the number of messages dropped (queue full or write error)
+       */
+      uint64_t nDropped() const;
+
+    private:
+      std::deque<Message>         m_messages = {};        ///< The messages waiting to be sent
+      uint64_t                    m_nSent = {0};          ///< The number of messages sent
+      uint64_t                    m_nDropped = {0};       ///< The number of messages dropped
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename Message>
+    inline void WsSendQueue<Message>::push(const Message &message, size_t maxSize) {
+      maxSize = std::max(size_t(1), maxSize);
+      // the maximum size may have been lowered since the last push
+      while(m_messages.size() >= maxSize) {
+        m_messages.pop_front();
+        m_nDropped++;
+      }
+      m_messages.push_back(message);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename Message>
+    inline void WsSendQueue<Message>::flush(size_t maxBufferedAmount, BufferedAmountFunction bufferedAmount, SendFunction send) {
+      while(not m_messages.empty() and bufferedAmount() < maxBufferedAmount) {
+        const bool sent = send(m_messages.front());
+        m_messages.pop_front();
+        if(not sent) {
+          m_nDropped++;
+          continue;
+        }
+        m_nSent++;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename Message>
+    inline size_t WsSendQueue<Message>::size() const {
+      return m_messages.size();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename Message>
+    inline bool WsSendQueue<Message>::empty() const {
+      return m_messages.empty();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename Message>
+    inline uint64_t WsSendQueue<Message>::nSent() const {
+      return m_nSent;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename Message>
+    inline uint64_t WsSendQueue<Message>::nDropped() const {
+      return m_nDropped;
+    }
+
+  }
+
+}
+
+#endif  //  DQM4HEP_WSSENDQUEUE_H
@@ -0,0 +1,556 @@
+/// \file dqm4hep-net-bench.cc
+/*
+ *
+ * dqm4hep-net-bench.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/Client.h"
+#include "dqm4hep/DQM4hepConfig.h"
+#include "dqm4hep/Server.h"
+#include "dqm4hep/Service.h"
+
+// -- tclap headers
+#include "tclap/Arg.h"
+#include "tclap/CmdLine.h"
+
+// -- std headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <signal.h>
+#include <thread>
+#include <vector>
+
+using namespace dqm4hep::net;
+using namespace dqm4hep::core;
+
+// Network benchmark of the DQMNet service, request and command paths.
+// Run the server and the client on the same host: the latencies are computed
+// from the steady clock timestamps embedded in the messages.
+//
+//   dqm4hep-net-bench server --services 4 --size 1024 --rate 1000
+//   dqm4hep-net-bench client --mode service --parallel 8 --duration 10
+//   dqm4hep-net-bench client --mode rpc --size 4096 --parallel 8
+//   dqm4hep-net-bench client --mode command --size 256 --rate 50000 --batching
+
+std::atomic_bool running(true);
+
+//-------------------------------------------------------------------------------------------------
+
+// key interrupt signal handling
+void int_key_signal_handler(int) {
+  std::cout << std::endl;
+  running = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  BenchMessage struct.
+ *          Header written at the start of each message: sequence number
+ *          and steady clock timestamp (ns), host byte order
+ */
+struct BenchMessage {
+  static const size_t headerSize = 16;
+
+  static void write(char *buffer, uint64_t sequence) {
+    const int64_t timestamp(now());
+    memcpy(buffer, &sequence, 8);
+    memcpy(buffer + 8, &timestamp, 8);
+  }
+
+  static bool read(const char *buffer, size_t size, uint64_t &sequence, int64_t &timestamp) {
+    if (nullptr == buffer || size < headerSize)
+      return false;
+
+    memcpy(&sequence, buffer, 8);
+    memcpy(&timestamp, buffer + 8, 8);
+    return true;
+  }
+
+  static int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  BenchStats class.
+ *          Message, byte and latency counters. Thread safe
+ */
+class BenchStats {
+public:
+  void add(size_t size, int64_t timestamp) {
+    const double latency((BenchMessage::now() - timestamp) / 1000.);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_nMessages++;
+    m_nBytes += size;
+    m_latencies.push_back(latency);
+  }
+
+  void addLost(uint64_t nLost) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_nLost += nLost;
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_nMessages = 0;
+    m_nBytes = 0;
+    m_nLost = 0;
+    m_latencies.clear();
+  }
+
+  json toJson() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::sort(m_latencies.begin(), m_latencies.end());
+    return {{"messages", m_nMessages}, {"bytes", m_nBytes}, {"lost", m_nLost},
+            {"p50", percentile(0.5)}, {"p99", percentile(0.99)}, {"p999", percentile(0.999)}};
+  }
+
+  static void print(const std::string &title, const json &stats, double seconds) {
+    const double nMessages(stats.value("messages", 0.));
+    const double nBytes(stats.value("bytes", 0.));
+
+    std::cout << std::fixed << std::setprecision(1) << "=== " << title << " ===" << std::endl
+              << "  messages     : " << stats.value("messages", 0) << " (" << nMessages / seconds << " msgs/s)" << std::endl
+              << "  throughput   : " << nBytes / seconds / (1024. * 1024.) << " MB/s" << std::endl
+              << "  lost         : " << stats.value("lost", 0) << std::endl
+              << "  latency (us) : p50 " << stats.value("p50", 0.) << ", p99 " << stats.value("p99", 0.) << ", p999 "
+              << stats.value("p999", 0.) << std::endl;
+  }
+
+private:
+  double percentile(double p) const {
+    if (m_latencies.empty())
+      return 0.;
+
+    return m_latencies[std::min(m_latencies.size() - 1, size_t(p * m_latencies.size()))];
+  }
+
+private:
+  uint64_t              m_nMessages = {0};
+  uint64_t              m_nBytes = {0};
+  uint64_t              m_nLost = {0};
+  std::vector<double>   m_latencies = {};
+  std::mutex            m_mutex = {};
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  RateLimiter class.
+ *          Paces a sending loop at a given rate (0: no limit)
+ */
+class RateLimiter {
+public:
+  RateLimiter(double rate) : m_rate(rate), m_next(std::chrono::steady_clock::now()) {}
+
+  void wait() {
+    if (m_rate <= 0.)
+      return;
+
+    m_next += std::chrono::nanoseconds(static_cast<int64_t>(1e9 / m_rate));
+    std::this_thread::sleep_until(m_next);
+  }
+
+private:
+  double                                   m_rate;
+  std::chrono::steady_clock::time_point    m_next;
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  BenchServer class.
+ *          Publishes the benchmark services, echoes the requests and measures the commands
+ */
+class BenchServer {
+public:
+  BenchServer(const std::string &name) : m_server(name) {}
+
+  void echo(const Buffer &request, Buffer &response) {
+    response.adopt(request.begin(), request.size());
+  }
+
+  void command(const Buffer &command) {
+    uint64_t sequence(0);
+    int64_t timestamp(0);
+
+    if (BenchMessage::read(command.begin(), command.size(), sequence, timestamp))
+      m_commandStats.add(command.size(), timestamp);
+  }
+
+  void stats(const Buffer &request, Buffer &response) {
+    if (std::string(request.begin(), request.size()) == "reset") {
+      m_commandStats.reset();
+      return;
+    }
+
+    auto model = response.createModel<std::string>();
+    model->move(m_commandStats.toJson().dump());
+    response.setModel(model);
+  }
+
+  int run(unsigned int nServices, size_t size, double rate, const std::string &codec, unsigned int sharedMemory) {
+    const std::string prefix("/" + m_server.name());
+    std::vector<Service *> services;
+
+    for (unsigned int s = 0; s < nServices; s++) {
+      Service *pService = m_server.createService(prefix + "/service/" + std::to_string(s));
+
+      if (codec != "none")
+        pService->setCodec(Codec::fromString(codec));
+
+      if (sharedMemory > 0)
+        pService->setSharedMemory(sharedMemory, std::max(size, size_t(1024)));
+
+      services.push_back(pService);
+    }
+
+    m_server.createRequestHandler(prefix + "/rpc", this, &BenchServer::echo);
+    m_server.createRequestHandler(prefix + "/stats", this, &BenchServer::stats);
+    m_server.createCommandHandler(prefix + "/command", this, &BenchServer::command);
+    m_server.start();
+
+    std::cout << "Server '" << m_server.name() << "' running: " << nServices << " service(s), " << size
+              << " bytes at " << rate << " msgs/s per service" << std::endl;
+
+    // same payload for all the services, only the header changes
+    std::string message(std::max(size, BenchMessage::headerSize), 'x');
+    RateLimiter limiter(rate);
+    uint64_t sequence(0);
+
+    while (running) {
+      if (nServices > 0) {
+        BenchMessage::write(&message[0], sequence++);
+
+        for (auto pService : services)
+          pService->sendBuffer(message.data(), message.size());
+
+        limiter.wait();
+      } else
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    m_server.stop();
+    return 0;
+  }
+
+private:
+  Server           m_server;
+  BenchStats       m_commandStats = {};
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  ServiceReceiver class.
+ *          Measures the updates of a service subscription
+ */
+class ServiceReceiver {
+public:
+  ServiceReceiver(BenchStats &stats) : m_stats(stats) {}
+
+  void receive(const Buffer &buffer) {
+    uint64_t sequence(0);
+    int64_t timestamp(0);
+
+    if (!BenchMessage::read(buffer.begin(), buffer.size(), sequence, timestamp))
+      return;
+
+    // dim sends the latest value: updates may be skipped, not reordered
+    if (m_started && sequence > m_lastSequence + 1)
+      m_stats.addLost(sequence - m_lastSequence - 1);
+
+    m_started = true;
+    m_lastSequence = sequence;
+    m_stats.add(buffer.size(), timestamp);
+  }
+
+private:
+  BenchStats      &m_stats;
+  bool             m_started = {false};
+  uint64_t         m_lastSequence = {0};
+};
+
+//-------------------------------------------------------------------------------------------------
+
+void waitFor(double duration) {
+  const auto end(std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<int64_t>(duration * 1000)));
+
+  while (running && std::chrono::steady_clock::now() < end)
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int runServiceClient(const std::string &serverName, unsigned int nServices, unsigned int parallel, double duration) {
+  BenchStats stats;
+  std::vector<std::unique_ptr<Client>> clients;
+  std::vector<std::unique_ptr<ServiceReceiver>> receivers;
+
+  // fan-out: each client subscribes to all the services
+  for (unsigned int c = 0; c < parallel; c++) {
+    clients.emplace_back(new Client());
+
+    for (unsigned int s = 0; s < nServices; s++) {
+      receivers.emplace_back(new ServiceReceiver(stats));
+      clients.back()->subscribe("/" + serverName + "/service/" + std::to_string(s), receivers.back().get(), &ServiceReceiver::receive);
+    }
+  }
+
+  // skip the initial updates
+  waitFor(1.);
+  stats.reset();
+  const auto start(std::chrono::steady_clock::now());
+  waitFor(duration);
+  const double seconds(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+  BenchStats::print("service: " + std::to_string(nServices) + " service(s) x " + std::to_string(parallel) + " subscriber(s)",
+                    stats.toJson(), seconds);
+  clients.clear();
+  return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int runRequestClient(const std::string &serverName, size_t size, double rate, unsigned int parallel, double duration) {
+  BenchStats stats;
+  Client client;
+  const std::string requestName("/" + serverName + "/rpc");
+  std::string message(std::max(size, BenchMessage::headerSize), 'x');
+  Buffer request;
+  request.adopt(message.data(), message.size());
+  RateLimiter limiter(rate);
+  uint64_t sequence(0);
+
+  // parallel requests in flight, matched by the client using the request header
+  unsigned int nInFlight(0);
+  std::mutex mutex;
+  std::condition_variable condition;
+
+  const auto start(std::chrono::steady_clock::now());
+  const auto end(start + std::chrono::milliseconds(static_cast<int64_t>(duration * 1000)));
+
+  while (running && std::chrono::steady_clock::now() < end) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [&]() { return nInFlight < parallel; });
+      nInFlight++;
+    }
+
+    BenchMessage::write(&message[0], sequence++);
+
+    client.sendRequestAsync(requestName, request, [&](StatusCode status, const Buffer &response) {
+      uint64_t responseSequence(0);
+      int64_t timestamp(0);
+
+      if (STATUS_CODE_SUCCESS == status && BenchMessage::read(response.begin(), response.size(), responseSequence, timestamp))
+        stats.add(response.size(), timestamp);
+      else
+        stats.addLost(1);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      nInFlight--;
+      condition.notify_one();
+    }, 5000);
+
+    limiter.wait();
+  }
+
+  const double seconds(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [&]() { return 0 == nInFlight; });
+  }
+
+  BenchStats::print("rpc: " + std::to_string(size) + " bytes x " + std::to_string(parallel) + " in flight, round trip",
+                    stats.toJson(), seconds);
+  return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int runCommandClient(const std::string &serverName, size_t size, double rate, unsigned int parallel, double duration,
+                     bool batching, const std::string &codec) {
+  Client client;
+  const std::string commandName("/" + serverName + "/command");
+  const std::string statsName("/" + serverName + "/stats");
+
+  if (batching)
+    client.setCommandBatching();
+
+  if (codec != "none")
+    client.setCommandCodec(Codec::fromString(codec));
+
+  std::string reset("reset");
+  Buffer resetRequest;
+  resetRequest.adopt(reset.data(), reset.size());
+  client.sendRequest(statsName, resetRequest, [](const Buffer &) {});
+
+  std::atomic_bool stopFlag(false);
+  std::atomic<uint64_t> nSent(0);
+  std::vector<std::thread> threads;
+  const auto start(std::chrono::steady_clock::now());
+
+  for (unsigned int t = 0; t < parallel; t++) {
+    threads.push_back(std::thread([&]() {
+      std::string message(std::max(size, BenchMessage::headerSize), 'x');
+      Buffer command;
+      command.adopt(message.data(), message.size());
+      RateLimiter limiter(rate / parallel);
+      uint64_t sequence(0);
+
+      while (!stopFlag) {
+        BenchMessage::write(&message[0], sequence++);
+        client.sendCommand(commandName, command);
+        nSent++;
+        limiter.wait();
+      }
+    }));
+  }
+
+  waitFor(duration);
+  stopFlag = true;
+
+  for (auto &thread : threads)
+    thread.join();
+
+  const double seconds(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+  // let the last commands arrive
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  json stats;
+  Buffer statsRequest;
+  client.sendRequest(statsName, statsRequest, [&stats](const Buffer &response) {
+    if (response.size() > 0)
+      stats = json::parse(response.begin(), response.end(), nullptr, false);
+  });
+
+  if (!stats.is_object()) {
+    std::cout << "Couldn't get the command statistics from the server" << std::endl;
+    return 1;
+  }
+
+  stats["lost"] = nSent.load() - stats.value("messages", uint64_t(0));
+  BenchStats::print("command: " + std::to_string(size) + " bytes x " + std::to_string(parallel) + " thread(s), one way" +
+                    (batching ? ", batched" : ""), stats, seconds);
+  return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[]) {
+  std::string cmdLineFooter = "Please report bug to <dqm4hep@gmail.com>";
+  TCLAP::CmdLine *pCommandLine = new TCLAP::CmdLine(cmdLineFooter, ' ', DQM4hep_VERSION_STR);
+
+  std::vector<std::string> roles = {"server", "client"};
+  TCLAP::ValuesConstraint<std::string> roleConstraint(roles);
+  TCLAP::UnlabeledValueArg<std::string> roleArg("role", "Run the benchmark server or client", true, "client", &roleConstraint);
+  pCommandLine->add(roleArg);
+
+  TCLAP::ValueArg<std::string> nameArg("n", "name", "The benchmark server name", false, "NetBench", "string");
+  pCommandLine->add(nameArg);
+
+  std::vector<std::string> modes = {"service", "rpc", "command"};
+  TCLAP::ValuesConstraint<std::string> modeConstraint(modes);
+  TCLAP::ValueArg<std::string> modeArg("m", "mode", "The path to measure (client)", false, "service", &modeConstraint);
+  pCommandLine->add(modeArg);
+
+  TCLAP::ValueArg<unsigned int> sizeArg("s", "size", "The message size in bytes (at least 16)", false, 1024, "unsigned int");
+  pCommandLine->add(sizeArg);
+
+  TCLAP::ValueArg<double> rateArg("r", "rate",
+                                  "The message rate in msgs/s: per service (server) or in total (client). 0 for no limit",
+                                  false, 0., "double");
+  pCommandLine->add(rateArg);
+
+  TCLAP::ValueArg<unsigned int> servicesArg("f", "services", "The number of published services", false, 1, "unsigned int");
+  pCommandLine->add(servicesArg);
+
+  TCLAP::ValueArg<unsigned int> parallelArg(
+      "p", "parallel", "The number of subscribers per service (service), of requests in flight (rpc) or of sending threads (command)", false, 1,
+      "unsigned int");
+  pCommandLine->add(parallelArg);
+
+  TCLAP::ValueArg<double> durationArg("d", "duration", "The measurement duration in seconds (client)", false, 10., "double");
+  pCommandLine->add(durationArg);
+
+  TCLAP::SwitchArg batchingArg("b", "batching", "Batch the commands (client, command mode)", false);
+  pCommandLine->add(batchingArg);
+
+  std::vector<std::string> codecs = {"none", "zlib", "lz4", "zstd"};
+  TCLAP::ValuesConstraint<std::string> codecConstraint(codecs);
+  TCLAP::ValueArg<std::string> codecArg("z", "codec", "The codec of the services (server) or of the commands (client)",
+                                        false, "none", &codecConstraint);
+  pCommandLine->add(codecArg);
+
+  TCLAP::ValueArg<unsigned int> sharedMemoryArg(
+      "x", "shared-memory", "The number of shared memory slots of the services, 0 to disable (server)", false, 0,
+      "unsigned int");
+  pCommandLine->add(sharedMemoryArg);
+
+  // parse command line
+  pCommandLine->parse(argc, argv);
+
+  // install signal handlers
+  signal(SIGINT, int_key_signal_handler);
+
+  const std::string serverName(nameArg.getValue());
+
+  if ("server" == roleArg.getValue()) {
+    BenchServer server(serverName);
+    return server.run(servicesArg.getValue(), sizeArg.getValue(), rateArg.getValue(), codecArg.getValue(),
+                      sharedMemoryArg.getValue());
+  }
+
+  if (!Server::isServerRunning(serverName)) {
+    std::cout << "Benchmark server '" << serverName << "' is not running" << std::endl;
+    return 1;
+  }
+
+  if ("service" == modeArg.getValue())
+    return runServiceClient(serverName, servicesArg.getValue(), parallelArg.getValue(), durationArg.getValue());
+
+  if ("rpc" == modeArg.getValue())
+    return runRequestClient(serverName, sizeArg.getValue(), rateArg.getValue(), parallelArg.getValue(), durationArg.getValue());
+
+  return runCommandClient(serverName, sizeArg.getValue(), rateArg.getValue(), parallelArg.getValue(), durationArg.getValue(),
+                          batchingArg.getValue(), codecArg.getValue());
+}
@@ -0,0 +1,230 @@
+/// \file dqm4hep-request-benchmark.cc
+/*
+ *
+ * dqm4hep-request-benchmark.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/Client.h"
+#include "dqm4hep/Server.h"
+
+// -- std headers
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// -- unix headers
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace dqm4hep::net;
+
+// Measures the latency of a cheap request handler while an expensive
+// request handler of the same server is busy. The server and the client
+// keeping the expensive handler busy run in child processes. The expensive
+// handler runs with the execution given as argument:
+//  - inline:   in the dim server thread, the cheap requests wait for it
+//  - thread:   in a dedicated thread
+//  - pool:     in the shared pool
+//  - deferred: in the dim server thread, completed later from another thread
+
+static const std::string serverName = "RequestBenchmark";
+static const std::string fastRequestName = "/RequestBenchmark/fast";
+static const std::string slowRequestName = "/RequestBenchmark/slow";
+
+class BenchmarkHandlers {
+public:
+  BenchmarkHandlers(unsigned int slowTime) : m_slowTime(slowTime) {}
+
+  void fast(const Buffer &request, Buffer &response) {
+    response.adopt(request.begin(), request.size());
+  }
+
+  void slow(const Buffer &request, Buffer &response) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(m_slowTime));
+    auto model = response.createModel<std::string>();
+    model->copy(request.begin(), request.size());
+    response.setModel(model);
+  }
+
+  void slowDeferred(const Buffer &request, DeferredResponse response) {
+    std::string contents(request.begin(), request.size());
+    unsigned int slowTime(m_slowTime);
+
+    // complete the response out of the dim server thread
+    std::thread([response, contents, slowTime]() mutable {
+      std::this_thread::sleep_for(std::chrono::milliseconds(slowTime));
+      response.send(contents.data(), contents.size());
+    }).detach();
+  }
+
+private:
+  unsigned int m_slowTime;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+int runServer(const std::string &mode, unsigned int slowTime) {
+  BenchmarkHandlers handlers(slowTime);
+  Server server(serverName);
+
+  server.createRequestHandler(fastRequestName, &handlers, &BenchmarkHandlers::fast);
+
+  if ("deferred" == mode)
+    server.createRequestHandler(slowRequestName, &handlers, &BenchmarkHandlers::slowDeferred);
+  else {
+    RequestHandler::Execution execution("thread" == mode ? RequestHandler::DEDICATED_THREAD
+                                                         : "pool" == mode ? RequestHandler::SHARED_POOL
+                                                                          : RequestHandler::INLINE);
+    server.createRequestHandler(slowRequestName, &handlers, &BenchmarkHandlers::slow, execution);
+  }
+
+  server.start();
+
+  while (1)
+    sleep(1);
+
+  return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int runSlowClient(int startPipe) {
+  // wait for the start signal
+  char start(0);
+
+  if (read(startPipe, &start, 1) != 1)
+    return 1;
+
+  Client client;
+  std::string contents("slow");
+  Buffer request;
+  request.adopt(contents.data(), contents.size());
+
+  while (1)
+    client.sendRequest(slowRequestName, request, [](const Buffer &) {});
+
+  return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::vector<double> measureLatencies(Client &client, unsigned int nRequests) {
+  std::vector<double> latencies;
+  std::string contents("ping");
+  Buffer request;
+  request.adopt(contents.data(), contents.size());
+
+  for (unsigned int r = 0; r < nRequests; r++) {
+    auto start = std::chrono::steady_clock::now();
+    client.sendRequest(fastRequestName, request, [](const Buffer &) {});
+    auto end = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  return latencies;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void printLatencies(const std::string &title, const std::vector<double> &latencies) {
+  double sum(0.);
+
+  for (auto latency : latencies)
+    sum += latency;
+
+  auto percentile = [&latencies](double p) { return latencies[std::min(latencies.size() - 1, size_t(p * latencies.size()))]; };
+
+  std::cout << std::fixed << std::setprecision(3) << std::setw(24) << std::left << title
+            << " mean: " << sum / latencies.size() << " ms, p50: " << percentile(0.5) << " ms, p99: " << percentile(0.99)
+            << " ms, max: " << latencies.back() << " ms" << std::endl;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::cout << "Usage : dqm4hep-request-benchmark inline|thread|pool|deferred [slowTimeMs] [nRequests]" << std::endl;
+    return 1;
+  }
+
+  const std::string mode(argv[1]);
+  const unsigned int slowTime(argc > 2 ? atoi(argv[2]) : 200);
+  const unsigned int nRequests(argc > 3 ? atoi(argv[3]) : 200);
+
+  if ("inline" != mode && "thread" != mode && "pool" != mode && "deferred" != mode) {
+    std::cout << "Invalid execution mode '" << mode << "'" << std::endl;
+    return 1;
+  }
+
+  // fork before any dim call in this process
+  int startPipe[2];
+
+  if (0 != pipe(startPipe))
+    return 1;
+
+  pid_t serverPid = fork();
+
+  if (0 == serverPid)
+    return runServer(mode, slowTime);
+
+  pid_t slowClientPid = fork();
+
+  if (0 == slowClientPid)
+    return runSlowClient(startPipe[0]);
+
+  while (!Server::isServerRunning(serverName))
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  Client client;
+  std::cout << "Execution: " << mode << ", slow handler: " << slowTime << " ms, " << nRequests << " requests" << std::endl;
+
+  // warm up
+  measureLatencies(client, 10);
+  printLatencies("idle", measureLatencies(client, nRequests));
+
+  // keep the slow handler busy
+  const char start(1);
+
+  if (write(startPipe[1], &start, 1) == 1) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(slowTime / 2));
+    printLatencies("slow handler busy", measureLatencies(client, nRequests));
+  }
+
+  kill(slowClientPid, SIGTERM);
+  waitpid(slowClientPid, nullptr, 0);
+
+  // let the last slow request complete
+  std::this_thread::sleep_for(std::chrono::milliseconds(slowTime));
+  kill(serverPid, SIGTERM);
+  waitpid(serverPid, nullptr, 0);
+
+  return 0;
+}
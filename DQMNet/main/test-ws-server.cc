@@ -80,8 +80,17 @@ int main(int argc, char **argv) {
 
   int intVal = rand();
   float floatVal = intVal * 0.78;
+  unsigned int loop = 0;
 
   while (1) {
+    // report the connection queues every 10 seconds
+    if(0 == (++loop % 100)) {
+      for(auto &stats : aServer->connectionStats()) {
+        std::cout << stats.m_service << " " << stats.m_remote << ": queue depth " << stats.m_queueDepth 
+                  << ", sent " << stats.m_nSent << ", dropped " << stats.m_nDropped << std::endl;
+      }
+    }
+
     intVal = rand();
     // std::cout << "Sending int = " << intVal << std::endl;
     intService->send(intVal);
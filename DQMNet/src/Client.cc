@@ -28,6 +28,7 @@
 // -- dqm4hep headers
 #include "dqm4hep/Client.h"
 #include "dqm4hep/RequestHandler.h"
+#include "dqm4hep/Logging.h"
 
 namespace dqm4hep {
 
@@ -35,15 +36,36 @@ namespace dqm4hep {
 
     Client::Client() {
       DimClient::setNoDataCopy();
+      // random start, so that request ids of different clients are unlikely to match
+      m_lastRequestId = static_cast<uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count() ^ getpid());
     }
 
     //-------------------------------------------------------------------------------------------------
 
     Client::~Client() {
+      // send the pending batches of commands
+      m_commandBatcher.reset();
+
       for (auto iter = m_serviceHandlerMap.begin(), endIter = m_serviceHandlerMap.end(); endIter != iter; ++iter)
         delete iter->second;
 
       m_serviceHandlerMap.clear();
+
+      if (m_timeoutThread.joinable()) {
+        {
+          std::lock_guard<std::mutex> lock(m_timeoutMutex);
+          m_stopTimeoutThread = true;
+        }
+        m_timeoutCondition.notify_one();
+        m_timeoutThread.join();
+      }
+
+      std::lock_guard<std::mutex> lock(m_channelMutex);
+
+      for (auto iter = m_requestChannels.begin(), endIter = m_requestChannels.end(); endIter != iter; ++iter)
+        delete iter->second;
+
+      m_requestChannels.clear();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -56,6 +78,135 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    uint32_t Client::queryServerInfoAsync(const std::string &serverName, ServerInfoFunction function, unsigned int timeout) {
+      Buffer request;
+      return this->sendRequestAsync("/" + serverName + "/info", request, [function](core::StatusCode statusCode, const Buffer &buffer) {
+        core::json serverInfo;
+
+        if (core::STATUS_CODE_SUCCESS == statusCode) {
+          try {
+            serverInfo = core::json::parse(buffer.begin(), buffer.end());
+          }
+          catch (...) {
+            statusCode = core::STATUS_CODE_FAILURE;
+          }
+        }
+
+        function(statusCode, serverInfo);
+      }, timeout);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t Client::sendRequestAsync(const std::string &name, const Buffer &request, ResponseFunction function, unsigned int timeout) {
+      // 0 is reserved (no link)
+      uint32_t requestId(++m_lastRequestId);
+
+      while (0 == requestId)
+        requestId = ++m_lastRequestId;
+
+      RequestChannel *pChannel = this->requestChannel(name);
+
+      if (0 != timeout)
+        this->scheduleTimeout(timeout);
+
+      pChannel->send(requestId, request, function, timeout);
+      return requestId;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::future<Buffer> Client::sendRequestAsync(const std::string &name, const Buffer &request, unsigned int timeout) {
+      auto promise = std::make_shared<std::promise<Buffer>>();
+      std::future<Buffer> future = promise->get_future();
+
+      this->sendRequestAsync(name, request, [promise](core::StatusCode statusCode, const Buffer &response) {
+        if (core::STATUS_CODE_SUCCESS != statusCode) {
+          promise->set_exception(std::make_exception_ptr(core::StatusCodeException(statusCode)));
+          return;
+        }
+
+        // the response is only valid during the call
+        Buffer copy;
+        auto model = copy.createModel<std::string>();
+        model->copy(response.begin(), response.size());
+        copy.setModel(model);
+        promise->set_value(std::move(copy));
+      }, timeout);
+
+      return future;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Client::cancelRequest(uint32_t requestId) {
+      std::lock_guard<std::mutex> lock(m_channelMutex);
+
+      for (auto iter = m_requestChannels.begin(), endIter = m_requestChannels.end(); endIter != iter; ++iter) {
+        if (iter->second->cancel(requestId))
+          return true;
+      }
+
+      return false;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int Client::numberOfPendingRequests() const {
+      std::lock_guard<std::mutex> lock(m_channelMutex);
+      unsigned int nRequests(0);
+
+      for (auto iter = m_requestChannels.begin(), endIter = m_requestChannels.end(); endIter != iter; ++iter)
+        nRequests += iter->second->numberOfPendingRequests();
+
+      return nRequests;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Client::setCommandBatching(size_t maxSize, unsigned int maxDelay) {
+      m_commandBatcher.reset(new CommandBatcher(maxSize, maxDelay));
+      m_commandBatcher->setCodec(m_commandCodec, m_commandCodecLevel, m_commandCodecMinSize);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Client::commandBatching() const {
+      return (nullptr != m_commandBatcher);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Client::flushCommands() const {
+      if (nullptr != m_commandBatcher)
+        m_commandBatcher->flush();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Client::setCommandCodec(Codec::Type type, int level, size_t minSize) {
+      if (!Codec::isAvailable(type)) {
+        dqm_warning("Client::setCommandCodec: codec '{0}' not available in this build, using zlib", Codec::toString(type));
+        type = Codec::ZLIB;
+        level = 0;
+      }
+
+      m_commandCodec = type;
+      m_commandCodecLevel = level;
+      m_commandCodecMinSize = minSize;
+
+      if (nullptr != m_commandBatcher)
+        m_commandBatcher->setCodec(type, level, minSize);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Codec::Type Client::commandCodec() const {
+      return m_commandCodec;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     bool Client::hasSubscribed(const std::string &name) const {
       return (m_serviceHandlerMap.end() != m_serviceHandlerMap.find(name));
     }
@@ -71,5 +222,105 @@ namespace dqm4hep {
     void Client::notifyServerOnExit(const std::string &serverName) {
       DimClient::setExitHandler(serverName.c_str());
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Client::sendCommandBuffer(const std::string &name, const char *data, size_t size, bool blocking) const {
+      if (nullptr != m_commandBatcher) {
+        if (!blocking) {
+          m_commandBatcher->send(name, data, size);
+          return;
+        }
+
+        // keep the command order
+        m_commandBatcher->flush(name);
+      }
+
+      std::string encoded;
+
+      if (Codec::encode(m_commandCodec, m_commandCodecLevel, m_commandCodecMinSize, data, size, encoded)) {
+        data = encoded.data();
+        size = encoded.size();
+      }
+
+      if (blocking) {
+        DimClient::sendCommand(const_cast<char *>(name.c_str()), (void *)data, size);
+      } else {
+        DimClient::sendCommandNB(const_cast<char *>(name.c_str()), (void *)data, size);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    RequestChannel *Client::requestChannel(const std::string &name) {
+      std::lock_guard<std::mutex> lock(m_channelMutex);
+      auto findIter = m_requestChannels.find(name);
+
+      if (m_requestChannels.end() != findIter)
+        return findIter->second;
+
+      RequestChannel *pChannel = new RequestChannel(this, name);
+      m_requestChannels.insert(RequestChannelMap::value_type(name, pChannel));
+      return pChannel;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Client::scheduleTimeout(unsigned int timeout) {
+      const RequestChannel::TimePoint deadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout));
+      {
+        std::lock_guard<std::mutex> lock(m_timeoutMutex);
+
+        if (!m_timeoutThread.joinable())
+          m_timeoutThread = std::thread(&Client::timeoutThread, this);
+
+        if (deadline >= m_nextDeadline)
+          return;
+
+        m_nextDeadline = deadline;
+      }
+      m_timeoutCondition.notify_one();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Client::timeoutThread() {
+      std::unique_lock<std::mutex> lock(m_timeoutMutex);
+
+      while (!m_stopTimeoutThread) {
+        if (RequestChannel::TimePoint::max() == m_nextDeadline)
+          m_timeoutCondition.wait(lock);
+        else
+          m_timeoutCondition.wait_until(lock, m_nextDeadline);
+
+        if (m_stopTimeoutThread)
+          break;
+
+        const RequestChannel::TimePoint now(std::chrono::steady_clock::now());
+
+        if (now < m_nextDeadline)
+          continue;
+
+        // deadlines scheduled while processing lower the next deadline again
+        m_nextDeadline = RequestChannel::TimePoint::max();
+        lock.unlock();
+
+        std::vector<RequestChannel *> channels;
+        {
+          std::lock_guard<std::mutex> channelLock(m_channelMutex);
+
+          for (auto iter = m_requestChannels.begin(), endIter = m_requestChannels.end(); endIter != iter; ++iter)
+            channels.push_back(iter->second);
+        }
+
+        RequestChannel::TimePoint nextDeadline(RequestChannel::TimePoint::max());
+
+        for (auto pChannel : channels)
+          nextDeadline = std::min(nextDeadline, pChannel->processTimeouts(now));
+
+        lock.lock();
+        m_nextDeadline = std::min(m_nextDeadline, nextDeadline);
+      }
+    }
   }
 }
@@ -0,0 +1,291 @@
+/// \file Codec.cc
+/*
+ *
+ * Codec.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/Codec.h"
+#include "dqm4hep/DQM4hepConfig.h"
+#include "dqm4hep/Logging.h"
+#include "dqm4hep/StatusCodes.h"
+
+// -- compression headers
+#include <zlib.h>
+#ifdef DQM4hep_WITH_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
+#ifdef DQM4hep_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace dqm4hep {
+
+  namespace net {
+
+    static void writeUInt32(char *buffer, uint32_t value) {
+      for (unsigned int i = 0; i < 4; i++)
+        buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static uint32_t readUInt32(const char *buffer) {
+      uint32_t value(0);
+
+      for (unsigned int i = 0; i < 4; i++)
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[i])) << (8 * i);
+
+      return value;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  The pool of decoded buffers, shared by all decoders
+     */
+    static BufferPool &decodePool() {
+      static BufferPool pool(32);
+      return pool;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  Compress the buffer after the header of the output string.
+     *          Returns the compressed size, 0 on failure
+     */
+    static size_t compress(Codec::Type type, int level, const char *buffer, size_t size, std::string &output) {
+      switch (type) {
+      case Codec::ZLIB: {
+        uLongf compressedSize = compressBound(size);
+        output.resize(Codec::headerSize + compressedSize);
+        const int status = compress2((Bytef *)&output[Codec::headerSize], &compressedSize, (const Bytef *)buffer, size,
+                                     (0 == level) ? Z_DEFAULT_COMPRESSION : level);
+        return (Z_OK == status) ? compressedSize : 0;
+      }
+#ifdef DQM4hep_WITH_LZ4
+      case Codec::LZ4: {
+        const int bound = LZ4_compressBound(size);
+        output.resize(Codec::headerSize + bound);
+        const int compressedSize = (level <= 1)
+                                       ? LZ4_compress_default(buffer, &output[Codec::headerSize], size, bound)
+                                       : LZ4_compress_HC(buffer, &output[Codec::headerSize], size, bound, level);
+        return (compressedSize > 0) ? compressedSize : 0;
+      }
+#endif
+#ifdef DQM4hep_WITH_ZSTD
+      case Codec::ZSTD: {
+        const size_t bound = ZSTD_compressBound(size);
+        output.resize(Codec::headerSize + bound);
+        const size_t compressedSize = ZSTD_compress(&output[Codec::headerSize], bound, buffer, size,
+                                                    (0 == level) ? ZSTD_CLEVEL_DEFAULT : level);
+        return ZSTD_isError(compressedSize) ? 0 : compressedSize;
+      }
+#endif
+      default:
+        return 0;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  Decompress the buffer into the output buffer of known size.
+     *          Returns false on failure
+     */
+    static bool decompress(Codec::Type type, const char *buffer, size_t size, char *output, size_t outputSize) {
+      switch (type) {
+      case Codec::ZLIB: {
+        uLongf decompressedSize = outputSize;
+        const int status = uncompress((Bytef *)output, &decompressedSize, (const Bytef *)buffer, size);
+        return (Z_OK == status && decompressedSize == outputSize);
+      }
+#ifdef DQM4hep_WITH_LZ4
+      case Codec::LZ4: {
+        const int decompressedSize = LZ4_decompress_safe(buffer, output, size, outputSize);
+        return (decompressedSize >= 0 && static_cast<size_t>(decompressedSize) == outputSize);
+      }
+#endif
+#ifdef DQM4hep_WITH_ZSTD
+      case Codec::ZSTD: {
+        const size_t decompressedSize = ZSTD_decompress(output, outputSize, buffer, size);
+        return (!ZSTD_isError(decompressedSize) && decompressedSize == outputSize);
+      }
+#endif
+      default:
+        return false;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  Whether the uncompressed size read from the header is possible for the
+     *          compressed data, so that a corrupted header can't trigger a huge allocation
+     */
+    static bool checkDecodedSize(Codec::Type type, const char *buffer, size_t size, size_t decodedSize) {
+#ifndef DQM4hep_WITH_ZSTD
+      (void)buffer;
+#endif
+      if (decodedSize > Codec::maxDecodedSize)
+        return false;
+
+      switch (type) {
+      case Codec::ZLIB:
+        // deflate can't compress more than 1032:1
+        return (decodedSize <= 1032 * size);
+#ifdef DQM4hep_WITH_LZ4
+      case Codec::LZ4:
+        // lz4 can't compress more than 255:1
+        return (decodedSize <= 255 * size + 16);
+#endif
+#ifdef DQM4hep_WITH_ZSTD
+      case Codec::ZSTD:
+        // the zstd frame stores its content size
+        return (ZSTD_getFrameContentSize(buffer, size) == static_cast<unsigned long long>(decodedSize));
+#endif
+      default:
+        return false;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    const uint32_t Codec::magic = 0xD04A5C03;
+    const size_t Codec::maxDecodedSize = 256 * 1024 * 1024;
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Codec::isAvailable(Type type) {
+      switch (type) {
+      case NONE:
+      case ZLIB:
+        return true;
+#ifdef DQM4hep_WITH_LZ4
+      case LZ4:
+        return true;
+#endif
+#ifdef DQM4hep_WITH_ZSTD
+      case ZSTD:
+        return true;
+#endif
+      default:
+        return false;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Codec::Type Codec::fromString(const std::string &name) {
+      if (name == "none")
+        return NONE;
+      if (name == "zlib")
+        return ZLIB;
+      if (name == "lz4")
+        return LZ4;
+      if (name == "zstd")
+        return ZSTD;
+
+      dqm_error("Codec::fromString: unknown codec '{0}'", name);
+      throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::string Codec::toString(Type type) {
+      switch (type) {
+      case NONE:
+        return "none";
+      case ZLIB:
+        return "zlib";
+      case LZ4:
+        return "lz4";
+      case ZSTD:
+        return "zstd";
+      default:
+        return "unknown";
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Codec::isEncoded(const char *buffer, size_t size) {
+      return (nullptr != buffer && size >= headerSize && magic == readUInt32(buffer));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Codec::encode(Type type, int level, size_t minSize, const char *buffer, size_t size, std::string &output) {
+      if (NONE == type || nullptr == buffer || size < minSize || size > maxDecodedSize)
+        return false;
+
+      const size_t compressedSize = compress(type, level, buffer, size, output);
+
+      // not worth it
+      if (0 == compressedSize || headerSize + compressedSize >= size)
+        return false;
+
+      output.resize(headerSize + compressedSize);
+      writeUInt32(&output[0], magic);
+      output[4] = static_cast<char>(type);
+      output[5] = output[6] = output[7] = 0;
+      writeUInt32(&output[8], static_cast<uint32_t>(size));
+
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Codec::decode(const char *buffer, size_t size, Buffer &output) {
+      if (!isEncoded(buffer, size))
+        return false;
+
+      const Type type = static_cast<Type>(static_cast<unsigned char>(buffer[4]));
+      const size_t decodedSize = readUInt32(buffer + 8);
+
+      if (NONE == type || !isAvailable(type)) {
+        dqm_error("Codec::decode: codec '{0}' (id {1}) not available in this build", toString(type), static_cast<int>(type));
+        return false;
+      }
+
+      if (!checkDecodedSize(type, buffer + headerSize, size - headerSize, decodedSize)) {
+        dqm_error("Codec::decode: invalid decoded size {0} for {1} encoded bytes ({2})", decodedSize, size, toString(type));
+        return false;
+      }
+
+      auto model = decodePool().acquire();
+
+      if (!decompress(type, buffer + headerSize, size - headerSize, model->resize(decodedSize), decodedSize)) {
+        dqm_error("Codec::decode: failed to decode {0} bytes ({1})", size, toString(type));
+        return false;
+      }
+
+      output.setModel(model);
+      return true;
+    }
+  }
+}
@@ -0,0 +1,244 @@
+/// \file CommandBatcher.cc
+/*
+ *
+ * CommandBatcher.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/CommandBatcher.h"
+#include "dqm4hep/Logging.h"
+
+// -- dim headers
+#include "dic.hxx"
+
+namespace dqm4hep {
+
+  namespace net {
+
+    static void writeUInt32(char *buffer, uint32_t value) {
+      for (unsigned int i = 0; i < 4; i++)
+        buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static uint32_t readUInt32(const char *buffer) {
+      uint32_t value(0);
+
+      for (unsigned int i = 0; i < 4; i++)
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[i])) << (8 * i);
+
+      return value;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    const uint32_t CommandBatch::magic = 0xD04A5C02;
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool CommandBatch::isBatch(const char *buffer, size_t size) {
+      return (nullptr != buffer && size >= headerSize && magic == readUInt32(buffer));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool CommandBatch::unpack(const char *buffer, size_t size, CommandFunction function) {
+      if (!isBatch(buffer, size))
+        return false;
+
+      const uint32_t nCommands(readUInt32(buffer + 4));
+      size_t offset(headerSize);
+
+      for (uint32_t c = 0; c < nCommands; c++) {
+        if (offset + 4 > size)
+          return false;
+
+        const size_t commandSize(readUInt32(buffer + offset));
+        offset += 4;
+
+        if (offset + commandSize > size)
+          return false;
+
+        function(buffer + offset, commandSize);
+        offset += commandSize;
+      }
+
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    CommandBatcher::CommandBatcher(size_t maxSize, unsigned int maxDelay, SendFunction function)
+        : m_maxSize(maxSize), m_maxDelay(maxDelay), m_sendFunction(function) {
+      if (nullptr == m_sendFunction) {
+        m_sendFunction = [](const std::string &name, const char *data, size_t size) {
+          DimClient::sendCommandNB(const_cast<char *>(name.c_str()), (void *)data, size);
+        };
+      }
+
+      m_flushThread = std::thread(&CommandBatcher::flushThread, this);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    CommandBatcher::~CommandBatcher() {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopFlag = true;
+      }
+      m_condition.notify_one();
+      m_flushThread.join();
+      this->flush();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CommandBatcher::send(const std::string &name, const char *data, size_t size) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      Batch &batch(m_batches[name]);
+
+      // too large to be batched. Keep the command order
+      if (size + 4 + CommandBatch::headerSize > m_maxSize) {
+        this->sendBatch(name, batch);
+        this->sendBuffer(name, data, size);
+        return;
+      }
+
+      // no room left for this command
+      if (batch.m_buffer.size() + 4 + size > m_maxSize)
+        this->sendBatch(name, batch);
+
+      const bool newBatch(0 == batch.m_nCommands);
+
+      if (newBatch) {
+        batch.m_buffer.resize(CommandBatch::headerSize);
+        writeUInt32(&batch.m_buffer[0], CommandBatch::magic);
+        batch.m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_maxDelay);
+      }
+
+      char sizeBuffer[4];
+      writeUInt32(sizeBuffer, static_cast<uint32_t>(size));
+      batch.m_buffer.append(sizeBuffer, 4);
+      batch.m_buffer.append(data, size);
+      batch.m_nCommands++;
+
+      if (newBatch)
+        m_condition.notify_one();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CommandBatcher::flush(const std::string &name) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto findIter = m_batches.find(name);
+
+      if (m_batches.end() != findIter)
+        this->sendBatch(findIter->first, findIter->second);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CommandBatcher::flush() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      for (auto iter = m_batches.begin(), endIter = m_batches.end(); endIter != iter; ++iter)
+        this->sendBatch(iter->first, iter->second);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t CommandBatcher::maxSize() const {
+      return m_maxSize;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int CommandBatcher::maxDelay() const {
+      return m_maxDelay;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CommandBatcher::setCodec(Codec::Type type, int level, size_t minSize) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_codec = type;
+      m_codecLevel = level;
+      m_codecMinSize = minSize;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CommandBatcher::sendBatch(const std::string &name, Batch &batch) {
+      if (0 == batch.m_nCommands)
+        return;
+
+      writeUInt32(&batch.m_buffer[4], batch.m_nCommands);
+      this->sendBuffer(name, batch.m_buffer.data(), batch.m_buffer.size());
+
+      // the buffer capacity is kept for the next batch
+      batch.m_buffer.clear();
+      batch.m_nCommands = 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CommandBatcher::sendBuffer(const std::string &name, const char *data, size_t size) {
+      if (Codec::encode(m_codec, m_codecLevel, m_codecMinSize, data, size, m_encodeBuffer)) {
+        data = m_encodeBuffer.data();
+        size = m_encodeBuffer.size();
+      }
+
+      m_sendFunction(name, data, size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CommandBatcher::flushThread() {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      while (!m_stopFlag) {
+        TimePoint nextDeadline(TimePoint::max());
+        const TimePoint now(std::chrono::steady_clock::now());
+
+        for (auto iter = m_batches.begin(), endIter = m_batches.end(); endIter != iter; ++iter) {
+          if (0 == iter->second.m_nCommands)
+            continue;
+
+          if (iter->second.m_deadline <= now)
+            this->sendBatch(iter->first, iter->second);
+          else
+            nextDeadline = std::min(nextDeadline, iter->second.m_deadline);
+        }
+
+        if (TimePoint::max() == nextDeadline)
+          m_condition.wait(lock);
+        else
+          m_condition.wait_until(lock, nextDeadline);
+      }
+    }
+  }
+}
@@ -0,0 +1,325 @@
+/// \file NameServiceCache.cc
+/*
+ *
+ * NameServiceCache.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/NameServiceCache.h"
+#include "dqm4hep/Logging.h"
+
+// -- std headers
+#include <chrono>
+#include <sstream>
+
+namespace dqm4hep {
+
+  namespace net {
+
+    /**
+     *  @brief  The maximum time to wait for the initial lists (seconds)
+     */
+    static const unsigned int initializationTimeout = 10;
+
+    //-------------------------------------------------------------------------------------------------
+
+    NameServiceCache &NameServiceCache::instance() {
+      // never deleted: dim subscriptions can't be released safely at exit
+      static NameServiceCache *pCache = new NameServiceCache(true);
+
+      // wait outside of the static initialization: dim callbacks calling instance() meanwhile
+      // would be blocked until the end of the wait, while the lists are received by the dim thread
+      if (!DimClient::inCallback())
+        pCache->waitInitialized();
+
+      return *pCache;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    NameServiceCache::NameServiceCache(bool subscribe) : m_subscribe(subscribe) {
+      if (m_subscribe)
+        m_serverListInfo.reset(new ServerListInfo(this));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void NameServiceCache::waitInitialized() {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      if (m_waited)
+        return;
+
+      if (!m_condition.wait_for(lock, std::chrono::seconds(initializationTimeout), [this]() { return this->initialized(); }))
+        dqm_warning("NameServiceCache: timeout while waiting for the name service lists");
+
+      m_waited = true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::vector<std::string> NameServiceCache::servers() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      std::vector<std::string> servers;
+      servers.reserve(m_servers.size());
+
+      for (auto &server : m_servers)
+        servers.push_back(server.first);
+
+      return servers;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool NameServiceCache::hasServer(const std::string &name) const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return (m_servers.end() != m_servers.find(name));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool NameServiceCache::hasService(const std::string &name) const {
+      return this->hasServiceType(name, SERVICE);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool NameServiceCache::hasRequestHandler(const std::string &name) const {
+      return this->hasServiceType(name, REQUEST_HANDLER);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool NameServiceCache::hasCommandHandler(const std::string &name) const {
+      return this->hasServiceType(name, COMMAND_HANDLER);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool NameServiceCache::hasServiceType(const std::string &name, ServiceType type) const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto findIter = m_services.find(name);
+      return (m_services.end() != findIter && type == findIter->second);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void NameServiceCache::handleServerList(const char *data) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_serverListReceived = true;
+
+      // dns not reachable: nothing is running as far as we know
+      if (nullptr == data) {
+        while (!m_servers.empty())
+          this->removeServer(m_servers.begin()->first);
+
+        m_condition.notify_all();
+        return;
+      }
+
+      const char prefix(data[0]);
+      const bool update('+' == prefix || '-' == prefix || '!' == prefix);
+      std::unordered_map<std::string, std::string> servers;
+      std::stringstream stream(update ? data + 1 : data);
+      std::string token;
+
+      // "server@node" tokens separated by '|'. The node is after the last '@'
+      while (std::getline(stream, token, '|')) {
+        const size_t pos(token.rfind('@'));
+
+        if (token.empty() || std::string::npos == pos)
+          continue;
+
+        servers[token.substr(0, pos)] = token.substr(pos + 1);
+      }
+
+      if (update) {
+        for (auto &server : servers) {
+          // a server in error is still registered in the dns
+          if ('-' == prefix)
+            this->removeServer(server.first);
+          else
+            this->addServer(server.first, server.second);
+        }
+      } else {
+        // full list: synchronize with the known servers
+        for (auto iter = m_servers.begin(); m_servers.end() != iter;) {
+          auto current = iter++;
+
+          if (servers.end() == servers.find(current->first))
+            this->removeServer(current->first);
+        }
+
+        for (auto &server : servers)
+          this->addServer(server.first, server.second);
+      }
+
+      m_condition.notify_all();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void NameServiceCache::handleServiceList(const std::string &server, const char *data) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto findIter = m_servers.find(server);
+
+      if (m_servers.end() == findIter)
+        return;
+
+      ServerEntry &entry(findIter->second);
+      entry.m_received = true;
+
+      // server not reachable. Its removal comes with the dns update
+      if (nullptr == data) {
+        this->clearServices(entry);
+        m_condition.notify_all();
+        return;
+      }
+
+      const char prefix(data[0]);
+      const bool fullList('+' != prefix && '-' != prefix);
+
+      if (fullList)
+        this->clearServices(entry);
+
+      std::stringstream stream(data);
+      std::string line;
+
+      while (std::getline(stream, line, '\n')) {
+        if (line.empty())
+          continue;
+
+        bool removed(false);
+
+        if ('-' == line[0] || '+' == line[0]) {
+          removed = ('-' == line[0]);
+          line.erase(0, 1);
+        }
+
+        const size_t namePos(line.find('|'));
+        const size_t typePos(line.rfind('|'));
+
+        if (std::string::npos == namePos)
+          continue;
+
+        const std::string name(line.substr(0, namePos));
+
+        if (removed) {
+          entry.m_services.erase(name);
+          m_services.erase(name);
+          continue;
+        }
+
+        const std::string type(typePos > namePos ? line.substr(typePos + 1) : "");
+        entry.m_services.insert(name);
+        m_services[name] = ("RPC" == type) ? REQUEST_HANDLER : ("CMD" == type) ? COMMAND_HANDLER : SERVICE;
+      }
+
+      m_condition.notify_all();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void NameServiceCache::addServer(const std::string &server, const std::string &node) {
+      ServerEntry &entry(m_servers[server]);
+
+      if (!entry.m_node.empty() && entry.m_node == node)
+        return;
+
+      // same server name on a new node: subscribe again
+      this->clearServices(entry);
+      entry.m_node = node;
+      entry.m_received = false;
+
+      if (m_subscribe)
+        entry.m_info.reset(new ServiceListInfo(this, server));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void NameServiceCache::removeServer(const std::string &server) {
+      auto findIter = m_servers.find(server);
+
+      if (m_servers.end() == findIter)
+        return;
+
+      this->clearServices(findIter->second);
+      m_servers.erase(findIter);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void NameServiceCache::clearServices(ServerEntry &entry) {
+      for (auto &service : entry.m_services)
+        m_services.erase(service);
+
+      entry.m_services.clear();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool NameServiceCache::initialized() const {
+      if (!m_serverListReceived)
+        return false;
+
+      for (auto &server : m_servers)
+        if (!server.second.m_received)
+          return false;
+
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    NameServiceCache::ServerListInfo::ServerListInfo(NameServiceCache *pCache)
+        : DimInfo("DIS_DNS/SERVER_LIST", (void *)nullptr, 0), m_pCache(pCache) {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void NameServiceCache::ServerListInfo::infoHandler() {
+      const char *data = (const char *)this->getData();
+      const int size = this->getSize();
+      m_pCache->handleServerList((nullptr == data || size <= 0) ? nullptr : data);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    NameServiceCache::ServiceListInfo::ServiceListInfo(NameServiceCache *pCache, const std::string &server)
+        : DimInfo((server + "/SERVICE_LIST").c_str(), (void *)nullptr, 0), m_pCache(pCache), m_server(server) {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void NameServiceCache::ServiceListInfo::infoHandler() {
+      const char *data = (const char *)this->getData();
+      const int size = this->getSize();
+      m_pCache->handleServiceList(m_server, (nullptr == data || size <= 0) ? nullptr : data);
+    }
+  }
+}
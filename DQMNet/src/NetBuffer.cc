@@ -28,6 +28,9 @@
 // -- dqm4hep headers
 #include "dqm4hep/DQMNet.h"
 
+// -- std headers
+#include <atomic>
+
 namespace dqm4hep {
 
   namespace net {
@@ -35,6 +38,14 @@ namespace dqm4hep {
     const char NullBuffer::buffer[] = "\0";
     const size_t NullBuffer::size = 1;
 
+    //-------------------------------------------------------------------------------------------------
+
+    static std::atomic<uint64_t> bufferAllocations(0);
+
+    void countBufferAllocation() {
+      bufferAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
 
@@ -78,13 +89,141 @@ namespace dqm4hep {
 
     void BufferModel::handle(const char *buffer, size_t s) {
       m_rawBuffer.adopt(buffer, s);
+      m_isOwner = false;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool BufferModel::isOwner() const {
+      return m_isOwner;
     }
 
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
 
-    Buffer::Buffer() {
-      this->adopt(NullBuffer::buffer, NullBuffer::size);
+    BufferPool::BufferPool(size_t maxSize) : m_maxSize(maxSize) {
+      m_models.reserve(m_maxSize);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    BufferPool::ModelPtr BufferPool::acquire() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      // a model only referenced by the pool is free
+      for (auto &model : m_models) {
+        if (1 == model.use_count())
+          return model;
+      }
+
+      countBufferAllocation();
+      auto model = std::make_shared<Model>();
+
+      if (m_models.size() < m_maxSize)
+        m_models.push_back(model);
+
+      return model;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    BufferPool::ModelPtr BufferPool::copy(const char *buffer, size_t s) {
+      auto model = this->acquire();
+      model->copy(buffer, s);
+      return model;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t BufferPool::size() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_models.size();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t BufferPool::maxSize() const {
+      return m_maxSize;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  ThreadModelPool class.
+     *          The pool of models of a thread (see BufferModelPool)
+     */
+    template <typename M>
+    class ThreadModelPool {
+    public:
+      std::shared_ptr<M> acquire() {
+        const size_t nModels(m_models.size());
+
+        for (size_t i = 0; i < nModels; i++) {
+          const size_t index((m_next + i) % nModels);
+          std::shared_ptr<M> &model(m_models[index]);
+
+          // a model only referenced by the pool is free. The fence makes
+          // the last writes of the releasing thread visible
+          if (1 == model.use_count()) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            m_next = (index + 1) % nModels;
+            model->handle(NullBuffer::buffer, NullBuffer::size);
+            return model;
+          }
+        }
+
+        countBufferAllocation();
+        auto model = std::make_shared<M>();
+
+        if (nModels < BufferModelPool::maxSize)
+          m_models.push_back(model);
+
+        return model;
+      }
+
+    private:
+      std::vector<std::shared_ptr<M>>     m_models = {};    ///< The models owned by the pool
+      size_t                              m_next = {0};     ///< The next model to check
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<BufferModel> BufferModelPool::acquireRaw() {
+      static thread_local ThreadModelPool<BufferModel> pool;
+      return pool.acquire();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<BufferModelT<std::string>> BufferModelPool::acquireString() {
+      static thread_local ThreadModelPool<BufferModelT<std::string>> pool;
+      auto model = pool.acquire();
+      model->copy(NullBuffer::buffer, NullBuffer::size);
+      return model;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint64_t BufferModelPool::allocations() {
+      return bufferAllocations.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  The model of default constructed buffers, shared by all of them
+     */
+    static const BufferModelPtr &nullModel() {
+      static const BufferModelPtr model = std::make_shared<BufferModel>();
+      return model;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Buffer::Buffer() :
+      m_model(nullModel()) {
+      /* nop */
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -96,7 +235,7 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
 
     std::shared_ptr<BufferModel> Buffer::createModel() const {
-      return std::make_shared<BufferModel>();
+      return BufferModelPool::acquireRaw();
     }
 
     //-------------------------------------------------------------------------------------------------
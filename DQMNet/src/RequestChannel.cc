@@ -0,0 +1,297 @@
+/// \file RequestChannel.cc
+/*
+ *
+ * RequestChannel.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/RequestChannel.h"
+#include "dqm4hep/RequestHandler.h"
+#include "dqm4hep/Logging.h"
+
+// -- dim headers
+#include "dic.h"
+
+namespace dqm4hep {
+
+  namespace net {
+
+    PendingRequests::PendingRequests(const std::string &rname) : m_name(rname) {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void PendingRequests::add(uint32_t requestId, ResponseFunction function, unsigned int timeout) {
+      PendingRequest pending;
+      pending.m_function = function;
+      pending.m_deadline = (0 == timeout) ? TimePoint::max()
+                                          : std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_requests.insert(PendingRequestMap::value_type(requestId, pending));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool PendingRequests::cancel(uint32_t requestId) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return (0 != m_requests.erase(requestId));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int PendingRequests::size() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_requests.size();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    PendingRequests::TimePoint PendingRequests::processTimeouts(const TimePoint &now) {
+      std::vector<ResponseFunction> expired;
+      TimePoint nextDeadline(TimePoint::max());
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto iter = m_requests.begin(); m_requests.end() != iter;) {
+          if (iter->second.m_deadline <= now) {
+            expired.push_back(iter->second.m_function);
+            iter = m_requests.erase(iter);
+            continue;
+          }
+
+          nextDeadline = std::min(nextDeadline, iter->second.m_deadline);
+          ++iter;
+        }
+      }
+
+      Buffer empty;
+
+      for (auto &function : expired) {
+        dqm_debug("PendingRequests::processTimeouts: request '{0}' timed out", m_name);
+        function(core::STATUS_CODE_TIMEOUT, empty);
+      }
+
+      return nextDeadline;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void PendingRequests::handleResponse(const char *data, size_t size) {
+      uint32_t requestId(0);
+
+      // the server doesn't echo the request header: the response can't be matched
+      if (!RequestHeader::read(data, size, requestId)) {
+        dqm_warning("PendingRequests::handleResponse: response to '{0}' without request header, dropped", m_name);
+        return;
+      }
+
+      // connection lost: all pending requests fail
+      if (0 == requestId) {
+        PendingRequestMap pendingRequests;
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          pendingRequests.swap(m_requests);
+        }
+
+        if (!pendingRequests.empty())
+          dqm_warning("PendingRequests::handleResponse: lost connection to '{0}', {1} request(s) failed", m_name, pendingRequests.size());
+
+        Buffer empty;
+
+        for (auto &pending : pendingRequests)
+          pending.second.m_function(core::STATUS_CODE_FAILURE, empty);
+
+        return;
+      }
+
+      ResponseFunction function;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto findIter = m_requests.find(requestId);
+
+        // cancelled or timed out
+        if (m_requests.end() == findIter)
+          return;
+
+        function = findIter->second.m_function;
+        m_requests.erase(findIter);
+      }
+
+      Buffer response;
+
+      if (size > RequestHeader::size)
+        response.adopt(data + RequestHeader::size, size - RequestHeader::size);
+
+      function(core::STATUS_CODE_SUCCESS, response);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    RequestChannel::RequestChannel(Client *pClient, const std::string &cname)
+        : m_name(cname), m_pClient(pClient), m_pendingRequests(cname), m_rpc(this) {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    RequestChannel::~RequestChannel() {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const std::string &RequestChannel::name() const {
+      return m_name;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Client *RequestChannel::client() const {
+      return m_pClient;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int RequestChannel::numberOfPendingRequests() const {
+      return m_pendingRequests.size();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestChannel::send(uint32_t requestId, const Buffer &request, ResponseFunction function, unsigned int timeout) {
+      // register before sending, the response may arrive before setData() returns
+      m_pendingRequests.add(requestId, function, timeout);
+
+      std::lock_guard<std::recursive_mutex> lock(m_sendMutex);
+      m_sendBuffer.resize(RequestHeader::size + request.size());
+      RequestHeader::write(&m_sendBuffer[0], requestId);
+      std::copy(request.begin(), request.end(), m_sendBuffer.begin() + RequestHeader::size);
+      m_rpc.send(&m_sendBuffer[0], m_sendBuffer.size());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool RequestChannel::cancel(uint32_t requestId) {
+      return m_pendingRequests.cancel(requestId);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    RequestChannel::TimePoint RequestChannel::processTimeouts(const TimePoint &now) {
+      return m_pendingRequests.processTimeouts(now);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestChannel::handleResponse(const char *data, size_t size) {
+      m_pendingRequests.handleResponse(data, size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  The buffer received by dim on connection loss (request id 0)
+     */
+    static std::string noLinkBuffer() {
+      std::string buffer(RequestHeader::size, 0);
+      RequestHeader::write(&buffer[0], 0);
+      return buffer;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  The channels by rpc id. A command may fail after the rpc deletion
+     */
+    static std::recursive_mutex rpcRegistryMutex;
+    static std::map<dim_long, RequestChannel *> rpcRegistry;
+    static dim_long lastRpcId = 0;
+
+    //-------------------------------------------------------------------------------------------------
+
+    RequestChannel::Rpc::Rpc(RequestChannel *pChannel)
+        : DimRpcInfo(pChannel->name().c_str(), (void *)noLinkBuffer().data(), RequestHeader::size),
+          m_pChannel(pChannel), m_commandName(pChannel->name() + "/RpcIn") {
+      std::lock_guard<std::recursive_mutex> lock(rpcRegistryMutex);
+      m_id = ++lastRpcId;
+      rpcRegistry[m_id] = pChannel;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    RequestChannel::Rpc::~Rpc() {
+      std::lock_guard<std::recursive_mutex> lock(rpcRegistryMutex);
+      rpcRegistry.erase(m_id);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestChannel::Rpc::send(char *data, size_t size) {
+      // first request: wait for the connection and start listening for responses
+      if (!m_listening) {
+        this->setData((void *)data, size);
+        this->keepWaiting();
+        m_listening = true;
+        return;
+      }
+
+      // setData() resets the waiting state. Called while a response is handled,
+      // dim would drop the next responses. Send the rpc command directly instead
+      dic_cmnd_callback(m_commandName.c_str(), (void *)data, size, &Rpc::commandCallback, m_id);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestChannel::Rpc::commandCallback(void *tag, int *status) {
+      if (nullptr == status || 1 == *status)
+        return;
+
+      // server not reachable: same as a connection loss
+      std::lock_guard<std::recursive_mutex> lock(rpcRegistryMutex);
+      auto findIter = rpcRegistry.find(*static_cast<dim_long *>(tag));
+
+      if (rpcRegistry.end() == findIter)
+        return;
+
+      const std::string buffer(noLinkBuffer());
+      findIter->second->handleResponse(buffer.data(), buffer.size());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestChannel::Rpc::rpcInfoHandler() {
+      // more responses may come for other requests in flight
+      this->keepWaiting();
+
+      char *data = (char *)this->getData();
+      int size = this->getSize();
+
+      m_pChannel->handleResponse(data, (nullptr == data || size < 0) ? 0 : size);
+    }
+  }
+}
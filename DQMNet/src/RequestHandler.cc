@@ -26,13 +26,206 @@
  */
 
 #include "dqm4hep/RequestHandler.h"
+#include "dqm4hep/Codec.h"
+#include "dqm4hep/CommandBatcher.h"
+#include "dqm4hep/Logging.h"
+
+// -- dim headers
+#include "dis.h"
+
+// -- std headers
+#include <atomic>
 
 namespace dqm4hep {
 
   namespace net {
 
+    const uint32_t RequestHeader::magic = 0xD04A5C01;
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestHeader::write(char *buffer, uint32_t requestId) {
+      for (unsigned int i = 0; i < 4; i++) {
+        buffer[i] = static_cast<char>((magic >> (8 * i)) & 0xFF);
+        buffer[4 + i] = static_cast<char>((requestId >> (8 * i)) & 0xFF);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool RequestHeader::read(const char *buffer, size_t bufferSize, uint32_t &requestId) {
+      if (nullptr == buffer || bufferSize < size)
+        return false;
+
+      uint32_t readMagic(0);
+      requestId = 0;
+
+      for (unsigned int i = 0; i < 4; i++) {
+        readMagic |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[i])) << (8 * i);
+        requestId |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[4 + i])) << (8 * i);
+      }
+
+      return (magic == readMagic);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    RequestExecutor::RequestExecutor(unsigned int nThreads) {
+      nThreads = std::max(1u, nThreads);
+
+      for (unsigned int t = 0; t < nThreads; t++)
+        m_threads.push_back(std::thread(&RequestExecutor::run, this));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    RequestExecutor::~RequestExecutor() {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopFlag = true;
+      }
+      m_condition.notify_all();
+
+      for (auto &thread : m_threads)
+        thread.join();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestExecutor::post(Task task) {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+      }
+      m_condition.notify_one();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int RequestExecutor::nThreads() const {
+      return m_threads.size();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t RequestExecutor::nPendingTasks() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_tasks.size();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    RequestExecutorPtr RequestExecutor::shared() {
+      static RequestExecutorPtr executor = std::make_shared<RequestExecutor>(std::thread::hardware_concurrency());
+      return executor;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestExecutor::run() {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      while (true) {
+        m_condition.wait(lock, [this]() { return m_stopFlag || !m_tasks.empty(); });
+
+        // run the pending tasks before exiting
+        if (m_tasks.empty())
+          return;
+
+        Task task(std::move(m_tasks.front()));
+        m_tasks.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  DeferredResponse::State class.
+     *          Sends the response at most once, with the send function
+     */
+    class DeferredResponse::State {
+    public:
+      State(SendFunction function) : m_sendFunction(function) {
+        /* nop */
+      }
+
+      State(const State&) = delete;
+      State& operator=(const State&) = delete;
+
+      ~State() {
+        // never completed: don't let the client wait for its timeout
+        if (this->pending()) {
+          Buffer response;
+          this->send(response.begin(), response.size());
+        }
+      }
+
+      void send(const char *buffer, size_t size) {
+        if (m_sent.exchange(true))
+          return;
+
+        if (m_sendFunction)
+          m_sendFunction(buffer, size);
+      }
+
+      bool pending() const {
+        return !m_sent.load();
+      }
+
+    private:
+      SendFunction                             m_sendFunction = {};     ///< The function sending the response
+      std::atomic<bool>                        m_sent = {false};        ///< Whether the response was sent
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    DeferredResponse::DeferredResponse(SendFunction function) : m_state(std::make_shared<State>(function)) {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void DeferredResponse::send(const Buffer &response) {
+      this->send(response.begin(), response.size());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void DeferredResponse::send(const char *buffer, size_t size) {
+      if (nullptr != m_state)
+        m_state->send(buffer, size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool DeferredResponse::pending() const {
+      return (nullptr != m_state && m_state->pending());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
     RequestHandler::~RequestHandler() {
       this->stopHandlingRequest();
+
+      // the posted requests still use the callback
+      std::unique_lock<std::mutex> lock(m_runningMutex);
+      m_runningCondition.wait(lock, [this]() { return 0 == m_nRunningRequests; });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestHandler::createExecutor() {
+      if (DEDICATED_THREAD == m_execution)
+        m_executor = std::make_shared<RequestExecutor>(1);
+      else if (SHARED_POOL == m_execution)
+        m_executor = RequestExecutor::shared();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -49,6 +242,12 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    RequestHandler::Execution RequestHandler::execution() const {
+      return m_execution;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void RequestHandler::startHandlingRequest() {
       if (!this->isHandlingRequest()) {
         m_pRpc = new Rpc(this);
@@ -82,27 +281,172 @@ namespace dqm4hep {
       m_requestSignal.process(request, response);
     }
 
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestHandler::handleDeferredRequest(const Buffer &request, DeferredResponse response) {
+      if (m_deferredFunction) {
+        m_deferredFunction(request, response);
+        return;
+      }
+
+      Buffer result;
+      m_requestSignal.emit(request, result);
+      response.send(result);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool RequestHandler::isSynchronous() const {
+      return (INLINE == m_execution && !m_deferredFunction);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestHandler::postRequest(const char *buffer, size_t size, DeferredResponse response) {
+      // the dim buffer is only valid in the dim thread
+      Buffer request;
+
+      if (nullptr != buffer) {
+        auto model = request.createModel<std::string>();
+        model->copy(buffer, size);
+        request.setModel(model);
+      }
+
+      auto model = request.model();
+
+      {
+        std::lock_guard<std::mutex> lock(m_runningMutex);
+        m_nRunningRequests++;
+      }
+
+      try {
+        m_executor->post([this, model, response]() {
+          try {
+            Buffer taskRequest;
+            taskRequest.setModel(model);
+            this->handleDeferredRequest(taskRequest, response);
+          } catch (const std::exception &exception) {
+            dqm_error("RequestHandler::postRequest: exception caught while handling request '{0}': {1}", m_name, exception.what());
+          } catch (...) {
+            dqm_error("RequestHandler::postRequest: exception caught while handling request '{0}': {1}", m_name, "unknown exception");
+          }
+
+          this->requestDone();
+        });
+      } catch (...) {
+        // never posted: the destructor must not wait for it
+        this->requestDone();
+        throw;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestHandler::requestDone() {
+      std::lock_guard<std::mutex> lock(m_runningMutex);
+      m_nRunningRequests--;
+      m_runningCondition.notify_all();
+    }
+
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
 
     RequestHandler::Rpc::Rpc(RequestHandler *pHandler)
-        : DimRpc((char *)pHandler->name().c_str(), "C", "C"), m_pHandler(pHandler) {
+        : DimRpc((char *)pHandler->name().c_str(), "C", "C"), m_pHandler(pHandler), m_link(std::make_shared<Rpc *>(this)) {
       /* nop */
     }
 
     //-------------------------------------------------------------------------------------------------
 
+    RequestHandler::Rpc::~Rpc() {
+      dim_lock();
+      *m_link = nullptr;
+      dim_unlock();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void RequestHandler::Rpc::rpcHandler() {
       char *data = (char *)this->getData();
       int size = this->getSize();
-      Buffer request;
+      const char *requestData(nullptr);
+      size_t requestSize(0);
+
+      // asynchronous request: strip the header, echo it in the response
+      uint32_t requestId(0);
+      const bool asyncRequest(RequestHeader::read(data, size, requestId));
+
+      if (asyncRequest) {
+        requestData = data + RequestHeader::size;
+        requestSize = size - RequestHeader::size;
+      } else if (nullptr != data && size != 0) {
+        requestData = data;
+        requestSize = size;
+      }
 
-      if (nullptr != data && size != 0)
-        request.adopt(data, size);
+      // a previous deferred request disabled the automatic reply
+      itsKilled = 0;
 
-      Buffer response;
-      m_pHandler->handleRequest(request, response);
-      this->setData((void *)response.begin(), response.size());
+      if (m_pHandler->isSynchronous()) {
+        Buffer request;
+
+        if (nullptr != requestData)
+          request.adopt(requestData, requestSize);
+
+        Buffer response;
+        m_pHandler->handleRequest(request, response);
+        this->setResponse(asyncRequest, requestId, response.begin(), response.size());
+        return;
+      }
+
+      // deferred response: dim must not reply when returning
+      itsKilled = 1;
+      auto link(m_link);
+      const int clientId(dis_get_conn_id());
+      DeferredResponse response([link, clientId, asyncRequest, requestId](const char *buffer, size_t size) {
+        // the rpc may have been deleted in the mean time
+        dim_lock();
+        Rpc *pRpc = *link;
+
+        if (nullptr != pRpc)
+          pRpc->reply(clientId, asyncRequest, requestId, buffer, size);
+
+        dim_unlock();
+      });
+
+      if (INLINE == m_pHandler->execution()) {
+        Buffer request;
+
+        if (nullptr != requestData)
+          request.adopt(requestData, requestSize);
+
+        m_pHandler->handleDeferredRequest(request, response);
+        return;
+      }
+
+      m_pHandler->postRequest(requestData, requestSize, response);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestHandler::Rpc::reply(int clientId, bool asyncRequest, uint32_t requestId, const char *buffer, size_t size) {
+      this->setResponse(asyncRequest, requestId, buffer, size);
+      int clientIds[2] = {clientId, 0};
+      dis_selective_update_service(itsIdOut, clientIds);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestHandler::Rpc::setResponse(bool asyncRequest, uint32_t requestId, const char *buffer, size_t size) {
+      if (!asyncRequest) {
+        this->setData((void *)buffer, size);
+        return;
+      }
+
+      m_response.resize(RequestHeader::size + size);
+      RequestHeader::write(&m_response[0], requestId);
+      std::copy(buffer, buffer + size, m_response.begin() + RequestHeader::size);
+      this->setData((void *)m_response.data(), m_response.size());
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -182,6 +526,54 @@ namespace dqm4hep {
       if (nullptr == data || size == 0)
         return;
 
+      // compressed command or batch (see Client::setCommandCodec())
+      Buffer decoded;
+
+      if (Codec::isEncoded(data, size)) {
+        if (!Codec::decode(data, size, decoded)) {
+          dqm_error("CommandHandler::Command::commandHandler: couldn't decode command received on '{0}'", m_pHandler->name());
+          return;
+        }
+
+        data = const_cast<char *>(decoded.begin());
+        size = decoded.size();
+      }
+
+      // batch of commands (see CommandBatcher): one call per command
+      if (CommandBatch::isBatch(data, size)) {
+        const bool valid = CommandBatch::unpack(data, size, [this](const char *commandData, size_t commandSize) {
+          if (0 == commandSize)
+            return;
+
+          this->handleCommand(commandData, commandSize);
+        });
+
+        if (!valid)
+          dqm_error("CommandHandler::Command::commandHandler: malformed batch of commands received on '{0}'", m_pHandler->name());
+
+        return;
+      }
+
+      this->handleCommand(data, size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CommandHandler::Command::handleCommand(const char *data, size_t size) {
+      // command in shared memory, read in place (see SharedMemoryRing)
+      if (SharedMemoryReference::isReference(data, size)) {
+        const bool read = m_sharedMemoryReader.read(data, size, [this](const char *contents, size_t contentsSize) {
+          Buffer command;
+          command.adopt(contents, contentsSize);
+          m_pHandler->handleCommand(command);
+        });
+
+        if (!read)
+          dqm_error("CommandHandler::Command::handleCommand: couldn't read command received on '{0}' from shared memory", m_pHandler->name());
+
+        return;
+      }
+
       Buffer command;
       command.adopt(data, size);
       m_pHandler->handleCommand(command);
@@ -27,6 +27,7 @@
 
 // -- dqm4hep headers
 #include <dqm4hep/Internal.h>
+#include <dqm4hep/NameServiceCache.h>
 #include <dqm4hep/Server.h>
 #include <dqm4hep/Logging.h>
 
@@ -299,35 +300,13 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
 
     std::vector<std::string> Server::runningServers() {
-      std::vector<std::string> runningServers;
-
-      DimBrowser browser;
-      browser.getServers();
-      char *pServer, *pNode;
-
-      while (browser.getNextServer(pServer, pNode)) {
-        std::string server(pServer);
-        runningServers.push_back(server);
-      }
-
-      return runningServers;
+      return NameServiceCache::instance().servers();
     }
 
     //-------------------------------------------------------------------------------------------------
 
     bool Server::isServerRunning(const std::string &serverName) {
-      DimBrowser browser;
-      browser.getServers();
-      char *pServer, *pNode;
-
-      while (browser.getNextServer(pServer, pNode)) {
-        std::string server(pServer);
-
-        if (server == serverName)
-          return true;
-      }
-
-      return false;
+      return NameServiceCache::instance().hasServer(serverName);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -367,88 +346,19 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
 
     bool Server::serviceAlreadyRunning(const std::string &sname) {
-      if(DimServer::inCallback()) {
-        dqm_warning( "Server::serviceAlreadyRunning: can't check for duplicated service on network !" );
-        return false;
-      }
-      DimBrowser browser;
-      int nServices = browser.getServices(sname.c_str());
-
-      if (nServices == 0)
-        return false;
-
-      int serviceType;
-      char *serviceName, *format;
-
-      while (1) {
-        serviceType = browser.getNextService(serviceName, format);
-
-        if (serviceType == 0)
-          break;
-
-        if (serviceType == DimSERVICE)
-          return true;
-      }
-
-      return false;
+      return NameServiceCache::instance().hasService(sname);
     }
 
     //-------------------------------------------------------------------------------------------------
 
     bool Server::requestHandlerAlreadyRunning(const std::string &rname) {
-      if(DimServer::inCallback()) {
-        dqm_warning( "Server::requestHandlerAlreadyRunning: can't check for duplicated request handler on network !" );
-        return false;
-      }
-      DimBrowser browser;
-      int nServices = browser.getServices(rname.c_str());
-
-      if (nServices == 0)
-        return false;
-
-      int serviceType;
-      char *serviceName, *format;
-
-      while (1) {
-        serviceType = browser.getNextService(serviceName, format);
-
-        if (serviceType == 0)
-          break;
-
-        if (serviceType == DimRPC)
-          return true;
-      }
-
-      return false;
+      return NameServiceCache::instance().hasRequestHandler(rname);
     }
 
     //-------------------------------------------------------------------------------------------------
 
     bool Server::commandHandlerAlreadyRunning(const std::string &cname) {
-      if(DimServer::inCallback()) {
-        dqm_warning( "Server::commandHandlerAlreadyRunning: can't check for duplicated command on network !" );
-        return false;
-      }
-      DimBrowser browser;
-      int nServices = browser.getServices(cname.c_str());
-
-      if (nServices == 0)
-        return false;
-
-      int serviceType;
-      char *serviceName, *format;
-
-      while (1) {
-        serviceType = browser.getNextService(serviceName, format);
-
-        if (serviceType == 0)
-          break;
-
-        if (serviceType == DimCOMMAND)
-          return true;
-      }
-
-      return false;
+      return NameServiceCache::instance().hasCommandHandler(cname);
     }
 
     //-------------------------------------------------------------------------------------------------
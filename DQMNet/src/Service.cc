@@ -27,11 +27,33 @@
 
 // -- dqm4hep headers
 #include "dqm4hep/Service.h"
+#include "dqm4hep/Logging.h"
+#include "dqm4hep/Server.h"
+
+// -- std headers
+#include <cstring>
+
+// -- dim headers
+#include "dim.h"
 
 namespace dqm4hep {
 
   namespace net {
 
+    /**
+     *  @brief  DimLock class.
+     *          Scoped dim lock, re-entrant in the same thread
+     */
+    class DimLock {
+    public:
+      DimLock() { dim_lock(); }
+      ~DimLock() { dim_unlock(); }
+      DimLock(const DimLock&) = delete;
+      DimLock &operator=(const DimLock&) = delete;
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
     Service::Service(Server *pServer, const std::string &sname) : 
       m_name(sname), 
       m_pServer(pServer) {
@@ -58,9 +80,62 @@ namespace dqm4hep {
 
     //-------------------------------------------------------------------------------------------------
 
+    void Service::setCodec(Codec::Type type, int level, size_t minSize) {
+      if (!Codec::isAvailable(type)) {
+        dqm_warning("Service::setCodec: codec '{0}' not available in this build, using zlib for service '{1}'",
+                    Codec::toString(type), m_name);
+        type = Codec::ZLIB;
+        level = 0;
+      }
+
+      std::lock_guard<std::mutex> lock(m_sendMutex);
+      m_codec = type;
+      m_codecLevel = level;
+      m_codecMinSize = minSize;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Codec::Type Service::codec() const {
+      return m_codec;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Service::setSharedMemory(unsigned int nSlots, size_t slotSize) {
+      {
+        std::lock_guard<std::mutex> lock(m_sendMutex);
+        m_sharedMemory = SharedMemoryRing::create(nSlots, slotSize);
+
+        if (nullptr == m_sharedMemory) {
+          dqm_warning("Service::setSharedMemory: couldn't create the shared memory ring of service '{0}', using network only", m_name);
+          return;
+        }
+      }
+
+      const std::string commandName(Service::sharedMemoryFailureName(m_name));
+
+      if (!m_pServer->isCommandHandlerRegistered(commandName))
+        m_pServer->createCommandHandler(commandName, this, &Service::handleSharedMemoryFailure);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Service::sharedMemory() const {
+      return (nullptr != m_sharedMemory);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::string Service::sharedMemoryFailureName(const std::string &sname) {
+      return sname + "/SharedMemoryFailure";
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void Service::connectService() {
       if (!this->isServiceConnected()) {
-        m_pService = new DimService((char *)m_name.c_str(), "C", (char *)NullBuffer::buffer, NullBuffer::size);
+        m_pService = new DimServiceImpl(this);
       }
     }
 
@@ -109,10 +184,27 @@ namespace dqm4hep {
       if (!this->isServiceConnected())
         throw; // TODO implement exceptions
 
+      // the dim thread reads the contents on new subscriptions (see selectClientContents()).
+      // They are set, sent and reset under the dim lock, taken first as in the dim callbacks
+      DimLock dimLock;
+      std::lock_guard<std::mutex> lock(m_sendMutex);
+      m_pContents = &buffer;
+      m_contentsPrepared = false;
+      m_sharedUpdate = (nullptr != m_sharedMemory && m_sharedMemory->write(buffer.begin(), buffer.size(), m_reference));
+
+      // clients on the same host get the reference, see selectClientContents()
+      void *data(nullptr);
+      int size(0);
+
+      if (m_sharedUpdate) {
+        data = (void *)m_reference.data();
+        size = m_reference.size();
+      } else {
+        this->networkContents(data, size);
+      }
+
       if (clientIds.empty()) {
-        m_pService->updateService((void *)buffer.begin(), buffer.size());
-        m_pService->itsData = (void *)NullBuffer::buffer;
-        m_pService->itsSize = NullBuffer::size;
+        m_pService->updateService(data, size);
       } else {
         std::vector<int> clientIdList(clientIds);
 
@@ -120,10 +212,138 @@ namespace dqm4hep {
           clientIdList.push_back(0);
 
         int *clientIdsArray = &clientIdList[0];
-        m_pService->selectiveUpdateService((void *)buffer.begin(), buffer.size(), clientIdsArray);
+        m_pService->selectiveUpdateService(data, size, clientIdsArray);
+      }
+
+      m_pService->itsData = (void *)NullBuffer::buffer;
+      m_pService->itsSize = NullBuffer::size;
+      m_lastUpdateShared = m_sharedUpdate;
+      m_sharedUpdate = false;
+      m_pContents = nullptr;
+      m_contentsPrepared = false;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Service::networkContents(void *&data, int &size) {
+      if (!m_contentsPrepared) {
+        const bool encoded(Codec::encode(m_codec, m_codecLevel, m_codecMinSize, m_pContents->begin(), m_pContents->size(), m_encodeBuffer));
+        m_networkData = encoded ? (void *)m_encodeBuffer.data() : (void *)m_pContents->begin();
+        m_networkSize = encoded ? m_encodeBuffer.size() : m_pContents->size();
+        m_contentsPrepared = true;
+      }
+
+      data = m_networkData;
+      size = m_networkSize;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Service::selectClientContents() {
+      // called by the dim thread with the dim lock held: the contents are only alive during sendData()
+      if (nullptr == m_pContents) {
         m_pService->itsData = (void *)NullBuffer::buffer;
         m_pService->itsSize = NullBuffer::size;
+        return;
+      }
+
+      // network only update
+      if (!m_sharedUpdate)
+        return;
+
+      if (Service::isLocalClient() && !this->isNetworkClient()) {
+        m_pService->itsData = (void *)m_reference.data();
+        m_pService->itsSize = m_reference.size();
+      } else {
+        this->networkContents(m_pService->itsData, m_pService->itsSize);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Service::isLocalClient() {
+      static const std::string localNode = []() {
+        char node[256] = {0};
+        get_node_name(node);
+        return std::string(node);
+      }();
+
+      // client name is task@node
+      const char *clientName = DimServer::getClientName();
+
+      if (nullptr == clientName)
+        return false;
+
+      const char *node = strrchr(clientName, '@');
+      return (nullptr != node && localNode == (node + 1));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Service::isNetworkClient() const {
+      std::lock_guard<std::mutex> lock(m_networkClientsMutex);
+      return (m_networkClients.end() != m_networkClients.find(m_pServer->clientId()));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Service::handleSharedMemoryFailure(const Buffer &/*command*/) {
+      const int clientId(m_pServer->clientId());
+      {
+        std::lock_guard<std::mutex> lock(m_networkClientsMutex);
+
+        if (!m_networkClients.insert(clientId).second)
+          return;
       }
+
+      dqm_warning("Service::handleSharedMemoryFailure: client {0} can't attach to the shared memory ring of service '{1}', using network", 
+                  clientId, m_name);
+
+      // send again the last update, the client couldn't read it
+      DimLock dimLock;
+      std::lock_guard<std::mutex> lock(m_sendMutex);
+      std::string ring;
+      uint32_t slot(0);
+      uint64_t sequence(0), size(0);
+      const char *contents(nullptr);
+
+      if (!this->isServiceConnected() || nullptr == m_sharedMemory || !m_lastUpdateShared ||
+          !SharedMemoryReference::read(m_reference.data(), m_reference.size(), ring, slot, sequence, size) ||
+          !m_sharedMemory->pin(slot, sequence, size, contents))
+        return;
+
+      Buffer buffer;
+      buffer.adopt(contents, size);
+      m_pContents = &buffer;
+      m_contentsPrepared = false;
+
+      void *data(nullptr);
+      int dataSize(0);
+      this->networkContents(data, dataSize);
+
+      int clientIds[2] = {clientId, 0};
+      m_pService->selectiveUpdateService(data, dataSize, clientIds);
+
+      m_pService->itsData = (void *)NullBuffer::buffer;
+      m_pService->itsSize = NullBuffer::size;
+      m_pContents = nullptr;
+      m_contentsPrepared = false;
+      m_sharedMemory->unpin(slot);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    Service::DimServiceImpl::DimServiceImpl(Service *pService)
+        : DimService((char *)pService->name().c_str(), (char *)"C", (void *)NullBuffer::buffer, NullBuffer::size),
+          m_pService(pService) {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Service::DimServiceImpl::serviceHandler() {
+      m_pService->selectClientContents();
     }
   }
 }
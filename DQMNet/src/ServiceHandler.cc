@@ -26,7 +26,10 @@
  */
 
 #include "dqm4hep/ServiceHandler.h"
+#include "dqm4hep/Client.h"
 #include "dqm4hep/Service.h"
+#include "dqm4hep/Codec.h"
+#include "dqm4hep/Logging.h"
 
 namespace dqm4hep {
 
@@ -77,9 +80,43 @@ namespace dqm4hep {
       if (nullptr == data || size == 0)
         return;
 
-      // std::string contents(data, size);
+      // contents in shared memory, read in place (see Service::setSharedMemory())
+      if (SharedMemoryReference::isReference(data, size)) {
+        // ring not accessible from this process: ask the server to use the network
+        if (!m_sharedMemoryReader.attach(data, size)) {
+          if (!m_networkFallback) {
+            dqm_warning("ServiceHandler::ServiceInfo::infoHandler: can't attach to the shared memory of service '{0}', switching to network", m_pHandler->name());
+            m_pHandler->client()->sendCommand(Service::sharedMemoryFailureName(m_pHandler->name()), std::string(""));
+            m_networkFallback = true;
+          }
+
+          return;
+        }
+
+        const bool read = m_sharedMemoryReader.read(data, size, [this](const char *contents, size_t contentsSize) {
+          Buffer buffer;
+          buffer.adopt(contents, contentsSize);
+          m_pHandler->receiveServiceUpdated(buffer);
+        });
+
+        if (!read)
+          dqm_error("ServiceHandler::ServiceInfo::infoHandler: couldn't read contents of service '{0}' from shared memory", m_pHandler->name());
+
+        return;
+      }
+
       Buffer buffer;
-      buffer.adopt(data, size);
+
+      // compressed contents (see Service::setCodec())
+      if (Codec::isEncoded(data, size)) {
+        if (!Codec::decode(data, size, buffer)) {
+          dqm_error("ServiceHandler::ServiceInfo::infoHandler: couldn't decode contents of service '{0}'", m_pHandler->name());
+          return;
+        }
+      } else {
+        buffer.adopt(data, size);
+      }
+
       m_pHandler->receiveServiceUpdated(buffer);
     }
   }
@@ -0,0 +1,416 @@
+/// \file SharedMemory.cc
+/*
+ *
+ * SharedMemory.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/SharedMemory.h"
+#include "dqm4hep/Logging.h"
+
+// -- std headers
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <sstream>
+
+// -- unix headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dqm4hep {
+
+  namespace net {
+
+    template <typename T>
+    static void writeUInt(char *buffer, T value) {
+      for (unsigned int i = 0; i < sizeof(T); i++)
+        buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    static T readUInt(const char *buffer) {
+      T value(0);
+
+      for (unsigned int i = 0; i < sizeof(T); i++)
+        value |= static_cast<T>(static_cast<unsigned char>(buffer[i])) << (8 * i);
+
+      return value;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    const uint32_t SharedMemoryReference::magic = 0xD04A5C04;
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SharedMemoryReference::isReference(const char *buffer, size_t size) {
+      return (nullptr != buffer && size >= headerSize && magic == readUInt<uint32_t>(buffer));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SharedMemoryReference::write(std::string &output, const std::string &ring, uint32_t slot, uint64_t sequence, uint64_t size) {
+      output.resize(headerSize + ring.size());
+      writeUInt<uint32_t>(&output[0], magic);
+      writeUInt<uint32_t>(&output[4], slot);
+      writeUInt<uint64_t>(&output[8], sequence);
+      writeUInt<uint64_t>(&output[16], size);
+      writeUInt<uint32_t>(&output[24], static_cast<uint32_t>(ring.size()));
+      std::copy(ring.begin(), ring.end(), output.begin() + headerSize);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SharedMemoryReference::read(const char *buffer, size_t bufferSize, std::string &ring, uint32_t &slot, uint64_t &sequence, uint64_t &size) {
+      if (!isReference(buffer, bufferSize))
+        return false;
+
+      const size_t nameSize(readUInt<uint32_t>(buffer + 24));
+
+      if (headerSize + nameSize != bufferSize)
+        return false;
+
+      slot = readUInt<uint32_t>(buffer + 4);
+      sequence = readUInt<uint64_t>(buffer + 8);
+      size = readUInt<uint64_t>(buffer + 16);
+      ring.assign(buffer + headerSize, nameSize);
+
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  The segment header, at the segment start
+     */
+    struct SegmentHeader {
+      uint32_t              m_magic;          ///< The segment magic number, written last
+      uint32_t              m_nSlots;         ///< The number of slots
+      uint64_t              m_slotSize;       ///< The maximum contents size of a slot
+    };
+
+    static const uint32_t segmentMagic = 0xD04A5C05;
+    static const size_t   alignment = 64;
+
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  The slot header, followed by the slot contents.
+     *          A sequence of 0 marks a slot being written
+     */
+    struct SharedMemoryRing::Slot {
+      std::atomic<uint32_t> m_readers;        ///< The number of readers pinning the slot
+      uint32_t              m_padding;        ///< Unused
+      std::atomic<uint64_t> m_sequence;       ///< The sequence of the contents
+      uint64_t              m_size;           ///< The contents size
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::unique_ptr<SharedMemoryRing> SharedMemoryRing::create(unsigned int nSlots, size_t slotSize) {
+      static std::atomic<unsigned int> counter(0);
+      static_assert(sizeof(Slot) <= alignment, "slot header too large");
+
+      if (0 == nSlots || 0 == slotSize)
+        return nullptr;
+
+      std::stringstream ss;
+      ss << "/dqm4hep-" << getpid() << "-" << counter++;
+      const std::string name(ss.str());
+      const size_t mappedSize(alignment + nSlots * slotStride(slotSize));
+
+      int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+      // left over by a crashed process with the same pid
+      if (fd < 0 && EEXIST == errno) {
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+      }
+
+      if (fd < 0) {
+        dqm_error("SharedMemoryRing::create: couldn't create segment '{0}': {1}", name, strerror(errno));
+        return nullptr;
+      }
+
+      if (0 != ftruncate(fd, mappedSize)) {
+        dqm_error("SharedMemoryRing::create: couldn't allocate {0} bytes for segment '{1}': {2}", mappedSize, name, strerror(errno));
+        close(fd);
+        shm_unlink(name.c_str());
+        return nullptr;
+      }
+
+      void *address = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      close(fd);
+
+      if (MAP_FAILED == address) {
+        dqm_error("SharedMemoryRing::create: couldn't map segment '{0}': {1}", name, strerror(errno));
+        shm_unlink(name.c_str());
+        return nullptr;
+      }
+
+      std::unique_ptr<SharedMemoryRing> ring(new SharedMemoryRing(name, true, static_cast<char *>(address), mappedSize));
+      ring->m_nSlots = nSlots;
+      ring->m_slotSize = slotSize;
+
+      for (unsigned int s = 0; s < nSlots; s++) {
+        Slot *slot = new (ring->slotAt(s)) Slot;
+        slot->m_readers.store(0);
+        slot->m_sequence.store(0);
+        slot->m_size = 0;
+      }
+
+      SegmentHeader *header = reinterpret_cast<SegmentHeader *>(address);
+      header->m_nSlots = nSlots;
+      header->m_slotSize = slotSize;
+      std::atomic_thread_fence(std::memory_order_release);
+      header->m_magic = segmentMagic;
+
+      return ring;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::unique_ptr<SharedMemoryRing> SharedMemoryRing::open(const std::string &name) {
+      int fd = shm_open(name.c_str(), O_RDWR, 0);
+
+      if (fd < 0) {
+        dqm_error("SharedMemoryRing::open: couldn't open segment '{0}': {1}", name, strerror(errno));
+        return nullptr;
+      }
+
+      struct stat segmentStat;
+
+      if (0 != fstat(fd, &segmentStat) || static_cast<size_t>(segmentStat.st_size) < alignment) {
+        dqm_error("SharedMemoryRing::open: invalid segment '{0}'", name);
+        close(fd);
+        return nullptr;
+      }
+
+      const size_t mappedSize(segmentStat.st_size);
+      void *address = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      close(fd);
+
+      if (MAP_FAILED == address) {
+        dqm_error("SharedMemoryRing::open: couldn't map segment '{0}': {1}", name, strerror(errno));
+        return nullptr;
+      }
+
+      std::unique_ptr<SharedMemoryRing> ring(new SharedMemoryRing(name, false, static_cast<char *>(address), mappedSize));
+      const SegmentHeader *header = reinterpret_cast<const SegmentHeader *>(address);
+
+      if (segmentMagic != header->m_magic || 0 == header->m_nSlots ||
+          alignment + header->m_nSlots * slotStride(header->m_slotSize) > mappedSize) {
+        dqm_error("SharedMemoryRing::open: segment '{0}' is not a valid ring", name);
+        return nullptr;
+      }
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      ring->m_nSlots = header->m_nSlots;
+      ring->m_slotSize = header->m_slotSize;
+
+      return ring;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    SharedMemoryRing::SharedMemoryRing(const std::string &name, bool owner, char *address, size_t mappedSize)
+        : m_name(name), m_owner(owner), m_address(address), m_mappedSize(mappedSize) {
+      /* nop */
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    SharedMemoryRing::~SharedMemoryRing() {
+      munmap(m_address, m_mappedSize);
+
+      if (m_owner)
+        shm_unlink(m_name.c_str());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const std::string &SharedMemoryRing::name() const {
+      return m_name;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int SharedMemoryRing::nSlots() const {
+      return m_nSlots;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t SharedMemoryRing::slotSize() const {
+      return m_slotSize;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SharedMemoryRing::write(const char *data, size_t size, std::string &reference) {
+      if (size > m_slotSize)
+        return false;
+
+      for (unsigned int i = 0; i < m_nSlots; i++) {
+        const uint32_t index((m_nextSlot + i) % m_nSlots);
+        Slot *slot = this->slotAt(index);
+
+        if (0 != slot->m_readers.load())
+          continue;
+
+        // invalidate the slot, then check that no reader pinned it in the meantime.
+        // A reader pinning it from now on sees the invalid sequence and gives up
+        const uint64_t previousSequence(slot->m_sequence.exchange(0));
+
+        if (0 != slot->m_readers.load()) {
+          slot->m_sequence.store(previousSequence);
+          continue;
+        }
+
+        memcpy(reinterpret_cast<char *>(slot) + alignment, data, size);
+        slot->m_size = size;
+        slot->m_sequence.store(++m_sequence);
+        m_nextSlot = (index + 1) % m_nSlots;
+
+        SharedMemoryReference::write(reference, m_name, index, m_sequence, size);
+        return true;
+      }
+
+      return false;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SharedMemoryRing::pin(uint32_t slot, uint64_t sequence, uint64_t size, const char *&data) {
+      if (slot >= m_nSlots || size > m_slotSize || 0 == sequence)
+        return false;
+
+      Slot *pSlot = this->slotAt(slot);
+      pSlot->m_readers.fetch_add(1);
+
+      if (sequence != pSlot->m_sequence.load()) {
+        pSlot->m_readers.fetch_sub(1);
+        return false;
+      }
+
+      data = reinterpret_cast<const char *>(pSlot) + alignment;
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SharedMemoryRing::unpin(uint32_t slot) {
+      if (slot < m_nSlots)
+        this->slotAt(slot)->m_readers.fetch_sub(1);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    SharedMemoryRing::Slot *SharedMemoryRing::slotAt(uint32_t slot) const {
+      return reinterpret_cast<Slot *>(m_address + alignment + slot * slotStride(m_slotSize));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t SharedMemoryRing::slotStride(size_t slotSize) {
+      return alignment + ((slotSize + alignment - 1) / alignment) * alignment;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    bool SharedMemoryReader::attach(const char *reference, size_t size) {
+      std::string ringName;
+      uint32_t slot(0);
+      uint64_t sequence(0), contentsSize(0);
+
+      if (!SharedMemoryReference::read(reference, size, ringName, slot, sequence, contentsSize))
+        return false;
+
+      return (nullptr != this->openRing(ringName));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SharedMemoryReader::read(const char *reference, size_t size, ReadFunction function) {
+      std::string ringName;
+      uint32_t slot(0);
+      uint64_t sequence(0), contentsSize(0);
+
+      if (!SharedMemoryReference::read(reference, size, ringName, slot, sequence, contentsSize)) {
+        dqm_error("SharedMemoryReader::read: malformed shared memory reference");
+        return false;
+      }
+
+      SharedMemoryRing *ring = this->openRing(ringName);
+
+      if (nullptr == ring)
+        return false;
+
+      const char *data(nullptr);
+
+      if (!ring->pin(slot, sequence, contentsSize, data)) {
+        dqm_warning("SharedMemoryReader::read: contents lost, slot {0} of ring '{1}' was rewritten before being read", slot, ringName);
+        return false;
+      }
+
+      try {
+        function(data, contentsSize);
+      } catch (...) {
+        ring->unpin(slot);
+        throw;
+      }
+
+      ring->unpin(slot);
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    SharedMemoryRing *SharedMemoryReader::openRing(const std::string &name) {
+      auto findIter = m_rings.find(name);
+
+      if (m_rings.end() != findIter)
+        return findIter->second.get();
+
+      std::unique_ptr<SharedMemoryRing> ring(SharedMemoryRing::open(name));
+
+      if (nullptr == ring)
+        return nullptr;
+
+      // rings of writers that have gone are not referenced anymore
+      if (m_rings.size() >= 8)
+        m_rings.clear();
+
+      return m_rings.insert(RingMap::value_type(name, std::move(ring))).first->second.get();
+    }
+  }
+}
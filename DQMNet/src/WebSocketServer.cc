@@ -36,6 +36,109 @@ namespace dqm4hep {
 
   namespace net {
     
+    /**
+     *  @brief  The period of the connection queues flush, when some updates are waiting (ms)
+     */
+    static const long queueFlushPeriod = 10;
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    /**
+     *  @brief  Create an unmasked data frame (server to client), prepared once and 
+     *          shared between all the connections speaking the RFC 6455 framing
+     */
+    static message_ptr createSharedFrame(const char *buffer, size_t size, websocketpp::frame::opcode::value opcode) {
+      auto frame = std::make_shared<message_type>(message_type::con_msg_man_ptr(), opcode, size);
+      websocketpp::frame::basic_header header(opcode, size, true, false, false);
+      websocketpp::frame::extended_header extendedHeader(size);
+      frame->set_header(websocketpp::frame::prepare_header(header, extendedHeader));
+      frame->set_payload(buffer, size);
+      frame->set_prepared(true);
+      return frame;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    /**
+     *  @brief  Get the update message, created on first use for all the connections
+     *          sharing the same framing
+     */
+    static const message_ptr &updateMessage(message_ptr &message, const char *buffer, size_t size, websocketpp::frame::opcode::value opcode, bool sharedFrame) {
+      if(nullptr == message) {
+        if(sharedFrame) {
+          message = createSharedFrame(buffer, size, opcode);
+        }
+        else {
+          // framed by the connection itself
+          message = std::make_shared<message_type>(message_type::con_msg_man_ptr(), opcode, size);
+          message->set_payload(buffer, size);
+        }
+      }
+      return message;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    void WsBinaryFrame::writeVarint(std::string &output, uint32_t value) {
+      while(value >= 0x80) {
+        output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+      }
+      output.push_back(static_cast<char>(value));
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool WsBinaryFrame::readVarint(const char *&buffer, const char *end, uint32_t &value) {
+      const char *current = buffer;
+      uint32_t result = 0;
+      for(unsigned int shift = 0 ; shift < 32 ; shift += 7) {
+        if(current >= end) {
+          return false;
+        }
+        const unsigned char byte = static_cast<unsigned char>(*current++);
+        // the fifth byte only holds the 4 high bits
+        if(28 == shift and byte > 0x0F) {
+          return false;
+        }
+        result |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if(0 == (byte & 0x80)) {
+          buffer = current;
+          value = result;
+          return true;
+        }
+      }
+      return false;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void WsBinaryFrame::write(std::string &output, uint32_t serviceId, Flags flags, const char *payload, size_t size) {
+      writeVarint(output, serviceId);
+      output.push_back(static_cast<char>(flags));
+      output.append(payload, size);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool WsBinaryFrame::read(const char *buffer, size_t size, uint32_t &serviceId, Flags &flags, const char *&payload, size_t &payloadSize) {
+      const char *end = buffer + size;
+      if(not readVarint(buffer, end, serviceId) or buffer >= end) {
+        return false;
+      }
+      const unsigned char flagsByte = static_cast<unsigned char>(*buffer++);
+      if(flagsByte > SUBSCRIBED) {
+        return false;
+      }
+      flags = static_cast<Flags>(flagsByte);
+      payload = buffer;
+      payloadSize = end - buffer;
+      return true;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     WsServiceBase::WsServiceBase(WsServer *s, const std::string &n, ServiceType t) :
       m_server(s),
       m_name(n),
@@ -69,13 +172,20 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
-    WsService::WsService(WsServer *s, const std::string &n) :
-      WsServiceBase(s, n, SERVICE_TYPE) {
+    WsService::WsService(WsServer *s, const std::string &n, uint32_t i) :
+      WsServiceBase(s, n, SERVICE_TYPE),
+      m_id(i) {
         
     }
     
     //-------------------------------------------------------------------------------------------------
     
+    uint32_t WsService::id() const {
+      return m_id;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void WsService::send(const char *buffer, size_t size, bool containsBinary) {
       server()->send(this, buffer, size, containsBinary);
     }
@@ -112,7 +222,8 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     WsServer::WsServer() :
-      m_server() {
+      m_server(),
+      m_nThreads(std::max(1u, std::thread::hardware_concurrency())) {
       
     }
     
@@ -124,6 +235,7 @@ namespace dqm4hep {
         delete svc.second;
       }
       m_serviceConnections.clear();
+      m_connectionQueues.clear();
       m_serviceMap.clear();
     }
     
@@ -137,6 +249,52 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
+    void WsServer::setNThreads(unsigned int nThreads) {
+      if(not m_running.load()) {
+        m_nThreads = std::max(1u, nThreads);
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void WsServer::setMaxQueueSize(size_t maxSize) {
+      m_maxQueueSize = std::max(size_t(1), maxSize);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void WsServer::setMaxBufferedAmount(size_t amount) {
+      m_maxBufferedAmount = amount;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::vector<WsConnectionStats> WsServer::connectionStats() const {
+      std::lock_guard<std::mutex> lock(m_connectionMutex);
+      std::vector<WsConnectionStats> stats;
+      for(auto &service : m_serviceConnections) {
+        for(auto &con : service.second) {
+          auto findIter = m_connectionQueues.find(con);
+          if(m_connectionQueues.end() == findIter) {
+            continue;
+          }
+          ConnectionQueue &queue(*findIter->second);
+          std::lock_guard<std::mutex> queueLock(queue.m_mutex);
+          WsConnectionStats conStats;
+          conStats.m_service = service.first;
+          conStats.m_remote = con->get_remote_endpoint();
+          conStats.m_queueDepth = queue.m_messages.size();
+          conStats.m_bufferedAmount = con->get_buffered_amount();
+          conStats.m_nSent = queue.m_messages.nSent();
+          conStats.m_nDropped = queue.m_messages.nDropped();
+          stats.push_back(conStats);
+        }
+      }
+      return stats;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     WsService *WsServer::createService(const std::string &name) {
       std::lock_guard<std::recursive_mutex> lock(m_mutex);
       auto findIter = m_serviceMap.find(name);
@@ -144,8 +302,9 @@ namespace dqm4hep {
         dqm_error("Couldn't create service '{0}' twice", name);
         return nullptr; 
       }
-      WsService *service = new WsService(this, name);
+      WsService *service = new WsService(this, name, m_nextServiceId++);
       m_serviceMap.insert(ServiceMap::value_type(name, service));
+      std::lock_guard<std::mutex> conLock(m_connectionMutex);
       m_serviceConnections[name] = connection_set();
       return service;
     }
@@ -194,6 +353,22 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
+    WsService *WsServer::findService(uint32_t id) {
+      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      for(auto &service : m_serviceMap) {
+        if(service.second->type() != SERVICE_TYPE) {
+          continue;
+        }
+        WsService *wsService = dynamic_cast<WsService*>(service.second);
+        if(wsService->id() == id) {
+          return wsService;
+        }
+      }
+      return nullptr;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     WsCommandHandler *WsServer::findCommandHandler(const std::string &name) {
       std::lock_guard<std::recursive_mutex> lock(m_mutex);
       auto findIter = m_serviceMap.find(name);
@@ -243,8 +418,10 @@ namespace dqm4hep {
       // Start the server accept loop
       m_server.start_accept();
 
-      // Start the ASIO io_service run loop
-      m_thread = std::thread(&server::run, std::ref(m_server));
+      // Start the ASIO io_service run loop in the thread pool
+      for(unsigned int t=0 ; t<m_nThreads ; t++) {
+        m_threads.push_back(std::thread(&server::run, std::ref(m_server)));
+      }
       m_running = true;
     }
     
@@ -254,8 +431,16 @@ namespace dqm4hep {
       if(m_running.load()) {
         // std::lock_guard<std::recursive_mutex> lock(m_mutex);
         m_server.stop();
-        m_thread.join();
-        m_serviceConnections.clear();
+        for(auto &thread : m_threads) {
+          thread.join();
+        }
+        m_threads.clear();
+        std::lock_guard<std::mutex> conLock(m_connectionMutex);
+        for(auto &service : m_serviceConnections) {
+          service.second.clear();
+        }
+        m_connectionQueues.clear();
+        m_flushScheduled = false;
         m_running = false; 
       }
     }
@@ -276,13 +461,14 @@ namespace dqm4hep {
       if(m_serviceMap.end() == findIter) {
         return;
       }
-      // remove service subscriber (if subscribed)
+      // remove service subscriber (if subscribed).
+      // Binary connections may have subscribed to several services
       if(findIter->second->type() == SERVICE_TYPE) {
-        auto findIter2 = m_serviceConnections.find(serviceName);
-        if(findIter2 == m_serviceConnections.end()) {
-          return;            
+        std::lock_guard<std::mutex> conLock(m_connectionMutex);
+        m_connectionQueues.erase(con);
+        for(auto &service : m_serviceConnections) {
+          service.second.erase(con);
         }
-        findIter2->second.erase(con);
       }
     }
     
@@ -317,20 +503,93 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void WsServer::send(WsService *service, const char *buffer, size_t size, bool containsBinary) {
-      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      std::lock_guard<std::mutex> lock(m_connectionMutex);
       auto findIter = m_serviceConnections.find(service->name());
-      if(findIter == m_serviceConnections.end()) {
+      if(findIter == m_serviceConnections.end() or findIter->second.empty()) {
         return;
       }
       websocketpp::frame::opcode::value opcode = containsBinary ? websocketpp::frame::opcode::binary : websocketpp::frame::opcode::text;
+      // serialize once per framing for all the connections
+      message_ptr frame = nullptr, message = nullptr, binaryFrame = nullptr, binaryMessage = nullptr;
+      std::string binaryUpdate;
+      const size_t maxQueueSize = m_maxQueueSize.load();
+      bool pending = false;
       for(auto &con : findIter->second) {
-        m_server.send(con, buffer, size, opcode);
+        auto findIter2 = m_connectionQueues.find(con);
+        if(m_connectionQueues.end() == findIter2) {
+          continue;
+        }
+        ConnectionQueue &queue(*findIter2->second);
+        std::lock_guard<std::mutex> queueLock(queue.m_mutex);
+        message_ptr update = nullptr;
+        if(queue.m_binary) {
+          if(binaryUpdate.empty()) {
+            WsBinaryFrame::write(binaryUpdate, service->id(), WsBinaryFrame::UPDATE, buffer, size);
+          }
+          update = updateMessage(queue.m_sharedFrames ? binaryFrame : binaryMessage, binaryUpdate.data(), binaryUpdate.size(), websocketpp::frame::opcode::binary, queue.m_sharedFrames);
+        }
+        else {
+          update = updateMessage(queue.m_sharedFrames ? frame : message, buffer, size, opcode, queue.m_sharedFrames);
+        }
+        // drop the oldest update if the connection can't follow
+        queue.m_messages.push(update, maxQueueSize);
+        flushQueue(con, queue);
+        pending = pending or not queue.m_messages.empty();
+      }
+      if(pending) {
+        scheduleFlush();
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void WsServer::flushQueue(const server::connection_ptr &con, ConnectionQueue &queue) {
+      queue.m_messages.flush(m_maxBufferedAmount.load(), [&con]() {
+        return con->get_buffered_amount();
+      }, [&con](const message_ptr &message) {
+        return not con->send(message);
+      });
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void WsServer::flushQueues() {
+      m_flushScheduled = false;
+      std::lock_guard<std::mutex> lock(m_connectionMutex);
+      bool pending = false;
+      for(auto &connection : m_connectionQueues) {
+        ConnectionQueue &queue(*connection.second);
+        std::lock_guard<std::mutex> queueLock(queue.m_mutex);
+        flushQueue(connection.first, queue);
+        pending = pending or not queue.m_messages.empty();
+      }
+      if(pending) {
+        scheduleFlush();
       }
     }
     
     //-------------------------------------------------------------------------------------------------
     
+    void WsServer::scheduleFlush() {
+      if(not m_running.load() or m_flushScheduled.exchange(true)) {
+        return;
+      }
+      m_server.set_timer(queueFlushPeriod, [this](const websocketpp::lib::error_code &ec) {
+        if(ec) {
+          m_flushScheduled = false;
+          return;
+        }
+        flushQueues();
+      });
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void WsServer::onServiceMessage(const std::string &serviceName, connection_hdl hdl, message_ptr msg) {
+      if(websocketpp::frame::opcode::binary == msg->get_opcode()) {
+        onBinaryServiceMessage(hdl, msg);
+        return;
+      }
       server::connection_ptr con = m_server.get_con_from_hdl(hdl);
       auto findIter2 = m_serviceConnections.find(serviceName);
       // handle subscription/un-subscription to/from service
@@ -339,7 +598,19 @@ namespace dqm4hep {
           m_server.close(hdl, websocketpp::close::status::normal, "Internal error: service '" + serviceName + "' not available !");
           return;
         }
-        // insert new subscriber
+        // insert new subscriber with its outbound queue
+        std::lock_guard<std::mutex> conLock(m_connectionMutex);
+        auto &queue = m_connectionQueues[con];
+        if(nullptr == queue) {
+          queue = std::make_shared<ConnectionQueue>();
+          // RFC 6455 and its last drafts share the same framing
+          const std::string &version = con->get_request_header("Sec-WebSocket-Version");
+          queue->m_sharedFrames = (version == "13" or version == "8" or version == "7");
+        }
+        else if(queue->m_binary) {
+          m_server.close(hdl, websocketpp::close::status::protocol_error, "Text subscription on a binary connection !");
+          return;
+        }
         findIter2->second.insert(con);
         m_server.send(hdl, "ok", websocketpp::frame::opcode::text);
         return;
@@ -350,7 +621,9 @@ namespace dqm4hep {
           return;
         }
         // remove subscriber
+        std::lock_guard<std::mutex> conLock(m_connectionMutex);
         findIter2->second.erase(con);
+        m_connectionQueues.erase(con);
         m_server.send(hdl, "ok", websocketpp::frame::opcode::text);
         return;
       }
@@ -362,6 +635,73 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
+    void WsServer::onBinaryServiceMessage(connection_hdl hdl, message_ptr msg) {
+      server::connection_ptr con = m_server.get_con_from_hdl(hdl);
+      const std::string &frame = msg->get_payload();
+      uint32_t serviceId(0);
+      WsBinaryFrame::Flags flags(WsBinaryFrame::UPDATE);
+      const char *payload(nullptr);
+      size_t payloadSize(0);
+      // clients only send control frames
+      if(not WsBinaryFrame::read(frame.data(), frame.size(), serviceId, flags, payload, payloadSize) or 0 != serviceId) {
+        m_server.close(hdl, websocketpp::close::status::protocol_error, "Malformed binary frame !");
+        return;
+      }
+      if(WsBinaryFrame::SUBSCRIBE == flags) {
+        const std::string serviceName(payload, payloadSize);
+        WsService *service = findService(serviceName);
+        if(nullptr == service) {
+          m_server.close(hdl, websocketpp::close::status::normal, "Service '" + serviceName + "' not available !");
+          return;
+        }
+        std::lock_guard<std::mutex> conLock(m_connectionMutex);
+        auto &queue = m_connectionQueues[con];
+        if(nullptr == queue) {
+          queue = std::make_shared<ConnectionQueue>();
+          const std::string &version = con->get_request_header("Sec-WebSocket-Version");
+          queue->m_sharedFrames = (version == "13" or version == "8" or version == "7");
+          queue->m_binary = true;
+        }
+        else if(not queue->m_binary) {
+          m_server.close(hdl, websocketpp::close::status::protocol_error, "Binary subscription on a text connection !");
+          return;
+        }
+        m_serviceConnections[serviceName].insert(con);
+        // acknowledge with the service id used in the updates
+        std::string subscribed, ackPayload;
+        WsBinaryFrame::writeVarint(ackPayload, service->id());
+        ackPayload += serviceName;
+        WsBinaryFrame::write(subscribed, 0, WsBinaryFrame::SUBSCRIBED, ackPayload.data(), ackPayload.size());
+        m_server.send(hdl, subscribed, websocketpp::frame::opcode::binary);
+        return;
+      }
+      else if(WsBinaryFrame::UNSUBSCRIBE == flags) {
+        uint32_t unsubscribeId(0);
+        WsService *service = WsBinaryFrame::readVarint(payload, payload + payloadSize, unsubscribeId) ? findService(unsubscribeId) : nullptr;
+        if(nullptr == service) {
+          m_server.close(hdl, websocketpp::close::status::protocol_error, "Unsubscription from an unknown service !");
+          return;
+        }
+        std::lock_guard<std::mutex> conLock(m_connectionMutex);
+        m_serviceConnections[service->name()].erase(con);
+        // drop the queue with the last subscription
+        bool subscribed(false);
+        for(auto &serviceCons : m_serviceConnections) {
+          subscribed = subscribed or (serviceCons.second.count(con) > 0);
+        }
+        if(not subscribed) {
+          m_connectionQueues.erase(con);
+        }
+        return;
+      }
+      else {
+        m_server.close(hdl, websocketpp::close::status::protocol_error, "Unexpected binary frame !");
+        return;
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void WsServer::onCommandMessage(const std::string &serviceName, connection_hdl hdl, message_ptr msg) {
       WsCommandHandler *command = findCommandHandler(serviceName);
       if(nullptr == command) {
@@ -38,8 +38,12 @@
 #include "dqm4hep/StatusCodes.h"
 #include "dqm4hep/AppTimer.h"
 
+// -- std headers
 #include <mutex>
 #include <atomic>
+#include <array>
+#include <deque>
+#include <condition_variable>
 
 namespace dqm4hep {
 
@@ -61,7 +65,8 @@ namespace dqm4hep {
        
       /**
        *  @brief  Post an event in the event queue. 
-       *          The event queue is sorted by event priority.
+       *          The event queue is sorted by event priority. Events 
+       *          with the same priority are processed in arrival order.
        *          The event pointer ownership is taken by the event loop.
        *          
        *  @param  pAppEvent the event to post
@@ -95,7 +100,8 @@ namespace dqm4hep {
        *          This is a blocking function. To exit the event loop,
        *          post or send a QuitEvent event.
        *          Posting or sending events is thread safe, even when
-       *          an event is being processed. 
+       *          an event is being processed. The calling thread sleeps
+       *          while the event queue is empty.
        */
       int exec();
       
@@ -166,14 +172,45 @@ namespace dqm4hep {
       template <typename Predicate>
       int count(Predicate predicate);
       
+      /**
+       *  @brief  Get the total number of events currently in the event queue
+       */
+      std::size_t size();
+      
+    private:
+      typedef std::chrono::steady_clock TimerClock;
+      
+      /// A timer deadline in the timer queue
+      struct TimerDeadline {
+        TimerClock::time_point   m_deadline;
+        AppTimer                *m_timer;
+        unsigned long long       m_scheduleId;
+      };
+      
+      /// Order the timer queue by earliest deadline first
+      struct DeadlineCompare {
+        bool operator()(const TimerDeadline& lhs, const TimerDeadline& rhs) const {
+          return lhs.m_deadline > rhs.m_deadline;
+        }
+      };
+      
+      static constexpr int                         MaxPriority = 100;
+      /// One FIFO queue per priority level, indexed by priority
+      typedef std::array<std::deque<AppEvent*>, MaxPriority+1> EventQueue;
+      typedef std::priority_queue<TimerDeadline, std::vector<TimerDeadline>, DeadlineCompare> TimerQueue;
+      
     private:
       void processEvent(AppEvent *pAppEvent);
+      AppEvent *popEvent();
+      void setQuitFlag();
       
       void timerThread();
       void addTimer(AppTimer *timer);
       void startTimer(AppTimer *timer);
       void stopTimer(AppTimer *timer);
       void removeTimer(AppTimer *timer);
+      void scheduleTimer(AppTimer *timer, const TimerClock::time_point &deadline);
+      bool isScheduled(const TimerDeadline &deadline) const;
       
     private:
       // not copiable, not movable
@@ -181,14 +218,10 @@ namespace dqm4hep {
       AppEventLoop(const AppEventLoop&) = delete;
       AppEventLoop(AppEventLoop&&) = delete;
       
-      struct QueueCompare {
-        bool operator()(AppEvent* lhs, AppEvent* rhs) const {
-          return lhs->priority() < rhs->priority();
-        }
-      };
-      
-      std::set<AppEvent*,QueueCompare>             m_eventQueue = {};
-      std::recursive_mutex                         m_queueMutex = {};
+      EventQueue                                   m_eventQueue = {};
+      std::size_t                                  m_queueSize = {0};
+      std::mutex                                   m_queueMutex = {};
+      std::condition_variable                      m_queueCondition = {};
       std::recursive_mutex                         m_eventMutex = {};
       std::recursive_mutex                         m_exceptionMutex = {};
       std::recursive_mutex                         m_timerMutex = {};
@@ -200,6 +233,9 @@ namespace dqm4hep {
       std::thread                                  m_timerThread = {};
       std::atomic_bool                             m_timerStopFlag = {false};
       std::set<AppTimer*>                          m_timers = {};
+      TimerQueue                                   m_timerQueue = {};
+      std::condition_variable_any                  m_timerCondition = {};
+      unsigned long long                           m_timerScheduleId = {0};
     };
     
     //-------------------------------------------------------------------------------------------------
@@ -239,8 +275,12 @@ namespace dqm4hep {
     
     template <typename Predicate>
     inline int AppEventLoop::count(Predicate predicate) {
-      std::lock_guard<std::recursive_mutex> lock(m_queueMutex);
-      return std::count_if(m_eventQueue.begin(), m_eventQueue.begin(), predicate);
+      std::lock_guard<std::mutex> lock(m_queueMutex);
+      int counter = 0;
+      for(const auto &level : m_eventQueue) {
+        counter += std::count_if(level.begin(), level.end(), predicate);
+      }
+      return counter;
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -114,8 +114,9 @@ namespace dqm4hep {
       core::Signal<>               m_signal = {};
       /// Whether the timer is active
       std::atomic_bool             m_active = {false};
-      /// The time point when the timer was started
-      core::TimePoint              m_startTime = {};
+      /// The id of the last scheduling of the timer in the event loop timer queue.
+      /// Any queued deadline with a different id is outdated
+      unsigned long long           m_scheduleId = {0};
     };
   
   }
@@ -193,6 +193,19 @@ namespace dqm4hep {
        */
       bool noServer() const;
       
+      /**
+       *  @brief  Enable or disable sending the remote log messages in batches (see RemoteLogger).
+       *          Disabled by default. Must be called before init(), e.g in the ctor or in parseCmdLine()
+       *  
+       *  @param  enable whether to enable / disable the log batching 
+       */
+      void setLogBatching(bool enable);
+      
+      /**
+       *  @brief  Whether the remote log messages are sent in batches
+       */
+      bool logBatching() const;
+      
       /**
        *  @brief  Initialize the application.
        *          Calls userInit()
@@ -294,12 +307,15 @@ namespace dqm4hep {
        *          respectively using the method RequestEvent::request() and 
        *          RequestEvent::response() in the callback method Application::onEvent().
        *          ATTN! The server thread will not be released until the event has
-       *          been processed by the sendEvent method !
+       *          been processed by the sendEvent method, unless the request is
+       *          executed out of the server thread (see net::RequestHandler::Execution) !
        *  
        *  @param requestName the request name to handle
+       *  @param execution the thread waiting for the event processing (server thread by default)
        */
       template <typename Controller>
-      void createRequestHandler(const std::string &requestName, Controller *controller, void (Controller::*function)(const net::Buffer &, net::Buffer &));
+      void createRequestHandler(const std::string &requestName, Controller *controller, void (Controller::*function)(const net::Buffer &, net::Buffer &),
+                                net::RequestHandler::Execution execution = net::RequestHandler::INLINE);
       
       /**
        *  @brief  Create a command handler. On command reception, the content is posted
@@ -485,6 +501,8 @@ namespace dqm4hep {
       core::ProcessStats           m_stats = {};
       ///
       bool                         m_noServer = {false};
+      /// Whether the remote log messages are sent in batches
+      bool                         m_logBatching = {false};
       /// The main server interface of the application
       ServerPtr                    m_server = {nullptr};
       /// The service for application state, updated when the state changes
@@ -505,6 +523,8 @@ namespace dqm4hep {
       LogLevel                     m_logLevel = {spdlog::level::info};
       ///
       AppTimer*                    m_appStatTimer = {nullptr};
+      /// The number of buffer allocations at the last statistics update
+      uint64_t                     m_lastBufferAllocations = {0};
       
     protected:
       /// The application event loop
@@ -586,7 +606,8 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     template <typename Controller>
-    inline void Application::createRequestHandler(const std::string &requestName, Controller *controller, void (Controller::*function)(const net::Buffer &, net::Buffer &)) {
+    inline void Application::createRequestHandler(const std::string &requestName, Controller *controller, void (Controller::*function)(const net::Buffer &, net::Buffer &),
+                                                  net::RequestHandler::Execution execution) {
       if(not m_server) {
         dqm_error( "Application::createRequestHandler(): couldn't create request handler '{0}', server is not yet allocated", requestName );
         throw core::StatusCodeException(core::STATUS_CODE_NOT_INITIALIZED);
@@ -600,7 +621,7 @@ namespace dqm4hep {
       
       auto handler = std::make_shared<NetworkHandler>(m_eventLoop, requestName, controller, function);
       m_serviceHandlerPtrMap.insert(NetworkHandlerPtrMap::value_type(requestName, handler));
-      m_server->createRequestHandler(requestName, handler.get(), &Application::NetworkHandler::sendRequestEvent);      
+      m_server->createRequestHandler(requestName, handler.get(), &Application::NetworkHandler::sendRequestEvent, execution);      
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -210,7 +210,7 @@ namespace dqm4hep {
       /// The end of cycle event priority in the event loop 
       std::atomic_int                  m_eventPriority = {60};
       /// The last time point when the increement method was called
-      core::TimePoint                  m_lastCounterIncrement = {};
+      std::atomic<core::TimePoint>     m_lastCounterIncrement = {};
     };
 
   }
@@ -0,0 +1,327 @@
+/// \file ElementPublisher.h
+/*
+ *
+ * ElementPublisher.h header template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+#ifndef DQM4HEP_ELEMENTPUBLISHER_H
+#define DQM4HEP_ELEMENTPUBLISHER_H
+
+// -- dqm4hep headers
+#include "dqm4hep/Internal.h"
+#include "dqm4hep/StatusCodes.h"
+#include "dqm4hep/OnlineElement.h"
+
+// -- root headers
+#include <TBuffer.h>
+#include <TBufferFile.h>
+
+class TH1;
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /**
+     *  @brief  ElementPublication class.
+     *          Defines the binary format of a monitor element publication,
+     *          sent by a module application at end of cycle:
+     *
+     *  - header: protocol version (uint), module name (string), run number (int),
+     *            publication sequence number (ulong64), full publication flag (bool),
+     *            number of elements (uint)
+     *  - for each element: path (string), name (string), encoding (uchar),
+     *            element version (ulong64)
+     *    - FULL_ELEMENT: the element written with OnlineElement::write()
+     *    - HISTOGRAM_DELTA: base version (ulong64), quality reports (json string),
+     *            number of stats (uchar), stats (double), entries (double),
+     *            whether bin errors are sent (bool), number of changed bins (varint),
+     *            then for each changed bin: the bin gap from the previous changed bin (varint),
+     *            the bin content (double) and the bin sum of weights square (double, optional)
+     *
+     *  A delta can only be applied on the element version it refers to (base version).
+     */
+    class ElementPublication {
+    public:
+      /**
+       *  @brief  Encoding enumerator
+       */
+      enum Encoding {
+        FULL_ELEMENT = 0,
+        HISTOGRAM_DELTA = 1
+      };
+
+      /**
+       *  @brief  Header struct
+       */
+      struct Header {
+        std::string           m_moduleName = {""};       ///< The publishing module name
+        int                   m_runNumber = {0};         ///< The run number
+        unsigned long long    m_sequence = {0};          ///< The publication sequence number
+        bool                  m_fullPublication = {false}; ///< Whether all elements are written in full
+        unsigned int          m_nElements = {0};         ///< The number of elements in the publication
+      };
+
+      /// The current protocol version
+      static const unsigned int protocolVersion;
+
+      /**
+       *  @brief  Write a variable length unsigned integer
+       *
+       *  @param  buffer the buffer to write to
+       *  @param  value the value to write
+       */
+      static void writeVarint(TBuffer &buffer, unsigned long long value);
+
+      /**
+       *  @brief  Read a variable length unsigned integer
+       *
+       *  @param  buffer the buffer to read from
+       *  @param  value the value to receive
+       */
+      static void readVarint(TBuffer &buffer, unsigned long long &value);
+
+      /**
+       *  @brief  Whether the histogram can be published as a delta (bin contents only).
+       *          Profiles and histograms with non-standard bin storage are always published in full
+       *
+       *  @param  histogram the histogram to check
+       */
+      static bool supportsDelta(const TH1 *histogram);
+
+      /**
+       *  @brief  Get the number of stats (see TH1::GetStats()) of a histogram supporting deltas
+       *
+       *  @param  histogram the histogram
+       */
+      static unsigned int nStats(const TH1 *histogram);
+
+      /**
+       *  @brief  Convert the quality reports to a json string
+       *
+       *  @param  reports the quality reports
+       */
+      static std::string reportsToString(const core::QReportMap &reports);
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  ElementPublisher class.
+     *          Writes the monitor element publications of a module application.
+     *          Only the elements changed since the last publication are written.
+     *          Histograms are written as a delta of the bins changed since their
+     *          last publication, other objects are written in full.
+     *          All elements are written in full every N publications and on request,
+     *          so that new receivers can catch up.
+     *          Not thread safe.
+     */
+    class ElementPublisher {
+    public:
+      ElementPublisher(const ElementPublisher&) = delete;
+      ElementPublisher& operator=(const ElementPublisher&) = delete;
+
+      /**
+       *  @brief  Constructor
+       */
+      ElementPublisher() = default;
+
+      /**
+       *  @brief  Set the module name written in publications
+       *
+       *  @param  moduleName the module name
+       */
+      void setModuleName(const std::string &moduleName);
+
+      /**
+       *  @brief  Set the number of publications between two full publications.
+       *          0 means never, except on request
+       *
+       *  @param  period the full publication period
+       */
+      void setFullPublicationPeriod(unsigned int period);
+
+      /**
+       *  @brief  Get the number of publications between two full publications
+       */
+      unsigned int fullPublicationPeriod() const;
+
+      /**
+       *  @brief  Request the next publication to be a full publication
+       */
+      void requestFullPublication();
+
+      /**
+       *  @brief  Write a publication of the monitor elements.
+       *          Elements unchanged since their last publication are not written
+       *
+       *  @param  runNumber the current run number
+       *  @param  elements the candidate elements to publish
+       *  @param  buffer the buffer to write to
+       */
+      core::StatusCode write(int runNumber, const OnlineElementPtrList &elements, TBuffer &buffer);
+
+      /**
+       *  @brief  Get the number of elements written in the last publication
+       */
+      unsigned int nWrittenElements() const;
+
+      /**
+       *  @brief  Get the number of elements written as delta in the last publication
+       */
+      unsigned int nDeltaElements() const;
+
+      /**
+       *  @brief  Forget all the published element versions.
+       *          The next publication is a full publication
+       */
+      void clear();
+
+    private:
+      /**
+       *  @brief  ElementState struct.
+       *          The state of an element at its last publication
+       */
+      struct ElementState {
+        unsigned long long    m_version = {0};           ///< The element version
+        std::size_t           m_hash = {0};              ///< The hash of the element written in full
+        std::string           m_reports = {""};          ///< The quality reports (json)
+        double                m_entries = {0};           ///< The histogram entries
+        std::vector<double>   m_stats = {};              ///< The histogram stats
+        std::vector<double>   m_contents = {};           ///< The histogram bin contents
+        std::vector<double>   m_sumw2 = {};              ///< The histogram sum of weights square
+      };
+
+      /**
+       *  @brief  Write an element in full if changed.
+       *          Returns false if the element is unchanged
+       */
+      bool writeFull(OnlineElementPtr element, ElementState &state, bool force, TBuffer &buffer);
+
+      /**
+       *  @brief  Find the histogram bins changed since the last publication (see m_changedBins).
+       *          Returns false if the histogram can't be published as a delta
+       */
+      bool findChangedBins(const TH1 *histogram, const ElementState &state);
+
+      /**
+       *  @brief  Write a histogram delta with the changed bins
+       */
+      void writeDelta(const TH1 *histogram, ElementState &state, const std::string &reports, TBuffer &buffer);
+
+      /**
+       *  @brief  Save the histogram state after publication
+       */
+      void saveHistogram(const TH1 *histogram, ElementState &state);
+
+    private:
+      typedef std::map<std::string, ElementState> ElementStateMap;
+
+      std::string                m_moduleName = {""};             ///< The module name
+      unsigned int               m_fullPublicationPeriod = {10};  ///< The number of publications between two full publications
+      bool                       m_fullPublicationRequested = {true}; ///< Whether the next publication is a full publication
+      unsigned long long         m_sequence = {0};                ///< The publication sequence number
+      unsigned int               m_nWrittenElements = {0};        ///< The number of elements written in the last publication
+      unsigned int               m_nDeltaElements = {0};          ///< The number of deltas written in the last publication
+      ElementStateMap            m_elementStates = {};            ///< The element states at last publication
+      std::vector<int>           m_changedBins = {};              ///< The changed bins of the current histogram
+      TBufferFile                m_elementBuffer = {TBuffer::kWrite, 64*1024};  ///< The buffer to serialize single elements (change detection)
+    };
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  ElementPublicationReader class.
+     *          Reads the publications of a single module and keeps the
+     *          latest version of each published element.
+     *          Deltas are applied on the stored elements. A delta referring
+     *          to a version that was not received is ignored until the
+     *          next full publication of the element.
+     *          Not thread safe.
+     */
+    class ElementPublicationReader {
+    public:
+      ElementPublicationReader(const ElementPublicationReader&) = delete;
+      ElementPublicationReader& operator=(const ElementPublicationReader&) = delete;
+
+      /**
+       *  @brief  Constructor
+       */
+      ElementPublicationReader() = default;
+
+      /**
+       *  @brief  Read a publication and update the stored elements.
+       *
+       *  @param  buffer the buffer to read from
+       *  @param  header the publication header to receive
+       *  @param  updatedElements the elements updated by the publication
+       */
+      core::StatusCode read(TBuffer &buffer, ElementPublication::Header &header, OnlineElementPtrList &updatedElements);
+
+      /**
+       *  @brief  Get the number of deltas that couldn't be applied in the last read publication.
+       *          A non zero value means that a full publication should be requested
+       */
+      unsigned int nMissedDeltas() const;
+
+      /**
+       *  @brief  Get all the stored elements
+       *
+       *  @param  elements the list of elements to receive
+       */
+      void elements(OnlineElementPtrList &elements) const;
+
+      /**
+       *  @brief  Remove all the stored elements
+       */
+      void clear();
+
+    private:
+      /**
+       *  @brief  ElementEntry struct
+       */
+      struct ElementEntry {
+        unsigned long long    m_version = {0};           ///< The element version
+        OnlineElementPtr      m_element = {nullptr};     ///< The element
+      };
+      typedef std::map<std::string, ElementEntry> ElementEntryMap;
+
+      /**
+       *  @brief  Read a histogram delta and apply it on the entry if possible.
+       *          Returns false if the delta could not be applied (data are skipped)
+       */
+      bool readDelta(TBuffer &buffer, ElementEntry *entry, unsigned long long version);
+
+    private:
+      ElementEntryMap            m_elements = {};                 ///< The stored elements
+      unsigned int               m_nMissedDeltas = {0};           ///< The number of missed deltas in the last publication
+    };
+
+  }
+
+}
+
+#endif  //  DQM4HEP_ELEMENTPUBLISHER_H
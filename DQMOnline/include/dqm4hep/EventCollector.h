@@ -67,6 +67,15 @@ namespace dqm4hep {
 
     private:
       void handleRegistration(const net::Buffer &request, net::Buffer &response);
+      
+      /**
+       *  @brief  Check the streamer ids sent by a source at registration and record them.
+       *          Two streamers with the same id can't be used by the sources of the collector
+       *
+       *  @param  streamers the source streamers (name -> id)
+       *  @param  message the error message to receive
+       */
+      bool registerStreamers(const core::json &streamers, std::string &message);
       void handleClientExit(StoreEvent<int> *event);
       void handleCollectEvent(const net::Buffer &buffer);
       void handleClientUnregistration(const net::Buffer &buffer);
@@ -86,7 +95,7 @@ namespace dqm4hep {
         
         int                  m_clientId = {0};
         std::string          m_name = {""};
-        std::string          m_streamerName = {""};
+        core::StringVector   m_streamers = {};
         core::StringVector   m_collectors = {};
         core::StringMap      m_hostInfo = {};
         net::Buffer          m_buffer = {};
@@ -97,6 +106,11 @@ namespace dqm4hep {
       
       std::shared_ptr<TCLAP::CmdLine>     m_cmdLine = nullptr;
       SourceInfoMap                       m_sourceInfoMap = {};
+      std::map<uint16_t, std::string>     m_streamers = {};
+      net::BufferPool                     m_bufferPool = {64};
+      net::Codec::Type                    m_codec = {net::Codec::NONE};
+      int                                 m_codecLevel = {0};
+      unsigned int                        m_sharedMemorySlots = {8};
       core::TimePoint                     m_lastStatCall10 = {};
       core::TimePoint                     m_lastStatCall60 = {};
       unsigned int                        m_nCollectedEvents10 = {0};
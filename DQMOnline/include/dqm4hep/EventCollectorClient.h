@@ -98,7 +98,17 @@ namespace dqm4hep {
       
     private:
       void setUpdateMode(const std::string &source, bool receiveUpdates);
-      core::EventPtr readEvent(const net::Buffer &buffer);
+      
+      /**
+       *  @brief  Read a single event or a batch of events. On failure, 
+       *          the events read before the failing one are still appended.
+       *          A buffer not owning its memory (dim memory) is copied once,
+       *          then all the events are read in place from this copy
+       *
+       *  @param  buffer the buffer to read
+       *  @param  events the list of events to append to
+       */
+      void readEvents(const net::Buffer &buffer, core::EventList &events);
 
     private:
       using EventUpdateSignal = core::Signal<core::EventPtr>;
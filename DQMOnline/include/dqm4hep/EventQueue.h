@@ -0,0 +1,192 @@
+/// \file EventQueue.h
+/*
+ *
+ * EventQueue.h header template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ * 
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ * 
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+#ifndef DQM4HEP_EVENTQUEUE_H
+#define DQM4HEP_EVENTQUEUE_H
+
+// -- dqm4hep headers
+#include "dqm4hep/Internal.h"
+#include "dqm4hep/StatusCodes.h"
+#include "dqm4hep/Event.h"
+
+// -- std headers
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+namespace dqm4hep {
+
+  namespace online {
+    
+    class EventQueue;
+    typedef std::shared_ptr<EventQueue> EventQueuePtr;
+
+    /**
+     *  @brief  EventQueue class.
+     *          A bounded lock-free multi-producer queue of physics events.
+     *          Events are pushed from the network threads (or the event reader)
+     *          and popped by the application event loop. When the queue is full, 
+     *          the overflow policy decides which event is lost. Each lost event
+     *          is counted per policy.
+     *          The implementation is a ring of cells with sequence numbers,
+     *          in which producers and consumers reserve cells with a single
+     *          compare and swap.
+     */
+    class EventQueue {
+    public:
+      /**
+       *  @brief  OverflowPolicy enumerator
+       */
+      enum OverflowPolicy {
+        DROP_NEWEST,     ///< drop the incoming event
+        DROP_OLDEST,     ///< drop the oldest queued event to push the incoming one
+        BLOCK,           ///< block the producer until an event is popped
+        SAMPLE           ///< keep one incoming event every N, replacing the oldest queued event
+      };
+      
+      /**
+       *  @brief  Counters struct
+       */
+      struct Counters {
+        unsigned long long    m_nPushed = {0};           ///< The number of events pushed in the queue
+        unsigned long long    m_nDroppedNewest = {0};    ///< The number of incoming events dropped
+        unsigned long long    m_nDroppedOldest = {0};    ///< The number of queued events dropped
+        unsigned long long    m_nSampledOut = {0};       ///< The number of incoming events rejected by the sampling
+        unsigned long long    m_nBlocked = {0};          ///< The number of push calls that had to wait
+      };
+      
+      EventQueue(const EventQueue&) = delete;
+      EventQueue& operator=(const EventQueue&) = delete;
+      
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  capacity the queue capacity, rounded up to the next power of 2
+       *  @param  policy the overflow policy
+       *  @param  sampling the sampling factor N for the SAMPLE policy
+       */
+      EventQueue(unsigned int capacity, OverflowPolicy policy = DROP_NEWEST, unsigned int sampling = 10);
+      
+      /**
+       *  @brief  Destructor
+       */
+      ~EventQueue() = default;
+      
+      /**
+       *  @brief  Push an event in the queue. Thread safe, lock-free except for the BLOCK policy.
+       *          Returns false if the pushed event has been dropped
+       *
+       *  @param  event the event to push
+       */
+      bool push(core::EventPtr event);
+      
+      /**
+       *  @brief  Pop the oldest event from the queue. Thread safe, lock-free.
+       *          Returns false if the queue is empty
+       *
+       *  @param  event the event to receive
+       */
+      bool pop(core::EventPtr &event);
+      
+      /**
+       *  @brief  Get the approximate number of queued events
+       */
+      unsigned int size() const;
+      
+      /**
+       *  @brief  Whether the queue is (approximatively) empty
+       */
+      bool empty() const;
+      
+      /**
+       *  @brief  Get the queue capacity
+       */
+      unsigned int capacity() const;
+      
+      /**
+       *  @brief  Get the overflow policy
+       */
+      OverflowPolicy policy() const;
+      
+      /**
+       *  @brief  Get a snapshot of the queue counters
+       */
+      Counters counters() const;
+      
+      /**
+       *  @brief  Close the queue. Producers blocked by the BLOCK policy 
+       *          are released and further events are dropped
+       */
+      void close();
+      
+      /**
+       *  @brief  Convert an overflow policy string to enum.
+       *          Possible values: "DropNewest", "DropOldest", "Block", "Sample"
+       *
+       *  @param  str the policy string
+       *  @param  policy the policy enum to receive
+       */
+      static core::StatusCode policyFromString(const std::string &str, OverflowPolicy &policy);
+      
+    private:
+      bool tryPush(core::EventPtr &event);
+      void notifyProducers();
+      
+    private:
+      /**
+       *  @brief  Cell struct
+       */
+      struct Cell {
+        std::atomic<unsigned long long>   m_sequence = {0};
+        core::EventPtr                    m_event = {nullptr};
+      };
+      
+      std::vector<Cell>                   m_cells;
+      const unsigned long long            m_mask;
+      const OverflowPolicy                m_policy;
+      const unsigned int                  m_sampling;
+      // the producer and consumer positions are kept on separate cache lines
+      alignas(64) std::atomic<unsigned long long>   m_enqueuePos = {0};
+      alignas(64) std::atomic<unsigned long long>   m_dequeuePos = {0};
+      alignas(64) std::atomic<unsigned long long>   m_nPushed = {0};
+      std::atomic<unsigned long long>     m_nDroppedNewest = {0};
+      std::atomic<unsigned long long>     m_nDroppedOldest = {0};
+      std::atomic<unsigned long long>     m_nSampledOut = {0};
+      std::atomic<unsigned long long>     m_nBlocked = {0};
+      std::atomic<unsigned long long>     m_nOverflows = {0};
+      std::atomic_bool                    m_closed = {false};
+      std::atomic_uint                    m_nWaitingProducers = {0};
+      std::mutex                          m_blockMutex = {};
+      std::condition_variable             m_blockCondition = {};
+    };
+
+  }
+
+} 
+
+#endif  //  DQM4HEP_EVENTQUEUE_H
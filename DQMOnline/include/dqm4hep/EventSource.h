@@ -35,10 +35,17 @@
 #include <dqm4hep/Event.h>
 #include <dqm4hep/EventStreamer.h>
 #include <dqm4hep/Client.h>
+#include <dqm4hep/SharedMemory.h>
 
 // -- root headers
 #include <TBufferFile.h>
 
+// -- std headers
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace dqm4hep {
 
   namespace online {
@@ -90,6 +97,63 @@ namespace dqm4hep {
        *  @param  name the event collector name
        */
       void addCollector(const std::string &name);
+
+      /**
+       *  @brief  Enable the batching of events sent to the same collector 
+       *          (see net::Client::setCommandBatching()). Improves the throughput 
+       *          of small events at high rate, at the price of a small latency.
+       *          Can be used only before calling start(). Exclusive with setEventBatching(),
+       *          which already packs the events: throws if event batching is enabled
+       *
+       *  @param  maxSize the maximum batch size in bytes
+       *  @param  maxDelay the maximum delay before sending a batch, in milliseconds
+       */
+      void setBatching(size_t maxSize = 64*1024, unsigned int maxDelay = 2);
+
+      /**
+       *  @brief  Pack several events in a single network message (see EventStreamer batches).
+       *          A batch is sent when it holds the maximum number of events, reaches the 
+       *          maximum size or when its oldest event waited for the maximum latency.
+       *          Unlike setBatching(), the collector state is checked once per batch.
+       *          The collectors publish the batches as they are and the collector clients 
+       *          unpack them. Sending an event to another set of collectors sends the 
+       *          pending batch first. Can be used only before calling start().
+       *          Exclusive with setBatching(): throws if command batching is enabled
+       *          and maxEvents is greater than 1
+       *
+       *  @param  maxEvents the maximum number of events in a batch
+       *  @param  maxSize the maximum batch size in bytes
+       *  @param  maxLatency the maximum delay before sending a batch, in milliseconds
+       */
+      void setEventBatching(unsigned int maxEvents, size_t maxSize = 256*1024, unsigned int maxLatency = 10);
+
+      /**
+       *  @brief  Send the pending batch of events, if any (see setEventBatching())
+       */
+      void flush();
+
+      /**
+       *  @brief  Compress the events sent to the collectors (see net::Client::setCommandCodec()).
+       *          Can be used only before calling start().
+       *
+       *  @param  codec the codec type
+       *  @param  level the compression level, 0 for the codec default
+       */
+      void setCompression(net::Codec::Type codec, int level = 0);
+
+      /**
+       *  @brief  Configure the shared memory transport, used automatically for the collectors
+       *          running on the same host (see net::SharedMemoryRing). The collectors report at
+       *          registration whether they can attach to the ring, the others receive the events
+       *          over the network. Events are written once
+       *          in shared memory and read in place by the collectors. Events larger than the
+       *          slot size are sent over the network. Enabled by default with 8 slots of 4 MB.
+       *          Can be used only before calling start().
+       *
+       *  @param  nSlots the number of slots in the ring, 0 to disable the shared memory transport
+       *  @param  slotSize the maximum event size in a slot
+       */
+      void setSharedMemory(unsigned int nSlots, size_t slotSize = 4*1024*1024);
       
       /**
        *  @brief  Start the event source.
@@ -114,6 +178,14 @@ namespace dqm4hep {
       void sendEvent(const std::string &collector, core::EventPtr event);
       
     private:
+      /**
+       *  @brief  CollectorInfo struct
+       */
+      struct CollectorInfo {
+        bool             m_registered = {false};   ///< Whether the source is registered to the event collector
+        bool             m_sharedMemory = {false}; ///< Whether the event collector can read the events from shared memory
+      };
+      
       /**
        *  @brief  Get the source info (host info + source info)
        *  
@@ -126,9 +198,10 @@ namespace dqm4hep {
        *  
        *  @param  collector the collector name to register to
        *  @param  info the source info to send to the collector
+       *  @param  collectorInfo the collector info to update from the collector response
        *  @return bool whether the source was registered
        */
-      bool registerMe(const std::string &collector, const core::json &info);
+      bool registerMe(const std::string &collector, const core::json &info, CollectorInfo &collectorInfo);
       
       /**
        *  @brief  Un-register the event source from the specified collector
@@ -145,6 +218,24 @@ namespace dqm4hep {
        */
       void sendEvent(const core::StringVector &collectors, core::EventPtr event);
 
+      /**
+       *  @brief  Send the serialized buffer (a single event or a batch of events) 
+       *          to the specified list of collectors. Must be called with the lock held
+       *  
+       *  @param  collectors the list of collectors
+       */
+      void sendBuffer(const core::StringVector &collectors);
+
+      /**
+       *  @brief  Send the pending batch of events and reset it. Must be called with the lock held
+       */
+      void sendBatch();
+
+      /**
+       *  @brief  The flush thread function. Send the pending batch when it reaches the maximum latency
+       */
+      void flushThread();
+
     private:
       /** 
        *  @brief  Constructor
@@ -153,15 +244,9 @@ namespace dqm4hep {
        */
       EventSource(const std::string &sourceName);
       
-      /**
-       *  @brief  CollectorInfo struct
-       */
-      struct CollectorInfo {
-        bool             m_registered = {false};   ///< Whether the source is registered to the event collector
-      };
-      
     private:
       typedef std::map<std::string, CollectorInfo> CollectorInfoMap;
+      typedef std::chrono::steady_clock::time_point SteadyTimePoint;
       
       bool                                m_started = {false};               ///< Whether the event source was started
       std::string                         m_sourceName = {""};               ///< The source name
@@ -169,6 +254,20 @@ namespace dqm4hep {
       CollectorInfoMap                    m_collectorInfos = {};             ///< The map of event collector infos
       net::Client                         m_client = {};                     ///< The networking client interface 
       TBufferFile                         m_buffer = {TBuffer::kWrite, 2*1024*1024};  ///< The serialized event raw buffer
+      std::unique_ptr<net::SharedMemoryRing> m_sharedMemory = {nullptr};     ///< The shared memory ring, created on first use
+      unsigned int                        m_sharedMemorySlots = {8};         ///< The number of slots in the shared memory ring
+      size_t                              m_sharedMemorySlotSize = {4*1024*1024}; ///< The maximum event size in a slot
+      std::string                         m_sharedReference = {""};          ///< The shared memory reference of the event being sent
+      unsigned int                        m_batchMaxEvents = {0};            ///< The maximum number of events in a batch, 0 if events are not batched
+      size_t                              m_batchMaxSize = {256*1024};       ///< The maximum batch size in bytes
+      unsigned int                        m_batchMaxLatency = {10};          ///< The maximum delay before sending a batch (ms)
+      core::StringVector                  m_batchCollectors = {};            ///< The collectors of the pending batch
+      uint32_t                            m_nBatchedEvents = {0};            ///< The number of events in the pending batch
+      SteadyTimePoint                     m_batchDeadline = {};              ///< The pending batch sending deadline
+      std::mutex                          m_mutex = {};                      ///< The sending mutex
+      std::condition_variable             m_condition = {};                  ///< The flush thread condition
+      bool                                m_stopFlag = {false};              ///< Whether to stop the flush thread
+      std::thread                         m_flushThread = {};                ///< The flush thread (event batching only)
     };
 
   }
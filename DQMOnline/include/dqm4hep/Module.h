@@ -79,6 +79,12 @@ namespace dqm4hep {
        *  @brief  Get the module version
        */
       const core::Version &version() const;
+      
+      /** 
+       *  @brief  Whether the module can process events from several threads at a time.
+       *          See setThreadSafe()
+       */
+      bool threadSafe() const;
 
       /** 
       *  @brief  Initialize the module.
@@ -152,6 +158,18 @@ namespace dqm4hep {
        *  @param  patch the patch number
        */
       void setVersion(unsigned int major, unsigned int minor = 0, unsigned int patch = 0);
+      
+      /** 
+       *  @brief  Declare whether the module can process events from several threads at a time.
+       *          A thread safe module only fills the monitor objects returned by 
+       *          OnlineElement::threadObject() in process(). A module declared as not thread 
+       *          safe always runs on a single thread, whatever the application settings.
+       *          Modules are not thread safe by default: objectTo() and object() return
+       *          the objects shared by all the threads, so modules must opt in
+       *
+       *  @param  safe whether the module is thread safe
+       */
+      void setThreadSafe(bool safe);
 
     private:
       /** 
@@ -173,6 +191,8 @@ namespace dqm4hep {
       std::string                   m_detectorName = {""};
       /// The module version
       core::Version                 m_version = {};
+      /// Whether the module can process events in parallel
+      bool                          m_threadSafe = {false};
       /// The module application instance
       ModuleApplication            *m_moduleApplication = {nullptr};
     };
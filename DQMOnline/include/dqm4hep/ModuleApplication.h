@@ -38,10 +38,16 @@
 #include "dqm4hep/Cycle.h"
 #include "dqm4hep/Module.h"
 #include "dqm4hep/EventCollectorClient.h"
+#include "dqm4hep/EventQueue.h"
+#include "dqm4hep/ProcessingThreadPool.h"
+#include "dqm4hep/ElementPublisher.h"
 #include "dqm4hep/MonitorElementManager.h"
 #include "dqm4hep/EventReader.h"
 #include "dqm4hep/Archiver.h"
 
+// -- root headers
+#include <TBufferFile.h>
+
 // -- tclap headers
 #include "tclap/CmdLine.h"
 #include "tclap/Arg.h"
@@ -189,12 +195,75 @@ namespace dqm4hep {
       void processEndOfRun();
       
       /**
-       *  @brief  Receive an event from event collector and post it in the event loop
+       *  @brief  Receive an event from event collector and push it in the event queue.
+       *          The event loop is notified if no processing is already pending.
+       *          Null events are counted and dropped
        *
        *  @param  event an event from the event collector
        */
       void receiveEvent(core::EventPtr event);
       
+      /**
+       *  @brief  Post a process event in the event loop, if not already pending
+       */
+      void postProcessEvent();
+      
+      /**
+       *  @brief  Pop the next event from the event queue and process it.
+       *          Called from the event loop
+       */
+      void processQueuedEvent();
+      
+      /**
+       *  @brief  Process an event from the event queue with the user module
+       *
+       *  @param  event the event to process
+       */
+      void processEvent(core::EventPtr event);
+      
+      /**
+       *  @brief  Whether events are processed by the processing threads
+       */
+      bool multiThreaded() const;
+      
+      /**
+       *  @brief  Create the monitor element shards and start the processing threads
+       */
+      void startProcessingThreads();
+      
+      /**
+       *  @brief  Stop and join the processing threads
+       */
+      void stopProcessingThreads();
+      
+      /**
+       *  @brief  Wake up the processing threads waiting for events
+       */
+      void notifyProcessingThreads();
+      
+      /**
+       *  @brief  Suspend the processing threads and wait for the events 
+       *          being processed to be done. Called from the event loop before 
+       *          running the module callbacks and accessing the monitor elements
+       */
+      void pauseProcessing();
+      
+      /**
+       *  @brief  Resume the processing threads. The shards of the monitor elements
+       *          booked while the processing was paused are created first
+       */
+      void resumeProcessing();
+      
+      /**
+       *  @brief  Merge the monitor element shards filled by the processing threads
+       */
+      void mergeElementShards();
+      
+      /**
+       *  @brief  Slot to send the event queue statistics on timer timeout
+       */
+      void sendEventQueueStats();
+      
       /**
        *  @brief  Receive the new monitor element subscription list
        *  
@@ -202,6 +271,14 @@ namespace dqm4hep {
        */
       void receiveSubscriptionList(CommandEvent *cmd);
       
+      /**
+       *  @brief  Publish the monitor elements changed since the last publication
+       *          to the monitor element collector
+       *  
+       *  @param  elements the list of elements to publish
+       */
+      void publishElements(const OnlineElementPtrList &elements);
+      
       /**
        *  @brief  Slot to set the run number of all monitor elements on start of run
        *  
@@ -274,16 +351,36 @@ namespace dqm4hep {
       EventClientPtr               m_eventCollectorClient = {nullptr};
       /// The event source from the event collector
       std::string                  m_eventSourceName = {""};
-      /// The current number of events in the event loop
-      std::atomic_uint             m_currentNQueuedEvents = {0};
+      /// The queue of events to process, filled from network or event reader
+      EventQueuePtr                m_eventQueue = {nullptr};
+      /// Whether a process event has been posted in the event loop and not processed yet
+      std::atomic_bool             m_processEventPending = {false};
+      /// The number of null events received and dropped
+      std::atomic<unsigned long long>  m_nDroppedNullEvents = {0};
       /// The maximum of queued events to be processed (sub-sampling)
       unsigned int                 m_eventQueueSize = {100};
+      /// The event queue overflow policy
+      EventQueue::OverflowPolicy   m_eventQueuePolicy = {EventQueue::DROP_NEWEST};
+      /// The sampling factor for the event queue SAMPLE overflow policy
+      unsigned int                 m_eventQueueSampling = {10};
+      /// The number of threads processing events (1 means in the event loop)
+      unsigned int                 m_nProcessingThreads = {1};
+      /// The pool of threads processing events in multi-threaded mode
+      std::unique_ptr<ProcessingThreadPool>  m_processingThreads = {nullptr};
+      /// The timer to send event queue statistics
+      AppTimer*                    m_eventQueueStatsTimer = {nullptr};
       /// The timer for the standalone module mode
       AppTimer*                    m_standaloneTimer = {nullptr};
       /// The time between two consecutive standalone module process (unit ms)
       unsigned int                 m_standaloneSleep = {1000};
       /// The monitor element manager
       MonitorElementManagerPtr     m_monitorElementManager = {nullptr};
+      /// The monitor element collector to publish the elements to
+      std::string                  m_monitorElementCollector = {""};
+      /// The monitor element publisher (delta encoding)
+      ElementPublisher             m_elementPublisher = {};
+      /// The buffer to serialize the monitor element publications
+      TBufferFile                  m_publicationBuffer = {TBuffer::kWrite, 1024*1024};
       /// Whether the application for monitor element booking (state variable)
       bool                         m_allowBooking = {false};
       /// The event reader 
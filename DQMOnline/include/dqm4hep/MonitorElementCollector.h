@@ -0,0 +1,190 @@
+/// \file MonitorElementCollector.h
+/*
+ *
+ * MonitorElementCollector.h header template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+#ifndef DQM4HEP_MONITORELEMENTCOLLECTOR_H
+#define DQM4HEP_MONITORELEMENTCOLLECTOR_H
+
+// -- dqm4hep headers
+#include "dqm4hep/Internal.h"
+#include "dqm4hep/StatusCodes.h"
+#include "dqm4hep/Application.h"
+#include "dqm4hep/ElementPublisher.h"
+
+// -- tclap headers
+#include "tclap/CmdLine.h"
+#include "tclap/Arg.h"
+
+// -- root headers
+#include <TBufferFile.h>
+
+// -- std headers
+#include <set>
+
+namespace dqm4hep {
+
+  namespace online {
+    
+    /** 
+     *  @brief  MonitorElementCollector class.
+     *          Collects the monitor element publications of the module applications
+     *          and serves them to the clients (viewers).
+     *          The latest version of each element is cached per module, in serialized form.
+     *          Clients subscribe to elements with the subscribe command and receive the 
+     *          updated subscribed elements on the element update service, in at most one 
+     *          batched message per refresh interval. Clients waiting for the same elements 
+     *          share the same message.
+     *          The collector forwards to the modules the union of the client subscriptions, 
+     *          so that the module load does not depend on the number of clients.
+     */
+    class MonitorElementCollector : public Application {
+    public:
+      /**
+       *  @brief  Default constructor
+       */
+      MonitorElementCollector();
+      MonitorElementCollector(const MonitorElementCollector&) = delete;
+      MonitorElementCollector& operator=(const MonitorElementCollector&) = delete;
+      
+      /**
+       *  @brief  Default destructor
+       */
+      ~MonitorElementCollector();
+      
+      void parseCmdLine(int argc, char **argv) override;
+      void onInit() override;
+      void onEvent(AppEvent *pAppEvent) override;
+      void onStart() override;
+      void onStop() override;
+      
+      /**
+       *  @brief  Read a batched element update message sent on the element update service.
+       *          For clients.
+       *
+       *  @param  buffer the received buffer
+       *  @param  elements the list of elements to receive
+       */
+      static core::StatusCode readElementUpdates(const net::Buffer &buffer, OnlineElementPtrList &elements);
+      
+      /**
+       *  @brief  Write a batched element update message as sent on the element update service:
+       *          the number of elements, then the size and contents of each serialized element
+       *
+       *  @param  elements the serialized elements (see OnlineElement::write())
+       *  @param  buffer the buffer to write to
+       */
+      static void writeElementUpdates(const std::vector<const net::RawBuffer*> &elements, TBuffer &buffer);
+
+    private:
+      /**
+       *  @brief  ElementKey struct.
+       *          Identifies an element of a module
+       */
+      struct ElementKey {
+        std::string       m_module = {""};
+        std::string       m_path = {""};
+        std::string       m_name = {""};
+        bool operator<(const ElementKey &rhs) const;
+      };
+      
+      typedef std::set<ElementKey> ElementKeySet;
+      typedef std::shared_ptr<net::BufferModelT<std::string>> BlobPtr;
+      
+      /**
+       *  @brief  ModuleCache struct
+       */
+      struct ModuleCache {
+        ElementPublicationReader         m_reader = {};         ///< The module publication reader (delta decoding)
+        std::map<ElementKey, BlobPtr>    m_blobs = {};          ///< The serialized elements
+        unsigned long long               m_lastSequence = {0};  ///< The last received publication sequence number
+      };
+      
+      /**
+       *  @brief  ClientInfo struct
+       */
+      struct ClientInfo {
+        ElementKeySet                    m_subscriptions = {};  ///< The subscribed elements
+        ElementKeySet                    m_pending = {};        ///< The subscribed elements updated since the last flush
+      };
+      
+      typedef std::map<std::string, std::shared_ptr<ModuleCache>> ModuleCacheMap;
+      typedef std::map<int, ClientInfo> ClientInfoMap;
+      typedef std::map<ElementKey, std::set<int>> SubscriberMap;
+      
+      void handleCollectElements(const net::Buffer &buffer);
+      void handleSubscription(const net::Buffer &buffer);
+      void handleBrowse(const net::Buffer &request, net::Buffer &response);
+      void handleClientExit(StoreEvent<int> *event);
+      
+      /**
+       *  @brief  Add or remove a client from the subscribers of an element.
+       *          If the element gets its first or loses its last subscriber, 
+       *          the subscription change is appended to the module subscription list
+       *
+       *  @param  clientId the client id
+       *  @param  key the element key
+       *  @param  subscribe whether to subscribe or unsubscribe
+       *  @param  moduleSubscriptions the subscription lists to send to modules
+       */
+      void updateSubscribers(int clientId, const ElementKey &key, bool subscribe, std::map<std::string, core::json> &moduleSubscriptions);
+      
+      /**
+       *  @brief  Send the subscribed elements of a module to the module
+       */
+      void sendModuleSubscriptions(const std::string &module);
+      
+      /**
+       *  @brief  Send the pending element updates to the clients. Called on timer timeout
+       */
+      void flushUpdates();
+      
+      /**
+       *  @brief  Send the statistics. Called on timer timeout
+       */
+      void sendStatsTimer10();
+    
+    private:
+      std::shared_ptr<TCLAP::CmdLine>     m_cmdLine = {nullptr};
+      unsigned int                        m_refreshInterval = {1000};
+      ModuleCacheMap                      m_moduleCaches = {};
+      ClientInfoMap                       m_clients = {};
+      SubscriberMap                       m_subscribers = {};
+      net::Service                       *m_pUpdateService = {nullptr};
+      AppTimer*                           m_refreshTimer = {nullptr};
+      AppTimer*                           m_statsTimer10 = {nullptr};
+      TBufferFile                         m_elementBuffer = {TBuffer::kWrite, 1024*1024};
+      TBufferFile                         m_batchBuffer = {TBuffer::kWrite, 4*1024*1024};
+      std::vector<const net::RawBuffer*>  m_batchElements = {};
+      unsigned int                        m_nCollectedBytes10 = {0};
+      unsigned int                        m_nSentBytes10 = {0};
+      unsigned int                        m_nSentMessages10 = {0};
+    };
+
+  }
+
+} 
+
+#endif  //  DQM4HEP_MONITORELEMENTCOLLECTOR_H
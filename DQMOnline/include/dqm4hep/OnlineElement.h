@@ -47,6 +47,7 @@ namespace dqm4hep {
     class OnlineElement : public core::MonitorElement {
       friend class ModuleApi;
       friend class ModuleApplication;
+      friend class ElementPublicationReader;
     public:
       /** 
        *  @brief  Make a shared pointer of OnlineElement
@@ -142,18 +143,64 @@ namespace dqm4hep {
       bool subscribed() const;
       
       /**
-       *  @brief  Reset the monitor element
+       *  @brief  Get the quality test reports of the last quality test run
+       */
+      const core::QReportMap &reports() const;
+      
+      /**
+       *  @brief  Get the monitor object to fill from the calling thread.
+       *          In a processing thread of a multi-threaded module application,
+       *          this is the clone (shard) owned by the thread, merged in the 
+       *          monitor object at end of cycle. Otherwise, this is the monitor object.
+       *          Only histograms (TH1 and daughters) are sharded, other objects are shared
+       *          between threads and have to be protected by the user
+       */
+      TObject *threadObject();
+      
+      /**
+       *  @brief  Get the monitor object to fill from the calling thread, dynamic casted to T
+       */
+      template <typename T>
+      T *threadObjectTo();
+      
+      /**
+       *  @brief  Create one clone of the monitor object per processing thread.
+       *          Called by the module application after monitor element booking
        *
-       *  @param  resetQtests whether to also reset the quality tests 
+       *  @param  nShards the number of processing threads
        */
-      virtual void reset(bool resetQtests = true);
+      core::StatusCode createShards(unsigned int nShards);
       
       /**
-       *  @brief  Convert the monitor element to json
-       *  
-       *  @param  object the json object to receive
+       *  @brief  Add the shards content to the monitor object and reset the shards.
+       *          Must not be called while processing threads are filling the shards
+       */
+      core::StatusCode mergeShards();
+      
+      /**
+       *  @brief  Get the number of shards of this element
+       */
+      unsigned int nShards() const;
+      
+      /**
+       *  @brief  Set the processing thread index of the calling thread.
+       *          A negative value means that the calling thread is not a processing thread
+       *
+       *  @param  index the thread index
        */
-      virtual void toJson(core::json &object) const;
+      static void setThreadIndex(int index);
+      
+      /**
+       *  @brief  Get the processing thread index of the calling thread
+       */
+      static int threadIndex();
+      
+      /**
+       *  @brief  Reset the monitor element
+       *
+       *  @param  resetQtests whether to also reset the quality tests 
+       */
+      virtual void reset(bool resetQtests = true);
       
 // #if ROOT_VERSION_CODE >= ROOT_VERSION(6, 14, 0)
 //       /**
@@ -184,6 +231,14 @@ namespace dqm4hep {
       OnlineElement(TObject *pMonitorObject, TObject *pReferenceObject);
       OnlineElement(const core::PtrHandler<TObject> &monitorObject);
       OnlineElement(const core::PtrHandler<TObject> &monitorObject, const core::PtrHandler<TObject> &referenceObject);
+      
+      /**
+       *  @brief  Write the monitor element json object members, 
+       *          including the online properties and quality reports
+       *  
+       *  @param  writer the json writer
+       */
+      void writeJsonMembers(core::JsonWriter &writer) const override;
      
       /**
        *  @brief  Set the collector name.
@@ -238,7 +293,17 @@ namespace dqm4hep {
       bool                          m_publish = {true};
       /// Whether a shifter has subscribed to this element
       bool                          m_subscribed = {false};
+      /// The monitor object clones filled by the processing threads
+      std::vector<core::PtrHandler<TObject>> m_shards = {};
     }; 
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    template <typename T>
+    inline T *OnlineElement::threadObjectTo() {
+      return dynamic_cast<T*>(threadObject());
+    }
 
   }
   
@@ -198,6 +198,61 @@ namespace dqm4hep {
          *  @param  moduleName the module name of the aplication
          */
         static const std::string subscribe(const std::string &moduleName);
+        
+        /**
+         *  @brief  Get the name of the command to receive (module) or send (client) a 
+         *          request for a full publication of the monitor elements at next end of cycle
+         *          
+         *  @param  moduleName the module name of the aplication
+         */
+        static const std::string fullPublication(const std::string &moduleName);
+      };
+      
+      //-------------------------------------------------------------------------------------------------
+      //-------------------------------------------------------------------------------------------------
+      
+      /**
+       *  @brief  MonitorElementCollector class
+       *          Defines routes related to the monitor element collector
+       */
+      class MonitorElementCollector {
+      public:
+        /**
+         *  @brief  Get the monitor element collector application type
+         */
+        static std::string applicationType();
+        
+        /**
+         *  @brief  Get the monitor element collector command name to collect 
+         *          a monitor element publication from a module
+         * 
+         *  @param  collector the collector name
+         */
+        static std::string collectElements(const std::string &collector);
+        
+        /**
+         *  @brief  Get the monitor element collector command name to update 
+         *          the monitor element subscriptions of a client
+         * 
+         *  @param  collector the collector name
+         */
+        static std::string subscribe(const std::string &collector);
+        
+        /**
+         *  @brief  Get the monitor element collector request name to get 
+         *          the list of cached monitor elements
+         * 
+         *  @param  collector the collector name
+         */
+        static std::string browse(const std::string &collector);
+        
+        /**
+         *  @brief  Get the monitor element collector service name to receive 
+         *          the batched updates of the subscribed monitor elements
+         * 
+         *  @param  collector the collector name
+         */
+        static std::string elementUpdates(const std::string &collector);
       };
     };
 
@@ -0,0 +1,154 @@
+/// \file ProcessingThreadPool.h
+/*
+ *
+ * ProcessingThreadPool.h header template automatically generated by a class generator
+ * Creation date : sam. oct. 17 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ * 
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ * 
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+#ifndef DQM4HEP_PROCESSINGTHREADPOOL_H
+#define DQM4HEP_PROCESSINGTHREADPOOL_H
+
+// -- dqm4hep headers
+#include "dqm4hep/Internal.h"
+#include "dqm4hep/StatusCodes.h"
+#include "dqm4hep/MonitorElementManager.h"
+#include "dqm4hep/EventQueue.h"
+
+// -- std headers
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    /**
+     *  @brief  ProcessingThreadPool class.
+     *          A pool of threads popping events from an event queue and processing them.
+     *          Each thread fills its own clone (shard) of the histograms booked in the
+     *          monitor element manager, merged back on demand.
+     *          The pool is paused before accessing the module or the monitor elements
+     *          from another thread. The shards of the elements booked while the pool
+     *          was paused are created when the processing resumes
+     */
+    class ProcessingThreadPool {
+    public:
+      typedef std::function<void(core::EventPtr)> ProcessFunction;
+
+      ProcessingThreadPool(const ProcessingThreadPool&) = delete;
+      ProcessingThreadPool& operator=(const ProcessingThreadPool&) = delete;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  nThreads the number of processing threads
+       *  @param  queue the event queue to pop events from
+       *  @param  manager the monitor element manager holding the elements to shard
+       *  @param  function the function processing an event, called from the processing threads
+       */
+      ProcessingThreadPool(unsigned int nThreads, EventQueuePtr queue, std::shared_ptr<core::MonitorElementManager> manager, ProcessFunction function);
+
+      /**
+       *  @brief  Destructor. Stop the processing threads
+       */
+      ~ProcessingThreadPool();
+
+      /**
+       *  @brief  Get the number of processing threads
+       */
+      unsigned int nThreads() const;
+
+      /**
+       *  @brief  Whether the processing threads are running
+       */
+      bool running() const;
+
+      /**
+       *  @brief  Create the monitor element shards and start the processing threads
+       */
+      core::StatusCode start();
+
+      /**
+       *  @brief  Stop and join the processing threads
+       */
+      void stop();
+
+      /**
+       *  @brief  Wake up a processing thread waiting for events
+       */
+      void notify();
+
+      /**
+       *  @brief  Suspend the processing threads and wait for the events
+       *          being processed to be done
+       */
+      void pause();
+
+      /**
+       *  @brief  Create the shards of the elements booked in the mean time
+       *          and resume the processing threads
+       */
+      void resume();
+
+      /**
+       *  @brief  Merge the monitor element shards in the monitor objects.
+       *          Must be called while the processing is paused
+       */
+      void mergeShards();
+
+    private:
+      /**
+       *  @brief  Create the shards of the elements that don't have any yet
+       */
+      core::StatusCode createMissingShards();
+
+      /**
+       *  @brief  The processing thread main loop. Pop events from the event queue
+       *          and process them until the threads are stopped
+       *
+       *  @param  index the processing thread index
+       */
+      void threadLoop(unsigned int index);
+
+    private:
+      const unsigned int                             m_nThreads;
+      EventQueuePtr                                  m_eventQueue = {nullptr};
+      std::shared_ptr<core::MonitorElementManager>   m_monitorElementManager = {nullptr};
+      ProcessFunction                                m_processFunction = {};
+      std::vector<std::thread>                       m_threads = {};
+      std::mutex                                     m_mutex = {};
+      std::condition_variable                        m_processingCondition = {};
+      std::condition_variable                        m_pauseCondition = {};
+      bool                                           m_paused = {false};
+      bool                                           m_stopped = {false};
+      unsigned int                                   m_nActive = {0};
+    };
+
+  }
+
+}
+
+#endif  //  DQM4HEP_PROCESSINGTHREADPOOL_H
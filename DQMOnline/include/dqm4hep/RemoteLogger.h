@@ -41,19 +41,26 @@ namespace dqm4hep {
   namespace online {
     
     /**
-     *  @brief  RemoteLogger class
+     *  @brief  RemoteLogger class.
+     *          Sends the log messages to the online manager. The messages can 
+     *          optionally be sent in batches (see net::Client::setCommandBatching()),
+     *          improving the throughput at high logging rate at the cost of a delay
      */
     class RemoteLogger : public spdlog::sinks::base_sink<std::mutex> {
     public:
       /**
        *  @brief  Constructor
+       *
+       *  @param  batching whether to send the log messages in batches
        */
-      RemoteLogger();
+      RemoteLogger(bool batching = false);
       
       /**
        *  @brief  Create a shared pointer of RemoteLogger
+       *
+       *  @param  batching whether to send the log messages in batches
        */
-      static core::Logger::AppenderPtr make_shared();
+      static core::Logger::AppenderPtr make_shared(bool batching = false);
       
       /**
        *  @brief  Log a message
@@ -98,6 +98,33 @@ int main(int argc, char* argv[])
       , "string");
   pCommandLine->add(collectorNameArg);
 
+  TCLAP::SwitchArg batchingArg(
+      "b"
+      , "batching"
+      , "Batch the events sent to the same collector and the log messages (only the log messages with event batching)"
+      , false);
+  pCommandLine->add(batchingArg);
+
+  TCLAP::ValueArg<unsigned int> eventBatchingArg(
+      "e"
+      , "event-batching"
+      , "The maximum number of events packed in a single message (0: no event batching)"
+      , false
+      , 0
+      , "unsigned int");
+  pCommandLine->add(eventBatchingArg);
+
+  StringVector codecs = {"none", "zlib", "lz4", "zstd"};
+  TCLAP::ValuesConstraint<std::string> codecConstraint(codecs);
+  TCLAP::ValueArg<std::string> codecArg(
+      "z"
+      , "codec"
+      , "The codec used to compress the events sent to collectors"
+      , false
+      , "none"
+      , &codecConstraint);
+  pCommandLine->add(codecArg);
+
   // parse command line
   pCommandLine->parse(argc, argv);
 
@@ -106,7 +133,7 @@ int main(int argc, char* argv[])
 
   // set log level
   std::string verbosity(verbosityArg.getValue());
-  Logger::createLogger("rand-src:" + sourceNameArg.getValue(), {Logger::coloredConsole(), RemoteLogger::make_shared()});
+  Logger::createLogger("rand-src:" + sourceNameArg.getValue(), {Logger::coloredConsole(), RemoteLogger::make_shared(batchingArg.getValue())});
   Logger::setMainLogger("rand-src:" + sourceNameArg.getValue());
   Logger::setLogLevel(Logger::logLevelFromString(verbosity));
 
@@ -117,6 +144,15 @@ int main(int argc, char* argv[])
   for(auto collector : collectors)
     eventSource->addCollector(collector);
 
+  // the event batches are not batched again, only the log messages
+  if(batchingArg.getValue() && 0 == eventBatchingArg.getValue())
+    eventSource->setBatching();
+
+  if(eventBatchingArg.getValue() > 0)
+    eventSource->setEventBatching(eventBatchingArg.getValue());
+
+  eventSource->setCompression(dqm4hep::net::Codec::fromString(codecArg.getValue()));
+
   eventSource->start();
   
   uint32_t eventNumber(0);
@@ -124,6 +160,7 @@ int main(int argc, char* argv[])
   std::random_device rd{};
   std::mt19937 gen{rd()};
   std::normal_distribution<> d{5,2};
+  const GenericEvent::KeyId dataKey(GenericEvent::key("data"));
   
   while(running)
   {
@@ -136,13 +173,10 @@ int main(int argc, char* argv[])
     event->setEventNumber(eventNumber);
     
     GenericEvent *generic = event->getEvent<GenericEvent>();
-    std::vector<float> values;
     int nValues(std::round((rand()/float(RAND_MAX))*10) + 1);
     
-    for(int i=0 ; i<nValues ; i++)
-      values.push_back(d(gen));
-    
-    generic->setValues("data", values);
+    for(auto &value : generic->allocateValues<float>(dataKey, nValues))
+      value = d(gen);
     
     eventSource->sendEvent(event);
     ++eventNumber;
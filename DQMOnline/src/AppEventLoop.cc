@@ -43,7 +43,7 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     AppEventLoop::~AppEventLoop() {
-      
+      clear();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -52,9 +52,13 @@ namespace dqm4hep {
       if(nullptr == pAppEvent) {
         return;
       }
-      // push event in the queue
-      std::lock_guard<std::recursive_mutex> lock(m_queueMutex);      
-      m_eventQueue.insert(pAppEvent);   
+      // push event in the queue of its priority level
+      {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_eventQueue[pAppEvent->priority()].push_back(pAppEvent);
+        m_queueSize++;
+      }
+      m_queueCondition.notify_one();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -76,11 +80,21 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void AppEventLoop::clear() {
-      std::lock_guard<std::recursive_mutex> lock(m_queueMutex);
-      for(auto evt : m_eventQueue) {
-        delete evt;
+      std::lock_guard<std::mutex> lock(m_queueMutex);
+      for(auto &level : m_eventQueue) {
+        for(auto evt : level) {
+          delete evt;
+        }
+        level.clear();
       }
-      m_eventQueue.clear();
+      m_queueSize = 0;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::size_t AppEventLoop::size() {
+      std::lock_guard<std::mutex> lock(m_queueMutex);
+      return m_queueSize;
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -88,30 +102,26 @@ namespace dqm4hep {
     int AppEventLoop::exec() {
       m_running = true;
       m_quitFlag = false;
+      m_timerStopFlag = false;
       
       m_timerThread = std::thread(&AppEventLoop::timerThread, this);
       
       while(1) {
-        if(m_quitFlag) {
-          break;
-        }
-        
-        // safely get the app event pointer 
+        // safely get the app event pointer.
+        // Sleep until an event is posted or the loop is asked to quit
         AppEvent* event = nullptr;
         
         {
-          std::lock_guard<std::recursive_mutex> lock(m_queueMutex);
+          std::unique_lock<std::mutex> lock(m_queueMutex);
+          m_queueCondition.wait(lock, [this](){
+            return (m_quitFlag.load() || m_queueSize > 0);
+          });
           
-          if(!m_eventQueue.empty()) {
-            event = *m_eventQueue.rbegin();
-            m_eventQueue.erase(event);               
+          if(m_quitFlag) {
+            break;
           }
-        }
-        
-        // if no event, save cpu ressources ...
-        if(nullptr == event) {
-          usleep(100);
-          continue;
+          
+          event = popEvent();
         }
         
         try {
@@ -119,13 +129,17 @@ namespace dqm4hep {
         }
         catch(...) {
           m_returnCode = 1;
+          delete event;
           break;
         }
         delete event;
-        usleep(100);
       }
       
-      m_timerStopFlag = true;
+      {
+        std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
+        m_timerStopFlag = true;
+      }
+      m_timerCondition.notify_all();
       m_timerThread.join();      
       m_running = false;
       return m_returnCode.load();
@@ -193,21 +207,49 @@ namespace dqm4hep {
       }
       
       if(pAppEvent->type() == AppEvent::QUIT) {
-        m_quitFlag = true;
         m_returnCode = 1;
         StoreEvent<int> *quitEvent = dynamic_cast<StoreEvent<int>*>(pAppEvent);
         
         if(quitEvent) {
           m_returnCode = quitEvent->data();
         }
+        setQuitFlag();
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    AppEvent *AppEventLoop::popEvent() {
+      // the queue mutex must be locked by the caller.
+      // Pick the oldest event of the highest non-empty priority level
+      for(int p = MaxPriority ; p >= 0 ; --p) {
+        auto &level = m_eventQueue[p];
+        if(!level.empty()) {
+          AppEvent *event = level.front();
+          level.pop_front();
+          m_queueSize--;
+          return event;
+        }
+      }
+      return nullptr;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void AppEventLoop::setQuitFlag() {
+      // set the flag under lock to not miss the notification 
+      // if exec() is about to wait on the condition
+      {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_quitFlag = true;
       }
+      m_queueCondition.notify_all();
     }
     
     //-------------------------------------------------------------------------------------------------
     
     int AppEventLoop::count(int eventType) {
-      std::lock_guard<std::recursive_mutex> lock(m_queueMutex);
-      return std::count_if(m_eventQueue.begin(), m_eventQueue.end(), [&eventType](AppEvent* ptr){
+      return this->count([&eventType](AppEvent* ptr){
         return (ptr->type() == eventType);
       });
     }
@@ -215,40 +257,53 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void AppEventLoop::timerThread() {
-      {
-        // initialize start time point of all timers
-        std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
-        for(auto timer : m_timers) {
-          timer->m_startTime = core::now();
+      std::unique_lock<std::recursive_mutex> lock(m_timerMutex);
+      // (re)schedule all active timers from now on
+      for(auto timer : m_timers) {
+        if(timer->active()) {
+          scheduleTimer(timer, TimerClock::now() + std::chrono::milliseconds(timer->interval()));
         }
       }
       while(not m_timerStopFlag.load()) {
+        // nothing scheduled, sleep until a timer is started
+        if(m_timerQueue.empty()) {
+          m_timerCondition.wait(lock);
+          continue;
+        }
+        const TimerDeadline next = m_timerQueue.top();
+        // sleep until the next deadline or until the timer queue is modified
+        if(TimerClock::now() < next.m_deadline) {
+          m_timerCondition.wait_until(lock, next.m_deadline);
+          continue;
+        }
+        m_timerQueue.pop();
+        if(not isScheduled(next)) {
+          continue;
+        }
+        // Process timer timeout in event loop. The event mutex must
+        // be acquired before the timer mutex, as done by any timer 
+        // function called from an event callback
+        lock.unlock();
         {
-          std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
-          for(auto timer : m_timers) {
-            if(timer->active()) {
-              const unsigned int timeoutEllapsed = std::chrono::duration_cast<std::chrono::milliseconds>(core::now()-timer->m_startTime).count();
-              const bool timeoutReached = (timeoutEllapsed >= timer->interval());
-              if(timeoutReached) {
-                // process timer timeout in event loop
-                processFunction([timer](){
-                  timer->m_signal.emit();
-                });
-                // stop it if single shot
-                if(timer->singleShot()) {
-                  timer->m_active = false;
-                }
-                else {
-                  timer->m_startTime = core::now();
-                }
-              }
+          std::lock_guard<std::recursive_mutex> eventLock(m_eventMutex);
+          std::lock_guard<std::recursive_mutex> timerLock(m_timerMutex);
+          // the timer may have been stopped or removed in the meantime
+          if(isScheduled(next)) {
+            AppTimer *timer = next.m_timer;
+            // stop it if single shot, else restart it. Done before 
+            // emitting, so that the callback can restart or stop it
+            if(timer->singleShot()) {
+              timer->m_active = false;
+              timer->m_scheduleId = 0;
             }
-            if(m_timerStopFlag.load()) {
-              break;
+            else {
+              const auto deadline = std::max(TimerClock::now(), next.m_deadline + std::chrono::milliseconds(timer->interval()));
+              scheduleTimer(timer, deadline);
             }
+            timer->m_signal.emit();
           }
         }
-        usleep(100);
+        lock.lock();
       }
       dqm_debug( "Exiting timer thread !" );
     }
@@ -263,9 +318,12 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void AppEventLoop::startTimer(AppTimer *timer) {
-      std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
-      timer->m_startTime = core::now();
-      timer->m_active = true;
+      {
+        std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
+        timer->m_active = true;
+        scheduleTimer(timer, TimerClock::now() + std::chrono::milliseconds(timer->interval()));
+      }
+      m_timerCondition.notify_all();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -274,7 +332,9 @@ namespace dqm4hep {
       std::lock_guard<std::recursive_mutex> lock(m_timerMutex);
       auto findIter = m_timers.find(timer);
       if(m_timers.end() != findIter) {
+        // the queued deadline becomes outdated
         (*findIter)->m_active = false;
+        (*findIter)->m_scheduleId = 0;
       }
     }
     
@@ -287,6 +347,38 @@ namespace dqm4hep {
       delete timer;
     }
     
+    //-------------------------------------------------------------------------------------------------
+    
+    void AppEventLoop::scheduleTimer(AppTimer *timer, const TimerClock::time_point &deadline) {
+      // the timer mutex must be locked by the caller.
+      // Any previous deadline of this timer is invalidated by the new id
+      timer->m_scheduleId = ++m_timerScheduleId;
+      m_timerQueue.push({deadline, timer, timer->m_scheduleId});
+      // outdated deadlines are normally dropped when reaching the top of the queue.
+      // Purge them if timers are restarted much more often than they expire
+      if(m_timerQueue.size() > 2*m_timers.size() + 64) {
+        TimerQueue purgedQueue;
+        while(not m_timerQueue.empty()) {
+          if(isScheduled(m_timerQueue.top())) {
+            purgedQueue.push(m_timerQueue.top());
+          }
+          m_timerQueue.pop();
+        }
+        m_timerQueue.swap(purgedQueue);
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool AppEventLoop::isScheduled(const TimerDeadline &deadline) const {
+      // the timer mutex must be locked by the caller.
+      // Check the timer is still registered before accessing it
+      if(m_timers.end() == m_timers.find(deadline.m_timer)) {
+        return false;
+      }
+      return (deadline.m_timer->active() && deadline.m_timer->m_scheduleId == deadline.m_scheduleId);
+    }
+    
   }
 
 }
@@ -158,6 +158,22 @@ namespace dqm4hep {
       return m_noServer;
     }
     
+    //-------------------------------------------------------------------------------------------------
+    
+    void Application::setLogBatching(bool enable) {
+      if(initialized()) {
+        dqm_error( "Application::setLogBatching(): Couldn't enable/disable log batching, app is already initialized !" );
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      m_logBatching = enable;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool Application::logBatching() const {
+      return m_logBatching;
+    }
+    
     //-------------------------------------------------------------------------------------------------
 
     void Application::init(int argc, char **argv) {
@@ -183,7 +199,7 @@ namespace dqm4hep {
         // configure logger
         m_logger = core::Logger::createLogger(this->type() + ":" + this->name(), {
           core::Logger::coloredConsole(),
-          RemoteLogger::make_shared()
+          RemoteLogger::make_shared(logBatching())
         });
       }
       core::Logger::setMainLogger(m_logger->name());
@@ -385,6 +401,10 @@ namespace dqm4hep {
       char date_buf[100];
       std::strftime(date_buf, sizeof(date_buf), "%Y-%m-%d %H:%M:%S", tm_time);
 
+      const uint64_t bufferAllocations(net::BufferModelPool::allocations());
+      sendStat("NBufferAllocs", bufferAllocations - m_lastBufferAllocations);
+      m_lastBufferAllocations = bufferAllocations;
+
       sendStat("LastUpdate", date_buf );
       dqm_debug( "Sending internal app stats ... OK" );
     }
@@ -411,6 +431,7 @@ namespace dqm4hep {
       createStatsEntry("LastUpdate", "%Y-%m-%d %H:%M:%S", "The time the last statistics update occured (unit %Y-%m-%d %H:%M:%S)");
 
       // Network
+      createStatsEntry("NBufferAllocs", "", "The number of network buffer allocations since the last statistics update. Null when the buffer pools are warm");
       // createStatsEntry("CPU", "%", "The current resident set size memory in use by the application (unit Mo)");
       // createStatsEntry("CPU", "%", "The current resident set size memory percentage in use by the application compare to the total available on the host (unit %)");
       // createStatsEntry("CPU", "%", "The current resident set size memory percentage in use by the application compare to the total used by the running processes (unit %)");
@@ -420,6 +441,7 @@ namespace dqm4hep {
       gettimeofday(&timeStart, NULL);
       m_stats.lastPollTime = timeStart;
       core::procStats(m_stats);
+      m_lastBufferAllocations = net::BufferModelPool::allocations();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -460,13 +482,9 @@ namespace dqm4hep {
         return;
       }
       
-      // copy buffer content
-      std::string content;
-      content.assign(buffer.begin(), buffer.size());
-      
-      // create new buffer model
+      // copy buffer content in a pooled buffer model
       auto bufferModel = buffer.createModel<std::string>();
-      bufferModel->move(std::move(content));
+      bufferModel->copy(buffer.begin(), buffer.size());
       
       // create the event to post, pass the copied buffer in ctor
       ServiceUpdateEvent *pEvent = new ServiceUpdateEvent(m_name, bufferModel);
@@ -505,13 +523,9 @@ namespace dqm4hep {
         return;
       }
       
-      // copy buffer content
-      std::string content;
-      content.assign(buffer.begin(), buffer.size());
-      
-      // create new buffer model
+      // copy buffer content in a pooled buffer model
       auto bufferModel = buffer.createModel<std::string>();
-      bufferModel->move(std::move(content));
+      bufferModel->copy(buffer.begin(), buffer.size());
       
       // create the event to post, pass the copied buffer in ctor
       CommandEvent *pEvent = new CommandEvent(m_name, bufferModel);
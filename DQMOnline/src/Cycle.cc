@@ -173,7 +173,7 @@ namespace dqm4hep {
             }
           }
           const core::TimePoint now = core::now();
-          const float timeoutEllapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now-m_lastCounterIncrement).count() / 1000.f;
+          const float timeoutEllapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now-m_lastCounterIncrement.load()).count() / 1000.f;
           const bool timeoutReached = (0 == m_timeout) ? false : (timeoutEllapsed >= m_timeout.load());
           // check timeout first
           if(timeoutReached) {
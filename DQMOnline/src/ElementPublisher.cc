@@ -0,0 +1,508 @@
+/// \file ElementPublisher.cc
+/*
+ *
+ * ElementPublisher.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/ElementPublisher.h"
+#include "dqm4hep/Logging.h"
+
+// -- root headers
+#include <TH1.h>
+#include <TArrayD.h>
+
+// -- std headers
+#include <algorithm>
+#include <functional>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    const unsigned int ElementPublication::protocolVersion = 1;
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementPublication::writeVarint(TBuffer &buffer, unsigned long long value) {
+      while(value >= 0x80) {
+        buffer.WriteUChar(static_cast<UChar_t>((value & 0x7F) | 0x80));
+        value >>= 7;
+      }
+      buffer.WriteUChar(static_cast<UChar_t>(value));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementPublication::readVarint(TBuffer &buffer, unsigned long long &value) {
+      value = 0;
+      unsigned int shift = 0;
+      UChar_t byte = 0;
+      do {
+        buffer.ReadUChar(byte);
+        value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+        shift += 7;
+      } while((byte & 0x80) and shift < 64);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ElementPublication::supportsDelta(const TH1 *histogram) {
+      if(nullptr == histogram) {
+        return false;
+      }
+      // profiles store extra per bin arrays, TH2Poly has its own bin storage
+      if(histogram->InheritsFrom("TProfile") or histogram->InheritsFrom("TProfile2D")
+        or histogram->InheritsFrom("TProfile3D") or histogram->InheritsFrom("TH2Poly")) {
+        return false;
+      }
+      return (histogram->GetDimension() >= 1 and histogram->GetDimension() <= 3);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int ElementPublication::nStats(const TH1 *histogram) {
+      switch(histogram->GetDimension()) {
+        case 1: return 4;
+        case 2: return 7;
+        default: return 11;
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::string ElementPublication::reportsToString(const core::QReportMap &reports) {
+      core::json jreports = {};
+      for(auto report : reports) {
+        core::json jreport;
+        report.second.toJson(jreport);
+        jreports[report.first] = jreport;
+      }
+      return jreports.dump();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementPublisher::setModuleName(const std::string &moduleName) {
+      m_moduleName = moduleName;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementPublisher::setFullPublicationPeriod(unsigned int period) {
+      m_fullPublicationPeriod = period;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int ElementPublisher::fullPublicationPeriod() const {
+      return m_fullPublicationPeriod;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementPublisher::requestFullPublication() {
+      m_fullPublicationRequested = true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode ElementPublisher::write(int runNumber, const OnlineElementPtrList &elements, TBuffer &buffer) {
+      if(not buffer.IsWriting()) {
+        return core::STATUS_CODE_NOT_ALLOWED;
+      }
+      const bool fullPublication = m_fullPublicationRequested
+        or (0 != m_fullPublicationPeriod and 0 == (m_sequence % m_fullPublicationPeriod));
+      m_nWrittenElements = 0;
+      m_nDeltaElements = 0;
+      // header
+      buffer.WriteUInt(ElementPublication::protocolVersion);
+      buffer.WriteStdString(&m_moduleName);
+      buffer.WriteInt(runNumber);
+      buffer.WriteULong64(m_sequence);
+      buffer.WriteBool(fullPublication);
+      // the number of elements is known at the end
+      const Int_t nElementsOffset = buffer.Length();
+      buffer.WriteUInt(0);
+      for(auto element : elements) {
+        if(nullptr == element or not element->hasObject()) {
+          continue;
+        }
+        const std::string path = element->path();
+        const std::string name = element->name();
+        ElementState &state = m_elementStates[path + "/" + name];
+        const std::string reports = ElementPublication::reportsToString(element->reports());
+        const Int_t elementOffset = buffer.Length();
+        // an element can only refer to objects written in its own buffer range,
+        // so that it can be discarded if unchanged
+        buffer.ResetMap();
+        buffer.WriteStdString(&path);
+        buffer.WriteStdString(&name);
+        const TH1 *histogram = element->objectTo<TH1>();
+        bool written = false;
+        if(not fullPublication and 0 != state.m_version and ElementPublication::supportsDelta(histogram)
+          and findChangedBins(histogram, state)) {
+          Double_t stats[TH1::kNstat] = {0};
+          histogram->GetStats(stats);
+          const bool changed = not m_changedBins.empty() or reports != state.m_reports
+            or histogram->GetEntries() != state.m_entries
+            or not std::equal(state.m_stats.begin(), state.m_stats.end(), stats);
+          // a delta is worth it only if a few bins have changed
+          if(changed and 2*m_changedBins.size() <= static_cast<size_t>(histogram->GetNcells())) {
+            writeDelta(histogram, state, reports, buffer);
+            m_nDeltaElements++;
+            written = true;
+          }
+          else if(changed) {
+            written = writeFull(element, state, true, buffer);
+          }
+        }
+        else {
+          written = writeFull(element, state, fullPublication, buffer);
+        }
+        if(written) {
+          state.m_reports = reports;
+          m_nWrittenElements++;
+        }
+        else {
+          buffer.SetBufferOffset(elementOffset);
+        }
+      }
+      buffer.ResetMap();
+      // write back the number of elements
+      const Int_t endOffset = buffer.Length();
+      buffer.SetBufferOffset(nElementsOffset);
+      buffer.WriteUInt(m_nWrittenElements);
+      buffer.SetBufferOffset(endOffset);
+      m_fullPublicationRequested = false;
+      m_sequence++;
+      return core::STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int ElementPublisher::nWrittenElements() const {
+      return m_nWrittenElements;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int ElementPublisher::nDeltaElements() const {
+      return m_nDeltaElements;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementPublisher::clear() {
+      m_elementStates.clear();
+      m_fullPublicationRequested = true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ElementPublisher::writeFull(OnlineElementPtr element, ElementState &state, bool force, TBuffer &buffer) {
+      // serialize alone first to detect changes
+      m_elementBuffer.Reset();
+      if(core::STATUS_CODE_SUCCESS != element->write(m_elementBuffer)) {
+        dqm_error( "ElementPublisher::writeFull: couldn't write element '{0}'", element->name() );
+        return false;
+      }
+      const std::size_t hash = std::hash<std::string>()(std::string(m_elementBuffer.Buffer(), m_elementBuffer.Length()));
+      if(not force and 0 != state.m_version and hash == state.m_hash) {
+        return false;
+      }
+      buffer.WriteUChar(static_cast<UChar_t>(ElementPublication::FULL_ELEMENT));
+      buffer.WriteULong64(state.m_version + 1);
+      if(core::STATUS_CODE_SUCCESS != element->write(buffer)) {
+        dqm_error( "ElementPublisher::writeFull: couldn't write element '{0}'", element->name() );
+        return false;
+      }
+      state.m_version++;
+      state.m_hash = hash;
+      const TH1 *histogram = element->objectTo<TH1>();
+      if(ElementPublication::supportsDelta(histogram)) {
+        saveHistogram(histogram, state);
+      }
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ElementPublisher::findChangedBins(const TH1 *histogram, const ElementState &state) {
+      m_changedBins.clear();
+      const int nCells = histogram->GetNcells();
+      const bool hasSumw2 = (histogram->GetSumw2N() > 0);
+      // binning or error storage changed
+      if(state.m_contents.size() != static_cast<size_t>(nCells) or hasSumw2 == state.m_sumw2.empty()) {
+        return false;
+      }
+      const Double_t *sumw2 = hasSumw2 ? histogram->GetSumw2()->GetArray() : nullptr;
+      for(int bin=0 ; bin<nCells ; bin++) {
+        if(histogram->GetBinContent(bin) != state.m_contents[bin] or (hasSumw2 and sumw2[bin] != state.m_sumw2[bin])) {
+          m_changedBins.push_back(bin);
+        }
+      }
+      return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementPublisher::writeDelta(const TH1 *histogram, ElementState &state, const std::string &reports, TBuffer &buffer) {
+      const bool hasSumw2 = (histogram->GetSumw2N() > 0);
+      const unsigned int nStats = ElementPublication::nStats(histogram);
+      Double_t stats[TH1::kNstat] = {0};
+      histogram->GetStats(stats);
+      buffer.WriteUChar(static_cast<UChar_t>(ElementPublication::HISTOGRAM_DELTA));
+      buffer.WriteULong64(state.m_version + 1);
+      buffer.WriteULong64(state.m_version);
+      buffer.WriteStdString(&reports);
+      buffer.WriteUChar(static_cast<UChar_t>(nStats));
+      for(unsigned int s=0 ; s<nStats ; s++) {
+        buffer.WriteDouble(stats[s]);
+      }
+      buffer.WriteDouble(histogram->GetEntries());
+      buffer.WriteBool(hasSumw2);
+      ElementPublication::writeVarint(buffer, m_changedBins.size());
+      const Double_t *sumw2 = hasSumw2 ? histogram->GetSumw2()->GetArray() : nullptr;
+      int previousBin = 0;
+      for(auto bin : m_changedBins) {
+        ElementPublication::writeVarint(buffer, bin - previousBin);
+        previousBin = bin;
+        buffer.WriteDouble(histogram->GetBinContent(bin));
+        if(hasSumw2) {
+          buffer.WriteDouble(sumw2[bin]);
+        }
+      }
+      state.m_version++;
+      // the full serialization hash is now outdated
+      state.m_hash = 0;
+      saveHistogram(histogram, state);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementPublisher::saveHistogram(const TH1 *histogram, ElementState &state) {
+      const int nCells = histogram->GetNcells();
+      state.m_contents.resize(nCells);
+      for(int bin=0 ; bin<nCells ; bin++) {
+        state.m_contents[bin] = histogram->GetBinContent(bin);
+      }
+      if(histogram->GetSumw2N() > 0) {
+        const Double_t *sumw2 = histogram->GetSumw2()->GetArray();
+        state.m_sumw2.assign(sumw2, sumw2 + nCells);
+      }
+      else {
+        state.m_sumw2.clear();
+      }
+      Double_t stats[TH1::kNstat] = {0};
+      histogram->GetStats(stats);
+      state.m_stats.assign(stats, stats + ElementPublication::nStats(histogram));
+      state.m_entries = histogram->GetEntries();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode ElementPublicationReader::read(TBuffer &buffer, ElementPublication::Header &header, OnlineElementPtrList &updatedElements) {
+      if(not buffer.IsReading()) {
+        return core::STATUS_CODE_NOT_ALLOWED;
+      }
+      m_nMissedDeltas = 0;
+      UInt_t version = 0;
+      buffer.ReadUInt(version);
+      if(ElementPublication::protocolVersion != version) {
+        dqm_error( "ElementPublicationReader::read: unsupported protocol version {0}", version );
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      ULong64_t sequence = 0;
+      UInt_t nElements = 0;
+      buffer.ReadStdString(&header.m_moduleName);
+      buffer.ReadInt(header.m_runNumber);
+      buffer.ReadULong64(sequence);
+      buffer.ReadBool(header.m_fullPublication);
+      buffer.ReadUInt(nElements);
+      header.m_sequence = sequence;
+      header.m_nElements = nElements;
+      for(UInt_t e=0 ; e<nElements ; e++) {
+        if(buffer.Length() >= buffer.BufferSize()) {
+          dqm_error( "ElementPublicationReader::read: truncated publication ({0}/{1} elements)", e, nElements );
+          return core::STATUS_CODE_FAILURE;
+        }
+        std::string path, name;
+        UChar_t encoding = 0;
+        ULong64_t elementVersion = 0;
+        buffer.ReadStdString(&path);
+        buffer.ReadStdString(&name);
+        buffer.ReadUChar(encoding);
+        buffer.ReadULong64(elementVersion);
+        const std::string key = path + "/" + name;
+        if(ElementPublication::FULL_ELEMENT == encoding) {
+          OnlineElementPtr element = OnlineElement::make_shared();
+          RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, element->read(buffer));
+          element->setModuleName(header.m_moduleName);
+          element->setRunNumber(header.m_runNumber);
+          ElementEntry &entry = m_elements[key];
+          entry.m_version = elementVersion;
+          entry.m_element = element;
+          updatedElements.push_back(element);
+        }
+        else if(ElementPublication::HISTOGRAM_DELTA == encoding) {
+          auto iter = m_elements.find(key);
+          ElementEntry *entry = (m_elements.end() == iter) ? nullptr : &iter->second;
+          if(readDelta(buffer, entry, elementVersion)) {
+            entry->m_element->setRunNumber(header.m_runNumber);
+            updatedElements.push_back(entry->m_element);
+          }
+          else {
+            m_nMissedDeltas++;
+          }
+        }
+        else {
+          dqm_error( "ElementPublicationReader::read: unknown element encoding {0}", static_cast<int>(encoding) );
+          return core::STATUS_CODE_FAILURE;
+        }
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int ElementPublicationReader::nMissedDeltas() const {
+      return m_nMissedDeltas;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementPublicationReader::elements(OnlineElementPtrList &elements) const {
+      for(auto &iter : m_elements) {
+        elements.push_back(iter.second.m_element);
+      }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ElementPublicationReader::clear() {
+      m_elements.clear();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ElementPublicationReader::readDelta(TBuffer &buffer, ElementEntry *entry, unsigned long long version) {
+      ULong64_t baseVersion = 0;
+      std::string reportsStr;
+      UChar_t nStats = 0;
+      Double_t stats[TH1::kNstat] = {0};
+      Double_t entries = 0;
+      Bool_t hasSumw2 = false;
+      unsigned long long nBins = 0;
+      buffer.ReadULong64(baseVersion);
+      buffer.ReadStdString(&reportsStr);
+      buffer.ReadUChar(nStats);
+      for(UChar_t s=0 ; s<nStats ; s++) {
+        Double_t stat = 0;
+        buffer.ReadDouble(stat);
+        if(s < TH1::kNstat) {
+          stats[s] = stat;
+        }
+      }
+      buffer.ReadDouble(entries);
+      buffer.ReadBool(hasSumw2);
+      ElementPublication::readVarint(buffer, nBins);
+      // corrupted publication: each bin takes at least a gap byte and a content
+      const unsigned long long minBinSize = 1 + (hasSumw2 ? 2 : 1) * sizeof(Double_t);
+      const unsigned long long remainingSize = buffer.BufferSize() - buffer.Length();
+      if(nBins > remainingSize / minBinSize) {
+        dqm_error( "ElementPublicationReader::readDelta: {0} bins announced, only {1} bytes left", nBins, remainingSize );
+        buffer.SetBufferOffset(buffer.BufferSize());
+        return false;
+      }
+      // can we apply it ? If not, the bins are only skipped
+      TH1 *histogram = (nullptr == entry or entry->m_version != baseVersion) ? nullptr : entry->m_element->objectTo<TH1>();
+      const bool applicable = (ElementPublication::supportsDelta(histogram) 
+        and nStats == ElementPublication::nStats(histogram)
+        and hasSumw2 == (histogram->GetSumw2N() > 0)
+        and nBins <= static_cast<unsigned long long>(histogram->GetNcells()));
+      std::vector<std::pair<unsigned long long, Double_t>> contents;
+      std::vector<Double_t> sumw2;
+      if(applicable) {
+        contents.reserve(nBins);
+        if(hasSumw2) {
+          sumw2.reserve(nBins);
+        }
+      }
+      unsigned long long bin = 0;
+      for(unsigned long long b=0 ; b<nBins ; b++) {
+        unsigned long long gap = 0;
+        Double_t content = 0;
+        Double_t w2 = 0;
+        ElementPublication::readVarint(buffer, gap);
+        buffer.ReadDouble(content);
+        if(hasSumw2) {
+          buffer.ReadDouble(w2);
+        }
+        if(not applicable) {
+          continue;
+        }
+        bin += gap;
+        contents.push_back(std::make_pair(bin, content));
+        if(hasSumw2) {
+          sumw2.push_back(w2);
+        }
+      }
+      if(not applicable) {
+        return false;
+      }
+      if(not contents.empty() and contents.back().first >= static_cast<unsigned long long>(histogram->GetNcells())) {
+        return false;
+      }
+      core::json reports = nullptr;
+      try {
+        reports = core::json::parse(reportsStr);
+      }
+      catch(...) {
+        dqm_error( "ElementPublicationReader::readDelta: couldn't parse the quality reports" );
+        return false;
+      }
+      for(size_t b=0 ; b<contents.size() ; b++) {
+        histogram->SetBinContent(contents[b].first, contents[b].second);
+        if(hasSumw2) {
+          histogram->GetSumw2()->SetAt(sumw2[b], contents[b].first);
+        }
+      }
+      // restore stats and entries modified by SetBinContent
+      histogram->PutStats(stats);
+      histogram->SetEntries(entries);
+      entry->m_element->m_reports.clear();
+      for(auto it = reports.begin() ; it != reports.end() ; it++) {
+        core::QReport report; report.fromJson(it.value());
+        entry->m_element->m_reports[it.key()] = report;
+      }
+      entry->m_version = version;
+      return true;
+    }
+
+  }
+
+}
@@ -26,9 +26,11 @@
 
 // -- dqm4hep headers
 #include "dqm4hep/EventCollector.h"
+#include "dqm4hep/EventStreamer.h"
 #include "dqm4hep/DQM4hepConfig.h"
 #include "dqm4hep/Logging.h"
 #include "dqm4hep/OnlineRoutes.h"
+#include "dqm4hep/SharedMemory.h"
 
 namespace dqm4hep {
 
@@ -71,6 +73,35 @@ namespace dqm4hep {
           , &verbosityConstraint);
       m_cmdLine->add(verbosityArg);
       
+      core::StringVector codecs = {"none", "zlib", "lz4", "zstd"};
+      TCLAP::ValuesConstraint<std::string> codecConstraint(codecs);
+      TCLAP::ValueArg<std::string> codecArg(
+          "z"
+          , "codec"
+          , "The codec used to compress the events sent to clients"
+          , false
+          , "none"
+          , &codecConstraint);
+      m_cmdLine->add(codecArg);
+      
+      TCLAP::ValueArg<int> codecLevelArg(
+          "l"
+          , "codec-level"
+          , "The compression level (0 for the codec default)"
+          , false
+          , 0
+          , "int");
+      m_cmdLine->add(codecLevelArg);
+      
+      TCLAP::ValueArg<unsigned int> sharedMemorySlotsArg(
+          "s"
+          , "shm-slots"
+          , "The number of shared memory slots per source used for the clients on the same host (0 to disable)"
+          , false
+          , 8
+          , "unsigned int");
+      m_cmdLine->add(sharedMemorySlotsArg);
+      
       // parse command line
       m_cmdLine->parse(argc, argv);
 
@@ -79,6 +110,9 @@ namespace dqm4hep {
       setType(OnlineRoutes::EventCollector::applicationType());
       setName(collectorName);
       setLogLevel(core::Logger::logLevelFromString(verbosity));
+      m_codec = net::Codec::fromString(codecArg.getValue());
+      m_codecLevel = codecLevelArg.getValue();
+      m_sharedMemorySlots = sharedMemorySlotsArg.getValue();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -90,10 +124,12 @@ namespace dqm4hep {
         this, 
         &EventCollector::handleRegistration
       );
+      // large events: don't block the registrations and the collected events
       createRequestHandler(
         OnlineRoutes::EventCollector::eventRequest(name()), 
         this, 
-        &EventCollector::handleEventRequest
+        &EventCollector::handleEventRequest,
+        net::RequestHandler::DEDICATED_THREAD
       );
       createDirectCommand(
         OnlineRoutes::EventCollector::unregisterSource(name()), 
@@ -162,6 +198,7 @@ namespace dqm4hep {
       auto clientId = this->serverClientId();  
       auto findIter = m_sourceInfoMap.find(clientSourceName);
       core::json clientResponseValue({});
+      std::string streamerMessage;
       
       // source already registered
       if(m_sourceInfoMap.end() != findIter) {
@@ -175,6 +212,12 @@ namespace dqm4hep {
           clientResponseValue["registered"] = false;
         }
       }
+      // the streamer ids of the source must match the ones of the other sources
+      else if(not this->registerStreamers(registrationDetails.value<core::json>("streamers", core::json({})), streamerMessage)) {
+        dqm_warning( "Event source '{0}' not registered: {1}", clientSourceName, streamerMessage );
+        clientResponseValue["message"] = streamerMessage;
+        clientResponseValue["registered"] = false;
+      }
       // source not registered yet
       else {
         std::string sourceName = registrationDetails.value<std::string>("source", "");
@@ -183,8 +226,15 @@ namespace dqm4hep {
         
         findIter->second.m_clientId = clientId;
         findIter->second.m_name = registrationDetails.value<std::string>("source", "");
-        findIter->second.m_streamerName = registrationDetails.value<std::string>("streamer", "");
+        for(auto streamer : registrationDetails.value<core::json>("streamers", core::json({})).items()) {
+          findIter->second.m_streamers.push_back(streamer.key());
+        }
         findIter->second.m_eventService = createService(OnlineRoutes::EventCollector::eventUpdate(name(), findIter->first));
+        findIter->second.m_eventService->setCodec(m_codec, m_codecLevel);
+        
+        if(m_sharedMemorySlots > 0) {
+          findIter->second.m_eventService->setSharedMemory(m_sharedMemorySlots);
+        }
         
         auto collectors = registrationDetails["collectors"];
         auto hostInfo = registrationDetails["host"];
@@ -206,6 +256,11 @@ namespace dqm4hep {
         sendStat("NSources", m_sourceInfoMap.size());
       }
       
+      // sources send events in shared memory only if their ring can be opened here
+      // (same host, same user and IPC namespace)
+      const std::string ringName(registrationDetails.value<std::string>("sharedMemory", ""));
+      clientResponseValue["sharedMemory"] = (not ringName.empty() && nullptr != net::SharedMemoryRing::open(ringName));
+      
       auto model = response.createModel<std::string>();
       model->copy(clientResponseValue.dump());
       response.setModel(model);
@@ -213,6 +268,30 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
+    bool EventCollector::registerStreamers(const core::json &streamers, std::string &message) {
+      for(auto streamer : streamers.items()) {
+        const std::string streamerName(streamer.key());
+        const uint16_t streamerId(streamer.value().get<uint16_t>());
+        // different hash function (software version) on the source side
+        if(core::EventStreamer::streamerId(streamerName) != streamerId) {
+          message = "Streamer '" + streamerName + "' id " + std::to_string(streamerId) 
+            + " differs from the collector one (" + std::to_string(core::EventStreamer::streamerId(streamerName)) + ")";
+          return false;
+        }
+        auto findIter = m_streamers.find(streamerId);
+        if(m_streamers.end() != findIter && findIter->second != streamerName) {
+          message = "Streamer '" + streamerName + "' has the same id as streamer '" + findIter->second + "'";
+          return false;
+        }
+      }
+      for(auto streamer : streamers.items()) {
+        m_streamers[streamer.value().get<uint16_t>()] = streamer.key();
+      }
+      return true;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void EventCollector::handleClientExit(StoreEvent<int> *event) {
       const int clientId(event->data());
       auto findIter = std::find_if(m_sourceInfoMap.begin(), m_sourceInfoMap.end(), [&clientId](const SourceInfoMap::value_type &iter){
@@ -235,18 +314,19 @@ namespace dqm4hep {
         return (iter.second.m_clientId == clientId);
       });
       
-      if(findIter != m_sourceInfoMap.end()) {          
-        std::string copiedBuffer(buffer.begin(), buffer.size());
-        auto newModel = findIter->second.m_buffer.createModel<std::string>();
-        findIter->second.m_buffer.setModel(newModel);
-        newModel->move(std::move(copiedBuffer));
+      if(findIter != m_sourceInfoMap.end()) {
+        // Copy the event once in a pooled buffer. The buffer is shared 
+        // by the last event cache and the event service update.
+        // Batches of events are published as they are
+        findIter->second.m_buffer.setModel(m_bufferPool.copy(buffer.begin(), buffer.size()));
+        const uint32_t nEvents(core::EventStreamer::nEvents(buffer.begin(), buffer.size()));
         
-        m_nCollectedEvents10++;
-        m_nCollectedEvents60++;
+        m_nCollectedEvents10 += nEvents;
+        m_nCollectedEvents60 += nEvents;
         m_nCollectedBytes10 += buffer.size();
         m_nCollectedBytes60 += buffer.size();
         // send update
-        findIter->second.m_eventService->sendBuffer(buffer.begin(), buffer.size());
+        findIter->second.m_eventService->send(findIter->second.m_buffer);
       }
     }
     
@@ -309,7 +389,9 @@ namespace dqm4hep {
       for(auto &source : m_sourceInfoMap) {
         dqm_debug( "== Source '{0}' ==", source.first );
         dqm_debug( "     Client id: '{0}' ==", source.second.m_clientId );
-        dqm_debug( "     Streamer:  '{0}' ==", source.second.m_streamerName );
+        for(auto &streamer : source.second.m_streamers) {
+          dqm_debug( "     Streamer:  '{0}' (id {1}) ==", streamer, core::EventStreamer::streamerId(streamer) );
+        }
       }
     }
     
@@ -319,7 +401,7 @@ namespace dqm4hep {
     EventCollector::SourceInfo::SourceInfo(EventCollector::SourceInfo&& info) :
       m_clientId(std::move(info.m_clientId)),
       m_name(std::move(info.m_name)),
-      m_streamerName(std::move(info.m_streamerName)),
+      m_streamers(std::move(info.m_streamers)),
       m_collectors(std::move(info.m_collectors)),
       m_hostInfo(std::move(info.m_hostInfo)),
       m_buffer(std::move(info.m_buffer)),
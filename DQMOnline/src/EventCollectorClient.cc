@@ -35,8 +35,11 @@ namespace dqm4hep {
     
     
     void EventCollectorClient::SourceInfo::receiveEvent(const net::Buffer &buffer) {
-      core::EventPtr event = m_collectorClient->readEvent(buffer);
-      m_eventUpdateSignal.emit(event);
+      core::EventList events;
+      m_collectorClient->readEvents(buffer, events);
+      for(auto &event : events) {
+        m_eventUpdateSignal.emit(event);
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -59,7 +62,12 @@ namespace dqm4hep {
         OnlineRoutes::EventCollector::eventRequest(m_collectorName),
         buffer,
         [&event,this](const net::Buffer &response){
-          event = this->readEvent(response);
+          // the last collected event of a batch
+          core::EventList events;
+          this->readEvents(response, events);
+          if(not events.empty()) {
+            event = events.back();
+          }
       });
       return event;
     }
@@ -140,25 +148,31 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
-    core::EventPtr EventCollectorClient::readEvent(const net::Buffer &buffer) {
+    void EventCollectorClient::readEvents(const net::Buffer &buffer, core::EventList &events) {
       std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      // the dim memory is only valid until the callback returns: copy it once
+      // in a pooled model, so that all the events can reference it in place
+      net::BufferModelPtr model(buffer.model());
+      if(not model->isOwner()) {
+        auto ownedModel = buffer.createModel<std::string>();
+        ownedModel->copy(buffer.begin(), buffer.size());
+        model = ownedModel;
+      }
       
       try {
-        m_buffer.SetBuffer((void*)buffer.begin(), buffer.size(), false);      
+        m_buffer.SetBuffer((void*)model->raw().begin(), model->raw().size(), false);      
       }
       catch(...) {
-        dqm_error( "EventCollectorClient::readEvent: couldn't setup buffer device !" );
-        return nullptr;
+        dqm_error( "EventCollectorClient::readEvents: couldn't setup buffer device !" );
+        return;
       }
-      // read event using event streamer
-      core::EventPtr event(nullptr);
-      core::StatusCode statusCode = m_eventStreamer.readEvent(event, m_buffer);
+      // read a single event or a batch of events using event streamer.
+      // The events keep the model alive as long as they reference it
+      core::StatusCode statusCode = m_eventStreamer.readEvents(events, m_buffer, model);
       
       if(core::STATUS_CODE_SUCCESS != statusCode) {
-        dqm_error( "EventCollectorClient::readEvent: streamer couldn't read event: {0}", core::statusCodeToString(statusCode) );
-        return nullptr;
+        dqm_error( "EventCollectorClient::readEvents: streamer couldn't read event: {0}", core::statusCodeToString(statusCode) );
       }
-      return event;
     }
 
 
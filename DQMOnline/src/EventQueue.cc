@@ -0,0 +1,251 @@
+/// \file EventQueue.cc
+/*
+ *
+ * EventQueue.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ * 
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ * 
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/EventQueue.h"
+#include "dqm4hep/Logging.h"
+
+namespace dqm4hep {
+
+  namespace online {
+    
+    static unsigned long long roundUpPowerOf2(unsigned int value) {
+      unsigned long long power = 1;
+      while(power < value) {
+        power <<= 1;
+      }
+      return power;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    EventQueue::EventQueue(unsigned int cap, OverflowPolicy pol, unsigned int sampling) :
+      m_cells(roundUpPowerOf2(std::max(cap, 2u))),
+      m_mask(m_cells.size()-1),
+      m_policy(pol),
+      m_sampling(std::max(sampling, 1u)) {
+      for(unsigned long long i=0 ; i<m_cells.size() ; i++) {
+        m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool EventQueue::push(core::EventPtr event) {
+      if(m_closed.load()) {
+        m_nDroppedNewest++;
+        return false;
+      }
+      if(tryPush(event)) {
+        m_nPushed++;
+        return true;
+      }
+      // the queue is full, apply the overflow policy
+      switch(m_policy) {
+      case DROP_NEWEST: {
+        m_nDroppedNewest++;
+        return false;
+      }
+      case DROP_OLDEST: {
+        core::EventPtr oldestEvent;
+        while(not tryPush(event)) {
+          if(pop(oldestEvent)) {
+            m_nDroppedOldest++;
+          }
+        }
+        m_nPushed++;
+        return true;
+      }
+      case SAMPLE: {
+        if(0 != (m_nOverflows++ % m_sampling)) {
+          m_nSampledOut++;
+          return false;
+        }
+        core::EventPtr oldestEvent;
+        while(not tryPush(event)) {
+          if(pop(oldestEvent)) {
+            m_nDroppedOldest++;
+          }
+        }
+        m_nPushed++;
+        return true;
+      }
+      case BLOCK: {
+        m_nBlocked++;
+        m_nWaitingProducers++;
+        std::unique_lock<std::mutex> lock(m_blockMutex);
+        while(not tryPush(event)) {
+          if(m_closed.load()) {
+            m_nWaitingProducers--;
+            m_nDroppedNewest++;
+            return false;
+          }
+          // timed wait: a pop may occur between the failed push and the wait
+          m_blockCondition.wait_for(lock, std::chrono::milliseconds(1));
+        }
+        m_nWaitingProducers--;
+        m_nPushed++;
+        return true;
+      }
+      }
+      return false;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool EventQueue::pop(core::EventPtr &event) {
+      Cell *cell = nullptr;
+      unsigned long long pos = m_dequeuePos.load(std::memory_order_relaxed);
+      while(1) {
+        cell = &m_cells[pos & m_mask];
+        const unsigned long long seq = cell->m_sequence.load(std::memory_order_acquire);
+        const long long diff = static_cast<long long>(seq) - static_cast<long long>(pos + 1);
+        if(0 == diff) {
+          if(m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        }
+        else if(diff < 0) {
+          // empty queue
+          return false;
+        }
+        else {
+          pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+      }
+      event = std::move(cell->m_event);
+      cell->m_event = nullptr;
+      cell->m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+      if(0 != m_nWaitingProducers.load()) {
+        notifyProducers();
+      }
+      return true;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned int EventQueue::size() const {
+      const unsigned long long enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+      const unsigned long long dequeuePos = m_dequeuePos.load(std::memory_order_relaxed);
+      return (enqueuePos > dequeuePos) ? static_cast<unsigned int>(enqueuePos - dequeuePos) : 0;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool EventQueue::empty() const {
+      return (0 == size());
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned int EventQueue::capacity() const {
+      return static_cast<unsigned int>(m_cells.size());
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    EventQueue::OverflowPolicy EventQueue::policy() const {
+      return m_policy;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    EventQueue::Counters EventQueue::counters() const {
+      Counters counters;
+      counters.m_nPushed = m_nPushed.load();
+      counters.m_nDroppedNewest = m_nDroppedNewest.load();
+      counters.m_nDroppedOldest = m_nDroppedOldest.load();
+      counters.m_nSampledOut = m_nSampledOut.load();
+      counters.m_nBlocked = m_nBlocked.load();
+      return counters;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventQueue::close() {
+      m_closed = true;
+      notifyProducers();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    core::StatusCode EventQueue::policyFromString(const std::string &str, OverflowPolicy &pol) {
+      if("DropNewest" == str) {
+        pol = DROP_NEWEST;
+      }
+      else if("DropOldest" == str) {
+        pol = DROP_OLDEST;
+      }
+      else if("Block" == str) {
+        pol = BLOCK;
+      }
+      else if("Sample" == str) {
+        pol = SAMPLE;
+      }
+      else {
+        return core::STATUS_CODE_INVALID_PARAMETER;
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool EventQueue::tryPush(core::EventPtr &event) {
+      Cell *cell = nullptr;
+      unsigned long long pos = m_enqueuePos.load(std::memory_order_relaxed);
+      while(1) {
+        cell = &m_cells[pos & m_mask];
+        const unsigned long long seq = cell->m_sequence.load(std::memory_order_acquire);
+        const long long diff = static_cast<long long>(seq) - static_cast<long long>(pos);
+        if(0 == diff) {
+          if(m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        }
+        else if(diff < 0) {
+          // full queue
+          return false;
+        }
+        else {
+          pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+      }
+      cell->m_event = std::move(event);
+      cell->m_sequence.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventQueue::notifyProducers() {
+      std::lock_guard<std::mutex> lock(m_blockMutex);
+      m_blockCondition.notify_all();
+    }
+
+  }
+
+}
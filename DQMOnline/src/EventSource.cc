@@ -49,6 +49,19 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     EventSource::~EventSource() {
+      if(m_flushThread.joinable()) {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_stopFlag = true;
+        }
+        m_condition.notify_one();
+        m_flushThread.join();
+      }
+      
+      if(m_started) {
+        this->flush();
+      }
+      
       for(auto colIter : m_collectorInfos) {
         this->unregisterMe(colIter.first);
       }
@@ -78,6 +91,65 @@ namespace dqm4hep {
       m_collectorInfos.insert(CollectorInfoMap::value_type(name, info));
     }
 
+    //-------------------------------------------------------------------------------------------------
+
+    void EventSource::setBatching(size_t maxSize, unsigned int maxDelay) {
+      if(m_started) {
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      // batching the batches only adds latency
+      if(m_batchMaxEvents > 1) {
+        dqm_error( "EventSource::setBatching: event batching already enabled, use one batching mode only" );
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      
+      m_client.setCommandBatching(maxSize, maxDelay);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EventSource::setEventBatching(unsigned int maxEvents, size_t maxSize, unsigned int maxLatency) {
+      if(m_started) {
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      if(maxEvents > 1 && m_client.commandBatching()) {
+        dqm_error( "EventSource::setEventBatching: command batching already enabled, use one batching mode only" );
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      
+      m_batchMaxEvents = maxEvents;
+      m_batchMaxSize = maxSize;
+      m_batchMaxLatency = maxLatency;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EventSource::flush() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      this->sendBatch();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EventSource::setCompression(net::Codec::Type codec, int level) {
+      if(m_started) {
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      
+      m_client.setCommandCodec(codec, level);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EventSource::setSharedMemory(unsigned int nSlots, size_t slotSize) {
+      if(m_started) {
+        throw core::StatusCodeException(core::STATUS_CODE_NOT_ALLOWED);
+      }
+      
+      m_sharedMemorySlots = nSlots;
+      m_sharedMemorySlotSize = slotSize;
+    }
+
     //-------------------------------------------------------------------------------------------------
     
     void EventSource::start() {
@@ -93,11 +165,16 @@ namespace dqm4hep {
       core::json sourceInfo;
       this->getSourceInfo(sourceInfo);
       
-      for(auto colIter : m_collectorInfos) {
-        bool registered = this->registerMe(colIter.first, sourceInfo);
+      for(auto &colIter : m_collectorInfos) {
+        bool registered = this->registerMe(colIter.first, sourceInfo, colIter.second);
         colIter.second.m_registered = registered;
       }
       
+      // a batch of one event is a single event
+      if(m_batchMaxEvents > 1) {
+        m_flushThread = std::thread(&EventSource::flushThread, this);
+      }
+      
       m_started = true;
     }
     
@@ -134,15 +211,103 @@ namespace dqm4hep {
         throw core::StatusCodeException(core::STATUS_CODE_INVALID_PTR);
       }
       
-      m_buffer.Reset();
-      THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, m_eventStreamer.writeEvent(event, m_buffer));
+      std::lock_guard<std::mutex> lock(m_mutex);
       
+      if(m_batchMaxEvents <= 1) {
+        m_buffer.Reset();
+        THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, m_eventStreamer.writeEvent(event, m_buffer));
+        this->sendBuffer(collectors);
+        return;
+      }
+      
+      // keep the event order per collector
+      if(m_nBatchedEvents > 0 && collectors != m_batchCollectors) {
+        this->sendBatch();
+      }
+      
+      const bool newBatch(0 == m_nBatchedEvents);
+      
+      if(newBatch) {
+        m_buffer.Reset();
+        core::EventStreamer::writeBatchHeader(m_buffer, 0);
+        m_batchCollectors = collectors;
+        m_batchDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_batchMaxLatency);
+      }
+      
+      const Int_t eventOffset(m_buffer.Length());
+      const core::StatusCode statusCode(m_eventStreamer.writeEvent(event, m_buffer));
+      
+      if(core::STATUS_CODE_SUCCESS != statusCode) {
+        // drop what was partially written
+        m_buffer.SetBufferOffset(eventOffset);
+        throw core::StatusCodeException(statusCode);
+      }
+      
+      m_nBatchedEvents++;
+      
+      if(newBatch) {
+        m_condition.notify_one();
+      }
+      
+      if(m_nBatchedEvents >= m_batchMaxEvents || static_cast<size_t>(m_buffer.Length()) >= m_batchMaxSize) {
+        this->sendBatch();
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::sendBatch() {
+      if(0 == m_nBatchedEvents) {
+        return;
+      }
+      
+      const Int_t endOffset(m_buffer.Length());
+      m_buffer.SetBufferOffset(0);
+      core::EventStreamer::writeBatchHeader(m_buffer, m_nBatchedEvents);
+      m_buffer.SetBufferOffset(endOffset);
+      m_nBatchedEvents = 0;
+      this->sendBuffer(m_batchCollectors);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::flushThread() {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      
+      while(!m_stopFlag) {
+        if(0 == m_nBatchedEvents) {
+          m_condition.wait(lock);
+          continue;
+        }
+        
+        if(m_batchDeadline > std::chrono::steady_clock::now()) {
+          m_condition.wait_until(lock, m_batchDeadline);
+          continue;
+        }
+        
+        try {
+          this->sendBatch();
+        }
+        catch(core::StatusCodeException &exception) {
+          dqm_error( "EventSource::flushThread(): Couldn't send batch of events: {0}", exception.toString() );
+        }
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void EventSource::sendBuffer(const core::StringVector &collectors) {
       core::json sourceInfo;
       net::Buffer collectBuffer;
       auto model = collectBuffer.createModel();
       collectBuffer.setModel(model);
       model->handle(m_buffer.Buffer(), m_buffer.Length());
       
+      // the event is written once in shared memory for all 
+      // the collectors that can attach to the ring (see registerMe())
+      net::Buffer referenceBuffer;
+      bool sharedTried(false), shared(false);
+      
       // send serialized event to all collectors 
       for(auto collector : collectors) {
         auto iter = m_collectorInfos.find(collector);
@@ -167,7 +332,7 @@ namespace dqm4hep {
           if(sourceInfo.empty()) {
             this->getSourceInfo(sourceInfo);
           }            
-          iter->second.m_registered = this->registerMe(iter->first, sourceInfo);
+          iter->second.m_registered = this->registerMe(iter->first, sourceInfo, iter->second);
         }
         
         if(!iter->second.m_registered) {
@@ -175,7 +340,20 @@ namespace dqm4hep {
           continue;
         }
         
-        m_client.sendCommand(OnlineRoutes::EventCollector::collectEvent(collector), collectBuffer);
+        if(iter->second.m_sharedMemory && nullptr != m_sharedMemory && !sharedTried) {
+          sharedTried = true;
+          shared = m_sharedMemory->write(m_buffer.Buffer(), m_buffer.Length(), m_sharedReference);
+          
+          if(shared) {
+            auto referenceModel = referenceBuffer.createModel();
+            referenceBuffer.setModel(referenceModel);
+            referenceModel->handle(m_sharedReference.data(), m_sharedReference.size());
+          }
+        }
+        
+        // events too large for a slot go over the network
+        const bool sendReference(iter->second.m_sharedMemory && shared);
+        m_client.sendCommand(OnlineRoutes::EventCollector::collectEvent(collector), sendReference ? referenceBuffer : collectBuffer);
       }  
     }
 
@@ -191,16 +369,37 @@ namespace dqm4hep {
       for(auto colIter : m_collectorInfos)
         collectorsValue.push_back(colIter.first);
       
+      // the streamer ids written in the event envelopes
+      core::json streamersValue({});
+      for(auto streamer : m_eventStreamer.streamers())
+        streamersValue[streamer.second] = streamer.first;
+      
       info = {
         {"source", m_sourceName},
         {"host", hostInfo},
-        {"collectors", collectorsValue}
+        {"collectors", collectorsValue},
+        {"streamers", streamersValue}
       };
+      
+      // the collectors check at registration that they can attach to the ring
+      if(m_sharedMemorySlots > 0 && nullptr == m_sharedMemory) {
+        m_sharedMemory = net::SharedMemoryRing::create(m_sharedMemorySlots, m_sharedMemorySlotSize);
+        
+        // don't try again
+        if(nullptr == m_sharedMemory) {
+          dqm_warning( "EventSource::getSourceInfo(): Couldn't create shared memory ring, sending events over the network" );
+          m_sharedMemorySlots = 0;
+        }
+      }
+      
+      if(nullptr != m_sharedMemory) {
+        info["sharedMemory"] = m_sharedMemory->name();
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
     
-    bool EventSource::registerMe(const std::string &collector, const core::json &info) {
+    bool EventSource::registerMe(const std::string &collector, const core::json &info, CollectorInfo &collectorInfo) {
       std::string requestName = OnlineRoutes::EventCollector::registerSource(collector);
       bool returnValue(false);
       net::Buffer requestBuffer;
@@ -210,7 +409,7 @@ namespace dqm4hep {
       model->move(std::move(jsonDump));
       
       dqm_debug( "Sending request to collector {0} for registration, request: {1}", collector , requestName);
-      m_client.sendRequest(requestName, requestBuffer, [&returnValue,&collector](const net::Buffer &buffer){
+      m_client.sendRequest(requestName, requestBuffer, [&returnValue,&collector,&collectorInfo](const net::Buffer &buffer){
         core::json response({});
         
         if(0 != buffer.size()) {
@@ -226,6 +425,12 @@ namespace dqm4hep {
         else {
           dqm_info( "Event source registered to event collector '{0}' !", collector );
           returnValue = true;
+          // the collector could attach to the shared memory ring
+          collectorInfo.m_sharedMemory = response.value<bool>("sharedMemory", false);
+          
+          if(collectorInfo.m_sharedMemory) {
+            dqm_info( "Event collector '{0}' reads events from shared memory", collector );
+          }
         }
       });
       
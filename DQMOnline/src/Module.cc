@@ -66,6 +66,18 @@ namespace dqm4hep {
       return m_version;
     }
     
+    //-------------------------------------------------------------------------------------------------
+    
+    void Module::setThreadSafe(bool safe) {
+      m_threadSafe = safe;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool Module::threadSafe() const {
+      return m_threadSafe;
+    }
+    
     //-------------------------------------------------------------------------------------------------
 
     ModuleApplication *Module::moduleApplication() const {
@@ -49,6 +49,14 @@ namespace dqm4hep {
     
     ModuleApplication::~ModuleApplication() {
       removeTimer(m_standaloneTimer);
+      if(nullptr != m_eventQueueStatsTimer) {
+        removeTimer(m_eventQueueStatsTimer);
+      }
+      // release producers blocked on a full queue
+      if(nullptr != m_eventQueue) {
+        m_eventQueue->close();
+      }
+      stopProcessingThreads();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -143,9 +151,30 @@ namespace dqm4hep {
         OnlineRoutes::ModuleApplication::subscribe(name()),
         Priorities::SUBSCRIBE
       );
+      createQueuedCommand(
+        OnlineRoutes::ModuleApplication::fullPublication(name()),
+        Priorities::SUBSCRIBE
+      );
+      m_elementPublisher.setModuleName(name());
+      createStatsEntry("NPublishedElements", "", "The number of monitor elements published at end of cycle");
+      createStatsEntry("NPublishedDeltas", "", "The number of histograms published as bin deltas at end of cycle");
+      createStatsEntry("PublicationSize", "bytes", "The size of the monitor element publication sent at end of cycle");
       if(EVENT_READER == appRunningMode()) {
         m_eventReader->onEventRead().connect(this, &ModuleApplication::receiveEvent);
       }
+      if(ANALYSIS == appModuleType()) {
+        createStatsEntry("NQueuedEvents", "", "The current number of events in the event queue");
+        createStatsEntry("NDroppedNewestEvents", "", "The total number of incoming events dropped on event queue overflow");
+        createStatsEntry("NDroppedOldestEvents", "", "The total number of queued events dropped on event queue overflow");
+        createStatsEntry("NSampledOutEvents", "", "The total number of incoming events rejected by sampling on event queue overflow");
+        createStatsEntry("NBlockedEventPushes", "", "The total number of event pushes blocked on event queue overflow");
+        createStatsEntry("NDroppedNullEvents", "", "The total number of null events received and dropped");
+        m_eventQueueStatsTimer = createTimer();
+        m_eventQueueStatsTimer->setInterval(10000);
+        m_eventQueueStatsTimer->setSingleShot(false);
+        m_eventQueueStatsTimer->onTimeout().connect(this, &ModuleApplication::sendEventQueueStats);
+        m_eventQueueStatsTimer->start();
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -168,11 +197,17 @@ namespace dqm4hep {
         if(cmd->commandName() == OnlineRoutes::ModuleApplication::subscribe(name())) {
           receiveSubscriptionList(cmd);
         }
+        // a new receiver needs all the elements
+        if(cmd->commandName() == OnlineRoutes::ModuleApplication::fullPublication(name())) {
+          m_elementPublisher.requestFullPublication();
+        }
       }
       if(AppEvent::END_OF_RUN == appEvent->type()) {
         auto eorEvent = dynamic_cast<StoreEvent<core::Run>*>(appEvent);
         auto run = eorEvent->data();
+        pauseProcessing();
         m_runControl.endCurrentRun(run.parameters());
+        resumeProcessing();
         if(EVENT_READER == appRunningMode()) {
           dqm_info( "End of run processed. Exiting application ..." );
           this->exit(0);
@@ -180,26 +215,7 @@ namespace dqm4hep {
       }
       // process event received from the event collector
       if(AppEvent::PROCESS_EVENT == appEvent->type() and ANALYSIS == appModuleType()) {  
-        if(m_currentNQueuedEvents != 0) {
-          m_currentNQueuedEvents--;
-        }
-        if(m_runControl.isRunning()) {
-          auto procEvent = dynamic_cast<StoreEvent<core::EventPtr>*>(appEvent);
-          auto anaModule = moduleAs<AnalysisModule>();
-          anaModule->process(procEvent->data());
-          m_cycle.incrementCounter();
-          if(EVENT_READER == appRunningMode()) {
-            auto status = m_eventReader->readNextEvent();
-            // end of file ?
-            if(status == core::STATUS_CODE_OUT_OF_RANGE) {
-              processEndOfRun();
-            }
-            else if(status != core::STATUS_CODE_SUCCESS) {
-              dqm_error( "Error while reading event: file reader returned status '{0}'", core::statusCodeToString(status) );
-              this->exit(1);
-            }
-          }
-        }
+        processQueuedEvent();
       }
       // generic loop
       if(AppEvent::PROCESS_EVENT == appEvent->type() and STANDALONE == appModuleType()) {
@@ -212,6 +228,10 @@ namespace dqm4hep {
       if(AppEvent::END_OF_CYCLE == appEvent->type()) {
         auto eocEvent = dynamic_cast<StoreEvent<EOCCondition>*>(appEvent);
         auto condition = eocEvent->data();
+        // the module and the monitor elements are not accessed 
+        // by the processing threads until the next cycle starts
+        pauseProcessing();
+        mergeElementShards();
         m_module->endOfCycle(condition);
         if(condition.m_counter > 0) {
           try {
@@ -221,21 +241,26 @@ namespace dqm4hep {
             core::json jreports;
             reportStorage.toJson(jreports);
             dqm_info( jreports.dump(2) );
-            
-            OnlineElementPtrList publishElements;
-            m_monitorElementManager->iterate<OnlineElement>([&](OnlineElementPtr monitorElement){
-              if(not monitorElement->publish() or not monitorElement->subscribed()){
-                return true;                
-              }
-              publishElements.push_back(monitorElement);
-              return true;
-            });
-            // TODO send monitor element to collector
           }
           catch(core::StatusCodeException &exception) {
             dqm_error( "Error caught at end of cycle: {0}", exception.getStatusCode() );
           }
         }
+        // published at every end of cycle, even without processed event
+        try {
+          OnlineElementPtrList publishElements;
+          m_monitorElementManager->iterate<OnlineElement>([&](OnlineElementPtr monitorElement){
+            if(not monitorElement->publish() or not monitorElement->subscribed()){
+              return true;                
+            }
+            publishElements.push_back(monitorElement);
+            return true;
+          });
+          this->publishElements(publishElements);
+        }
+        catch(core::StatusCodeException &exception) {
+          dqm_error( "Error caught while publishing the monitor elements: {0}", exception.getStatusCode() );
+        }
         // always restart a new cycle for standalone modules
         if(STANDALONE == appModuleType()) {
           m_module->startOfCycle();
@@ -247,12 +272,16 @@ namespace dqm4hep {
           m_module->startOfCycle();
           m_cycle.startCycle(true); 
         }
+        resumeProcessing();
       }
     }
     
     //-------------------------------------------------------------------------------------------------
     
     void ModuleApplication::onStart() {
+      if(multiThreaded()) {
+        startProcessingThreads();
+      }
       if(ONLINE == appRunningMode()) {
         // get run control status in case it is already running
         sendRequest(OnlineRoutes::RunControl::status(m_runControl.name()), net::Buffer(), [this](const net::Buffer &response){
@@ -262,7 +291,9 @@ namespace dqm4hep {
             core::json runJson = statusJson.value<core::json>("run", core::json({}));
             core::Run run;
             run.fromJson(runJson);
+            pauseProcessing();
             m_runControl.startNewRun(run);
+            resumeProcessing();
           }
         });        
       }
@@ -292,6 +323,7 @@ namespace dqm4hep {
       if(STANDALONE == appModuleType()) {
         m_standaloneTimer->stop();
       }
+      stopProcessingThreads();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -390,6 +422,34 @@ namespace dqm4hep {
       THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND,!=, 
         core::XmlHelper::readParameter(settingsHandle, "EnableStatistics", enableStatistics));
       enableStats(enableStatistics);
+      THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND,!=, 
+        core::XmlHelper::readParameter(settingsHandle, "NProcessingThreads", m_nProcessingThreads));
+      if(0 == m_nProcessingThreads) {
+        dqm_error( "parseSteeringFile: NProcessingThreads must be at least 1 !" );
+        throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
+      }
+      if(m_nProcessingThreads > 1) {
+        if(ANALYSIS != appModuleType() or ONLINE != appRunningMode()) {
+          dqm_warning( "Multi-threaded processing is only available for analysis modules running online. Processing events in one thread" );
+          m_nProcessingThreads = 1;
+        }
+        else if(not m_module->threadSafe()) {
+          dqm_warning( "Module '{0}' is not thread safe. Processing events in one thread", m_moduleType );
+          m_nProcessingThreads = 1;
+        }
+      }
+      
+      if(ANALYSIS == appModuleType()) {
+        m_eventQueue = std::make_shared<EventQueue>(m_eventQueueSize, m_eventQueuePolicy, m_eventQueueSampling);
+      }
+      if(multiThreaded()) {
+        // the run control is only modified while the processing is paused
+        m_processingThreads = std::unique_ptr<ProcessingThreadPool>(new ProcessingThreadPool(m_nProcessingThreads, m_eventQueue, m_monitorElementManager, [this](core::EventPtr event){
+          if(m_runControl.isRunning()) {
+            processEvent(event);
+          }
+        }));
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -471,12 +531,20 @@ namespace dqm4hep {
       std::string runControlName;
       THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, core::XmlHelper::readParameter(handle, "RunControl", runControlName));
       m_runControl.setName(runControlName);
+      THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "MonitorElementCollector", m_monitorElementCollector));
+      unsigned int fullPublicationPeriod = m_elementPublisher.fullPublicationPeriod();
+      THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "FullPublicationPeriod", fullPublicationPeriod));
+      m_elementPublisher.setFullPublicationPeriod(fullPublicationPeriod);
       
       if(ANALYSIS == appModuleType()) {
         std::string eventCollector;
         THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, core::XmlHelper::readParameter(handle, "EventCollector", eventCollector));
         THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, core::XmlHelper::readParameter(handle, "EventSource", m_eventSourceName));
         THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "EventQueueSize", m_eventQueueSize));
+        std::string queuePolicy = "DropNewest";
+        THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "EventQueuePolicy", queuePolicy));
+        THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, EventQueue::policyFromString(queuePolicy, m_eventQueuePolicy));
+        THROW_RESULT_IF_AND_IF(core::STATUS_CODE_SUCCESS, core::STATUS_CODE_NOT_FOUND, !=, core::XmlHelper::readParameter(handle, "EventQueueSampling", m_eventQueueSampling));
         
         m_eventCollectorClient = std::make_shared<EventClientPtr::element_type>(eventCollector);
         m_eventCollectorClient->onEventUpdate(m_eventSourceName, this, &ModuleApplication::receiveEvent);        
@@ -573,6 +641,7 @@ namespace dqm4hep {
       core::Run run;
       run.fromJson(runJson);
       dqm_info( "Starting new run {0}", run.runNumber() );
+      pauseProcessing();
       m_runControl.startNewRun(run);
       if(ANALYSIS == appModuleType()) {
         m_module->startOfCycle();
@@ -581,6 +650,7 @@ namespace dqm4hep {
           m_eventCollectorClient->startEventUpdates(m_eventSourceName);          
         }
       }
+      resumeProcessing();
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -602,13 +672,134 @@ namespace dqm4hep {
     //-------------------------------------------------------------------------------------------------
     
     void ModuleApplication::receiveEvent(core::EventPtr event) {
-      if(m_currentNQueuedEvents.load() >= m_eventQueueSize) {
+      if(nullptr == event) {
+        m_nDroppedNullEvents++;
+        dqm_warning( "Received a null event: event dropped" );
+        return;
+      }
+      const uint32_t eventNumber = event->getEventNumber();
+      if(not m_eventQueue->push(event)) {
+        dqm_debug( "Event queue full: event {0} dropped", eventNumber );
+      }
+      if(multiThreaded()) {
+        notifyProcessingThreads();
+      }
+      else {
+        postProcessEvent();        
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::postProcessEvent() {
+      // only one process event at a time in the event loop
+      if(m_processEventPending.exchange(true)) {
         return;
       }
-      auto appEvent = new StoreEvent<core::EventPtr>(AppEvent::PROCESS_EVENT, event);
+      auto appEvent = new AppEvent(AppEvent::PROCESS_EVENT);
       appEvent->setPriority(ModuleApplication::PROCESS_CALL);
       m_eventLoop.postEvent(appEvent);
-      m_currentNQueuedEvents++;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::processQueuedEvent() {
+      // reset first: an event pushed from now on will post a new process event
+      m_processEventPending = false;
+      core::EventPtr event;
+      if(m_eventQueue->pop(event) and m_runControl.isRunning()) {
+        processEvent(event);
+        if(EVENT_READER == appRunningMode()) {
+          auto status = m_eventReader->readNextEvent();
+          // end of file ?
+          if(status == core::STATUS_CODE_OUT_OF_RANGE) {
+            processEndOfRun();
+          }
+          else if(status != core::STATUS_CODE_SUCCESS) {
+            dqm_error( "Error while reading event: file reader returned status '{0}'", core::statusCodeToString(status) );
+            this->exit(1);
+          }
+        }
+      }
+      // process one event at a time to let higher priority events 
+      // (end of cycle, run control, ...) be processed in between
+      if(not m_eventQueue->empty()) {
+        postProcessEvent();
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::processEvent(core::EventPtr event) {
+      auto anaModule = moduleAs<AnalysisModule>();
+      anaModule->process(event);
+      m_cycle.incrementCounter();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    bool ModuleApplication::multiThreaded() const {
+      return (m_nProcessingThreads > 1);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::startProcessingThreads() {
+      // booking is over at this point. Each thread fills its own clone of the histograms
+      THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, m_processingThreads->start());
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::stopProcessingThreads() {
+      if(nullptr != m_processingThreads) {
+        m_processingThreads->stop();
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::notifyProcessingThreads() {
+      m_processingThreads->notify();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::pauseProcessing() {
+      if(not multiThreaded()) {
+        return;
+      }
+      m_processingThreads->pause();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::resumeProcessing() {
+      if(not multiThreaded()) {
+        return;
+      }
+      m_processingThreads->resume();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::mergeElementShards() {
+      if(not multiThreaded()) {
+        return;
+      }
+      m_processingThreads->mergeShards();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void ModuleApplication::sendEventQueueStats() {
+      auto counters = m_eventQueue->counters();
+      sendStat("NQueuedEvents", m_eventQueue->size());
+      sendStat("NDroppedNewestEvents", counters.m_nDroppedNewest);
+      sendStat("NDroppedOldestEvents", counters.m_nDroppedOldest);
+      sendStat("NSampledOutEvents", counters.m_nSampledOut);
+      sendStat("NBlockedEventPushes", counters.m_nBlocked);
+      sendStat("NDroppedNullEvents", m_nDroppedNullEvents.load());
     }
     
     //-------------------------------------------------------------------------------------------------
@@ -643,6 +834,28 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
+    void ModuleApplication::publishElements(const OnlineElementPtrList &elements) {
+      if(m_monitorElementCollector.empty()) {
+        return;
+      }
+      m_publicationBuffer.Reset();
+      THROW_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, m_elementPublisher.write(m_runControl.currentRun().runNumber(), elements, m_publicationBuffer));
+      sendStat("NPublishedElements", m_elementPublisher.nWrittenElements());
+      sendStat("NPublishedDeltas", m_elementPublisher.nDeltaElements());
+      sendStat("PublicationSize", m_publicationBuffer.Length());
+      // always sent, even if nothing has changed since last cycle,
+      // so that the collector can detect a module restart
+      net::Buffer buffer;
+      auto model = buffer.createModel();
+      buffer.setModel(model);
+      model->handle(m_publicationBuffer.Buffer(), m_publicationBuffer.Length());
+      sendCommand(OnlineRoutes::MonitorElementCollector::collectElements(m_monitorElementCollector), buffer);
+      dqm_debug( "Published {0} monitor elements ({1} deltas, {2} bytes)", 
+        m_elementPublisher.nWrittenElements(), m_elementPublisher.nDeltaElements(), m_publicationBuffer.Length() );
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void ModuleApplication::setElementsRunNumber(core::Run &run) {
       m_monitorElementManager->iterate<OnlineElement>([&](OnlineElementPtr monitorElement){
         monitorElement->setRunNumber(run.runNumber());
@@ -0,0 +1,466 @@
+/// \file MonitorElementCollector.cc
+/*
+ *
+ * MonitorElementCollector.cc source template automatically generated by a class generator
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/MonitorElementCollector.h"
+#include "dqm4hep/DQM4hepConfig.h"
+#include "dqm4hep/Logging.h"
+#include "dqm4hep/OnlineRoutes.h"
+
+namespace dqm4hep {
+
+  namespace online {
+    
+    MonitorElementCollector::MonitorElementCollector() : 
+      Application() {
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    MonitorElementCollector::~MonitorElementCollector() {
+      removeTimer(m_refreshTimer);
+      removeTimer(m_statsTimer10);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MonitorElementCollector::parseCmdLine(int argc, char **argv) {
+      std::string cmdLineFooter = "Please report bug to <dqm4hep@gmail.com>";
+      m_cmdLine = std::make_shared<TCLAP::CmdLine>(cmdLineFooter, ' ', DQM4hep_VERSION_STR);
+      
+      TCLAP::ValueArg<std::string> collectorNameArg(
+          "c"
+          , "collector-name"
+          , "The monitor element collector name"
+          , true
+          , ""
+          , "string");
+      m_cmdLine->add(collectorNameArg);
+      
+      TCLAP::ValueArg<unsigned int> refreshIntervalArg(
+          "r"
+          , "refresh-interval"
+          , "The minimum time between two updates sent to a client (unit ms)"
+          , false
+          , 1000
+          , "unsigned int");
+      m_cmdLine->add(refreshIntervalArg);
+      
+      core::StringVector verbosities(core::Logger::logLevels());
+      TCLAP::ValuesConstraint<std::string> verbosityConstraint(verbosities);
+      TCLAP::ValueArg<std::string> verbosityArg(
+          "v"
+          , "verbosity"
+          , "The logging verbosity"
+          , false
+          , "info"
+          , &verbosityConstraint);
+      m_cmdLine->add(verbosityArg);
+      
+      // parse command line
+      m_cmdLine->parse(argc, argv);
+
+      std::string verbosity(verbosityArg.getValue());
+      std::string collectorName(collectorNameArg.getValue());
+      m_refreshInterval = refreshIntervalArg.getValue();
+      if(0 == m_refreshInterval) {
+        dqm_error( "Invalid refresh interval: must be greater than 0" );
+        throw core::StatusCodeException(core::STATUS_CODE_INVALID_PARAMETER);
+      }
+      setType(OnlineRoutes::MonitorElementCollector::applicationType());
+      setName(collectorName);
+      setLogLevel(core::Logger::logLevelFromString(verbosity));
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::onInit() {
+      // create network services
+      createDirectCommand(
+        OnlineRoutes::MonitorElementCollector::collectElements(name()), 
+        this, 
+        &MonitorElementCollector::handleCollectElements
+      );
+      createDirectCommand(
+        OnlineRoutes::MonitorElementCollector::subscribe(name()), 
+        this, 
+        &MonitorElementCollector::handleSubscription
+      );
+      createRequestHandler(
+        OnlineRoutes::MonitorElementCollector::browse(name()), 
+        this, 
+        &MonitorElementCollector::handleBrowse
+      );
+      m_pUpdateService = createService(OnlineRoutes::MonitorElementCollector::elementUpdates(name()));
+      
+      // create statistics entries
+      createStatsEntry("NModules", "", "The current number of publishing modules");
+      createStatsEntry("NClients", "", "The current number of subscribing clients");
+      createStatsEntry("NCollectedBytes_10sec", "bytes", "The total number of bytes collected from modules within the last 10 secondes");
+      createStatsEntry("NSentBytes_10sec", "bytes", "The total number of bytes sent to clients within the last 10 secondes");
+      createStatsEntry("NSentMessages_10sec", "1/10 sec", "The number of update messages sent to clients within the last 10 secondes");
+      
+      m_refreshTimer = createTimer();
+      m_refreshTimer->setInterval(m_refreshInterval);
+      m_refreshTimer->setSingleShot(false);
+      m_refreshTimer->onTimeout().connect(this, &MonitorElementCollector::flushUpdates);
+      m_statsTimer10 = createTimer();
+      m_statsTimer10->setInterval(10000);
+      m_statsTimer10->setSingleShot(false);
+      m_statsTimer10->onTimeout().connect(this, &MonitorElementCollector::sendStatsTimer10);
+      
+      m_refreshTimer->start();
+      m_statsTimer10->start();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::onEvent(AppEvent *pAppEvent) {
+      if(pAppEvent->type() == AppEvent::CLIENT_EXIT) {
+        auto exitEvent = dynamic_cast<StoreEvent<int>*>(pAppEvent);
+        this->handleClientExit(exitEvent);
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::onStart() {
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::onStop() {
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    core::StatusCode MonitorElementCollector::readElementUpdates(const net::Buffer &buffer, OnlineElementPtrList &elements) {
+      TBufferFile readBuffer(TBuffer::kRead, buffer.size(), const_cast<char*>(buffer.begin()), false);
+      UInt_t nElements = 0;
+      readBuffer.ReadUInt(nElements);
+      for(UInt_t e=0 ; e<nElements ; e++) {
+        UInt_t size = 0;
+        readBuffer.ReadUInt(size);
+        const Int_t offset = readBuffer.Length();
+        // no 32 bits overflow with a corrupted size
+        if(static_cast<size_t>(offset) > buffer.size() or size > buffer.size() - offset) {
+          return core::STATUS_CODE_OUT_OF_RANGE;
+        }
+        // each element has been serialized on its own
+        TBufferFile elementBuffer(TBuffer::kRead, size, readBuffer.Buffer() + offset, false);
+        OnlineElementPtr element = OnlineElement::make_shared();
+        RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, element->read(elementBuffer));
+        elements.push_back(element);
+        readBuffer.SetBufferOffset(offset + size);
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::writeElementUpdates(const std::vector<const net::RawBuffer*> &elements, TBuffer &buffer) {
+      buffer.WriteUInt(elements.size());
+      for(auto raw : elements) {
+        buffer.WriteUInt(raw->size());
+        buffer.WriteFastArray(raw->begin(), raw->size());
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::handleCollectElements(const net::Buffer &buffer) {
+      TBufferFile readBuffer(TBuffer::kRead, buffer.size(), const_cast<char*>(buffer.begin()), false);
+      // peek the module name to find the module cache
+      UInt_t version = 0;
+      std::string moduleName;
+      readBuffer.ReadUInt(version);
+      if(ElementPublication::protocolVersion != version) {
+        dqm_error( "Received element publication with unsupported protocol version {0}", version );
+        return;
+      }
+      readBuffer.ReadStdString(&moduleName);
+      readBuffer.SetBufferOffset(0);
+      m_nCollectedBytes10 += buffer.size();
+      
+      auto &cache = m_moduleCaches[moduleName];
+      const bool newModule = (nullptr == cache);
+      if(newModule) {
+        dqm_info( "New module '{0}' publishing elements", moduleName );
+        cache = std::make_shared<ModuleCache>();
+        sendStat("NModules", m_moduleCaches.size());
+      }
+      ElementPublication::Header header;
+      OnlineElementPtrList updatedElements;
+      const core::StatusCode statusCode = cache->m_reader.read(readBuffer, header, updatedElements);
+      if(core::STATUS_CODE_SUCCESS != statusCode) {
+        dqm_error( "Couldn't read element publication of module '{0}': {1}", moduleName, core::statusCodeToString(statusCode) );
+        return;
+      }
+      // a new or restarted module doesn't know the current subscriptions
+      if(newModule or header.m_sequence <= cache->m_lastSequence) {
+        sendModuleSubscriptions(moduleName);
+      }
+      cache->m_lastSequence = header.m_sequence;
+      // we missed a base version for some deltas, ask for all elements
+      if(0 != cache->m_reader.nMissedDeltas()) {
+        dqm_debug( "Missed {0} element deltas from module '{1}', requesting full publication", cache->m_reader.nMissedDeltas(), moduleName );
+        // empty commands are not delivered, the contents is not used
+        sendCommand(OnlineRoutes::ModuleApplication::fullPublication(moduleName), moduleName);
+      }
+      for(auto element : updatedElements) {
+        ElementKey key;
+        key.m_module = moduleName;
+        key.m_path = element->path();
+        key.m_name = element->name();
+        // serialize once, whatever the number of subscribers
+        m_elementBuffer.Reset();
+        if(core::STATUS_CODE_SUCCESS != element->write(m_elementBuffer)) {
+          dqm_error( "Couldn't serialize element '{0}' of module '{1}'", key.m_name, moduleName );
+          continue;
+        }
+        BlobPtr &blob = cache->m_blobs[key];
+        // the blob may still be referenced by a pending update
+        if(nullptr == blob or blob.use_count() > 1) {
+          blob = std::make_shared<BlobPtr::element_type>();
+        }
+        blob->copy(m_elementBuffer.Buffer(), m_elementBuffer.Length());
+        auto subIter = m_subscribers.find(key);
+        if(m_subscribers.end() == subIter) {
+          continue;
+        }
+        for(auto clientId : subIter->second) {
+          m_clients[clientId].m_pending.insert(key);
+        }
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::handleSubscription(const net::Buffer &buffer) {
+      const int clientId(serverClientId());
+      core::json jsubscription = nullptr;
+      try {
+        jsubscription = core::json::parse(buffer.begin(), buffer.end());
+      }
+      catch(...) {
+        dqm_error( "Caught exception: Couldn't parse monitor element subscription list of client {0}!", clientId );
+        return;
+      }
+      if(not jsubscription.is_array()) {
+        dqm_error( "Monitor element subscription json object is not a list !" );
+        return;
+      }
+      auto clientIter = m_clients.find(clientId);
+      if(m_clients.end() == clientIter) {
+        clientIter = m_clients.insert(ClientInfoMap::value_type(clientId, ClientInfo())).first;
+        sendStat("NClients", m_clients.size());
+      }
+      std::map<std::string, core::json> moduleSubscriptions;
+      for(auto &element : jsubscription) {
+        ElementKey key;
+        key.m_module = element.value<std::string>("module", "");
+        key.m_path = element.value<std::string>("path", "");
+        key.m_name = element.value<std::string>("name", "");
+        const bool subscribe = element.value<bool>("sub", true);
+        if(subscribe) {
+          if(not clientIter->second.m_subscriptions.insert(key).second) {
+            continue;
+          }
+          updateSubscribers(clientId, key, true, moduleSubscriptions);
+          // send the cached version at next flush
+          auto cacheIter = m_moduleCaches.find(key.m_module);
+          if(m_moduleCaches.end() != cacheIter and cacheIter->second->m_blobs.count(key)) {
+            clientIter->second.m_pending.insert(key);
+          }
+        }
+        else {
+          if(0 == clientIter->second.m_subscriptions.erase(key)) {
+            continue;
+          }
+          clientIter->second.m_pending.erase(key);
+          updateSubscribers(clientId, key, false, moduleSubscriptions);
+        }
+      }
+      for(auto &subscriptions : moduleSubscriptions) {
+        sendCommand(OnlineRoutes::ModuleApplication::subscribe(subscriptions.first), subscriptions.second.dump());
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::handleBrowse(const net::Buffer &/*request*/, net::Buffer &response) {
+      core::json jmodules = core::json::object();
+      for(auto &cache : m_moduleCaches) {
+        core::json jelements = core::json::array();
+        for(auto &blob : cache.second->m_blobs) {
+          auto subIter = m_subscribers.find(blob.first);
+          const unsigned int nSubscribers = (m_subscribers.end() == subIter) ? 0 : subIter->second.size();
+          jelements.push_back({
+            {"path", blob.first.m_path},
+            {"name", blob.first.m_name},
+            {"subscribers", nSubscribers}
+          });
+        }
+        jmodules[cache.first] = jelements;
+      }
+      auto model = response.createModel<std::string>();
+      model->move(jmodules.dump());
+      response.setModel(model);
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::handleClientExit(StoreEvent<int> *event) {
+      const int clientId(event->data());
+      auto clientIter = m_clients.find(clientId);
+      if(m_clients.end() == clientIter) {
+        return;
+      }
+      std::map<std::string, core::json> moduleSubscriptions;
+      for(auto &key : clientIter->second.m_subscriptions) {
+        updateSubscribers(clientId, key, false, moduleSubscriptions);
+      }
+      m_clients.erase(clientIter);
+      for(auto &subscriptions : moduleSubscriptions) {
+        sendCommand(OnlineRoutes::ModuleApplication::subscribe(subscriptions.first), subscriptions.second.dump());
+      }
+      dqm_info( "Removed client {0} from subscribers", clientId );
+      sendStat("NClients", m_clients.size());
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::updateSubscribers(int clientId, const ElementKey &key, bool subscribe, std::map<std::string, core::json> &moduleSubscriptions) {
+      bool forward = false;
+      if(subscribe) {
+        auto &subscribers = m_subscribers[key];
+        forward = subscribers.empty();
+        subscribers.insert(clientId);
+      }
+      else {
+        auto subIter = m_subscribers.find(key);
+        if(m_subscribers.end() == subIter) {
+          return;
+        }
+        subIter->second.erase(clientId);
+        if(subIter->second.empty()) {
+          m_subscribers.erase(subIter);
+          forward = true;
+        }
+      }
+      if(forward) {
+        moduleSubscriptions[key.m_module].push_back({
+          {"path", key.m_path},
+          {"name", key.m_name},
+          {"sub", subscribe}
+        });
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::sendModuleSubscriptions(const std::string &module) {
+      core::json jsubscriptions = core::json::array();
+      for(auto &subscribers : m_subscribers) {
+        if(subscribers.first.m_module != module) {
+          continue;
+        }
+        jsubscriptions.push_back({
+          {"path", subscribers.first.m_path},
+          {"name", subscribers.first.m_name},
+          {"sub", true}
+        });
+      }
+      if(not jsubscriptions.empty()) {
+        sendCommand(OnlineRoutes::ModuleApplication::subscribe(module), jsubscriptions.dump());
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::flushUpdates() {
+      // clients waiting for the same elements share the same message
+      std::map<ElementKeySet, std::vector<int>> batches;
+      for(auto &client : m_clients) {
+        if(client.second.m_pending.empty()) {
+          continue;
+        }
+        batches[client.second.m_pending].push_back(client.first);
+        client.second.m_pending.clear();
+      }
+      for(auto &batch : batches) {
+        m_batchElements.clear();
+        for(auto &key : batch.first) {
+          auto cacheIter = m_moduleCaches.find(key.m_module);
+          if(m_moduleCaches.end() == cacheIter) {
+            continue;
+          }
+          auto blobIter = cacheIter->second->m_blobs.find(key);
+          if(cacheIter->second->m_blobs.end() == blobIter) {
+            continue;
+          }
+          m_batchElements.push_back(&blobIter->second->raw());
+        }
+        if(m_batchElements.empty()) {
+          continue;
+        }
+        m_batchBuffer.Reset();
+        writeElementUpdates(m_batchElements, m_batchBuffer);
+        const Int_t length = m_batchBuffer.Length();
+        m_pUpdateService->sendBuffer(m_batchBuffer.Buffer(), length, batch.second);
+        m_nSentBytes10 += length * batch.second.size();
+        m_nSentMessages10 += batch.second.size();
+      }
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void MonitorElementCollector::sendStatsTimer10() {
+      sendStat("NCollectedBytes_10sec", m_nCollectedBytes10);
+      sendStat("NSentBytes_10sec", m_nSentBytes10);
+      sendStat("NSentMessages_10sec", m_nSentMessages10);
+      m_nCollectedBytes10 = 0;
+      m_nSentBytes10 = 0;
+      m_nSentMessages10 = 0;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    bool MonitorElementCollector::ElementKey::operator<(const ElementKey &rhs) const {
+      if(m_module != rhs.m_module) {
+        return m_module < rhs.m_module;
+      }
+      if(m_path != rhs.m_path) {
+        return m_path < rhs.m_path;
+      }
+      return m_name < rhs.m_name;
+    }
+
+  }
+
+}
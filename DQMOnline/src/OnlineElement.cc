@@ -27,15 +27,20 @@
 
 // -- dqm4hep header
 #include <dqm4hep/OnlineElement.h>
+#include <dqm4hep/JsonWriter.h>
 #include <dqm4hep/Logging.h>
 #include <dqm4hep/QualityTest.h>
 
 // -- root headers
 #include <TBuffer.h>
+#include <TH1.h>
 
 namespace dqm4hep {
   
   namespace online {
+    
+    /// The processing thread index of the current thread
+    static thread_local int currentThreadIndex = -1;
 
     OnlineElementPtr OnlineElement::make_shared() {
       return std::shared_ptr<OnlineElement>(new OnlineElement());
@@ -192,6 +197,85 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
+    const core::QReportMap &OnlineElement::reports() const {
+      return m_reports;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    TObject *OnlineElement::threadObject() {
+      const int index = OnlineElement::threadIndex();
+      if(index < 0 or static_cast<unsigned int>(index) >= m_shards.size()) {
+        return object();
+      }
+      return m_shards[index].ptr();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    core::StatusCode OnlineElement::createShards(unsigned int nShards) {
+      m_shards.clear();
+      TH1 *histogram = objectTo<TH1>();
+      // only histograms can be merged back
+      if(nullptr == histogram or nShards < 2) {
+        return core::STATUS_CODE_SUCCESS;
+      }
+      for(unsigned int i=0 ; i<nShards ; i++) {
+        TH1 *shard = dynamic_cast<TH1*>(histogram->Clone());
+        if(nullptr == shard) {
+          m_shards.clear();
+          return core::STATUS_CODE_FAILURE;
+        }
+        shard->SetDirectory(nullptr);
+        shard->Reset();
+        m_shards.push_back(core::PtrHandler<TObject>(shard, true));
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    core::StatusCode OnlineElement::mergeShards() {
+      if(m_shards.empty()) {
+        return core::STATUS_CODE_SUCCESS;
+      }
+      TH1 *histogram = objectTo<TH1>();
+      if(nullptr == histogram) {
+        return core::STATUS_CODE_FAILURE;
+      }
+      for(auto &shard : m_shards) {
+        TH1 *shardHistogram = static_cast<TH1*>(shard.ptr());
+        if(0 == shardHistogram->GetEntries()) {
+          continue;
+        }
+        if(not histogram->Add(shardHistogram)) {
+          return core::STATUS_CODE_FAILURE;
+        }
+        shardHistogram->Reset();
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    unsigned int OnlineElement::nShards() const {
+      return m_shards.size();
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    void OnlineElement::setThreadIndex(int index) {
+      currentThreadIndex = index;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    int OnlineElement::threadIndex() {
+      return currentThreadIndex;
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
     void OnlineElement::reset(bool resetQtests) {
       core::MonitorElement::reset(resetQtests);
       m_runNumber = 0;
@@ -199,23 +283,25 @@ namespace dqm4hep {
       m_moduleName.clear();
       m_description.clear();
       m_reports.clear();
+      m_shards.clear();
     }
     
     //-------------------------------------------------------------------------------------------------
     
-    void OnlineElement::toJson(core::json &obj) const {
-      core::MonitorElement::toJson(obj);
-      obj["run"] = m_runNumber;
-      obj["collector"] = m_collectorName;
-      obj["module"] = m_moduleName;
-      obj["description"] = m_description;
+    void OnlineElement::writeJsonMembers(core::JsonWriter &writer) const {
+      core::MonitorElement::writeJsonMembers(writer);
+      writer.key("run").value(m_runNumber);
+      writer.key("collector").value(m_collectorName);
+      writer.key("module").value(m_moduleName);
+      writer.key("description").value(m_description);
+      // quality reports are small, no need to stream them
       core::json reports = {};
       for(auto report : m_reports) {
         core::json jreport;
         report.second.toJson(jreport);
         reports[report.first] = jreport;
       }
-      obj["reports"] = reports;
+      writer.key("reports").raw(reports.dump());
     }
     
     //-------------------------------------------------------------------------------------------------
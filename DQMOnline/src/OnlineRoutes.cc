@@ -142,6 +142,43 @@ namespace dqm4hep {
       return OnlineRoutes::Application::serverName(applicationType(), moduleName) + "/subscribe";
     }
     
+    //-------------------------------------------------------------------------------------------------
+    
+    const std::string OnlineRoutes::ModuleApplication::fullPublication(const std::string &moduleName) {
+      return OnlineRoutes::Application::serverName(applicationType(), moduleName) + "/fullpub";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::applicationType() {
+      return "mecol";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::collectElements(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/collect";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::subscribe(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/subscribe";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::browse(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/browse";
+    }
+    
+    //-------------------------------------------------------------------------------------------------
+    
+    std::string OnlineRoutes::MonitorElementCollector::elementUpdates(const std::string &collector) {
+      return OnlineRoutes::Application::serverName(applicationType(), collector) + "/updates";
+    }
+    
     //-------------------------------------------------------------------------------------------------
     //-------------------------------------------------------------------------------------------------
   }
@@ -0,0 +1,212 @@
+/// \file ProcessingThreadPool.cc
+/*
+ *
+ * ProcessingThreadPool.cc source template automatically generated by a class generator
+ * Creation date : sam. oct. 17 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ * 
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ * 
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include "dqm4hep/ProcessingThreadPool.h"
+#include "dqm4hep/OnlineElement.h"
+#include "dqm4hep/Logging.h"
+
+// -- root headers
+#include <TROOT.h>
+
+namespace dqm4hep {
+
+  namespace online {
+
+    ProcessingThreadPool::ProcessingThreadPool(unsigned int nThreads, EventQueuePtr queue, std::shared_ptr<core::MonitorElementManager> manager, ProcessFunction function) :
+      m_nThreads(nThreads),
+      m_eventQueue(queue),
+      m_monitorElementManager(manager),
+      m_processFunction(function) {
+
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    ProcessingThreadPool::~ProcessingThreadPool() {
+      stop();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    unsigned int ProcessingThreadPool::nThreads() const {
+      return m_nThreads;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ProcessingThreadPool::running() const {
+      return (not m_threads.empty());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode ProcessingThreadPool::start() {
+      if(running()) {
+        return core::STATUS_CODE_SUCCESS;
+      }
+      ROOT::EnableThreadSafety();
+      // each thread fills its own clone of the histograms
+      RETURN_RESULT_IF(core::STATUS_CODE_SUCCESS, !=, createMissingShards());
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = false;
+      }
+      dqm_info( "Starting {0} event processing threads", m_nThreads );
+      for(unsigned int i=0 ; i<m_nThreads ; i++) {
+        m_threads.push_back(std::thread(&ProcessingThreadPool::threadLoop, this, i));
+      }
+      return core::STATUS_CODE_SUCCESS;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ProcessingThreadPool::stop() {
+      if(not running()) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+      }
+      m_processingCondition.notify_all();
+      for(auto &thread : m_threads) {
+        thread.join();
+      }
+      m_threads.clear();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ProcessingThreadPool::notify() {
+      // lock to not miss a thread about to wait on an empty queue
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+      }
+      m_processingCondition.notify_one();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ProcessingThreadPool::pause() {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_paused = true;
+      m_pauseCondition.wait(lock, [this]{
+        return (0 == m_nActive);
+      });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ProcessingThreadPool::resume() {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // elements booked while paused (start of run, start of cycle)
+        // would otherwise be filled concurrently by all the threads
+        if(running() and core::STATUS_CODE_SUCCESS != createMissingShards()) {
+          dqm_error( "Couldn't create the thread shards of the new monitor elements" );
+        }
+        m_paused = false;
+      }
+      m_processingCondition.notify_all();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ProcessingThreadPool::mergeShards() {
+      m_monitorElementManager->iterate<OnlineElement>([&](OnlineElementPtr monitorElement){
+        if(nullptr != monitorElement and core::STATUS_CODE_SUCCESS != monitorElement->mergeShards()) {
+          dqm_error( "Couldn't merge thread shards of monitor element '{0}'", monitorElement->name() );
+        }
+        return true;
+      });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    core::StatusCode ProcessingThreadPool::createMissingShards() {
+      core::StatusCode statusCode = core::STATUS_CODE_SUCCESS;
+      m_monitorElementManager->iterate<OnlineElement>([&](OnlineElementPtr monitorElement){
+        // never re-create existing shards: they hold the entries of the current cycle
+        if(nullptr == monitorElement or monitorElement->nShards() > 0) {
+          return true;
+        }
+        if(core::STATUS_CODE_SUCCESS != monitorElement->createShards(m_nThreads)) {
+          dqm_error( "Couldn't create thread shards of monitor element '{0}'", monitorElement->name() );
+          statusCode = core::STATUS_CODE_FAILURE;
+        }
+        return true;
+      });
+      return statusCode;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ProcessingThreadPool::threadLoop(unsigned int index) {
+      OnlineElement::setThreadIndex(index);
+      while(1) {
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_processingCondition.wait(lock, [this]{
+            return m_stopped or (not m_paused and not m_eventQueue->empty());
+          });
+          if(m_stopped) {
+            break;
+          }
+          ++m_nActive;
+        }
+        core::EventPtr event;
+        if(m_eventQueue->pop(event)) {
+          try {
+            m_processFunction(event);
+          }
+          catch(core::StatusCodeException &exception) {
+            dqm_error( "Processing thread {0}: caught exception while processing event: {1}", index, exception.getStatusCode() );
+          }
+          catch(std::exception &exception) {
+            dqm_error( "Processing thread {0}: caught exception while processing event: {1}", index, exception.what() );
+          }
+          catch(...) {
+            dqm_error( "Processing thread {0}: caught unknown exception while processing event", index );
+          }
+        }
+        bool notifyPause = false;
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          --m_nActive;
+          notifyPause = (m_paused and 0 == m_nActive);
+        }
+        if(notifyPause) {
+          m_pauseCondition.notify_all();
+        }
+      }
+      OnlineElement::setThreadIndex(-1);
+    }
+
+  }
+
+}
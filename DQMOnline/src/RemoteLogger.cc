@@ -33,16 +33,20 @@ namespace dqm4hep {
 
   namespace online {
 
-    RemoteLogger::RemoteLogger() {
+    RemoteLogger::RemoteLogger(bool batching) {
       char hname[256];
       gethostname(hname, 256);
       m_hostname = hname;
+      
+      if(batching) {
+        m_client.setCommandBatching();        
+      }
     }
     
     //-------------------------------------------------------------------------------------------------
     
-    core::Logger::AppenderPtr RemoteLogger::make_shared() {
-      return std::make_shared<RemoteLogger>();
+    core::Logger::AppenderPtr RemoteLogger::make_shared(bool batching) {
+      return std::make_shared<RemoteLogger>(batching);
     }
         
     //-------------------------------------------------------------------------------------------------
@@ -60,7 +64,8 @@ namespace dqm4hep {
     
     //-------------------------------------------------------------------------------------------------
     
-    void RemoteLogger::flush() {      
+    void RemoteLogger::flush() {
+      m_client.flushCommands();
     }
     
   }
@@ -0,0 +1,235 @@
+#ifndef DQM4HEP_BENCHMARK_H
+#define DQM4HEP_BENCHMARK_H
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/json.h>
+#include <dqm4hep/DQM4hepConfig.h>
+
+// -- std headers
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+namespace dqm4hep {
+
+  namespace test {
+
+    /**
+     *  @brief  Prevent the compiler from optimizing away a computed value
+     */
+    template <typename T>
+    inline void doNotOptimize(const T &value) {
+      asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    //-------------------------------------------------------------------------------------------------
+    //-------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief  Benchmark class.
+     *          Runs timed scenarios (warmup + repetitions) and reports
+     *          statistics per scenario. Results can be written in json so
+     *          that runs on different commits can be compared.
+     *
+     *  @code
+     *  Benchmark bench("dqm4hep-bench");
+     *  bench.run("storage-find", {{"objects", "1000"}}, 1000, [&](){ ... });
+     *  bench.writeJson("results.json");
+     *  @endcode
+     */
+    class Benchmark {
+    public:
+      /**
+       *  @brief  Result struct. Times in nanoseconds per repetition
+       */
+      struct Result {
+        std::string           m_scenario = {""};
+        core::StringMap       m_parameters = {};
+        unsigned int          m_items = {1};
+        unsigned int          m_repetitions = {0};
+        double                m_min = {0.};
+        double                m_mean = {0.};
+        double                m_stddev = {0.};
+        double                m_p50 = {0.};
+        double                m_p90 = {0.};
+        double                m_p99 = {0.};
+        double                m_max = {0.};
+      };
+
+      Benchmark(const std::string &name) :
+      m_name(name) {
+        core::Logger::createLogger(name, {core::Logger::coloredConsole()});
+        core::Logger::setMainLogger(name);
+        core::Logger::setLogLevel(spdlog::level::info);
+      }
+
+      void setWarmup(unsigned int warmup) {
+        m_warmup = warmup;
+      }
+
+      void setRepetitions(unsigned int repetitions) {
+        m_repetitions = std::max(1u, repetitions);
+      }
+
+      void setFilter(const std::string &filter) {
+        m_filter = filter;
+      }
+
+      void setTag(const std::string &tag) {
+        m_tag = tag;
+      }
+
+      /**
+       *  @brief  Whether the scenario passes the filter (wildcard)
+       */
+      bool enabled(const std::string &scenario) const {
+        return (m_filter.empty() || core::wildcardMatch(scenario, m_filter));
+      }
+
+      /**
+       *  @brief  Run a scenario. The function is called warmup + repetitions times,
+       *          each call being timed. The items count is the number of processed
+       *          items per call (events, elements, ...), used to compute the throughput
+       *
+       *  @param  scenario the scenario name
+       *  @param  parameters the scenario parameters
+       *  @param  items the number of items processed per call
+       *  @param  function the function to time
+       */
+      template <typename F>
+      void run(const std::string &scenario, const core::StringMap &parameters, unsigned int items, F function) {
+        if(not enabled(scenario)) {
+          return;
+        }
+        for(unsigned int i=0 ; i<m_warmup ; i++) {
+          function();
+        }
+        std::vector<double> samples;
+        samples.reserve(m_repetitions);
+        for(unsigned int i=0 ; i<m_repetitions ; i++) {
+          auto start = std::chrono::steady_clock::now();
+          function();
+          auto end = std::chrono::steady_clock::now();
+          samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        addSamples(scenario, parameters, items, samples);
+      }
+
+      /**
+       *  @brief  Add a scenario result from samples measured by the caller (nanoseconds)
+       */
+      void addSamples(const std::string &scenario, const core::StringMap &parameters, unsigned int items, std::vector<double> samples) {
+        if(not enabled(scenario) || samples.empty()) {
+          return;
+        }
+        std::sort(samples.begin(), samples.end());
+        Result result;
+        result.m_scenario = scenario;
+        result.m_parameters = parameters;
+        result.m_items = std::max(1u, items);
+        result.m_repetitions = samples.size();
+        result.m_min = samples.front();
+        result.m_max = samples.back();
+        result.m_p50 = percentile(samples, 0.50);
+        result.m_p90 = percentile(samples, 0.90);
+        result.m_p99 = percentile(samples, 0.99);
+        double sum(0.), sum2(0.);
+        for(auto sample : samples) {
+          sum += sample;
+          sum2 += sample*sample;
+        }
+        result.m_mean = sum / samples.size();
+        result.m_stddev = std::sqrt(std::max(0., sum2 / samples.size() - result.m_mean*result.m_mean));
+        print(result);
+        m_results.push_back(result);
+      }
+
+      /**
+       *  @brief  Get the results
+       */
+      const std::vector<Result> &results() const {
+        return m_results;
+      }
+
+      /**
+       *  @brief  Convert the results to json
+       */
+      void toJson(core::json &object) const {
+        core::StringMap hostInfo;
+        core::fillHostInfo(hostInfo);
+        core::json results = core::json::array();
+        for(auto &result : m_results) {
+          const double perItem(result.m_p50 / result.m_items);
+          results.push_back({
+            {"scenario", result.m_scenario},
+            {"parameters", result.m_parameters},
+            {"items", result.m_items},
+            {"repetitions", result.m_repetitions},
+            {"minNs", result.m_min},
+            {"meanNs", result.m_mean},
+            {"stddevNs", result.m_stddev},
+            {"p50Ns", result.m_p50},
+            {"p90Ns", result.m_p90},
+            {"p99Ns", result.m_p99},
+            {"maxNs", result.m_max},
+            {"p50NsPerItem", perItem},
+            {"itemsPerSecond", perItem > 0. ? 1e9 / perItem : 0.}
+          });
+        }
+        object = {
+          {"benchmark", m_name},
+          {"version", DQM4hep_VERSION_STR},
+          {"tag", m_tag},
+          {"warmup", m_warmup},
+          {"host", hostInfo},
+          {"results", results}
+        };
+      }
+
+      /**
+       *  @brief  Write the results in a json file
+       */
+      bool writeJson(const std::string &fname) const {
+        core::json object;
+        toJson(object);
+        std::ofstream file(fname);
+        if(not file) {
+          dqm_error("Benchmark: couldn't open output file '{0}'", fname);
+          return false;
+        }
+        file << object.dump(2) << std::endl;
+        return true;
+      }
+
+    private:
+      static double percentile(const std::vector<double> &sorted, double fraction) {
+        const std::size_t index(static_cast<std::size_t>(std::ceil(fraction * sorted.size())));
+        return sorted[std::min(sorted.size(), std::max<std::size_t>(index, 1)) - 1];
+      }
+
+      void print(const Result &result) const {
+        std::stringstream sstr;
+        for(auto &param : result.m_parameters) {
+          sstr << param.first << "=" << param.second << " ";
+        }
+        dqm_info("[BENCH:{0}] {1}p50: {2:.0f} ns, p99: {3:.0f} ns, mean: {4:.0f} +/- {5:.0f} ns, per item: {6:.1f} ns",
+          result.m_scenario, sstr.str(), result.m_p50, result.m_p99, result.m_mean, result.m_stddev, result.m_p50 / result.m_items);
+      }
+
+    private:
+      std::string                m_name = {""};
+      std::string                m_filter = {""};
+      std::string                m_tag = {""};
+      unsigned int               m_warmup = {3};
+      unsigned int               m_repetitions = {20};
+      std::vector<Result>        m_results = {};
+    };
+
+  }
+
+}
+
+#endif  //  DQM4HEP_BENCHMARK_H
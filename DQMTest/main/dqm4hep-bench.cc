@@ -0,0 +1,545 @@
+/// \file dqm4hep-bench.cc
+/*
+ *
+ * dqm4hep-bench.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+/**
+ * Microbenchmarks of the DQMCore and DQMOnline hot paths:
+ * event streaming, monitor element serialization, storage lookup,
+ * signals, application event loop, quality tests and element publication.
+ * No network service is started. Use --output to write the results
+ * in json and compare them across commits.
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/BufferEvent.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/MonitorElementManager.h>
+#include <dqm4hep/JsonWriter.h>
+#include <dqm4hep/Signal.h>
+#include <dqm4hep/Storage.h>
+#include <dqm4hep/XMLParser.h>
+#include <dqm4hep/AppEventLoop.h>
+#include <dqm4hep/OnlineElement.h>
+#include <dqm4hep/ElementPublisher.h>
+#include <dqm4hep/Benchmark.h>
+#include <dqm4hep/DQM4hepConfig.h>
+
+// -- tclap headers
+#include <tclap/Arg.h>
+#include <tclap/CmdLine.h>
+#include <tclap/ValuesConstraint.h>
+
+// -- root headers
+#include <TBufferFile.h>
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TRandom3.h>
+
+// -- std headers
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using Benchmark = dqm4hep::test::Benchmark;
+using dqm4hep::test::doNotOptimize;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+void benchEventStreamer(Benchmark &bench) {
+  EventStreamer streamer;
+  for(unsigned int nValues : {100, 10000, 1000000}) {
+    const StringMap params = {{"values", typeToString(nValues)}};
+    EventPtr event = GenericEvent::make_shared();
+    event->getEvent<GenericEvent>()->setValues("Energy", DoubleVector(nValues, 3.14));
+    event->getEvent<GenericEvent>()->setValues("CellID", IntVector(nValues, 42));
+    TBufferFile buffer(TBuffer::kWrite, 16*nValues + 1024);
+
+    bench.run("event-streamer-write", params, 1, [&](){
+      buffer.Reset();
+      streamer.writeEvent(event, buffer);
+    });
+
+    buffer.Reset();
+    streamer.writeEvent(event, buffer);
+    bench.run("event-streamer-read", params, 1, [&](){
+      TBufferFile readBuffer(TBuffer::kRead, buffer.Length(), buffer.Buffer(), false);
+      EventPtr readEvent;
+      streamer.readEvent(readEvent, readBuffer);
+      doNotOptimize(readEvent);
+    });
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void benchEventStreamerMixed(Benchmark &bench) {
+  // two streamer types in turn: the streamer plugin changes on each event
+  EventStreamer streamer;
+  const std::string contents(1000, 'x');
+  EventPtr genericEvent = GenericEvent::make_shared();
+  genericEvent->getEvent<GenericEvent>()->setValues("Energy", DoubleVector(100, 3.14));
+  EventPtr bufferEvent = BufferEvent::make_shared();
+  bufferEvent->getEvent<BufferEvent>()->copyBuffer(contents.data(), contents.size());
+  const std::vector<EventPtr> events = {genericEvent, bufferEvent};
+  TBufferFile buffer(TBuffer::kWrite, 64*1024);
+  const size_t nCreated(EventStreamerRegistry::instance().nCreatedStreamers());
+
+  bench.run("event-streamer-mixed-write", {}, events.size(), [&](){
+    for(auto &event : events) {
+      buffer.Reset();
+      streamer.writeEvent(event, buffer);
+    }
+  });
+
+  std::vector<std::string> streams;
+  for(auto &event : events) {
+    buffer.Reset();
+    streamer.writeEvent(event, buffer);
+    streams.push_back(std::string(buffer.Buffer(), buffer.Length()));
+  }
+  bench.run("event-streamer-mixed-read", {}, streams.size(), [&](){
+    for(auto &stream : streams) {
+      TBufferFile readBuffer(TBuffer::kRead, stream.size(), const_cast<char*>(stream.data()), false);
+      EventPtr readEvent;
+      streamer.readEvent(readEvent, readBuffer);
+      doNotOptimize(readEvent);
+    }
+  });
+  dqm_info( "event-streamer-mixed: {0} streamer instance(s) created", EventStreamerRegistry::instance().nCreatedStreamers() - nCreated );
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void benchGenericEvent(Benchmark &bench) {
+  const GenericEvent::KeyId energyKey(GenericEvent::key("Energy"));
+  const GenericEvent::KeyId cellIdKey(GenericEvent::key("CellID"));
+  for(unsigned int nValues : {10, 1000}) {
+    const StringMap params = {{"values", typeToString(nValues)}};
+    const DoubleVector energies(nValues, 3.14);
+    const IntVector cellIds(nValues, 42);
+
+    // a new event per fill
+    bench.run("generic-event-fill", params, 1, [&](){
+      EventPtr event = GenericEvent::make_shared();
+      event->getEvent<GenericEvent>()->setValues("Energy", energies);
+      event->getEvent<GenericEvent>()->setValues("CellID", cellIds);
+      doNotOptimize(event);
+    });
+
+    // a recycled event, filled in place
+    EventPtr event = GenericEvent::make_shared();
+    GenericEvent *generic = event->getEvent<GenericEvent>();
+    bench.run("generic-event-refill", params, 1, [&](){
+      generic->reset();
+      std::copy(energies.begin(), energies.end(), generic->allocateValues<double>(energyKey, nValues).begin());
+      std::copy(cellIds.begin(), cellIds.end(), generic->allocateValues<int>(cellIdKey, nValues).begin());
+      doNotOptimize(generic);
+    });
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void fillHistogram(TH1 *histogram, unsigned int entries) {
+  TRandom3 random(12345);
+  if(histogram->GetDimension() == 1) {
+    for(unsigned int i=0 ; i<entries ; i++) {
+      histogram->Fill(random.Gaus(50., 15.));
+    }
+  }
+  else {
+    for(unsigned int i=0 ; i<entries ; i++) {
+      histogram->Fill(random.Gaus(50., 15.), random.Gaus(50., 15.));
+    }
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void benchMonitorElement(Benchmark &bench, MonitorElementPtr element, MonitorElementPtr readElement, const StringMap &params) {
+  TBufferFile buffer(TBuffer::kWrite, 1024*1024);
+
+  bench.run("me-write", params, 1, [&](){
+    buffer.Reset();
+    element->write(buffer);
+  });
+
+  buffer.Reset();
+  element->write(buffer);
+  bench.run("me-read", params, 1, [&](){
+    TBufferFile readBuffer(TBuffer::kRead, buffer.Length(), buffer.Buffer(), false);
+    readElement->read(readBuffer);
+  });
+
+  std::string output;
+  bench.run("me-json-string", params, 1, [&](){
+    output.clear();
+    element->toJson(output);
+    doNotOptimize(output);
+  });
+
+  bench.run("me-json-object", params, 1, [&](){
+    json object;
+    element->toJson(object);
+    doNotOptimize(object);
+  });
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void benchMonitorElements(Benchmark &bench) {
+  std::unique_ptr<MonitorElementManager> meMgr = std::unique_ptr<MonitorElementManager>(new MonitorElementManager());
+
+  for(unsigned int nBins : {100, 10000}) {
+    MonitorElementPtr element, readElement;
+    meMgr->bookHisto<TH1F>("/Bench1D", "Histo" + typeToString(nBins), "A 1D histogram", element, nBins, 0.f, 100.f);
+    meMgr->bookHisto<TH1F>("/Bench1D", "ReadHisto" + typeToString(nBins), "A 1D histogram", readElement, nBins, 0.f, 100.f);
+    fillHistogram(element->objectTo<TH1>(), 100000);
+    benchMonitorElement(bench, element, readElement, {{"class", "TH1F"}, {"bins", typeToString(nBins)}});
+  }
+
+  for(unsigned int nBins : {100, 316}) {
+    MonitorElementPtr element, readElement;
+    meMgr->bookHisto<TH2F>("/Bench2D", "Histo" + typeToString(nBins), "A 2D histogram", element, nBins, 0.f, 100.f, nBins, 0.f, 100.f);
+    meMgr->bookHisto<TH2F>("/Bench2D", "ReadHisto" + typeToString(nBins), "A 2D histogram", readElement, nBins, 0.f, 100.f, nBins, 0.f, 100.f);
+    fillHistogram(element->objectTo<TH1>(), 100000);
+    benchMonitorElement(bench, element, readElement, {{"class", "TH2F"}, {"bins", typeToString(nBins*nBins)}});
+  }
+
+  // all elements of a manager in json
+  for(unsigned int nElements : {100, 1000}) {
+    std::unique_ptr<MonitorElementManager> mgr = std::unique_ptr<MonitorElementManager>(new MonitorElementManager());
+    for(unsigned int e=0 ; e<nElements ; e++) {
+      MonitorElementPtr element;
+      mgr->bookHisto<TH1F>("/Dir" + typeToString(e%10), "Histo" + typeToString(e), "A histogram", element, 100, 0.f, 100.f);
+      fillHistogram(element->objectTo<TH1>(), 1000);
+    }
+    std::string output;
+    bench.run("me-manager-json", {{"elements", typeToString(nElements)}}, nElements, [&](){
+      output.clear();
+      mgr->monitorElementsToJson(output);
+      doNotOptimize(output);
+    });
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class BenchObject {
+public:
+  BenchObject(const std::string &oname) : m_name(oname) {}
+  const std::string &name() const { return m_name; }
+
+private:
+  std::string     m_name;
+};
+
+void benchStorage(Benchmark &bench) {
+  const unsigned int nDirectories(20);
+  for(unsigned int nObjects : {1000, 20000}) {
+    const StringMap params = {{"objects", typeToString(nObjects)}, {"directories", typeToString(nDirectories)}};
+    std::vector<std::string> dirNames, objectNames;
+    for(unsigned int i=0 ; i<nObjects ; i++) {
+      dirNames.push_back("/Detector/Layer" + typeToString(i%nDirectories));
+      objectNames.push_back("Object" + typeToString(i));
+    }
+
+    Storage<BenchObject> storage;
+    bench.run("storage-add", params, nObjects, [&](){
+      storage.clear();
+      for(unsigned int i=0 ; i<nObjects ; i++) {
+        storage.add(dirNames[i], std::make_shared<BenchObject>(objectNames[i]));
+      }
+    });
+
+    bench.run("storage-find", params, nObjects, [&](){
+      std::shared_ptr<BenchObject> object;
+      for(unsigned int i=0 ; i<nObjects ; i++) {
+        storage.findObject(dirNames[i], objectNames[i], object);
+        doNotOptimize(object);
+      }
+    });
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class SignalReceiver {
+public:
+  void slot(int &value) { value++; }
+};
+
+void benchSignal(Benchmark &bench) {
+  const unsigned int nEmits(10000);
+  for(unsigned int nSlots : {1, 10, 100}) {
+    Signal<int&> signal;
+    std::vector<SignalReceiver> receivers(nSlots);
+    for(auto &receiver : receivers) {
+      signal.connect(&receiver, &SignalReceiver::slot);
+    }
+    int value(0);
+    bench.run("signal-emit", {{"slots", typeToString(nSlots)}}, nEmits, [&](){
+      for(unsigned int i=0 ; i<nEmits ; i++) {
+        signal.emit(value);
+      }
+    });
+    doNotOptimize(value);
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+class EventCounter {
+public:
+  EventCounter(AppEventLoop &loop) {
+    loop.connectOnEvent(this, &EventCounter::onEvent);
+  }
+
+  void onEvent(AppEvent *pAppEvent) {
+    if(pAppEvent->type() == AppEvent::USER) {
+      m_count++;
+    }
+  }
+
+public:
+  std::atomic<unsigned long long>    m_count = {0};
+};
+
+void benchAppEventLoop(Benchmark &bench, unsigned int warmup, unsigned int repetitions) {
+  if(not bench.enabled("event-loop-latency") and not bench.enabled("event-loop-throughput")) {
+    return;
+  }
+  AppEventLoop loop;
+  EventCounter counter(loop);
+  std::thread loopThread([&](){
+    loop.exec();
+  });
+
+  // post to processing latency, one event at a time
+  std::vector<double> samples;
+  unsigned long long expected(counter.m_count.load());
+  for(unsigned int i=0 ; i<warmup+repetitions ; i++) {
+    auto start = std::chrono::steady_clock::now();
+    loop.postEvent(new StoreEvent<int>(AppEvent::USER, i));
+    expected++;
+    while(counter.m_count.load() < expected) {
+      std::this_thread::yield();
+    }
+    auto end = std::chrono::steady_clock::now();
+    if(i >= warmup) {
+      samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+  }
+  bench.addSamples("event-loop-latency", {}, 1, samples);
+
+  // throughput, bursts of events
+  for(unsigned int nEvents : {1000, 100000}) {
+    bench.run("event-loop-throughput", {{"events", typeToString(nEvents)}}, nEvents, [&](){
+      expected = counter.m_count.load() + nEvents;
+      for(unsigned int i=0 ; i<nEvents ; i++) {
+        loop.postEvent(new StoreEvent<int>(AppEvent::USER, i));
+      }
+      while(counter.m_count.load() < expected) {
+        std::this_thread::yield();
+      }
+    });
+  }
+
+  loop.quit();
+  loopThread.join();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void benchQualityTests(Benchmark &bench) {
+  std::unique_ptr<MonitorElementManager> meMgr = std::unique_ptr<MonitorElementManager>(new MonitorElementManager());
+
+  for(const std::string qtestType : {"Chi2Test", "KolmogorovTest"}) {
+    const std::string qtestName("Bench" + qtestType);
+    std::shared_ptr<TiXmlElement> qtestElement(new TiXmlElement("qtest"));
+    qtestElement->SetAttribute("type", qtestType);
+    qtestElement->SetAttribute("name", qtestName);
+    meMgr->createQualityTest(qtestElement.get());
+
+    for(unsigned int nBins : {100, 10000}) {
+      MonitorElementPtr element;
+      const std::string name(qtestType + typeToString(nBins));
+      meMgr->bookHisto<TH1F>("/QTests", name, "A histogram", element, nBins, 0.f, 100.f);
+      fillHistogram(element->objectTo<TH1>(), 100000);
+      PtrHandler<TObject> reference(element->objectTo<TH1F>()->Clone(), true);
+      element->setReferenceObject(reference);
+      meMgr->addQualityTest(element->path(), element->name(), qtestName);
+
+      QReportStorage storage;
+      bench.run("qtest-run", {{"qtest", qtestType}, {"bins", typeToString(nBins)}}, 1, [&](){
+        storage.clear();
+        meMgr->runQualityTest(element->path(), element->name(), qtestName, storage);
+      });
+    }
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void benchElementPublisher(Benchmark &bench) {
+  std::unique_ptr<MonitorElementManager> meMgr = std::unique_ptr<MonitorElementManager>(new MonitorElementManager());
+
+  for(unsigned int nElements : {10, 100}) {
+    const StringMap params = {{"elements", typeToString(nElements)}, {"class", "TH2F"}, {"bins", "10000"}};
+    OnlineElementPtrList elements;
+    for(unsigned int e=0 ; e<nElements ; e++) {
+      OnlineElementPtr element;
+      meMgr->bookHisto<TH2F>("/Publisher" + typeToString(nElements), "Map" + typeToString(e), "A map", element, 100, 0.f, 100.f, 100, 0.f, 100.f);
+      fillHistogram(element->objectTo<TH1>(), 10000);
+      elements.push_back(element);
+    }
+    ElementPublisher publisher;
+    publisher.setModuleName("BenchModule");
+    publisher.setFullPublicationPeriod(0);
+    TBufferFile buffer(TBuffer::kWrite, 1024*1024);
+
+    bench.run("publisher-full", params, nElements, [&](){
+      buffer.Reset();
+      publisher.requestFullPublication();
+      publisher.write(0, elements, buffer);
+    });
+
+    // a few bins changed in every element between two publications
+    bench.run("publisher-delta", params, nElements, [&](){
+      for(auto &element : elements) {
+        element->objectTo<TH2F>()->Fill(10.5, 20.5);
+        element->objectTo<TH2F>()->Fill(60.5, 30.5);
+      }
+      buffer.Reset();
+      publisher.write(0, elements, buffer);
+    });
+  }
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[]) {
+  std::string cmdLineFooter = "Please report bug to <dqm4hep@gmail.com>";
+  TCLAP::CmdLine *pCommandLine = new TCLAP::CmdLine(cmdLineFooter, ' ', DQM4hep_VERSION_STR);
+
+  TCLAP::ValueArg<std::string> filterArg(
+      "f"
+      , "filter"
+      , "A wildcard on the scenario names to run (i.e 'me-*')"
+      , false
+      , ""
+      , "string");
+  pCommandLine->add(filterArg);
+
+  TCLAP::ValueArg<std::string> outputArg(
+      "o"
+      , "output"
+      , "The json file to write the results to"
+      , false
+      , ""
+      , "string");
+  pCommandLine->add(outputArg);
+
+  TCLAP::ValueArg<std::string> tagArg(
+      "t"
+      , "tag"
+      , "A tag written in the json output (i.e a commit hash)"
+      , false
+      , ""
+      , "string");
+  pCommandLine->add(tagArg);
+
+  TCLAP::ValueArg<unsigned int> warmupArg(
+      "w"
+      , "warmup"
+      , "The number of untimed calls before each scenario"
+      , false
+      , 3
+      , "unsigned int");
+  pCommandLine->add(warmupArg);
+
+  TCLAP::ValueArg<unsigned int> repetitionsArg(
+      "r"
+      , "repetitions"
+      , "The number of timed calls of each scenario"
+      , false
+      , 20
+      , "unsigned int");
+  pCommandLine->add(repetitionsArg);
+
+  StringVector verbosities(Logger::logLevels());
+  TCLAP::ValuesConstraint<std::string> verbosityConstraint(verbosities);
+  TCLAP::ValueArg<std::string> verbosityArg(
+      "v"
+      , "verbosity"
+      , "The logging verbosity"
+      , false
+      , "info"
+      , &verbosityConstraint);
+  pCommandLine->add(verbosityArg);
+
+  // parse command line
+  pCommandLine->parse(argc, argv);
+
+  Benchmark bench("dqm4hep-bench");
+  Logger::setLogLevel(Logger::logLevelFromString(verbosityArg.getValue()));
+  bench.setFilter(filterArg.getValue());
+  bench.setTag(tagArg.getValue());
+  bench.setWarmup(warmupArg.getValue());
+  bench.setRepetitions(repetitionsArg.getValue());
+
+  try {
+    benchEventStreamer(bench);
+    benchEventStreamerMixed(bench);
+    benchGenericEvent(bench);
+    benchMonitorElements(bench);
+    benchStorage(bench);
+    benchSignal(bench);
+    benchAppEventLoop(bench, warmupArg.getValue(), repetitionsArg.getValue());
+    benchQualityTests(bench);
+    benchElementPublisher(bench);
+  }
+  catch(StatusCodeException &exception) {
+    dqm_error( "Caught exception: {0}", exception.toString() );
+    return 1;
+  }
+
+  if(outputArg.isSet() and not bench.writeJson(outputArg.getValue())) {
+    return 1;
+  }
+
+  delete pCommandLine;
+  return 0;
+}
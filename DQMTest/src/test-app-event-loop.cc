@@ -0,0 +1,142 @@
+/// \file test-app-event-loop.cc
+/*
+ *
+ * test-app-event-loop.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/AppEventLoop.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <thread>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+class EventRecorder {
+public:
+  EventRecorder(AppEventLoop &loop) :
+    m_eventLoop(loop) {
+    m_eventLoop.connectOnEvent(this, &EventRecorder::onEvent);
+  }
+  
+  void onEvent(AppEvent *pAppEvent) {
+    if(pAppEvent->type() == AppEvent::QUIT) {
+      return;
+    }
+    auto *storeEvent = dynamic_cast<StoreEvent<int>*>(pAppEvent);
+    if(nullptr == storeEvent) {
+      return;
+    }
+    // a negative value means exit the loop
+    if(storeEvent->data() < 0) {
+      m_eventLoop.quit();
+      return;
+    }
+    m_values.push_back(storeEvent->data());
+  }
+  
+public:
+  AppEventLoop&            m_eventLoop;
+  std::vector<int>         m_values = {};
+};
+
+//-------------------------------------------------------------------------------------------------
+
+void postIntEvent(AppEventLoop &loop, int value, int priority) {
+  auto event = new StoreEvent<int>(AppEvent::USER, value);
+  event->setPriority(priority);
+  loop.postEvent(event);
+}
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int /*argc*/, char ** /*argv*/) {
+  
+  UnitTest unitTest("test-app-event-loop");
+  
+  // ordering: highest priority first, arrival order within a priority level
+  {
+    AppEventLoop loop;
+    EventRecorder recorder(loop);
+    postIntEvent(loop, 1, 50);
+    postIntEvent(loop, 2, 50);
+    postIntEvent(loop, 3, 80);
+    postIntEvent(loop, 4, 50);
+    postIntEvent(loop, 5, 80);
+    postIntEvent(loop, 6, 10);
+    postIntEvent(loop, -1, 0);
+    unitTest.test("QUEUE_SIZE", loop.size() == 7);
+    unitTest.test("QUEUE_COUNT", loop.count(static_cast<int>(AppEvent::USER)) == 7);
+    unitTest.test("EXEC", loop.exec() == 0);
+    const std::vector<int> expected = {3, 5, 1, 2, 4, 6};
+    unitTest.test("N_EVENTS", recorder.m_values.size() == expected.size());
+    unitTest.test("FIFO_PRIORITY_ORDER", recorder.m_values == expected);
+    unitTest.test("QUEUE_EMPTY", loop.size() == 0);
+  }
+  
+  // events posted from another thread wake up an idle event loop
+  {
+    AppEventLoop loop;
+    EventRecorder recorder(loop);
+    std::thread poster([&loop](){
+      for(int i=0 ; i<100 ; i++) {
+        postIntEvent(loop, i, 50);
+        if(i % 10 == 0) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+      }
+      postIntEvent(loop, -1, 0);
+    });
+    unitTest.test("EXEC2", loop.exec() == 0);
+    poster.join();
+    bool ordered = (recorder.m_values.size() == 100);
+    for(unsigned int i=0 ; ordered && i<recorder.m_values.size() ; i++) {
+      ordered = (recorder.m_values[i] == static_cast<int>(i));
+    }
+    unitTest.test("THREAD_FIFO_ORDER", ordered);
+  }
+  
+  // exit from another thread while the loop is idle
+  {
+    AppEventLoop loop;
+    std::thread exiter([&loop](){
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      loop.exit(3);
+    });
+    unitTest.test("EXIT_IDLE", loop.exec() == 3);
+    exiter.join();
+  }
+  
+  return 0;
+}
@@ -0,0 +1,163 @@
+/// \file test-app-timer.cc
+/*
+ *
+ * test-app-timer.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Application.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <ctime>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+class TimerTestApp : public Application {
+public:
+  TimerTestApp(unsigned int nIdleTimers) :
+    Application(),
+    m_nIdleTimers(nIdleTimers) {
+    setType("test");
+    setName("timer");
+    setLogLevel(spdlog::level::debug);
+    enableStats(false);
+    setNoServer(true);
+  }
+  TimerTestApp(const TimerTestApp&) = delete;
+  TimerTestApp& operator=(const TimerTestApp&) = delete;
+  
+  ~TimerTestApp() {
+    for(auto timer : m_timers) {
+      removeTimer(timer);
+    }
+  }
+  
+  void parseCmdLine(int /*argc*/, char ** /*argv*/) override {}
+  void onEvent(AppEvent * /*pAppEvent*/) override {}
+  void onStop() override {}
+  
+  void onInit() override {
+    // a lot of active timers that never time out during the test
+    for(unsigned int i=0 ; i<m_nIdleTimers ; i++) {
+      auto timer = newTimer(60000 + i, false);
+      timer->onTimeout().connect(this, &TimerTestApp::idleTimeout);
+    }
+    auto periodicTimer = newTimer(50, false);
+    periodicTimer->onTimeout().connect(this, &TimerTestApp::periodicTimeout);
+    auto singleShotTimer = newTimer(200, true);
+    singleShotTimer->onTimeout().connect(this, &TimerTestApp::singleShotTimeout);
+    // restarted before timeout, must never time out
+    m_restartedTimer = newTimer(300, true);
+    m_restartedTimer->onTimeout().connect(this, &TimerTestApp::restartedTimeout);
+    auto exitTimer = newTimer(1200, true);
+    exitTimer->onTimeout().connect(this, &TimerTestApp::exitTimeout);
+  }
+  
+  void onStart() override {
+    m_cpuStart = std::clock();
+    m_wallStart = dqm4hep::core::time::now();
+  }
+  
+  void idleTimeout() {
+    m_nIdleTimeouts++;
+  }
+  
+  void periodicTimeout() {
+    m_nPeriodicTimeouts++;
+    m_restartedTimer->start();
+  }
+  
+  void singleShotTimeout() {
+    m_nSingleShotTimeouts++;
+  }
+  
+  void restartedTimeout() {
+    m_nRestartedTimeouts++;
+  }
+  
+  void exitTimeout() {
+    m_cpuTime = static_cast<double>(std::clock() - m_cpuStart) / CLOCKS_PER_SEC;
+    m_wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(dqm4hep::core::time::now() - m_wallStart).count() / 1000.;
+    m_restartedTimer->stop();
+    exit(0);
+  }
+  
+private:
+  AppTimer *newTimer(unsigned int interval, bool singleShot) {
+    auto timer = createTimer();
+    timer->setSingleShot(singleShot);
+    timer->setInterval(interval);
+    timer->start();
+    m_timers.push_back(timer);
+    return timer;
+  }
+  
+public:
+  unsigned int              m_nIdleTimers = {0};
+  std::vector<AppTimer*>    m_timers = {};
+  AppTimer*                 m_restartedTimer = {nullptr};
+  unsigned int              m_nIdleTimeouts = {0};
+  unsigned int              m_nPeriodicTimeouts = {0};
+  unsigned int              m_nSingleShotTimeouts = {0};
+  unsigned int              m_nRestartedTimeouts = {0};
+  std::clock_t              m_cpuStart = {0};
+  dqm4hep::core::TimePoint  m_wallStart = {};
+  double                    m_cpuTime = {0.};
+  double                    m_wallTime = {0.};
+};
+
+//-------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+  
+  UnitTest unitTest("test-app-timer");
+  
+  const unsigned int nIdleTimers = 1000;
+  TimerTestApp app(nIdleTimers);
+  app.init(argc, argv);
+  app.exec();
+  
+  dqm_info( "{0} active timers: cpu time {1} s over {2} s wall time ({3} %)", 
+    nIdleTimers+4, app.m_cpuTime, app.m_wallTime, 100*app.m_cpuTime/app.m_wallTime );
+  
+  unitTest.test("NO_IDLE_TIMEOUT", app.m_nIdleTimeouts == 0);
+  unitTest.test("SINGLE_SHOT_ONCE", app.m_nSingleShotTimeouts == 1);
+  unitTest.test("RESTARTED_NEVER_TIMEOUT", app.m_nRestartedTimeouts == 0);
+  unitTest.test("PERIODIC_MIN", app.m_nPeriodicTimeouts >= 15);
+  unitTest.test("PERIODIC_MAX", app.m_nPeriodicTimeouts <= 25);
+  // the timer thread must sleep until the next deadline, not poll the timers
+  unitTest.test("IDLE_CPU", app.m_cpuTime < 0.1*app.m_wallTime);
+  
+  return 0;
+}
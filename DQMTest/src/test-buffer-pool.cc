@@ -0,0 +1,110 @@
+/// \file test-buffer-pool.cc
+/*
+ *
+ * test-buffer-pool.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/NetBuffer.h>
+#include <dqm4hep/UnitTesting.h>
+
+using namespace dqm4hep::net;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  
+  UnitTest unitTest("test-buffer-pool");
+  
+  BufferPool pool(2);
+  const std::string event1(1024, 'a');
+  const std::string event2(512, 'b');
+  
+  // copy in a pooled buffer and share it between two buffers
+  Buffer cache;
+  cache.setModel(pool.copy(event1.c_str(), event1.size()));
+  const char *firstAddress = cache.begin();
+  unitTest.test("COPY_SIZE", cache.size() == event1.size());
+  unitTest.test("COPY_CONTENT", std::string(cache.begin(), cache.size()) == event1);
+  {
+    Buffer shared;
+    shared.setModel(cache.model());
+    unitTest.test("SHARED_ADDRESS", shared.begin() == cache.begin());
+    // model in use, a new one is created
+    auto model = pool.acquire();
+    unitTest.test("IN_USE_NOT_RECYCLED", model.get() != cache.model().get());
+    unitTest.test("POOL_SIZE", pool.size() == 2);
+  }
+  
+  // release the cached model, it must be recycled with its memory
+  cache.setModel(pool.copy(event2.c_str(), event2.size()));
+  unitTest.test("RECYCLED_CONTENT", std::string(cache.begin(), cache.size()) == event2);
+  auto recycled = pool.copy(event2.c_str(), event2.size());
+  unitTest.test("RECYCLED_ADDRESS", recycled->raw().begin() == firstAddress);
+  
+  // pool full and all models in use, still get a valid model
+  auto extra = pool.copy(event1.c_str(), event1.size());
+  unitTest.test("POOL_FULL_MODEL", nullptr != extra);
+  unitTest.test("POOL_FULL_SIZE", pool.size() == 2);
+  
+  // per-thread model pools: warm up, then steady state messaging must not allocate
+  for(unsigned int i=0 ; i<2 ; i++) {
+    Buffer buffer;
+    auto model = buffer.createModel<std::string>();
+    model->copy(event1.c_str(), event1.size());
+    buffer.setModel(model);
+    Buffer raw;
+    raw.adopt(event2.c_str(), event2.size());
+  }
+  const uint64_t allocations = BufferModelPool::allocations();
+  bool sameContents = true;
+  for(unsigned int i=0 ; i<100 ; i++) {
+    Buffer buffer;
+    auto model = buffer.createModel<std::string>();
+    model->copy(event1.c_str(), event1.size());
+    buffer.setModel(model);
+    sameContents = sameContents && (std::string(buffer.begin(), buffer.size()) == event1);
+    Buffer raw;
+    raw.adopt(event2.c_str(), event2.size());
+    sameContents = sameContents && (raw.begin() == event2.c_str());
+  }
+  unitTest.test("MODEL_POOL_CONTENTS", sameContents);
+  unitTest.test("MODEL_POOL_NO_ALLOCATION", BufferModelPool::allocations() == allocations);
+  
+  // a recycled model is reset to the null buffer
+  Buffer buffer;
+  auto model = buffer.createModel<std::string>();
+  unitTest.test("MODEL_POOL_RESET", model->raw().size() == NullBuffer::size);
+  
+  // memory ownership: copied contents are owned, adopted ones are not
+  model->copy(event1.c_str(), event1.size());
+  unitTest.test("OWNER_COPY", model->isOwner());
+  Buffer adopted;
+  adopted.adopt(event2.c_str(), event2.size());
+  unitTest.test("OWNER_ADOPT", not adopted.model()->isOwner());
+  unitTest.test("OWNER_NULL", not Buffer().model()->isOwner());
+  
+  return 0;
+}
@@ -0,0 +1,88 @@
+/// \file test-codec.cc
+/*
+ *
+ * test-codec.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Codec.h>
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/UnitTesting.h>
+
+using namespace dqm4hep::net;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  
+  UnitTest unitTest("test-codec");
+  
+  std::string payload;
+  for (unsigned int i = 0; i < 500; i++)
+    payload += "{\"name\":\"histogram\",\"entries\":" + std::to_string(i % 10) + "}";
+  
+  // raw buffers are not encoded
+  unitTest.test("RAW_NOT_ENCODED", !Codec::isEncoded(payload.c_str(), payload.size()));
+  
+  std::string encoded;
+  unitTest.test("NONE_NOT_ENCODED", !Codec::encode(Codec::NONE, 0, 0, payload.c_str(), payload.size(), encoded));
+  unitTest.test("SMALL_NOT_ENCODED", !Codec::encode(Codec::ZLIB, 0, 512, payload.c_str(), 100, encoded));
+  
+  const Codec::Type types[] = {Codec::ZLIB, Codec::LZ4, Codec::ZSTD};
+  
+  for (auto type : types) {
+    if (!Codec::isAvailable(type))
+      continue;
+    
+    const std::string name(Codec::toString(type));
+    unitTest.test("ENCODE_" + name, Codec::encode(type, 0, 0, payload.c_str(), payload.size(), encoded));
+    unitTest.test("ENCODED_" + name, Codec::isEncoded(encoded.c_str(), encoded.size()));
+    unitTest.test("COMPRESSED_" + name, encoded.size() < payload.size());
+    
+    Buffer decoded;
+    unitTest.test("DECODE_" + name, Codec::decode(encoded.c_str(), encoded.size(), decoded));
+    unitTest.test("DECODED_" + name, std::string(decoded.begin(), decoded.size()) == payload);
+    
+    // truncated payload
+    Buffer truncated;
+    unitTest.test("TRUNCATED_" + name, !Codec::decode(encoded.c_str(), encoded.size() / 2, truncated));
+    
+    // corrupted decoded size, rejected before allocation
+    std::string corrupted(encoded);
+    corrupted[8] = corrupted[9] = corrupted[10] = corrupted[11] = static_cast<char>(0xFF);
+    Buffer huge;
+    unitTest.test("MAX_SIZE_" + name, !Codec::decode(corrupted.c_str(), corrupted.size(), huge));
+    const uint32_t inflatedSize(1024 * 1024 * 64);
+    for (unsigned int i = 0; i < 4; i++)
+      corrupted[8 + i] = static_cast<char>((inflatedSize >> (8 * i)) & 0xFF);
+    unitTest.test("MAX_RATIO_" + name, !Codec::decode(corrupted.c_str(), corrupted.size(), huge));
+  }
+  
+  // too large to be encoded
+  unitTest.test("LARGE_NOT_ENCODED", !Codec::encode(Codec::ZLIB, 0, 0, payload.c_str(), Codec::maxDecodedSize + 1, encoded));
+  
+  unitTest.test("FROM_STRING", Codec::ZSTD == Codec::fromString(Codec::toString(Codec::ZSTD)));
+  
+  return 0;
+}
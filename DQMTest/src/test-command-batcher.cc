@@ -0,0 +1,142 @@
+/// \file test-command-batcher.cc
+/*
+ *
+ * test-command-batcher.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/CommandBatcher.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <thread>
+
+using namespace dqm4hep::net;
+using UnitTest = dqm4hep::test::UnitTest;
+
+/**
+ *  @brief  A buffer sent by the batcher
+ */
+struct SentBuffer {
+  std::string    m_name;
+  std::string    m_data;
+};
+
+/**
+ *  @brief  Unpack a batch in a list of commands. Returns false if malformed
+ */
+bool unpack(const std::string &batch, std::vector<std::string> &commands) {
+  return CommandBatch::unpack(batch.data(), batch.size(), [&commands](const char *data, size_t size) {
+    commands.push_back(std::string(data, size));
+  });
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  
+  UnitTest unitTest("test-command-batcher");
+  
+  std::mutex mutex;
+  std::vector<SentBuffer> sent;
+  auto sendFunction = [&](const std::string &name, const char *data, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    sent.push_back(SentBuffer{name, std::string(data, size)});
+  };
+  
+  {
+    // no deadline during the test
+    CommandBatcher batcher(256, 60000, sendFunction);
+    batcher.send("A", "first", 5);
+    batcher.send("B", "other", 5);
+    batcher.send("A", "", 0);
+    batcher.send("A", "third", 5);
+    unitTest.test("NOT_SENT_BEFORE_FLUSH", sent.empty());
+    
+    // round trip, one batch per target, in order
+    batcher.flush("A");
+    unitTest.test("FLUSH_TARGET", sent.size() == 1 && sent[0].m_name == "A");
+    std::vector<std::string> commands;
+    unitTest.test("IS_BATCH", CommandBatch::isBatch(sent[0].m_data.data(), sent[0].m_data.size()));
+    unitTest.test("UNPACK", unpack(sent[0].m_data, commands));
+    unitTest.test("UNPACK_COMMANDS", commands == std::vector<std::string>({"first", "", "third"}));
+    
+    // a command too large to be batched is sent directly, after the pending batch
+    const std::string large(512, 'x');
+    batcher.send("B", large.data(), large.size());
+    unitTest.test("LARGE_ORDER", sent.size() == 3 && sent[1].m_name == "B" && sent[2].m_data == large);
+    unitTest.test("LARGE_NOT_BATCH", !CommandBatch::isBatch(sent[2].m_data.data(), sent[2].m_data.size()));
+    
+    // full batch is sent
+    sent.clear();
+    const std::string command(100, 'y');
+    for(unsigned int i=0 ; i<3 ; i++)
+      batcher.send("C", command.data(), command.size());
+    unitTest.test("FULL_BATCH_SENT", sent.size() == 1);
+    commands.clear();
+    unitTest.test("FULL_BATCH_UNPACK", unpack(sent[0].m_data, commands) && commands.size() == 2);
+    
+    // the pending batch is sent on destruction
+    sent.clear();
+  }
+  unitTest.test("DESTRUCTOR_FLUSH", sent.size() == 1 && sent[0].m_name == "C");
+  
+  // the batch is sent after the max delay
+  sent.clear();
+  {
+    CommandBatcher batcher(256, 5, sendFunction);
+    batcher.send("D", "delayed", 7);
+    for(unsigned int i=0 ; i<200 ; i++) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!sent.empty())
+          break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    unitTest.test("DELAY_SENT", sent.size() == 1 && sent[0].m_name == "D");
+  }
+  
+  // malformed batches
+  std::string batch = sent[0].m_data;
+  std::vector<std::string> commands;
+  unitTest.test("TRUNCATED_HEADER", !unpack(batch.substr(0, CommandBatch::headerSize - 1), commands) && commands.empty());
+  unitTest.test("TRUNCATED_SIZE", !unpack(batch.substr(0, CommandBatch::headerSize + 2), commands) && commands.empty());
+  unitTest.test("TRUNCATED_COMMAND", !unpack(batch.substr(0, batch.size() - 1), commands) && commands.empty());
+  batch[0] = ~batch[0];
+  unitTest.test("BAD_MAGIC", !CommandBatch::isBatch(batch.data(), batch.size()) && !unpack(batch, commands) && commands.empty());
+  
+  // the commands preceding a malformed one are processed
+  sent.clear();
+  {
+    CommandBatcher batcher(256, 60000, sendFunction);
+    batcher.send("E", "valid", 5);
+    batcher.send("E", "truncated", 9);
+  }
+  batch = sent[0].m_data.substr(0, sent[0].m_data.size() - 1);
+  unitTest.test("TRUNCATED_PARTIAL", !unpack(batch, commands) && commands == std::vector<std::string>({"valid"}));
+  
+  return 0;
+}
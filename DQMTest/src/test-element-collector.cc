@@ -0,0 +1,113 @@
+/// \file test-element-collector.cc
+/*
+ *
+ * test-element-collector.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/MonitorElementManager.h>
+#include <dqm4hep/MonitorElementCollector.h>
+#include <dqm4hep/OnlineElement.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TBufferFile.h>
+#include <TGraph.h>
+#include <TH1F.h>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-element-collector");
+
+  std::unique_ptr<MonitorElementManager> meMgr = std::unique_ptr<MonitorElementManager>(new MonitorElementManager());
+  OnlineElementPtr histoElement, graphElement;
+  meMgr->bookHisto<TH1F>("/Calo", "TestHisto", "A test histogram", histoElement, 100, 0.f, 100.f);
+  meMgr->bookMonitorElement("TGraph", "/", "TestGraph", graphElement);
+  unitTest.test("BOOK", nullptr != histoElement and nullptr != graphElement);
+  for(unsigned int i=0 ; i<1000 ; i++) {
+    histoElement->objectTo<TH1F>()->Fill(i%100);
+  }
+
+  // the collector caches each element in serialized form
+  std::vector<std::shared_ptr<dqm4hep::net::BufferModelT<std::string>>> blobs;
+  std::vector<const dqm4hep::net::RawBuffer*> rawElements;
+  for(auto element : {histoElement, graphElement}) {
+    TBufferFile elementBuffer(TBuffer::kWrite, 64*1024);
+    unitTest.test("WRITE_ELEMENT_" + element->name(), STATUS_CODE_SUCCESS == element->write(elementBuffer));
+    auto blob = std::make_shared<dqm4hep::net::BufferModelT<std::string>>();
+    blob->copy(elementBuffer.Buffer(), elementBuffer.Length());
+    blobs.push_back(blob);
+    rawElements.push_back(&blob->raw());
+  }
+
+  // batched update message, as sent to the clients
+  TBufferFile batchBuffer(TBuffer::kWrite, 256*1024);
+  MonitorElementCollector::writeElementUpdates(rawElements, batchBuffer);
+  const std::string message(batchBuffer.Buffer(), batchBuffer.Length());
+  dqm4hep::net::Buffer updates;
+  updates.adopt(message.data(), message.size());
+
+  OnlineElementPtrList elements;
+  unitTest.test("READ_UPDATES", STATUS_CODE_SUCCESS == MonitorElementCollector::readElementUpdates(updates, elements));
+  unitTest.test("READ_UPDATES_N", 2 == elements.size());
+  unitTest.test("READ_HISTO", 2 == elements.size() and elements[0]->name() == "TestHisto" and elements[0]->path() == "/Calo");
+  unitTest.test("READ_HISTO_ENTRIES", 2 == elements.size() and nullptr != elements[0]->objectTo<TH1F>() and 1000 == elements[0]->objectTo<TH1F>()->GetEntries());
+  unitTest.test("READ_GRAPH", 2 == elements.size() and elements[1]->name() == "TestGraph" and nullptr != elements[1]->objectTo<TGraph>());
+
+  // empty update
+  TBufferFile emptyBuffer(TBuffer::kWrite, 1024);
+  MonitorElementCollector::writeElementUpdates({}, emptyBuffer);
+  const std::string emptyMessage(emptyBuffer.Buffer(), emptyBuffer.Length());
+  dqm4hep::net::Buffer emptyUpdates;
+  emptyUpdates.adopt(emptyMessage.data(), emptyMessage.size());
+  elements.clear();
+  unitTest.test("READ_EMPTY", STATUS_CODE_SUCCESS == MonitorElementCollector::readElementUpdates(emptyUpdates, elements) and elements.empty());
+
+  // truncated message: the second element is incomplete
+  dqm4hep::net::Buffer truncatedUpdates;
+  truncatedUpdates.adopt(message.data(), message.size() - 16);
+  elements.clear();
+  unitTest.test("READ_TRUNCATED", STATUS_CODE_OUT_OF_RANGE == MonitorElementCollector::readElementUpdates(truncatedUpdates, elements));
+  unitTest.test("READ_TRUNCATED_N", 1 == elements.size());
+
+  // corrupted element size, wrapping around in 32 bits
+  TBufferFile corruptBuffer(TBuffer::kWrite, 1024);
+  corruptBuffer.WriteUInt(1);
+  corruptBuffer.WriteUInt(0xFFFFFFFC);
+  corruptBuffer.WriteUInt(0);
+  const std::string corruptMessage(corruptBuffer.Buffer(), corruptBuffer.Length());
+  dqm4hep::net::Buffer corruptUpdates;
+  corruptUpdates.adopt(corruptMessage.data(), corruptMessage.size());
+  elements.clear();
+  unitTest.test("READ_CORRUPT_SIZE", STATUS_CODE_OUT_OF_RANGE == MonitorElementCollector::readElementUpdates(corruptUpdates, elements));
+  unitTest.test("READ_CORRUPT_SIZE_N", elements.empty());
+
+  return 0;
+}
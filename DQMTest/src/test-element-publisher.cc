@@ -0,0 +1,156 @@
+/// \file test-element-publisher.cc
+/*
+ *
+ * test-element-publisher.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/MonitorElementManager.h>
+#include <dqm4hep/OnlineElement.h>
+#include <dqm4hep/ElementPublisher.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TBufferFile.h>
+#include <TGraph.h>
+#include <TH2F.h>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+StatusCode readPublication(ElementPublicationReader &reader, TBufferFile &writeBuffer, ElementPublication::Header &header, OnlineElementPtrList &elements) {
+  TBufferFile readBuffer(TBuffer::kRead, writeBuffer.Length(), writeBuffer.Buffer(), false);
+  elements.clear();
+  return reader.read(readBuffer, header, elements);
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-element-publisher");
+
+  std::unique_ptr<MonitorElementManager> meMgr = std::unique_ptr<MonitorElementManager>(new MonitorElementManager());
+  OnlineElementPtr histoElement, graphElement;
+  meMgr->bookHisto<TH2F>("/", "TestMap", "A test map", histoElement, 100, 0.f, 100.f, 100, 0.f, 100.f);
+  meMgr->bookMonitorElement("TGraph", "/", "TestGraph", graphElement);
+  unitTest.test("BOOK", nullptr != histoElement and nullptr != graphElement);
+  OnlineElementPtrList elements = {histoElement, graphElement};
+  TH2F *histo = histoElement->objectTo<TH2F>();
+  for(unsigned int i=0 ; i<10000 ; i++) {
+    histo->Fill(i%100, (i/100)%100);
+  }
+
+  ElementPublisher publisher;
+  publisher.setModuleName("TestModule");
+  publisher.setFullPublicationPeriod(3);
+  ElementPublicationReader reader, lateReader;
+  ElementPublication::Header header;
+  OnlineElementPtrList readElements;
+  TBufferFile buffer(TBuffer::kWrite, 1024*1024);
+
+  // first publication is always full
+  unitTest.test("WRITE_FULL", STATUS_CODE_SUCCESS == publisher.write(42, elements, buffer));
+  unitTest.test("WRITE_FULL_N", 2 == publisher.nWrittenElements() and 0 == publisher.nDeltaElements());
+  const Int_t fullSize = buffer.Length();
+  unitTest.test("READ_FULL", STATUS_CODE_SUCCESS == readPublication(reader, buffer, header, readElements));
+  unitTest.test("READ_FULL_HEADER", header.m_moduleName == "TestModule" and 42 == header.m_runNumber and header.m_fullPublication);
+  unitTest.test("READ_FULL_N", 2 == readElements.size());
+  unitTest.test("READ_FULL_ENTRIES", 10000 == readElements.at(0)->objectTo<TH2F>()->GetEntries());
+
+  // nothing changed
+  buffer.Reset();
+  unitTest.test("WRITE_UNCHANGED", STATUS_CODE_SUCCESS == publisher.write(42, elements, buffer));
+  unitTest.test("WRITE_UNCHANGED_N", 0 == publisher.nWrittenElements());
+  unitTest.test("READ_UNCHANGED", STATUS_CODE_SUCCESS == readPublication(reader, buffer, header, readElements));
+  unitTest.test("READ_UNCHANGED_N", 0 == readElements.size());
+
+  // a few bins changed
+  histo->Fill(10.5, 20.5);
+  histo->Fill(10.5, 20.5);
+  histo->Fill(50.5, 70.5);
+  buffer.Reset();
+  unitTest.test("WRITE_DELTA", STATUS_CODE_SUCCESS == publisher.write(42, elements, buffer));
+  unitTest.test("WRITE_DELTA_N", 1 == publisher.nWrittenElements() and 1 == publisher.nDeltaElements());
+  unitTest.test("WRITE_DELTA_SIZE", 10*buffer.Length() < fullSize);
+  unitTest.test("READ_DELTA", STATUS_CODE_SUCCESS == readPublication(reader, buffer, header, readElements));
+  unitTest.test("READ_DELTA_N", 1 == readElements.size() and 0 == reader.nMissedDeltas());
+  TH2F *readHisto = readElements.at(0)->objectTo<TH2F>();
+  unitTest.test("READ_DELTA_ENTRIES", 10003 == readHisto->GetEntries());
+  unitTest.test("READ_DELTA_BIN", 3 == readHisto->GetBinContent(readHisto->FindBin(10.5, 20.5)));
+  unitTest.test("READ_DELTA_MEAN", histo->GetMean(1) == readHisto->GetMean(1) and histo->GetMean(2) == readHisto->GetMean(2));
+
+  // a receiver that missed the full publication can't apply deltas
+  unitTest.test("READ_LATE", STATUS_CODE_SUCCESS == readPublication(lateReader, buffer, header, readElements));
+  unitTest.test("READ_LATE_MISSED", 0 == readElements.size() and 1 == lateReader.nMissedDeltas());
+
+  // periodic full publication
+  buffer.Reset();
+  unitTest.test("WRITE_PERIODIC_FULL", STATUS_CODE_SUCCESS == publisher.write(42, elements, buffer));
+  unitTest.test("WRITE_PERIODIC_FULL_N", 2 == publisher.nWrittenElements() and 0 == publisher.nDeltaElements());
+  unitTest.test("READ_LATE_FULL", STATUS_CODE_SUCCESS == readPublication(lateReader, buffer, header, readElements));
+  unitTest.test("READ_LATE_FULL_N", 2 == readElements.size() and header.m_fullPublication);
+  unitTest.test("READ_LATE_FULL_ENTRIES", 10003 == readElements.at(0)->objectTo<TH2F>()->GetEntries());
+
+  // reset changes all bins: written in full
+  histo->Reset();
+  buffer.Reset();
+  unitTest.test("WRITE_RESET", STATUS_CODE_SUCCESS == publisher.write(43, elements, buffer));
+  unitTest.test("WRITE_RESET_N", 1 == publisher.nWrittenElements());
+  unitTest.test("READ_RESET", STATUS_CODE_SUCCESS == readPublication(reader, buffer, header, readElements));
+  unitTest.test("READ_RESET_ENTRIES", 1 == readElements.size() and 0 == readElements.at(0)->objectTo<TH2F>()->GetEntries());
+  unitTest.test("READ_RESET_RUN", 43 == readElements.at(0)->runNumber());
+
+  // graph changes are written in full
+  graphElement->objectTo<TGraph>()->SetPoint(0, 1., 2.);
+  buffer.Reset();
+  unitTest.test("WRITE_GRAPH", STATUS_CODE_SUCCESS == publisher.write(43, elements, buffer));
+  unitTest.test("WRITE_GRAPH_N", 1 == publisher.nWrittenElements() and 0 == publisher.nDeltaElements());
+
+  // corrupted delta: the announced number of bins is bounded by the buffer size
+  TBufferFile corruptBuffer(TBuffer::kWrite);
+  std::string moduleName("TestModule"), path("/"), name("TestMap"), reports("{}");
+  corruptBuffer.WriteUInt(ElementPublication::protocolVersion);
+  corruptBuffer.WriteStdString(&moduleName);
+  corruptBuffer.WriteInt(43);
+  corruptBuffer.WriteULong64(1000);
+  corruptBuffer.WriteBool(false);
+  corruptBuffer.WriteUInt(1);
+  corruptBuffer.WriteStdString(&path);
+  corruptBuffer.WriteStdString(&name);
+  corruptBuffer.WriteUChar(ElementPublication::HISTOGRAM_DELTA);
+  corruptBuffer.WriteULong64(1000);
+  corruptBuffer.WriteULong64(0);
+  corruptBuffer.WriteStdString(&reports);
+  corruptBuffer.WriteUChar(0);
+  corruptBuffer.WriteDouble(0.);
+  corruptBuffer.WriteBool(false);
+  ElementPublication::writeVarint(corruptBuffer, 1ULL << 60);
+  unitTest.test("READ_CORRUPT_DELTA", STATUS_CODE_SUCCESS == readPublication(reader, corruptBuffer, header, readElements));
+  unitTest.test("READ_CORRUPT_DELTA_MISSED", 0 == readElements.size() and 1 == reader.nMissedDeltas());
+
+  return 0;
+}
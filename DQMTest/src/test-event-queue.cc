@@ -0,0 +1,152 @@
+/// \file test-event-queue.cc
+/*
+ *
+ * test-event-queue.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventQueue.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <thread>
+#include <vector>
+
+using dqm4hep::core::Event;
+using dqm4hep::core::EventBase;
+using dqm4hep::core::EventPtr;
+using dqm4hep::online::EventQueue;
+using UnitTest = dqm4hep::test::UnitTest;
+
+EventPtr createEvent(uint32_t eventNumber) {
+  auto event = std::shared_ptr<Event>(new EventBase<int>());
+  event->setEventNumber(eventNumber);
+  return event;
+}
+
+std::vector<uint32_t> popAll(EventQueue &queue) {
+  std::vector<uint32_t> eventNumbers;
+  EventPtr event;
+  while(queue.pop(event)) {
+    eventNumbers.push_back(event->getEventNumber());
+  }
+  return eventNumbers;
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  
+  UnitTest unitTest("test-event-queue");
+  
+  // capacity rounding
+  EventQueue rounded(5);
+  unitTest.test("CAPACITY_ROUNDED", rounded.capacity() == 8);
+  EventPtr noEvent;
+  unitTest.test("EMPTY_POP", !rounded.pop(noEvent) && rounded.empty());
+  
+  // policy parsing
+  EventQueue::OverflowPolicy policy;
+  unitTest.test("POLICY_BLOCK", dqm4hep::core::STATUS_CODE_SUCCESS == EventQueue::policyFromString("Block", policy) && EventQueue::BLOCK == policy);
+  unitTest.test("POLICY_INVALID", dqm4hep::core::STATUS_CODE_SUCCESS != EventQueue::policyFromString("Whatever", policy));
+
+  // drop newest: the first events are kept
+  EventQueue dropNewest(4, EventQueue::DROP_NEWEST);
+  for(uint32_t e=0 ; e<6 ; e++) {
+    dropNewest.push(createEvent(e));
+  }
+  unitTest.test("DROP_NEWEST_SIZE", dropNewest.size() == 4);
+  unitTest.test("DROP_NEWEST_COUNTER", dropNewest.counters().m_nDroppedNewest == 2 && dropNewest.counters().m_nPushed == 4);
+  unitTest.test("DROP_NEWEST_ORDER", popAll(dropNewest) == std::vector<uint32_t>({0, 1, 2, 3}));
+  
+  // drop oldest: the last events are kept
+  EventQueue dropOldest(4, EventQueue::DROP_OLDEST);
+  for(uint32_t e=0 ; e<6 ; e++) {
+    dropOldest.push(createEvent(e));
+  }
+  unitTest.test("DROP_OLDEST_COUNTER", dropOldest.counters().m_nDroppedOldest == 2 && dropOldest.counters().m_nPushed == 6);
+  unitTest.test("DROP_OLDEST_ORDER", popAll(dropOldest) == std::vector<uint32_t>({2, 3, 4, 5}));
+  
+  // sample: one overflowing event out of 2 replaces the oldest one
+  EventQueue sample(4, EventQueue::SAMPLE, 2);
+  for(uint32_t e=0 ; e<8 ; e++) {
+    sample.push(createEvent(e));
+  }
+  auto sampleCounters = sample.counters();
+  unitTest.test("SAMPLE_COUNTERS", sampleCounters.m_nSampledOut == 2 && sampleCounters.m_nDroppedOldest == 2);
+  unitTest.test("SAMPLE_SIZE", popAll(sample).size() == 4);
+  
+  // block: producers wait for the consumer, no event lost
+  const uint32_t nProducers = 4;
+  const uint32_t nEventsPerProducer = 5000;
+  EventQueue block(16, EventQueue::BLOCK);
+  std::vector<std::thread> producers;
+  for(uint32_t p=0 ; p<nProducers ; p++) {
+    producers.push_back(std::thread([&block, p, nEventsPerProducer](){
+      for(uint32_t e=0 ; e<nEventsPerProducer ; e++) {
+        block.push(createEvent(p*nEventsPerProducer + e));
+      }
+    }));
+  }
+  std::vector<uint32_t> lastEventNumbers(nProducers, 0);
+  std::vector<uint32_t> nReceived(nProducers, 0);
+  bool ordered(true);
+  uint32_t nPopped(0);
+  EventPtr event;
+  while(nPopped < nProducers*nEventsPerProducer) {
+    if(!block.pop(event)) {
+      std::this_thread::yield();
+      continue;
+    }
+    const uint32_t producer = event->getEventNumber() / nEventsPerProducer;
+    // events from a single producer are received in order
+    if(nReceived[producer] > 0 && event->getEventNumber() <= lastEventNumbers[producer]) {
+      ordered = false;
+    }
+    lastEventNumbers[producer] = event->getEventNumber();
+    nReceived[producer]++;
+    nPopped++;
+  }
+  for(auto &producer : producers) {
+    producer.join();
+  }
+  unitTest.test("BLOCK_NO_LOSS", block.counters().m_nPushed == nProducers*nEventsPerProducer && block.empty());
+  unitTest.test("BLOCK_PRODUCER_ORDER", ordered);
+  
+  // close: blocked producers are released and events are dropped
+  EventQueue closed(2, EventQueue::BLOCK);
+  closed.push(createEvent(0));
+  closed.push(createEvent(1));
+  std::thread blockedProducer([&closed](){
+    closed.push(createEvent(2));
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  closed.close();
+  blockedProducer.join();
+  unitTest.test("CLOSE_RELEASE", closed.counters().m_nDroppedNewest == 1);
+  unitTest.test("CLOSE_DROP", !closed.push(createEvent(3)));
+  
+  return 0;
+}
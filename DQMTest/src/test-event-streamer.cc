@@ -0,0 +1,226 @@
+/// \file test-event-streamer.cc
+/*
+ *
+ * test-event-streamer.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/PluginManager.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/BufferEvent.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+// -- std headers
+#include <thread>
+
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+EventPtr createEvent(uint32_t eventNumber) {
+  EventPtr event = GenericEvent::make_shared();
+  event->setType(PHYSICS_EVENT);
+  event->setSource("TestSource");
+  event->setEventNumber(eventNumber);
+  event->setRunNumber(7);
+  event->setTimeStamp(TimePoint(std::chrono::microseconds(1500000000123456)));
+  event->getEvent<GenericEvent>()->setValues("Energy", DoubleVector{1.5, 2.5});
+  return event;
+}
+
+bool checkEvent(EventPtr event, uint32_t eventNumber) {
+  return (nullptr != event && nullptr != event->getEvent<GenericEvent>() 
+    && event->getStreamerName() == "GenericEventStreamer" && event->getType() == PHYSICS_EVENT 
+    && event->getSource() == "TestSource" && event->getEventNumber() == eventNumber && event->getRunNumber() == 7
+    && event->getEvent<GenericEvent>()->values<double>(GenericEvent::key("Energy")).size() == 2);
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-event-streamer");
+  EventStreamer streamer;
+
+  // streamer ids
+  const uint16_t genericId = EventStreamer::streamerId("GenericEventStreamer");
+  unitTest.test("STREAMER_ID_STABLE", genericId == EventStreamer::streamerId("GenericEventStreamer"));
+  unitTest.test("STREAMER_ID_VALID", 0 != genericId && genericId != EventStreamer::streamerId("RootEventStreamer"));
+  auto streamers = streamer.streamers();
+  unitTest.test("STREAMER_TABLE", streamers.end() != streamers.find(genericId) && streamers[genericId] == "GenericEventStreamer");
+
+  // two events in the same buffer
+  TBufferFile outBuffer(TBuffer::kWrite);
+  unitTest.test("WRITE_EVENT1", STATUS_CODE_SUCCESS == streamer.writeEvent(createEvent(1), outBuffer));
+  unitTest.test("WRITE_EVENT2", STATUS_CODE_SUCCESS == streamer.writeEvent(createEvent(2), outBuffer));
+
+  TBufferFile inBuffer(TBuffer::kRead);
+  inBuffer.SetBuffer(outBuffer.Buffer(), outBuffer.Length(), false);
+  UInt_t magic(0);
+  inBuffer.ReadUInt(magic);
+  unitTest.test("ENVELOPE_MAGIC", EventStreamer::magic == magic);
+  inBuffer.SetBufferOffset(0);
+
+  EventPtr inEvent1, inEvent2;
+  unitTest.test("READ_EVENT1", STATUS_CODE_SUCCESS == streamer.readEvent(inEvent1, inBuffer));
+  unitTest.test("READ_EVENT2", STATUS_CODE_SUCCESS == streamer.readEvent(inEvent2, inBuffer));
+  unitTest.test("CHECK_EVENT1", checkEvent(inEvent1, 1));
+  unitTest.test("CHECK_EVENT2", checkEvent(inEvent2, 2));
+  unitTest.test("TIME_STAMP", inEvent1->getTimeStamp() == createEvent(1)->getTimeStamp());
+  unitTest.test("EVENT_SIZE", inEvent1->getEventSize() > 0);
+
+  // unknown streamer
+  EventPtr unknownEvent = createEvent(3);
+  unknownEvent->setStreamerName("UnknownStreamer");
+  TBufferFile unknownBuffer(TBuffer::kWrite);
+  unitTest.test("WRITE_UNKNOWN", STATUS_CODE_SUCCESS != streamer.writeEvent(unknownEvent, unknownBuffer));
+
+  // former format: streamer name + base event fields + payload
+  EventPtr legacyEvent = createEvent(4);
+  auto plugin = PluginManager::instance()->create<EventStreamerPlugin>("GenericEventStreamer");
+  std::string streamerName("GenericEventStreamer"), source("TestSource");
+  TBufferFile legacyBuffer(TBuffer::kWrite);
+  legacyBuffer.WriteStdString(&streamerName);
+  legacyBuffer.WriteInt(PHYSICS_EVENT);
+  legacyBuffer.WriteStdString(&source);
+  legacyBuffer.WriteLong64(1500000000);
+  legacyBuffer.WriteLong64(0);
+  legacyBuffer.WriteInt(4);
+  legacyBuffer.WriteInt(7);
+  unitTest.test("WRITE_LEGACY", nullptr != plugin && STATUS_CODE_SUCCESS == plugin->write(legacyEvent, legacyBuffer));
+
+  EventPtr inLegacyEvent;
+  TBufferFile inLegacyBuffer(TBuffer::kRead);
+  inLegacyBuffer.SetBuffer(legacyBuffer.Buffer(), legacyBuffer.Length(), false);
+  unitTest.test("READ_LEGACY", STATUS_CODE_SUCCESS == streamer.readEvent(inLegacyEvent, inLegacyBuffer));
+  unitTest.test("CHECK_LEGACY", checkEvent(inLegacyEvent, 4));
+
+  // envelope truncated inside its header: before the source name and inside the payload length
+  TBufferFile headerBuffer(TBuffer::kWrite);
+  streamer.writeEvent(createEvent(8), headerBuffer);
+  const Int_t sourceEnd = 26 + std::string("TestSource").size();
+  EventPtr truncatedEvent;
+  TBufferFile inHeaderBuffer(TBuffer::kRead);
+  inHeaderBuffer.SetBuffer(headerBuffer.Buffer(), 20, false);
+  unitTest.test("READ_TRUNCATED_HEADER", STATUS_CODE_SUCCESS != streamer.readEvent(truncatedEvent, inHeaderBuffer));
+  inHeaderBuffer.SetBuffer(headerBuffer.Buffer(), sourceEnd + 2, false);
+  unitTest.test("READ_TRUNCATED_LENGTH", STATUS_CODE_SUCCESS != streamer.readEvent(truncatedEvent, inHeaderBuffer));
+  inHeaderBuffer.SetBuffer(headerBuffer.Buffer(), headerBuffer.Length(), false);
+  unitTest.test("READ_COMPLETE_HEADER", STATUS_CODE_SUCCESS == streamer.readEvent(truncatedEvent, inHeaderBuffer) && checkEvent(truncatedEvent, 8));
+
+  // streamer instances: one per thread, shared by the event streamers of the thread
+  EventStreamerRegistry &registry(EventStreamerRegistry::instance());
+  const size_t nCreated = registry.nCreatedStreamers();
+  EventStreamer otherStreamer;
+  TBufferFile otherBuffer(TBuffer::kWrite);
+  otherStreamer.writeEvent(createEvent(5), otherBuffer);
+  unitTest.test("SAME_THREAD_INSTANCE", registry.nCreatedStreamers() == nCreated);
+  unitTest.test("SAME_THREAD_ENTRY", registry.find(genericId) == registry.find(genericId));
+  const EventStreamerPlugin *pMainPlugin = registry.find(genericId)->m_streamer.get();
+  const EventStreamerPlugin *pThreadPlugin(nullptr);
+  std::thread thread([&](){
+    EventStreamer threadStreamer;
+    TBufferFile threadBuffer(TBuffer::kWrite);
+    threadStreamer.writeEvent(createEvent(6), threadBuffer);
+    pThreadPlugin = registry.find(genericId)->m_streamer.get();
+  });
+  thread.join();
+  unitTest.test("OTHER_THREAD_INSTANCE", registry.nCreatedStreamers() == nCreated + 1 && pThreadPlugin != pMainPlugin);
+
+  // buffer event read in place: the event references the held memory
+  const std::string contents(4096, 'r');
+  EventPtr rawEvent = BufferEvent::make_shared();
+  rawEvent->getEvent<BufferEvent>()->copyBuffer(contents.data(), contents.size());
+  TBufferFile rawBuffer(TBuffer::kWrite);
+  unitTest.test("WRITE_BUFFER_EVENT", STATUS_CODE_SUCCESS == streamer.writeEvent(rawEvent, rawBuffer));
+  auto memory = std::make_shared<std::string>(rawBuffer.Buffer(), rawBuffer.Length());
+  TBufferFile inRawBuffer(TBuffer::kRead);
+  inRawBuffer.SetBuffer(&(*memory)[0], memory->size(), false);
+  EventPtr inPlaceEvent;
+  unitTest.test("READ_IN_PLACE", STATUS_CODE_SUCCESS == streamer.readEvent(inPlaceEvent, inRawBuffer, memory));
+  const BufferEvent *inPlaceBuffer = inPlaceEvent->getEvent<BufferEvent>();
+  unitTest.test("IN_PLACE_CONTENTS", std::string(inPlaceBuffer->buffer(), inPlaceBuffer->bufferSize()) == contents);
+  unitTest.test("IN_PLACE_NO_COPY", inPlaceBuffer->buffer() >= memory->data() && inPlaceBuffer->buffer() < memory->data() + memory->size());
+  unitTest.test("IN_PLACE_HOLDER", 2 == memory.use_count());
+  inPlaceEvent.reset();
+  unitTest.test("IN_PLACE_RELEASED", 1 == memory.use_count());
+
+  // no holder: the buffer is copied
+  inRawBuffer.SetBuffer(&(*memory)[0], memory->size(), false);
+  EventPtr copiedEvent;
+  unitTest.test("READ_COPY", STATUS_CODE_SUCCESS == streamer.readEvent(copiedEvent, inRawBuffer));
+  const BufferEvent *copiedBuffer = copiedEvent->getEvent<BufferEvent>();
+  unitTest.test("COPY_CONTENTS", std::string(copiedBuffer->buffer(), copiedBuffer->bufferSize()) == contents);
+  unitTest.test("COPY_NOT_IN_PLACE", copiedBuffer->buffer() < memory->data() || copiedBuffer->buffer() >= memory->data() + memory->size());
+
+  // batch of events
+  TBufferFile batchBuffer(TBuffer::kWrite);
+  EventStreamer::writeBatchHeader(batchBuffer, 0);
+  for(uint32_t e=10 ; e<13 ; e++) {
+    streamer.writeEvent(createEvent(e), batchBuffer);
+  }
+  const Int_t batchEnd = batchBuffer.Length();
+  batchBuffer.SetBufferOffset(0);
+  EventStreamer::writeBatchHeader(batchBuffer, 3);
+  batchBuffer.SetBufferOffset(batchEnd);
+  unitTest.test("BATCH_N_EVENTS", 3 == EventStreamer::nEvents(batchBuffer.Buffer(), batchBuffer.Length()));
+  unitTest.test("SINGLE_N_EVENTS", 1 == EventStreamer::nEvents(outBuffer.Buffer(), outBuffer.Length()));
+
+  EventList batchEvents;
+  TBufferFile inBatchBuffer(TBuffer::kRead);
+  inBatchBuffer.SetBuffer(batchBuffer.Buffer(), batchBuffer.Length(), false);
+  unitTest.test("READ_BATCH", STATUS_CODE_SUCCESS == streamer.readEvents(batchEvents, inBatchBuffer));
+  unitTest.test("CHECK_BATCH", 3 == batchEvents.size() && checkEvent(batchEvents[0], 10) && checkEvent(batchEvents[2], 12));
+
+  // a single event is read as a batch of one
+  EventList singleEvents;
+  inBuffer.SetBufferOffset(0);
+  unitTest.test("READ_SINGLE", STATUS_CODE_SUCCESS == streamer.readEvents(singleEvents, inBuffer));
+  unitTest.test("CHECK_SINGLE", 1 == singleEvents.size() && checkEvent(singleEvents[0], 1));
+
+  // truncated batch: the complete events are still read
+  batchBuffer.SetBufferOffset(0);
+  EventStreamer::writeBatchHeader(batchBuffer, 4);
+  batchBuffer.SetBufferOffset(batchEnd);
+  EventList truncatedEvents;
+  inBatchBuffer.SetBuffer(batchBuffer.Buffer(), batchBuffer.Length(), false);
+  unitTest.test("READ_TRUNCATED_BATCH", STATUS_CODE_SUCCESS != streamer.readEvents(truncatedEvents, inBatchBuffer));
+  unitTest.test("CHECK_TRUNCATED_BATCH", 3 == truncatedEvents.size());
+
+  // corrupted event count: the allocation is bounded by the buffer size
+  TBufferFile bogusBuffer(TBuffer::kWrite);
+  EventStreamer::writeBatchHeader(bogusBuffer, 0xFFFFFFFF);
+  streamer.writeEvent(createEvent(20), bogusBuffer);
+  EventList bogusEvents;
+  TBufferFile inBogusBuffer(TBuffer::kRead);
+  inBogusBuffer.SetBuffer(bogusBuffer.Buffer(), bogusBuffer.Length(), false);
+  unitTest.test("READ_BOGUS_BATCH", STATUS_CODE_SUCCESS != streamer.readEvents(bogusEvents, inBogusBuffer));
+  unitTest.test("CHECK_BOGUS_BATCH", 1 == bogusEvents.size() && bogusEvents.capacity() <= bogusBuffer.Length() / EventStreamer::minEventSize);
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+/// \file test-generic-event.cc
+/*
+ *
+ * test-generic-event.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventStreamer.h>
+#include <dqm4hep/GenericEvent.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- root headers
+#include <TBufferFile.h>
+
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-generic-event");
+
+  // key interning
+  const GenericEvent::KeyId energyKey = GenericEvent::key("Energy");
+  const GenericEvent::KeyId namesKey = GenericEvent::key("Names");
+  unitTest.test("KEY_INTERNED", energyKey == GenericEvent::key("Energy"));
+  unitTest.test("KEY_DIFFERENT", energyKey != namesKey);
+  unitTest.test("KEY_NAME", GenericEvent::keyName(energyKey) == "Energy");
+
+  // set and get values, the same key can be used with different types
+  EventPtr outEvent = GenericEvent::make_shared();
+  GenericEvent *outGeneric = outEvent->getEvent<GenericEvent>();
+  unitTest.test("SET_DOUBLE", STATUS_CODE_SUCCESS == outGeneric->setValues("Energy", DoubleVector{1.5, 2.5, 3.5}));
+  unitTest.test("SET_INT", STATUS_CODE_SUCCESS == outGeneric->setValues(energyKey, IntVector{4, 5}));
+  unitTest.test("SET_FLOAT", STATUS_CODE_SUCCESS == outGeneric->setValues("Empty", FloatVector()));
+  unitTest.test("SET_STRING", STATUS_CODE_SUCCESS == outGeneric->setValues(namesKey, StringVector{"a", std::string(64, 'b')}));
+
+  Span<const double> energies = outGeneric->values<double>(energyKey);
+  unitTest.test("SPAN_SIZE", energies.size() == 3);
+  unitTest.test("SPAN_CONTENT", energies[0] == 1.5 && energies[2] == 3.5);
+  unitTest.test("SPAN_NOT_FOUND", outGeneric->values<float>(energyKey).empty());
+  unitTest.test("HAS_EMPTY", outGeneric->hasValues<float>(GenericEvent::key("Empty")));
+
+  IntVector intValues;
+  FloatVector floatValues;
+  unitTest.test("GET_INT", STATUS_CODE_SUCCESS == outGeneric->getValues("Energy", intValues) && intValues == IntVector({4, 5}));
+  unitTest.test("GET_NOT_FOUND", STATUS_CODE_NOT_FOUND == outGeneric->getValues("Energy", floatValues));
+  unitTest.test("GET_UNKNOWN_KEY", STATUS_CODE_NOT_FOUND == outGeneric->getValues("UnknownKey", floatValues));
+
+  // replace values
+  outGeneric->setValues(energyKey, DoubleVector{7.5, 8.5, 9.5, 10.5});
+  unitTest.test("REPLACE", outGeneric->values<double>(energyKey).size() == 4 && outGeneric->values<double>(energyKey)[3] == 10.5);
+
+  // streaming round trip
+  TBufferFile outBuffer(TBuffer::kWrite);
+  EventStreamer streamer;
+  unitTest.test("WRITE_EVENT", STATUS_CODE_SUCCESS == streamer.writeEvent(outEvent, outBuffer));
+
+  EventPtr inEvent;
+  TBufferFile inBuffer(TBuffer::kRead);
+  inBuffer.SetBuffer(outBuffer.Buffer(), outBuffer.Length(), false);
+  unitTest.test("READ_EVENT", STATUS_CODE_SUCCESS == streamer.readEvent(inEvent, inBuffer));
+  GenericEvent *inGeneric = inEvent->getEvent<GenericEvent>();
+  unitTest.test("READ_GENERIC", nullptr != inGeneric);
+  Span<const double> inEnergies = inGeneric->values<double>(energyKey);
+  unitTest.test("READ_DOUBLE", inEnergies.size() == 4 && inEnergies[0] == 7.5 && inEnergies[3] == 10.5);
+  unitTest.test("READ_INT", inGeneric->values<int>(energyKey).size() == 2 && inGeneric->values<int>(energyKey)[1] == 5);
+  unitTest.test("READ_EMPTY", inGeneric->hasValues<float>(GenericEvent::key("Empty")));
+  Span<const std::string> inNames = inGeneric->values<std::string>(namesKey);
+  unitTest.test("READ_STRING", inNames.size() == 2 && inNames[1] == std::string(64, 'b'));
+
+  // reset keeps the memory: the same fill sequence gives the same addresses
+  const double *firstAddress = outGeneric->values<double>(energyKey).data();
+  outGeneric->reset();
+  unitTest.test("RESET_EMPTY", not outGeneric->hasValues<double>(energyKey) && not outGeneric->hasValues<std::string>(namesKey));
+  outGeneric->setValues(energyKey, DoubleVector{1.5, 2.5, 3.5});
+  outGeneric->setValues(energyKey, IntVector{4, 5});
+  Span<double> refill = outGeneric->allocateValues<double>(energyKey, 4);
+  unitTest.test("RESET_RECYCLED", refill.data() == firstAddress);
+
+  // replacing a column with a different size gives its storage back
+  const GenericEvent::KeyId firstKey = GenericEvent::key("First");
+  const GenericEvent::KeyId secondKey = GenericEvent::key("Second");
+  outGeneric->reset();
+  outGeneric->setValues(firstKey, DoubleVector{1., 2.});
+  outGeneric->setValues(secondKey, DoubleVector{3., 4.});
+  outGeneric->setValues(firstKey, DoubleVector{5., 6., 7.});
+  const double *replacedAddress = nullptr;
+  for (unsigned int i = 0; i < 10; i++) {
+    outGeneric->setValues(firstKey, DoubleVector(4 + (i % 2), 8.));
+    // the arena has grown to the largest size after the second replacement
+    if (1 == i) {
+      replacedAddress = outGeneric->values<double>(firstKey).data();
+    }
+  }
+  Span<const double> replaced = outGeneric->values<double>(firstKey);
+  Span<const double> moved = outGeneric->values<double>(secondKey);
+  unitTest.test("REPLACE_RECLAIMED", replaced.data() == replacedAddress && replaced.size() == 5);
+  unitTest.test("REPLACE_MOVED", moved.size() == 2 && moved[0] == 3. && moved[1] == 4.);
+  outGeneric->setValues(firstKey, StringVector{"a", "b"});
+  outGeneric->setValues(secondKey, StringVector{"c"});
+  outGeneric->setValues(firstKey, StringVector{"d", "e", "f"});
+  Span<const std::string> movedStrings = outGeneric->values<std::string>(secondKey);
+  Span<const std::string> replacedStrings = outGeneric->values<std::string>(firstKey);
+  unitTest.test("REPLACE_STRINGS", movedStrings.size() == 1 && movedStrings[0] == "c" && replacedStrings.size() == 3 && replacedStrings[2] == "f");
+
+  // payload version check
+  outGeneric->reset();
+  TBufferFile versionBuffer(TBuffer::kWrite);
+  unitTest.test("WRITE_EMPTY", STATUS_CODE_SUCCESS == streamer.writeEvent(outEvent, versionBuffer));
+  // empty event payload: version and number of columns
+  versionBuffer.Buffer()[versionBuffer.Length() - 5] = 0;
+  TBufferFile badVersionBuffer(TBuffer::kRead);
+  badVersionBuffer.SetBuffer(versionBuffer.Buffer(), versionBuffer.Length(), false);
+  unitTest.test("READ_BAD_VERSION", STATUS_CODE_SUCCESS != streamer.readEvent(inEvent, badVersionBuffer));
+
+  return 0;
+}
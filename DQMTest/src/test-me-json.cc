@@ -31,8 +31,13 @@
 #include <dqm4hep/MonitorElementManager.h>
 #include <dqm4hep/StatusCodes.h>
 #include <dqm4hep/json.h>
+#include <dqm4hep/JsonWriter.h>
 #include <dqm4hep/UnitTesting.h>
 
+// -- root headers
+#include <TH2F.h>
+#include <TBufferJSON.h>
+
 // -- std headers
 #include <iostream>
 #include <signal.h>
@@ -62,6 +67,50 @@ int main(int /*argc*/, char ** /*argv*/) {
   unitTest.test("GRAPH_JSON_PATH", 0 != graphJson.count("path"));
   
   DQM4HEP_NO_EXCEPTION( dqm_debug(graphJson.dump(2)); );
+  
+  // streamed histogram
+  MonitorElementPtr histoElement;
+  meMgr->bookHisto<TH2F>("/", "TestMap", "A test map", histoElement, 100, 0.f, 100.f, 100, 0.f, 100.f);
+  TH2F *histo = histoElement->objectTo<TH2F>();
+  unitTest.test("VALID_HISTO", nullptr != histo);
+  histo->Sumw2();
+  histo->Fill(10.5, 20.5, 3.);
+  histo->Fill(80.5, 20.5);
+  
+  std::string histoStr;
+  histoElement->toJson(histoStr);
+  json histoJson = json::parse(histoStr);
+  json histoObject = histoJson.value("object", json(nullptr));
+  unitTest.test("HISTO_JSON_TYPE", "TH2F" == histoObject.value<std::string>("_typename", ""));
+  unitTest.test("HISTO_JSON_ENTRIES", 2 == histoObject.value<int>("fEntries", 0));
+  unitTest.test("HISTO_JSON_NBINS", 100 == histoObject["fXaxis"].value<int>("fNbins", 0));
+  json histoArray = histoObject.value("fArray", json(nullptr));
+  unitTest.test("HISTO_JSON_ARRAY_COMPRESSED", histoArray.is_object() and "Float32" == histoArray.value<std::string>("$arr", ""));
+  unitTest.test("HISTO_JSON_ARRAY_LEN", histo->GetNcells() == histoArray.value<int>("len", 0));
+  unitTest.test("HISTO_JSON_ARRAY_FIRST", histo->GetBin(11, 21) == histoArray.value<int>("p", 0));
+  unitTest.test("HISTO_JSON_ARRAY_FIRST_VALUE", 3 == histoArray["v"].at(0).get<int>());
+  
+  // json object version and element list
+  json histoJson2;
+  histoElement->toJson(histoJson2);
+  unitTest.test("HISTO_JSON_SAME", histoJson == histoJson2);
+  std::string elementsStr;
+  meMgr->monitorElementsToJson(elementsStr);
+  json elementsJson = json::parse(elementsStr);
+  unitTest.test("ELEMENTS_JSON", elementsJson.is_array() and 2 == elementsJson.size());
+  
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 14, 0)
+  // read back with ROOT
+  TObject *pReadObject = TBufferJSON::ConvertFromJSON(histoObject.dump().c_str());
+  TH2F *readHisto = dynamic_cast<TH2F*>(pReadObject);
+  unitTest.test("HISTO_JSON_ROOT_READ", nullptr != readHisto);
+  if(nullptr != readHisto) {
+    unitTest.test("HISTO_JSON_ROOT_CONTENT", 3.f == readHisto->GetBinContent(11, 21) and 1.f == readHisto->GetBinContent(81, 21));
+    unitTest.test("HISTO_JSON_ROOT_ERROR", std::fabs(3. - readHisto->GetBinError(11, 21)) < 1e-6);
+    unitTest.test("HISTO_JSON_ROOT_ENTRIES", 2 == readHisto->GetEntries());
+  }
+  delete pReadObject;
+#endif
 
   return 0;
 }
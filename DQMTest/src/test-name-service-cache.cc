@@ -0,0 +1,100 @@
+/// \file test-name-service-cache.cc
+/*
+ *
+ * test-name-service-cache.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/NameServiceCache.h>
+#include <dqm4hep/UnitTesting.h>
+
+using namespace dqm4hep::net;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  
+  UnitTest unitTest("test-name-service-cache");
+  
+  // updated by hand, no dim traffic
+  NameServiceCache cache(false);
+  unitTest.test("EMPTY", cache.servers().empty() && !cache.hasServer("srv1"));
+  
+  // full server list
+  cache.handleServerList("srv1@node1|srv2@node2.domain@host|");
+  unitTest.test("SERVERS", cache.servers().size() == 2);
+  unitTest.test("HAS_SERVER", cache.hasServer("srv1") && cache.hasServer("srv2@node2.domain"));
+  
+  // full service list
+  cache.handleServiceList("srv1", "/srv1/svc|C|\n/srv1/cmd|C|CMD\n/srv1/rpc|C,C|RPC\n");
+  unitTest.test("HAS_SERVICE", cache.hasService("/srv1/svc"));
+  unitTest.test("HAS_COMMAND", cache.hasCommandHandler("/srv1/cmd") && !cache.hasService("/srv1/cmd"));
+  unitTest.test("HAS_RPC", cache.hasRequestHandler("/srv1/rpc") && !cache.hasCommandHandler("/srv1/rpc"));
+  unitTest.test("NO_WILDCARD", !cache.hasService("/srv1/*"));
+  
+  // incremental service updates
+  cache.handleServiceList("srv1", "+/srv1/new|C|\n/srv1/new2|C|CMD\n");
+  unitTest.test("ADD_SERVICES", cache.hasService("/srv1/new") && cache.hasCommandHandler("/srv1/new2"));
+  cache.handleServiceList("srv1", "-/srv1/svc|C|\n");
+  unitTest.test("REMOVE_SERVICE", !cache.hasService("/srv1/svc") && cache.hasService("/srv1/new"));
+  
+  // unknown server, ignored
+  cache.handleServiceList("unknown", "/unknown/svc|C|\n");
+  unitTest.test("UNKNOWN_SERVER", !cache.hasService("/unknown/svc"));
+  
+  // a new full list replaces the services
+  cache.handleServiceList("srv1", "/srv1/other|C|\n");
+  unitTest.test("FULL_LIST", cache.hasService("/srv1/other") && !cache.hasService("/srv1/new") && !cache.hasRequestHandler("/srv1/rpc"));
+  
+  // server not reachable
+  cache.handleServiceList("srv1", nullptr);
+  unitTest.test("SERVER_UNREACHABLE", !cache.hasService("/srv1/other") && cache.hasServer("srv1"));
+  
+  // incremental server updates
+  cache.handleServiceList("srv1", "/srv1/svc|C|\n");
+  cache.handleServerList("+srv3@node3");
+  unitTest.test("ADD_SERVER", cache.hasServer("srv3") && cache.servers().size() == 3);
+  cache.handleServerList("!srv3@node3");
+  unitTest.test("SERVER_IN_ERROR", cache.hasServer("srv3"));
+  cache.handleServerList("-srv1@node1");
+  unitTest.test("REMOVE_SERVER", !cache.hasServer("srv1") && !cache.hasService("/srv1/svc"));
+  
+  // same server on the same node keeps its services, not on a new node
+  cache.handleServiceList("srv3", "/srv3/svc|C|\n");
+  cache.handleServerList("+srv3@node3");
+  unitTest.test("SAME_NODE", cache.hasService("/srv3/svc"));
+  cache.handleServerList("+srv3@node4");
+  unitTest.test("NEW_NODE", cache.hasServer("srv3") && !cache.hasService("/srv3/svc"));
+  
+  // full server list removes the missing servers
+  cache.handleServerList("srv3@node4");
+  unitTest.test("FULL_SERVER_LIST", cache.servers() == std::vector<std::string>({"srv3"}));
+  
+  // dns not reachable
+  cache.handleServerList(nullptr);
+  unitTest.test("DNS_UNREACHABLE", cache.servers().empty());
+  
+  return 0;
+}
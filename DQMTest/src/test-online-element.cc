@@ -36,6 +36,12 @@
 // -- std headers
 #include <iostream>
 #include <signal.h>
+#include <thread>
+#include <vector>
+
+// -- root headers
+#include <TH1F.h>
+#include <TROOT.h>
 
 using namespace std;
 using namespace dqm4hep::core;
@@ -62,5 +68,38 @@ int main(int /*argc*/, char ** /*argv*/) {
   unitTest.test("RM_ELEMENT", STATUS_CODE_SUCCESS == meMgr->removeMonitorElement("/", "TestGraph"));
   unitTest.test("GET_ELEMENT_NOT_FOUND2", STATUS_CODE_NOT_FOUND == meMgr->getMonitorElement("/", "TestGraph", monitorElement));
 
+  // thread shards
+  ROOT::EnableThreadSafety();
+  OnlineElementPtr histoElement;
+  unitTest.test("BOOK_HISTO", STATUS_CODE_SUCCESS == meMgr->bookHisto<TH1F>("/", "TestHisto", "A test histogram", histoElement, 100, 0.f, 100.f));
+  unitTest.test("CREATE_SHARDS", STATUS_CODE_SUCCESS == histoElement->createShards(4));
+  unitTest.test("N_SHARDS", 4 == histoElement->nShards());
+  unitTest.test("NO_THREAD_OBJECT", histoElement->threadObject() == histoElement->object());
+  
+  std::vector<std::thread> threads;
+  for(unsigned int t=0 ; t<4 ; t++) {
+    threads.push_back(std::thread([histoElement,t](){
+      OnlineElement::setThreadIndex(t);
+      TH1F *histo = histoElement->threadObjectTo<TH1F>();
+      for(unsigned int i=0 ; i<1000 ; i++) {
+        histo->Fill(t*25 + (i%25));
+      }
+      OnlineElement::setThreadIndex(-1);
+    }));
+  }
+  for(auto &thread : threads) {
+    thread.join();
+  }
+  TH1F *histo = histoElement->objectTo<TH1F>();
+  unitTest.test("SHARDS_NOT_MERGED", 0 == histo->GetEntries());
+  unitTest.test("MERGE_SHARDS", STATUS_CODE_SUCCESS == histoElement->mergeShards());
+  unitTest.test("MERGED_ENTRIES", 4000 == histo->GetEntries());
+  unitTest.test("MERGED_BIN", 40 == histo->GetBinContent(histo->FindBin(10.f)));
+  unitTest.test("SHARDS_RESET", STATUS_CODE_SUCCESS == histoElement->mergeShards() and 4000 == histo->GetEntries());
+  
+  OnlineElementPtr graphElement;
+  unitTest.test("BOOK_GRAPH2", STATUS_CODE_SUCCESS == meMgr->bookMonitorElement("TGraph", "/", "TestGraph", graphElement));
+  unitTest.test("NO_GRAPH_SHARDS", STATUS_CODE_SUCCESS == graphElement->createShards(4) and 0 == graphElement->nShards());
+
   return 0;
 }
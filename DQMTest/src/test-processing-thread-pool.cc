@@ -0,0 +1,151 @@
+/// \file test-processing-thread-pool.cc
+/*
+ *
+ * test-processing-thread-pool.cc main source file template automatically generated
+ * Creation date : sam. oct. 17 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/Event.h>
+#include <dqm4hep/EventQueue.h>
+#include <dqm4hep/MonitorElementManager.h>
+#include <dqm4hep/OnlineElement.h>
+#include <dqm4hep/ProcessingThreadPool.h>
+#include <dqm4hep/StatusCodes.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// -- root headers
+#include <TH1F.h>
+
+using namespace dqm4hep::core;
+using namespace dqm4hep::online;
+using UnitTest = dqm4hep::test::UnitTest;
+
+const unsigned int nThreads = 4;
+const unsigned int nEvents = 1000;
+
+EventPtr createEvent(uint32_t eventNumber) {
+  auto event = std::shared_ptr<Event>(new EventBase<int>());
+  event->setEventNumber(eventNumber);
+  return event;
+}
+
+// wait for the processing threads with a timeout
+bool waitProcessed(const std::atomic_uint &nProcessed, unsigned int expected) {
+  for(unsigned int i=0 ; i<1000 ; i++) {
+    if(nProcessed.load() >= expected) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  UnitTest unitTest("test-processing-thread-pool");
+
+  auto meMgr = std::make_shared<MonitorElementManager>();
+  auto queue = std::make_shared<EventQueue>(2*nEvents, EventQueue::BLOCK);
+
+  OnlineElementPtr histoElement;
+  unitTest.test("BOOK_HISTO", STATUS_CODE_SUCCESS == meMgr->bookHisto<TH1F>("/", "Histo", "A test histogram", histoElement, 100, 0.f, 100.f));
+
+  // booked later, while the processing is paused
+  OnlineElementPtr lateElement;
+  std::atomic_uint nProcessed = {0};
+  std::atomic_uint nBadThreadIndex = {0};
+
+  ProcessingThreadPool pool(nThreads, queue, meMgr, [&](EventPtr event){
+    const int index = OnlineElement::threadIndex();
+    if(index < 0 or index >= static_cast<int>(nThreads)) {
+      nBadThreadIndex++;
+    }
+    const float value = event->getEventNumber() % 100;
+    histoElement->threadObjectTo<TH1F>()->Fill(value);
+    if(nullptr != lateElement) {
+      lateElement->threadObjectTo<TH1F>()->Fill(value);
+    }
+    nProcessed++;
+  });
+
+  unitTest.test("NOT_RUNNING", not pool.running());
+  unitTest.test("START", STATUS_CODE_SUCCESS == pool.start());
+  unitTest.test("RUNNING", pool.running());
+  unitTest.test("SHARDS_CREATED", nThreads == histoElement->nShards());
+
+  // first cycle
+  for(uint32_t e=0 ; e<nEvents ; e++) {
+    queue->push(createEvent(e));
+    pool.notify();
+  }
+  unitTest.test("FIRST_CYCLE_PROCESSED", waitProcessed(nProcessed, nEvents));
+  pool.pause();
+  TH1F *histo = histoElement->objectTo<TH1F>();
+  unitTest.test("THREAD_INDEX", 0 == nBadThreadIndex.load());
+  unitTest.test("SHARDS_NOT_MERGED", 0 == histo->GetEntries());
+  pool.mergeShards();
+  unitTest.test("FIRST_CYCLE_MERGED", nEvents == histo->GetEntries());
+  unitTest.test("FIRST_CYCLE_BIN", nEvents/100 == histo->GetBinContent(histo->FindBin(10.f)));
+
+  // no event processed while paused
+  for(uint32_t e=0 ; e<10 ; e++) {
+    queue->push(createEvent(e));
+    pool.notify();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  unitTest.test("PAUSED", nEvents == nProcessed.load() and 10 == queue->size());
+
+  // an element booked while paused gets its shards on resume
+  unitTest.test("BOOK_LATE_HISTO", STATUS_CODE_SUCCESS == meMgr->bookHisto<TH1F>("/", "LateHisto", "A late histogram", lateElement, 100, 0.f, 100.f));
+  unitTest.test("LATE_NO_SHARDS", 0 == lateElement->nShards());
+  pool.resume();
+  unitTest.test("LATE_SHARDS_CREATED", nThreads == lateElement->nShards());
+  unitTest.test("SHARDS_KEPT", nThreads == histoElement->nShards());
+
+  // second cycle
+  for(uint32_t e=10 ; e<nEvents ; e++) {
+    queue->push(createEvent(e));
+    pool.notify();
+  }
+  unitTest.test("SECOND_CYCLE_PROCESSED", waitProcessed(nProcessed, 2*nEvents));
+  pool.pause();
+  TH1F *lateHisto = lateElement->objectTo<TH1F>();
+  unitTest.test("LATE_NOT_MERGED", 0 == lateHisto->GetEntries());
+  pool.mergeShards();
+  unitTest.test("SECOND_CYCLE_MERGED", 2*nEvents == histo->GetEntries());
+  unitTest.test("LATE_MERGED", nEvents == lateHisto->GetEntries());
+  unitTest.test("LATE_BIN", nEvents/100 == lateHisto->GetBinContent(lateHisto->FindBin(10.f)));
+  pool.resume();
+
+  pool.stop();
+  unitTest.test("STOPPED", not pool.running());
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+/// \file test-request-channel.cc
+/*
+ *
+ * test-request-channel.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/RequestChannel.h>
+#include <dqm4hep/RequestHandler.h>
+#include <dqm4hep/UnitTesting.h>
+
+using namespace dqm4hep::net;
+using namespace dqm4hep::core;
+using UnitTest = dqm4hep::test::UnitTest;
+
+/**
+ *  @brief  Build a response as sent back by the request handler
+ */
+std::string response(uint32_t requestId, const std::string &contents) {
+  std::string buffer(RequestHeader::size + contents.size(), 0);
+  RequestHeader::write(&buffer[0], requestId);
+  std::copy(contents.begin(), contents.end(), buffer.begin() + RequestHeader::size);
+  return buffer;
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  
+  UnitTest unitTest("test-request-channel");
+  
+  // header round trip
+  char header[RequestHeader::size];
+  uint32_t requestId(0);
+  RequestHeader::write(header, 0xCAFE1234);
+  unitTest.test("HEADER_READ", RequestHeader::read(header, RequestHeader::size, requestId));
+  unitTest.test("HEADER_ID", 0xCAFE1234 == requestId);
+  unitTest.test("HEADER_TRUNCATED", !RequestHeader::read(header, RequestHeader::size - 1, requestId));
+  unitTest.test("HEADER_NULL", !RequestHeader::read(nullptr, RequestHeader::size, requestId));
+  header[0] = ~header[0];
+  unitTest.test("HEADER_BAD_MAGIC", !RequestHeader::read(header, RequestHeader::size, requestId));
+  
+  PendingRequests requests("test");
+  std::map<uint32_t, std::pair<StatusCode, std::string>> results;
+  auto function = [&](uint32_t id) {
+    return [&results, id](StatusCode statusCode, const Buffer &buffer) {
+      results[id] = std::make_pair(statusCode, std::string(buffer.begin(), buffer.size()));
+    };
+  };
+  
+  // responses are matched by id, in any order
+  requests.add(1, function(1), 0);
+  requests.add(2, function(2), 0);
+  requests.add(3, function(3), 0);
+  unitTest.test("PENDING", requests.size() == 3);
+  std::string buffer = response(2, "second");
+  requests.handleResponse(buffer.data(), buffer.size());
+  unitTest.test("MATCH_BY_ID", results.size() == 1 && results[2].first == STATUS_CODE_SUCCESS && results[2].second == "second");
+  buffer = response(1, "");
+  requests.handleResponse(buffer.data(), buffer.size());
+  unitTest.test("MATCH_EMPTY_RESPONSE", results.count(1) && results[1].first == STATUS_CODE_SUCCESS && results[1].second.size() <= 1);
+  unitTest.test("PENDING_AFTER_MATCH", requests.size() == 1);
+  
+  // unknown id and response without header are dropped
+  buffer = response(42, "unknown");
+  requests.handleResponse(buffer.data(), buffer.size());
+  requests.handleResponse("no header", 9);
+  unitTest.test("UNMATCHED_DROPPED", results.size() == 2 && requests.size() == 1);
+  
+  // cancelled requests are not notified
+  unitTest.test("CANCEL", requests.cancel(3));
+  unitTest.test("CANCEL_TWICE", !requests.cancel(3));
+  buffer = response(3, "third");
+  requests.handleResponse(buffer.data(), buffer.size());
+  unitTest.test("CANCEL_NOT_NOTIFIED", results.count(3) == 0 && requests.size() == 0);
+  
+  // timeouts
+  results.clear();
+  const auto now = std::chrono::steady_clock::now();
+  requests.add(4, function(4), 10);
+  requests.add(5, function(5), 0);
+  auto nextDeadline = requests.processTimeouts(now);
+  unitTest.test("TIMEOUT_NOT_EXPIRED", results.empty() && nextDeadline != PendingRequests::TimePoint::max());
+  nextDeadline = requests.processTimeouts(now + std::chrono::seconds(1));
+  unitTest.test("TIMEOUT_EXPIRED", results.size() == 1 && results[4].first == STATUS_CODE_TIMEOUT);
+  unitTest.test("TIMEOUT_NO_DEADLINE", nextDeadline == PendingRequests::TimePoint::max() && requests.size() == 1);
+  buffer = response(4, "late");
+  requests.handleResponse(buffer.data(), buffer.size());
+  unitTest.test("TIMEOUT_LATE_RESPONSE", results[4].first == STATUS_CODE_TIMEOUT);
+  
+  // connection loss fails all pending requests
+  requests.add(6, function(6), 0);
+  buffer = response(0, "");
+  requests.handleResponse(buffer.data(), buffer.size());
+  unitTest.test("NO_LINK", results[5].first == STATUS_CODE_FAILURE && results[6].first == STATUS_CODE_FAILURE);
+  unitTest.test("NO_LINK_EMPTY", requests.size() == 0);
+  
+  return 0;
+}
@@ -0,0 +1,152 @@
+/// \file test-request-executor.cc
+/*
+ *
+ * test-request-executor.cc main source file template automatically generated
+ * Creation date : sam. oct. 17 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/NetBuffer.h>
+#include <dqm4hep/RequestHandler.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- std headers
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace dqm4hep::net;
+using UnitTest = dqm4hep::test::UnitTest;
+
+/**
+ *  @brief  The responses sent by the deferred responses
+ */
+struct SentResponses {
+  std::mutex                 m_mutex;
+  std::vector<std::string>   m_responses;
+
+  DeferredResponse::SendFunction function() {
+    return [this](const char *buffer, size_t size) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_responses.push_back(std::string(buffer, size));
+    };
+  }
+
+  size_t size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_responses.size();
+  }
+};
+
+int main(int /*argc*/, char ** /*argv*/) {
+
+  UnitTest unitTest("test-request-executor");
+
+  // at least one thread
+  {
+    RequestExecutor executor(0);
+    unitTest.test("MIN_THREADS", 1 == executor.nThreads());
+  }
+
+  // one thread: tasks run in the posting order
+  std::vector<unsigned int> order;
+  {
+    RequestExecutor executor(1);
+    for (unsigned int i = 0; i < 100; i++)
+      executor.post([&order, i]() { order.push_back(i); });
+  }
+  bool ordered(100 == order.size());
+  for (unsigned int i = 0; ordered && i < order.size(); i++)
+    ordered = (i == order[i]);
+  unitTest.test("TASK_ORDER", ordered);
+
+  // the pending tasks are run before the threads exit
+  std::atomic<unsigned int> nRun(0);
+  {
+    RequestExecutor executor(1);
+    executor.post([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); });
+    for (unsigned int i = 0; i < 10; i++)
+      executor.post([&nRun]() { nRun++; });
+    unitTest.test("PENDING_TASKS", executor.nPendingTasks() >= 10);
+  }
+  unitTest.test("PENDING_TASKS_DRAINED", 10 == nRun.load());
+
+  // several threads
+  nRun = 0;
+  {
+    RequestExecutor executor(4);
+    unitTest.test("N_THREADS", 4 == executor.nThreads());
+    for (unsigned int i = 0; i < 1000; i++)
+      executor.post([&nRun]() { nRun++; });
+  }
+  unitTest.test("POOL_TASKS_RUN", 1000 == nRun.load());
+
+  // not linked to any request
+  DeferredResponse unlinked;
+  unitTest.test("UNLINKED_NOT_PENDING", !unlinked.pending());
+  unlinked.send("abc", 3);
+
+  // only the first send is sent, whatever the copy
+  SentResponses sent;
+  {
+    DeferredResponse response(sent.function());
+    DeferredResponse copy(response);
+    unitTest.test("PENDING", response.pending() && copy.pending());
+    response.send("first", 5);
+    copy.send("second", 6);
+    unitTest.test("NOT_PENDING", !response.pending() && !copy.pending());
+  }
+  unitTest.test("SENT_ONCE", 1 == sent.size() && "first" == sent.m_responses[0]);
+
+  // an empty response is sent when the last copy is dropped
+  SentResponses dropped;
+  {
+    DeferredResponse response(dropped.function());
+    {
+      DeferredResponse copy(response);
+    }
+    unitTest.test("COPY_DROPPED", 0 == dropped.size() && response.pending());
+  }
+  Buffer emptyBuffer;
+  unitTest.test("EMPTY_ON_DROP", 1 == dropped.size() && emptyBuffer.size() == dropped.m_responses[0].size());
+
+  // completed from an executor thread
+  SentResponses deferred;
+  {
+    RequestExecutor executor(2);
+    for (unsigned int i = 0; i < 10; i++) {
+      DeferredResponse response(deferred.function());
+      executor.post([response, i]() mutable {
+        std::string data(std::to_string(i));
+        response.send(data.data(), data.size());
+      });
+    }
+  }
+  unitTest.test("EXECUTOR_SENT", 10 == deferred.size());
+
+  return 0;
+}
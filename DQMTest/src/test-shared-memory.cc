@@ -0,0 +1,114 @@
+/// \file test-shared-memory.cc
+/*
+ *
+ * test-shared-memory.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/SharedMemory.h>
+#include <dqm4hep/UnitTesting.h>
+
+// -- unix headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace dqm4hep::net;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  
+  UnitTest unitTest("test-shared-memory");
+  
+  auto writer = SharedMemoryRing::create(2, 1024);
+  unitTest.test("CREATE", nullptr != writer);
+  
+  if (nullptr == writer)
+    return 0;
+  
+  // segment only accessible to the same user
+  const int fd = shm_open(writer->name().c_str(), O_RDONLY, 0);
+  struct stat segmentStat;
+  unitTest.test("MODE", fd >= 0 && 0 == fstat(fd, &segmentStat) && 0600 == (segmentStat.st_mode & 0777));
+  if (fd >= 0)
+    close(fd);
+  
+  SharedMemoryReader reader;
+  const std::string event1(1000, 'a');
+  const std::string event2(500, 'b');
+  const std::string event3(800, 'c');
+  std::string reference1, reference2, reference3;
+  
+  unitTest.test("TOO_LARGE", !writer->write(event1.c_str(), 2000, reference1));
+  unitTest.test("WRITE", writer->write(event1.c_str(), event1.size(), reference1));
+  unitTest.test("IS_REFERENCE", SharedMemoryReference::isReference(reference1.c_str(), reference1.size()));
+  unitTest.test("NOT_REFERENCE", !SharedMemoryReference::isReference(event1.c_str(), event1.size()));
+  
+  // read in place
+  std::string contents;
+  bool read = reader.read(reference1.c_str(), reference1.size(), [&](const char *data, size_t size) {
+    contents.assign(data, size);
+  });
+  unitTest.test("READ", read);
+  unitTest.test("READ_CONTENTS", contents == event1);
+  
+  // a slot being read is not rewritten
+  auto ring = SharedMemoryRing::open(writer->name());
+  unitTest.test("OPEN", nullptr != ring);
+  uint32_t slot(0);
+  uint64_t sequence(0), size(0);
+  std::string ringName;
+  SharedMemoryReference::read(reference1.c_str(), reference1.size(), ringName, slot, sequence, size);
+  const char *pinned(nullptr);
+  unitTest.test("PIN", ring->pin(slot, sequence, size, pinned));
+  unitTest.test("WRITE_SECOND", writer->write(event2.c_str(), event2.size(), reference2));
+  unitTest.test("WRITE_THIRD", writer->write(event3.c_str(), event3.size(), reference3));
+  unitTest.test("PINNED_CONTENTS", std::string(pinned, size) == event1);
+  ring->unpin(slot);
+  
+  // the second event was rewritten by the third one
+  read = reader.read(reference2.c_str(), reference2.size(), [&](const char *data, size_t s) {
+    contents.assign(data, s);
+  });
+  unitTest.test("LOST", !read);
+  read = reader.read(reference3.c_str(), reference3.size(), [&](const char *data, size_t s) {
+    contents.assign(data, s);
+  });
+  unitTest.test("READ_THIRD", read && contents == event3);
+  
+  unitTest.test("OPEN_UNKNOWN", nullptr == SharedMemoryRing::open("/dqm4hep-unknown-ring"));
+  
+  // attach check before reading (network fallback)
+  SharedMemoryReader otherReader;
+  unitTest.test("ATTACH", otherReader.attach(reference3.c_str(), reference3.size()));
+  std::string unknownReference;
+  SharedMemoryReference::write(unknownReference, "/dqm4hep-unknown-ring", 0, 1, 10);
+  unitTest.test("ATTACH_UNKNOWN", !otherReader.attach(unknownReference.c_str(), unknownReference.size()));
+  unitTest.test("ATTACH_MALFORMED", !otherReader.attach(event1.c_str(), event1.size()));
+  
+  return 0;
+}
@@ -93,10 +93,25 @@ int main(int /*argc*/, char ** /*argv*/) {
   unitTest.test("DIR_NOT_EXISTS1", !storage.dirExists("best"));
   unitTest.test("DIR_EXISTS2", storage.dirExists("/heroes"));
 
+  // indexed lookups
+  std::shared_ptr<Object> found;
+  unitTest.test("FIND_ABS", storage.findObject("/heroes/worst", "Batman", found) == STATUS_CODE_SUCCESS && found->name() == "Batman");
+  unitTest.test("FIND_ABS_SLASH", storage.findObject("/heroes/worst/", "Batman", found) == STATUS_CODE_SUCCESS && found->name() == "Batman");
+  unitTest.test("FIND_REL", storage.findObject("", "Me", found) == STATUS_CODE_SUCCESS && found->name() == "Me");
+  unitTest.test("FIND_REL_UP", storage.findObject("../worst", "Batman", found) == STATUS_CODE_SUCCESS && found->name() == "Batman");
+  unitTest.test("FIND_NOT_FOUND", storage.findObject("/heroes/worst", "Me", found) == STATUS_CODE_NOT_FOUND && nullptr == found);
+  unitTest.test("FIND_NO_DIR", storage.findObject("/villains", "Joker", found) != STATUS_CODE_SUCCESS);
+  unitTest.test("REMOVE", storage.remove("/heroes/best", [](std::shared_ptr<Object> o) { return o->name() == "Me"; }) == STATUS_CODE_SUCCESS);
+  unitTest.test("FIND_REMOVED", storage.findObject("/heroes/best", "Me", found) == STATUS_CODE_NOT_FOUND);
+  unitTest.test("FIND_DIR_SLASHES", storage.dirExists("//heroes//best/"));
+
   unitTest.test("GO_UP", storage.goUp() == STATUS_CODE_SUCCESS);
   unitTest.test("PWD2", storage.pwd() == "heroes");
 
   unitTest.test("RMDIR", storage.rmdir("/heroes/worst") == STATUS_CODE_SUCCESS);
+  unitTest.test("FIND_RMDIR", storage.findObject("/heroes/worst", "Batman", found) != STATUS_CODE_SUCCESS);
+  storage.clear();
+  unitTest.test("FIND_CLEAR", storage.findObject("/heroes/best", "Superman", found) != STATUS_CODE_SUCCESS);
 
   return 0;
 }
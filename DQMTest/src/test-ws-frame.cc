@@ -0,0 +1,110 @@
+/// \file test-ws-frame.cc
+/*
+ *
+ * test-ws-frame.cc main source file template automatically generated
+ * Creation date : ven. oct. 16 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/UnitTesting.h>
+#include <dqm4hep/WebSocketServer.h>
+
+using namespace dqm4hep::net;
+using UnitTest = dqm4hep::test::UnitTest;
+
+int main(int /*argc*/, char ** /*argv*/) {
+  
+  UnitTest unitTest("test-ws-frame");
+  
+  // varint round trip, on the 7 bits boundaries
+  const uint32_t values[] = {0, 1, 127, 128, 16383, 16384, 2097151, 2097152, 0xFFFFFFFF};
+  const size_t sizes[] = {1, 1, 1, 2, 2, 3, 3, 4, 5};
+  
+  for (unsigned int i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    const std::string name(std::to_string(values[i]));
+    std::string varint;
+    WsBinaryFrame::writeVarint(varint, values[i]);
+    unitTest.test("VARINT_SIZE_" + name, varint.size() == sizes[i]);
+    
+    const char *buffer = varint.data();
+    uint32_t value(0);
+    unitTest.test("VARINT_READ_" + name, WsBinaryFrame::readVarint(buffer, varint.data() + varint.size(), value));
+    unitTest.test("VARINT_VALUE_" + name, value == values[i]);
+    unitTest.test("VARINT_END_" + name, buffer == varint.data() + varint.size());
+  }
+  
+  // truncated and overflowing varints
+  std::string varint;
+  WsBinaryFrame::writeVarint(varint, 16384);
+  const char *buffer = varint.data();
+  uint32_t value(0);
+  unitTest.test("VARINT_TRUNCATED", !WsBinaryFrame::readVarint(buffer, varint.data() + 2, value));
+  unitTest.test("VARINT_TRUNCATED_UNMOVED", buffer == varint.data());
+  
+  const std::string overflow("\xFF\xFF\xFF\xFF\x1F", 5);
+  buffer = overflow.data();
+  unitTest.test("VARINT_OVERFLOW", !WsBinaryFrame::readVarint(buffer, overflow.data() + overflow.size(), value));
+  
+  // update frame round trip
+  const std::string payload("\x00binary\x01update", 14);
+  std::string frame;
+  WsBinaryFrame::write(frame, 300, WsBinaryFrame::UPDATE, payload.data(), payload.size());
+  unitTest.test("FRAME_SIZE", frame.size() == 2 + 1 + payload.size());
+  
+  uint32_t serviceId(0);
+  WsBinaryFrame::Flags flags(WsBinaryFrame::SUBSCRIBED);
+  const char *framePayload(nullptr);
+  size_t framePayloadSize(0);
+  unitTest.test("FRAME_READ", WsBinaryFrame::read(frame.data(), frame.size(), serviceId, flags, framePayload, framePayloadSize));
+  unitTest.test("FRAME_ID", serviceId == 300);
+  unitTest.test("FRAME_FLAGS", flags == WsBinaryFrame::UPDATE);
+  unitTest.test("FRAME_PAYLOAD", std::string(framePayload, framePayloadSize) == payload);
+  
+  // subscription acknowledgment: control frame with the service id and name
+  std::string ackPayload, ack;
+  WsBinaryFrame::writeVarint(ackPayload, 300);
+  ackPayload += "/dqm4hep/service";
+  WsBinaryFrame::write(ack, 0, WsBinaryFrame::SUBSCRIBED, ackPayload.data(), ackPayload.size());
+  unitTest.test("CONTROL_READ", WsBinaryFrame::read(ack.data(), ack.size(), serviceId, flags, framePayload, framePayloadSize));
+  unitTest.test("CONTROL_ID", serviceId == 0);
+  unitTest.test("CONTROL_FLAGS", flags == WsBinaryFrame::SUBSCRIBED);
+  const char *payloadEnd = framePayload + framePayloadSize;
+  unitTest.test("CONTROL_SERVICE_ID", WsBinaryFrame::readVarint(framePayload, payloadEnd, value) && value == 300);
+  unitTest.test("CONTROL_SERVICE_NAME", std::string(framePayload, payloadEnd) == "/dqm4hep/service");
+  
+  // empty payload
+  std::string empty;
+  WsBinaryFrame::write(empty, 0, WsBinaryFrame::SUBSCRIBE, nullptr, 0);
+  unitTest.test("EMPTY_READ", WsBinaryFrame::read(empty.data(), empty.size(), serviceId, flags, framePayload, framePayloadSize));
+  unitTest.test("EMPTY_PAYLOAD", framePayloadSize == 0 && flags == WsBinaryFrame::SUBSCRIBE);
+  
+  // malformed frames
+  unitTest.test("MALFORMED_NO_FLAGS", !WsBinaryFrame::read(frame.data(), 2, serviceId, flags, framePayload, framePayloadSize));
+  unitTest.test("MALFORMED_TRUNCATED_ID", !WsBinaryFrame::read(frame.data(), 1, serviceId, flags, framePayload, framePayloadSize));
+  const std::string badFlags("\x00\x09", 2);
+  unitTest.test("MALFORMED_FLAGS", !WsBinaryFrame::read(badFlags.data(), badFlags.size(), serviceId, flags, framePayload, framePayloadSize));
+  
+  return 0;
+}
@@ -0,0 +1,129 @@
+/// \file test-ws-send-queue.cc
+/*
+ *
+ * test-ws-send-queue.cc main source file template automatically generated
+ * Creation date : sam. oct. 17 2026
+ *
+ * This file is part of DQM4HEP libraries.
+ *
+ * DQM4HEP is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * based upon these libraries are permitted. Any copy of these libraries
+ * must include this copyright notice.
+ *
+ * DQM4HEP is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with DQM4HEP.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @author Remi Ete
+ * @copyright CNRS , IPNL
+ */
+
+// -- dqm4hep headers
+#include <dqm4hep/Internal.h>
+#include <dqm4hep/Logging.h>
+#include <dqm4hep/UnitTesting.h>
+#include <dqm4hep/WsSendQueue.h>
+
+// -- std headers
+#include <string>
+#include <vector>
+
+using namespace dqm4hep::net;
+using UnitTest = dqm4hep::test::UnitTest;
+
+/**
+ *  @brief  A fake connection buffering the written messages
+ */
+struct FakeConnection {
+  std::vector<std::string>   m_written = {};
+  size_t                     m_bufferedAmount = {0};
+  bool                       m_error = {false};
+
+  WsSendQueue<std::string>::BufferedAmountFunction bufferedAmount() {
+    return [this]() { return m_bufferedAmount; };
+  }
+
+  WsSendQueue<std::string>::SendFunction send() {
+    return [this](const std::string &message) {
+      if(m_error) {
+        return false;
+      }
+      m_written.push_back(message);
+      m_bufferedAmount += message.size();
+      return true;
+    };
+  }
+};
+
+int main(int /*argc*/, char ** /*argv*/) {
+
+  UnitTest unitTest("test-ws-send-queue");
+
+  // drop oldest when full
+  WsSendQueue<std::string> queue;
+  for(unsigned int i=0 ; i<5 ; i++) {
+    queue.push("msg" + std::to_string(i), 3);
+  }
+  unitTest.test("FULL_SIZE", 3 == queue.size());
+  unitTest.test("FULL_DROPPED", 2 == queue.nDropped() and 0 == queue.nSent());
+
+  // the oldest were dropped: the newest are sent in order
+  FakeConnection connection;
+  queue.flush(1024, connection.bufferedAmount(), connection.send());
+  unitTest.test("FLUSH_ALL", queue.empty() and 3 == queue.nSent());
+  unitTest.test("FLUSH_ORDER", std::vector<std::string>({"msg2", "msg3", "msg4"}) == connection.m_written);
+
+  // the connection buffers too much: nothing is written
+  connection.m_written.clear();
+  connection.m_bufferedAmount = 10;
+  queue.push("abcd", 16);
+  queue.flush(10, connection.bufferedAmount(), connection.send());
+  unitTest.test("BUFFERED_QUEUED", 1 == queue.size() and connection.m_written.empty());
+  
+  // written while the connection buffers less than the maximum amount
+  connection.m_bufferedAmount = 0;
+  for(unsigned int i=0 ; i<4 ; i++) {
+    queue.push("efgh", 16);
+  }
+  queue.flush(10, connection.bufferedAmount(), connection.send());
+  unitTest.test("BUFFERED_PARTIAL", 3 == connection.m_written.size() and 2 == queue.size());
+  unitTest.test("BUFFERED_AMOUNT", 12 == connection.m_bufferedAmount);
+  unitTest.test("BUFFERED_ORDER", "abcd" == connection.m_written[0] and "efgh" == connection.m_written[2]);
+
+  // the connection wrote its buffer
+  connection.m_bufferedAmount = 0;
+  queue.flush(10, connection.bufferedAmount(), connection.send());
+  unitTest.test("BUFFERED_DRAINED", queue.empty() and 5 == connection.m_written.size());
+  unitTest.test("SENT_COUNT", 8 == queue.nSent() and 2 == queue.nDropped());
+
+  // a maximum buffered amount of 0 always queues
+  queue.push("ijkl", 16);
+  queue.flush(0, connection.bufferedAmount(), connection.send());
+  unitTest.test("ZERO_BUFFERED_AMOUNT", 1 == queue.size());
+
+  // lowering the maximum size drops the oldest messages on the next push
+  for(unsigned int i=0 ; i<4 ; i++) {
+    queue.push("mnop", 16);
+  }
+  queue.push("last", 2);
+  unitTest.test("LOWER_MAX_SIZE", 2 == queue.size() and 6 == queue.nDropped());
+  
+  // a maximum size of 0 keeps one message
+  queue.push("only", 0);
+  unitTest.test("MIN_MAX_SIZE", 1 == queue.size() and 8 == queue.nDropped());
+
+  // a write error drops the message
+  connection.m_error = true;
+  connection.m_bufferedAmount = 0;
+  queue.flush(10, connection.bufferedAmount(), connection.send());
+  unitTest.test("SEND_ERROR", queue.empty() and 9 == queue.nDropped() and 8 == queue.nSent());
+
+  return 0;
+}